@@ -82,7 +82,7 @@ extern "C"
 #include "libdar.hpp"
 #include "fichier_local.hpp"
 
-#define OPT_STRING "c:A:x:d:t:l:v::z::y:nw::p::k::R:s:S:X:I:P:bhLWDru:U:VC:i:o:OT:E:F:K:J:Y:Z:B:fm:NH::a::eQGMg:#:*:,[:]:+:@:$:~:%:q/:^:_:01:2:.:3:9:<:>:=:4:5::6:7:8:{:}:j:\\:"
+#define OPT_STRING "c:A:x:d:t:l:v::z::y:nw::p::k::R:s:S:X:I:P:bhLWDru:U:VC:i:o:OT:E:F:K:J:Y:Z:B:fm:NH::a::eQG::Mg:#:*:,[:]:+:@:$:~:%:q/:^:_:01:2:.:3:9:<:>:=:4:5::6:7:8:{:}:j:\\:"
 
 #define ONLY_ONCE "Only one -%c is allowed, ignoring this extra option"
 #define MISSING_ARG "Missing argument to -%c option"
@@ -129,7 +129,7 @@ static void show_license(user_interaction & dialog);
 static void show_warranty(user_interaction & dialog);
 static void show_version(user_interaction & dialog, const char *command_name);
 static void usage(user_interaction & dialog, const char *command_name);
-static void split_compression_algo(const char *arg, compression & algo, U_I & level);
+static void split_compression_algo(const char *arg, compression & algo, U_I & level, U_I & block_size);
 static fsa_scope string_to_fsa(const string & arg);
 
 #if HAVE_GETOPT_LONG
@@ -165,6 +165,7 @@ struct recursive_param
     deque<string> read_targets; // list of not found uset targets so far
     deque<pre_mask> path_delta_include_exclude;
     bool duc_and;
+    bool slices_in_flight_set;
 
     recursive_param(shared_ptr<user_interaction> & x_dialog,
                     const char *x_home,
@@ -189,6 +190,7 @@ struct recursive_param
         detruire = true;
         no_inter = false;
 	duc_and = false;
+	slices_in_flight_set = false;
     };
 
     recursive_param(const recursive_param & ref): dar_dcf_path(ref.dar_dcf_path), dar_duc_path(ref.dar_duc_path)
@@ -219,8 +221,13 @@ static mask *make_include_exclude_name(const string & x, mask_opt opt);
 static mask *make_exclude_path_ordered(const string & x, mask_opt opt);
 static mask *make_exclude_path_unordered(const string & x, mask_opt opt);
 static mask *make_include_path(const string & x, mask_opt opt);
-static mask *make_ordered_mask(deque<pre_mask> & listing, mask *(*make_include_mask) (const string & x, mask_opt opt), mask *(*make_exclude_mask)(const string & x, mask_opt opt), const path & prefix);
-static mask *make_unordered_mask(deque<pre_mask> & listing, mask *(*make_include_mask) (const string & x, mask_opt opt), mask *(*make_exclude_mask)(const string & x, mask_opt opt), const path & prefix);
+static bool make_include_exclude_name_patterns(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex);
+static bool make_exclude_path_ordered_patterns(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex);
+static bool make_exclude_path_unordered_patterns(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex);
+static mask *make_pattern_set_mask(const deque<string> & globs, const deque<string> & regex, bool case_sensit);
+static mask *make_merged_mask(deque<pre_mask> & listing, mask *(*make_mask) (const string & x, mask_opt opt), bool (*make_patterns)(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex), const mask_opt & opt);
+static mask *make_ordered_mask(deque<pre_mask> & listing, mask *(*make_include_mask) (const string & x, mask_opt opt), mask *(*make_exclude_mask)(const string & x, mask_opt opt), bool (*include_patterns)(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex), bool (*exclude_patterns)(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex), const path & prefix);
+static mask *make_unordered_mask(deque<pre_mask> & listing, mask *(*make_include_mask) (const string & x, mask_opt opt), mask *(*make_exclude_mask)(const string & x, mask_opt opt), bool (*include_patterns)(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex), bool (*exclude_patterns)(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex), const path & prefix);
 static void add_non_options(S_I argc, char * const argv[], deque<string> & non_options);
 
 bool get_args(shared_ptr<user_interaction> & dialog,
@@ -249,6 +256,7 @@ bool get_args(shared_ptr<user_interaction> & dialog,
     p.display_masks = false;
     p.algo = compression::none;
     p.compression_level = 9;
+    p.compression_block_size = 0;
     p.pause = 0;
     p.beep = false;
     p.empty_dir = false;
@@ -314,6 +322,9 @@ bool get_args(shared_ptr<user_interaction> & dialog,
     p.no_compare_symlink_date = true;
     p.scope = all_fsa_families();
     p.multi_threaded = false;
+    p.num_workers = 1;
+    p.compress_workers = 0;
+    p.slices_in_flight = 0;
     p.delta_sig = false;
     p.delta_mask = nullptr;
     p.delta_diff = true;
@@ -324,6 +335,10 @@ bool get_args(shared_ptr<user_interaction> & dialog,
     p.sizes_in_bytes = false;
     p.header_only = false;
     p.zeroing_neg_dates = false;
+    p.physical_order = false;
+    p.memory_mapped = false;
+    p.cache_size = 102400;
+    p.subtree_restricted = false;
     p.ignored_as_symlink = "";
     p.modet = modified_data_detection::mtime_size;
     p.iteration_count = 0; // will not touch the default API value if still set to zero
@@ -345,6 +360,11 @@ bool get_args(shared_ptr<user_interaction> & dialog,
             if(! update_with_config_files(rec, p))
                 return false;
 
+        if(p.compress_workers == 0) // --compression-workers not given
+            p.compress_workers = p.num_workers;
+        if(p.multi_threaded && !rec.slices_in_flight_set)
+            p.slices_in_flight = 2; // finishing slices in background was formerly only driven by -G
+
             // this cannot be done sooner, because "info_details" would always be equal to false
             // as command-line would not have been yet parsed.
 
@@ -480,6 +500,10 @@ bool get_args(shared_ptr<user_interaction> & dialog,
             dialog->message(gettext("-ac is only useful with -c or -d"));
         if(p.same_fs && p.op != create)
             dialog->message(gettext("-M is only useful with -c"));
+        if(p.physical_order && p.op != create)
+            dialog->message(gettext("-ap is only useful with -c"));
+        if(p.memory_mapped && p.lax)
+            dialog->message(gettext("-ammap is ignored in lax mode (-al)"));
         if(p.snapshot && p.op != create)
             dialog->message(gettext("The snapshot backup (-A +) is only available with -c option, ignoring"));
         if(p.cache_directory_tagging && p.op != create)
@@ -606,11 +630,15 @@ bool get_args(shared_ptr<user_interaction> & dialog,
             p.selection = make_ordered_mask(rec.name_include_exclude,
                                             &make_include_exclude_name,
                                             &make_include_exclude_name,
+                                            &make_include_exclude_name_patterns,
+                                            &make_include_exclude_name_patterns,
                                             tools_relative2absolute_path(*p.fs_root, cwd));
         else // unordered filters
             p.selection = make_unordered_mask(rec.name_include_exclude,
                                               &make_include_exclude_name,
                                               &make_include_exclude_name,
+                                              &make_include_exclude_name_patterns,
+                                              &make_include_exclude_name_patterns,
                                               tools_relative2absolute_path(*p.fs_root, cwd));
 
 
@@ -619,15 +647,20 @@ bool get_args(shared_ptr<user_interaction> & dialog,
             // directory tree
             //
 
+        p.subtree_restricted = !rec.path_include_exclude.empty();
         if(rec.ordered_filters)
             p.subtree = make_ordered_mask(rec.path_include_exclude,
                                           &make_include_path,
                                           &make_exclude_path_ordered,
+                                          nullptr,
+                                          &make_exclude_path_ordered_patterns,
                                           p.op != test && p.op != merging && p.op != listing ? tools_relative2absolute_path(*p.fs_root, cwd) : PSEUDO_ROOT);
         else // unordered filters
             p.subtree = make_unordered_mask(rec.path_include_exclude,
                                             &make_include_path,
                                             &make_exclude_path_unordered,
+                                            nullptr,
+                                            &make_exclude_path_unordered_patterns,
                                             p.op != test && p.op != merging && p.op != listing ? tools_relative2absolute_path(*p.fs_root, cwd) : PSEUDO_ROOT);
 
 
@@ -648,11 +681,15 @@ bool get_args(shared_ptr<user_interaction> & dialog,
                 p.compress_mask = make_ordered_mask(rec.compr_include_exclude,
                                                     &make_include_exclude_name,
                                                     &make_include_exclude_name,
+                                                    &make_include_exclude_name_patterns,
+                                                    &make_include_exclude_name_patterns,
                                                     tools_relative2absolute_path(*p.fs_root, cwd));
             else
                 p.compress_mask = make_unordered_mask(rec.compr_include_exclude,
                                                       &make_include_exclude_name,
                                                       &make_include_exclude_name,
+                                                      &make_include_exclude_name_patterns,
+                                                      &make_include_exclude_name_patterns,
                                                       tools_relative2absolute_path(*p.fs_root, cwd));
         else
         {
@@ -670,11 +707,15 @@ bool get_args(shared_ptr<user_interaction> & dialog,
             p.ea_mask = make_ordered_mask(rec.ea_include_exclude,
                                           &make_include_exclude_name,
                                           &make_include_exclude_name,
+                                          &make_include_exclude_name_patterns,
+                                          &make_include_exclude_name_patterns,
                                           tools_relative2absolute_path(*p.fs_root, cwd));
         else // unordered filters
             p.ea_mask = make_unordered_mask(rec.ea_include_exclude,
                                             &make_include_exclude_name,
                                             &make_include_exclude_name,
+                                            &make_include_exclude_name_patterns,
+                                            &make_include_exclude_name_patterns,
                                             tools_relative2absolute_path(*p.fs_root, cwd));
 
 
@@ -707,11 +748,15 @@ bool get_args(shared_ptr<user_interaction> & dialog,
                     p.backup_hook_mask = make_ordered_mask(rec.backup_hook_include_exclude,
                                                            &make_exclude_path_unordered, // no mistake here about *exclude*, nor *unordered*
                                                            &make_exclude_path_unordered, // no mistake here about *exclude*, nor *unordered*
+                                                           &make_exclude_path_unordered_patterns,
+                                                           &make_exclude_path_unordered_patterns,
                                                            tools_relative2absolute_path(*p.fs_root, cwd));
                 else
                     p.backup_hook_mask = make_unordered_mask(rec.backup_hook_include_exclude,
                                                              &make_exclude_path_unordered,// no mistake here about *exclude*
                                                              &make_exclude_path_unordered,
+                                                             &make_exclude_path_unordered_patterns,
+                                                             &make_exclude_path_unordered_patterns,
                                                              tools_relative2absolute_path(*p.fs_root, cwd));
 
 
@@ -726,11 +771,15 @@ bool get_args(shared_ptr<user_interaction> & dialog,
 		p.delta_mask = make_ordered_mask(rec.path_delta_include_exclude,
 						 &make_exclude_path_unordered, // no mistake here about *exclude*, nor *unordered*
 						 &make_exclude_path_unordered, // no mistake here about *exclude*, nor *unordered*
+						 &make_exclude_path_unordered_patterns,
+						 &make_exclude_path_unordered_patterns,
 						 p.op != test && p.op != merging && p.op != listing && p.op != isolate ? tools_relative2absolute_path(*p.fs_root, tools_getcwd()) : PSEUDO_ROOT);
 	    else // unordered filters
 		p.delta_mask = make_unordered_mask(rec.path_delta_include_exclude,
 						   &make_exclude_path_unordered, // no mistake here about *exclude*
 						   &make_exclude_path_unordered, // no mistake here about *exclude*
+						   &make_exclude_path_unordered_patterns,
+						   &make_exclude_path_unordered_patterns,
 						   p.op != test && p.op != merging && p.op != listing && p.op != isolate ? tools_relative2absolute_path(*p.fs_root, tools_getcwd()) : PSEUDO_ROOT);
 	}
 
@@ -1007,7 +1056,7 @@ static bool get_args_recursive(recursive_param & rec,
                 break;
             case 'z':
                 if(optarg != nullptr)
-                    split_compression_algo(optarg, p.algo, p.compression_level);
+                    split_compression_algo(optarg, p.algo, p.compression_level, p.compression_block_size);
                 else
                     if(p.algo == compression::none)
                         p.algo = compression::gzip;
@@ -1610,6 +1659,10 @@ static bool get_args_recursive(recursive_param & rec,
 		    p.header_only = true;
 		else if(strcasecmp("z", optarg) == 0 || strcasecmp("zeroing-negative-dates", optarg) == 0)
 		    p.zeroing_neg_dates = true;
+		else if(strcasecmp("p", optarg) == 0 || strcasecmp("physical-order", optarg) == 0)
+		    p.physical_order = true;
+		else if(strcasecmp("mmap", optarg) == 0 || strcasecmp("memory-mapped", optarg) == 0)
+		    p.memory_mapped = true;
 		else
                     throw Erange("command_line.cpp:get_args_recursive", tools_printf(gettext("Unknown argument given to -a : %s"), optarg));
                 break;
@@ -1623,12 +1676,15 @@ static bool get_args_recursive(recursive_param & rec,
                 rec.no_inter = true;
                 break;
             case 'G':
-                if(optarg != nullptr)
-                    throw Erange("command_line.cpp:get_arg_recursive", tools_printf(gettext(INVALID_ARG), char(lu)));
 		if(compile_time::libthreadar())
 		    p.multi_threaded = true;
 		else
 		    throw Ecompilation(gettext("libthreadar required for multithreaded execution"));
+                if(optarg != nullptr)
+		{
+		    if(!tools_my_atoi(optarg, p.num_workers) || p.num_workers < 1)
+			throw Erange("command_line.cpp:get_arg_recursive", tools_printf(gettext(INVALID_ARG), char(lu)));
+		}
                 break;
             case 'M':
                 if(p.same_fs)
@@ -1791,6 +1847,44 @@ static bool get_args_recursive(recursive_param & rec,
                             throw Erange("command_line.cpp:get_args_recursive", tools_printf(gettext("Unknown argument given to -2 : %s"), optarg));
                 }
                 break;
+            case '&':
+                if(optarg == nullptr)
+                    throw Erange("get_args", tools_printf(gettext(MISSING_ARG), char(lu)));
+                if(!tools_my_atoi(optarg, p.slices_in_flight))
+                    throw Erange("get_args", gettext("Invalid number given to --slices-in-flight option"));
+                if(p.slices_in_flight > 0 && !compile_time::libthreadar())
+                    throw Ecompilation(gettext("libthreadar required for multithreaded execution"));
+                rec.slices_in_flight_set = true;
+                break;
+            case ')':
+                if(optarg == nullptr)
+                    throw Erange("get_args", tools_printf(gettext(MISSING_ARG), char(lu)));
+                if(!tools_my_atoi(optarg, p.compress_workers) || p.compress_workers < 1)
+                    throw Erange("get_args", gettext("Invalid number given to --compression-workers option"));
+                if(p.compress_workers > 1 && !compile_time::libthreadar())
+                    throw Ecompilation(gettext("libthreadar required for multithreaded execution"));
+                break;
+            case '(':
+                if(optarg == nullptr)
+                    throw Erange("get_args", tools_printf(gettext(MISSING_ARG), char(lu)));
+                else
+                {
+                    try
+                    {
+                        infinint tmp_size = tools_get_extended_size(optarg, rec.suffix_base);
+
+                        p.cache_size = 0;
+                        tmp_size.unstack(p.cache_size);
+                        if(!tmp_size.is_zero() || p.cache_size < 10)
+                            throw Erange("get_args", gettext("Invalid size given to --cache-size option"));
+                    }
+                    catch(Edeci &e)
+                    {
+                        rec.dialog->message(gettext("Invalid size given to --cache-size option"));
+                        return false;
+                    }
+                }
+                break;
             case '"':
                 if(optarg == nullptr)
                     throw Erange("get_args", tools_printf(gettext(MISSING_ARG), char(lu)));
@@ -2010,13 +2104,30 @@ static bool get_args_recursive(recursive_param & rec,
 	    case 'j':
 		if(optarg == nullptr)
 		    throw Erange("get_args", tools_printf(gettext(MISSING_ARG), char(lu)));
-		if(!tools_my_atoi(optarg, tmp))
-		    throw Erange("get_args", tools_printf(gettext(INVALID_ARG), char(lu)));
 		else
 		{
+		    string arg = optarg;
+		    string::size_type sep = arg.find(':');
+		    U_I parallel = 1;
+
+		    if(sep != string::npos)
+		    {
+			if(!tools_my_atoi(arg.substr(sep + 1).c_str(), parallel) || parallel < 1)
+			    throw Erange("get_args", tools_printf(gettext(INVALID_ARG), char(lu)));
+			if(parallel > 1 && !compile_time::libthreadar())
+			    throw Ecompilation(gettext("libthreadar required for parallel transfers"));
+			arg = arg.substr(0, sep);
+		    }
+
+		    if(!tools_my_atoi(arg.c_str(), tmp))
+			throw Erange("get_args", tools_printf(gettext(INVALID_ARG), char(lu)));
+
 		    p.remote.network_retry = tmp;
 		    p.ref_remote.network_retry = tmp;
 		    p.aux_remote.network_retry = tmp;
+		    p.remote.parallel_transfers = parallel;
+		    p.ref_remote.parallel_transfers = parallel;
+		    p.aux_remote.parallel_transfers = parallel;
 		}
 		break;
 	    case '\\':
@@ -2116,8 +2227,8 @@ static void usage(user_interaction & dialog, const char *command_name)
     dialog.printf(gettext("   -@ [path/]<basename> auxiliary archive of reference for merging\n"));
     dialog.printf(gettext("   -$ <string>\t   encryption key for auxiliary archive\n"));
     dialog.printf(gettext("   -~ <string>\t   command between slices of the auxiliary archive\n"));
-    dialog.printf(gettext("   -z [[algo:]level]\t compress data in archive. -z = -z9 = -zgzip:9\n"));
-    dialog.printf(gettext("      Available algo: gzip,bzip2,lzo,xz. Exemples: -zlzo -zxz:5 -z1 -z\n"));
+    dialog.printf(gettext("   -z [[algo:]level[:blocksize]]\t compress data in archive. -z = -z9 = -zgzip:9\n"));
+    dialog.printf(gettext("      Available algo: gzip,bzip2,lzo,xz,zstd,zstd-long,lz4. Exemples: -zlzo -zxz:5 -zzstd:19 -z1 -z\n"));
     dialog.printf(gettext("   -s <integer>    split the archive in several files of size <integer>\n"));
     dialog.printf(gettext("   -S <integer>    first file size (if different from following ones)\n"));
     dialog.printf(gettext("   -aSI \t   slice size suffixes k, M, T, G, etc. are powers of 10\n"));
@@ -2624,7 +2735,7 @@ const struct option *get_long_opt()
         {"fsa-scope", required_argument, nullptr, '4'},
         {"exclude-by-ea", optional_argument, nullptr, '5'},
         {"sign", required_argument, nullptr, '7'},
-        {"multi-thread", no_argument, nullptr, 'G'},
+        {"multi-thread", optional_argument, nullptr, 'G'},
 	{"delta", required_argument, nullptr, '8'},
 	{"include-delta-sig", required_argument, nullptr, '{'},
 	{"exclude-delta-sig", required_argument, nullptr, '}'},
@@ -2633,6 +2744,9 @@ const struct option *get_long_opt()
 	{"ignored-as-symlink", required_argument, nullptr, '\\'},
 	{"add-missing-catalogue", required_argument, nullptr, 'y'},
 	{"modified-data-detection", required_argument, nullptr, '\''},
+	{"cache-size", required_argument, nullptr, '('},
+	{"compression-workers", required_argument, nullptr, ')'},
+	{"slices-in-flight", required_argument, nullptr, '&'},
 	{"kdf-param", required_argument, nullptr, 'T'},
         { nullptr, 0, nullptr, 0 }
     };
@@ -3053,7 +3167,92 @@ static mask *make_include_path(const string & x, mask_opt opt)
     return ret;
 }
 
-static mask *make_ordered_mask(deque<pre_mask> & listing, mask *(*make_include_mask) (const string & x, mask_opt opt), mask *(*make_exclude_mask)(const string & x, mask_opt opt), const path & prefix)
+static bool make_include_exclude_name_patterns(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex)
+{
+    if(opt.glob_exp)
+        globs.push_back(x);
+    else
+        regex.push_back(x);
+
+    return true;
+}
+
+static bool make_exclude_path_ordered_patterns(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex)
+{
+    if(opt.file_listing)
+        return false;
+
+    if(opt.glob_exp)
+    {
+        globs.push_back((opt.prefix + x).display());
+        globs.push_back((opt.prefix + x).display() + "/*");
+    }
+    else
+        regex.push_back(line_tools_build_regex_for_exclude_mask(opt.prefix.display(), x));
+
+    return true;
+}
+
+static bool make_exclude_path_unordered_patterns(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex)
+{
+    if(opt.file_listing)
+        return false;
+
+    if(opt.glob_exp)
+        globs.push_back((opt.prefix + x).display());
+    else
+        regex.push_back(line_tools_build_regex_for_exclude_mask(opt.prefix.display(), x));
+
+    return true;
+}
+
+static mask *make_pattern_set_mask(const deque<string> & globs, const deque<string> & regex, bool case_sensit)
+{
+    mask *ret = nullptr;
+
+    if(globs.size() + regex.size() == 1)
+    {
+        if(globs.empty())
+            ret = new (nothrow) regular_mask(regex.front(), case_sensit);
+        else
+            ret = new (nothrow) simple_mask(globs.front(), case_sensit);
+    }
+    else
+        ret = new (nothrow) pattern_set_mask(globs, regex, case_sensit);
+
+    if(ret == nullptr)
+        throw Ememory("make_pattern_set_mask");
+
+    return ret;
+}
+
+static mask *make_merged_mask(deque<pre_mask> & listing, mask *(*make_mask) (const string & x, mask_opt opt), bool (*make_patterns)(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex), const mask_opt & opt)
+{
+    deque<string> globs, regex;
+    mask_opt next_opt = opt;
+
+        // the mask of the first entry of the listing is merged with the
+        // masks of the following entries of the same kind (include or exclude)
+        // and case sensitivity, these are removed from the listing, the first
+        // entry is left for the caller to remove
+
+    if(make_patterns == nullptr || !(*make_patterns)(listing.front().mask, opt, globs, regex))
+        return (*make_mask)(listing.front().mask, opt);
+
+    while(listing.size() > 1
+          && listing[1].included == listing.front().included
+          && listing[1].case_sensit == opt.case_sensit)
+    {
+        next_opt.read_from(listing[1]);
+        if(!(*make_patterns)(listing[1].mask, next_opt, globs, regex))
+            break;
+        listing.erase(listing.begin() + 1);
+    }
+
+    return make_pattern_set_mask(globs, regex, opt.case_sensit);
+}
+
+static mask *make_ordered_mask(deque<pre_mask> & listing, mask *(*make_include_mask) (const string & x, mask_opt opt), mask *(*make_exclude_mask)(const string & x, mask_opt opt), bool (*include_patterns)(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex), bool (*exclude_patterns)(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex), const path & prefix)
 {
     mask *ret_mask = nullptr;
     ou_mask *tmp_ou_mask = nullptr;
@@ -3069,7 +3268,7 @@ static mask *make_ordered_mask(deque<pre_mask> & listing, mask *(*make_include_m
             if(listing.front().included)
                 if(ret_mask == nullptr) // first mask
                 {
-                    ret_mask = (*make_include_mask)(listing.front().mask, opt);
+                    ret_mask = make_merged_mask(listing, make_include_mask, include_patterns, opt);
                     if(ret_mask == nullptr)
                         throw Ememory("make_ordered_mask");
                 }
@@ -3077,14 +3276,14 @@ static mask *make_ordered_mask(deque<pre_mask> & listing, mask *(*make_include_m
                 {
                     if(tmp_ou_mask != nullptr)
                     {
-                        tmp_mask = (*make_include_mask)(listing.front().mask, opt);
+                        tmp_mask = make_merged_mask(listing, make_include_mask, include_patterns, opt);
                         tmp_ou_mask->add_mask(*tmp_mask);
                         delete tmp_mask;
                         tmp_mask = nullptr;
                     }
                     else  // need to create ou_mask
                     {
-                        tmp_mask = (*make_include_mask)(listing.front().mask, opt);
+                        tmp_mask = make_merged_mask(listing, make_include_mask, include_patterns, opt);
                         tmp_ou_mask = new (nothrow) ou_mask();
                         if(tmp_ou_mask == nullptr)
                             throw Ememory("make_ordered_mask");
@@ -3100,7 +3299,7 @@ static mask *make_ordered_mask(deque<pre_mask> & listing, mask *(*make_include_m
             else // exclude mask
                 if(ret_mask == nullptr)
                 {
-                    tmp_mask = (*make_exclude_mask)(listing.front().mask, opt);
+                    tmp_mask = make_merged_mask(listing, make_exclude_mask, exclude_patterns, opt);
                     ret_mask = new (nothrow) not_mask(*tmp_mask);
                     if(ret_mask == nullptr)
                         throw Ememory("make_ordered_mask");
@@ -3111,14 +3310,14 @@ static mask *make_ordered_mask(deque<pre_mask> & listing, mask *(*make_include_m
                 {
                     if(tmp_et_mask != nullptr)
                     {
-                        tmp_mask = (*make_exclude_mask)(listing.front().mask, opt);
+                        tmp_mask = make_merged_mask(listing, make_exclude_mask, exclude_patterns, opt);
                         tmp_et_mask->add_mask(not_mask(*tmp_mask));
                         delete tmp_mask;
                         tmp_mask = nullptr;
                     }
                     else // need to create et_mask
                     {
-                        tmp_mask = (*make_exclude_mask)(listing.front().mask, opt);
+                        tmp_mask = make_merged_mask(listing, make_exclude_mask, exclude_patterns, opt);
                         tmp_et_mask = new (nothrow) et_mask();
                         if(tmp_et_mask == nullptr)
                             throw Ememory("make_ordered_mask");
@@ -3169,12 +3368,15 @@ static mask *make_ordered_mask(deque<pre_mask> & listing, mask *(*make_include_m
     return ret_mask;
 }
 
-static mask *make_unordered_mask(deque<pre_mask> & listing, mask *(*make_include_mask) (const string & x, mask_opt opt), mask *(*make_exclude_mask)(const string & x, mask_opt opt), const path & prefix)
+static mask *make_unordered_mask(deque<pre_mask> & listing, mask *(*make_include_mask) (const string & x, mask_opt opt), mask *(*make_exclude_mask)(const string & x, mask_opt opt), bool (*include_patterns)(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex), bool (*exclude_patterns)(const string & x, mask_opt opt, deque<string> & globs, deque<string> & regex), const path & prefix)
 {
     et_mask *ret_mask = new (nothrow) et_mask();
     ou_mask tmp_include, tmp_exclude;
     mask *tmp_mask = nullptr;
     mask_opt opt = prefix;
+        // glob and regular expressions, indexed by case sensitivity
+    deque<string> include_globs[2], include_regex[2];
+    deque<string> exclude_globs[2], exclude_regex[2];
 
     if(ret_mask == nullptr)
         throw Ememory("make_unordered_mask");
@@ -3186,19 +3388,47 @@ static mask *make_unordered_mask(deque<pre_mask> & listing, mask *(*make_include
             opt.read_from(listing.front());
             if(listing.front().included)
             {
-                tmp_mask = (*make_include_mask)(listing.front().mask, opt);
+                if(include_patterns == nullptr
+                   || !(*include_patterns)(listing.front().mask, opt, include_globs[opt.case_sensit], include_regex[opt.case_sensit]))
+                {
+                    tmp_mask = (*make_include_mask)(listing.front().mask, opt);
+                    tmp_include.add_mask(*tmp_mask);
+                    delete tmp_mask;
+                    tmp_mask = nullptr;
+                }
+            }
+            else // excluded mask
+            {
+                if(exclude_patterns == nullptr
+                   || !(*exclude_patterns)(listing.front().mask, opt, exclude_globs[opt.case_sensit], exclude_regex[opt.case_sensit]))
+                {
+                    tmp_mask = (*make_exclude_mask)(listing.front().mask, opt);
+                    tmp_exclude.add_mask(*tmp_mask);
+                    delete tmp_mask;
+                    tmp_mask = nullptr;
+                }
+            }
+            listing.pop_front();
+        }
+
+            // the glob and regular expressions are compiled together
+
+        for(U_I case_sensit = 0; case_sensit < 2; ++case_sensit)
+        {
+            if(!include_globs[case_sensit].empty() || !include_regex[case_sensit].empty())
+            {
+                tmp_mask = make_pattern_set_mask(include_globs[case_sensit], include_regex[case_sensit], case_sensit != 0);
                 tmp_include.add_mask(*tmp_mask);
                 delete tmp_mask;
                 tmp_mask = nullptr;
             }
-            else // excluded mask
+            if(!exclude_globs[case_sensit].empty() || !exclude_regex[case_sensit].empty())
             {
-                tmp_mask = (*make_exclude_mask)(listing.front().mask, opt);
+                tmp_mask = make_pattern_set_mask(exclude_globs[case_sensit], exclude_regex[case_sensit], case_sensit != 0);
                 tmp_exclude.add_mask(*tmp_mask);
                 delete tmp_mask;
                 tmp_mask = nullptr;
             }
-            listing.pop_front();
         }
 
         if(tmp_include.size() > 0)
@@ -3212,13 +3442,18 @@ static mask *make_unordered_mask(deque<pre_mask> & listing, mask *(*make_include
     {
         delete ret_mask;
         ret_mask = nullptr;
+        if(tmp_mask != nullptr)
+        {
+            delete tmp_mask;
+            tmp_mask = nullptr;
+        }
         throw;
     }
 
     return ret_mask;
 }
 
-static void split_compression_algo(const char *arg, compression & algo, U_I & level)
+static void split_compression_algo(const char *arg, compression & algo, U_I & level, U_I & block_size)
 {
     if(arg == nullptr)
         throw SRC_BUG;
@@ -3253,6 +3488,16 @@ static void split_compression_algo(const char *arg, compression & algo, U_I & le
         {
             string first_part = string(working.begin(), it);
             string second_part = string(it+1, working.end());
+	    string third_part = "";
+
+	    it = second_part.begin();
+	    while(it != second_part.end() && *it != ':')
+		it++;
+	    if(it != second_part.end()) // a second ':' has been found
+	    {
+		third_part = string(it+1, second_part.end());
+		second_part = string(second_part.begin(), it);
+	    }
 
             if(first_part != "")
                 algo = string2compression(first_part);
@@ -3261,11 +3506,21 @@ static void split_compression_algo(const char *arg, compression & algo, U_I & le
 
             if(second_part != "")
             {
-                if(!tools_my_atoi(second_part.c_str(), level) || level > 9 || level < 1)
-                    throw Erange("split_compression_algo", gettext("Compression level must be between 1 and 9, included"));
+                if(!tools_my_atoi(second_part.c_str(), level) || level > compression_max_level(algo) || level < 1)
+                    throw Erange("split_compression_algo", tools_printf(gettext("Compression level must be between 1 and %u, included"), compression_max_level(algo)));
             }
             else
                 level = 9; // default compression level
+
+	    if(third_part != "")
+	    {
+		infinint tmp = tools_get_extended_size(third_part, 1024);
+
+		block_size = 0;
+		tmp.unstack(block_size);
+		if(!tmp.is_zero() || block_size == 0)
+		    throw Erange("split_compression_algo", gettext("Invalid compression block size"));
+	    }
         }
     }
 }
@@ -53,11 +53,13 @@ struct ent_params
     string ent_host;              ///< entrepot hostname
     string ent_port;              ///< entrepot port
     U_I network_retry;            ///< libcurl entrepot network retry time
+    U_I parallel_transfers;       ///< libcurl entrepot number of slices transferred at the same time
     bool auth_from_file;          ///< whether ~/.netrc and ~/.ssh files should be considered for credentials
 
     void clear()
     {   ent_proto.clear(); ent_login.clear(); ent_pass.clear();
 	ent_host.clear(); ent_port.clear(); network_retry = 3;
+	parallel_transfers = 1;
 	auth_from_file = false; };
 };
 
@@ -84,6 +86,7 @@ struct line_param
     bool display_masks;           ///< whether to display masks value
     compression algo;             ///< compression algorithm to use when generating an archive
     U_I compression_level;        ///< compression level to use when generating an archive
+    U_I compression_block_size;   ///< size of compression blocks (zero for stream compression)
     infinint pause;               ///< whether to pause between slices
     bool beep;                    ///< whether to ring the terminal upon user interaction request
     bool empty_dir;               ///< whether to store skipped directories as empty, whether to avoid restoring directory where no data is to be restored
@@ -150,6 +153,9 @@ struct line_param
     bool no_compare_symlink_date; ///< whether to report difference in dates of symlinks while diffing an archive with filesystem
     fsa_scope scope;              ///< FSA scope to consider for the operation
     bool multi_threaded;          ///< allows libdar to use multiple threads (requires libthreadar)
+    U_I num_workers;              ///< number of threads to use for ciphering, deciphering and restoring
+    U_I compress_workers;         ///< number of threads to use for compression and decompression
+    U_I slices_in_flight;         ///< number of completed slices closed in background (zero to close them inline)
     bool delta_sig;               ///< whether to calculate rsync signature of files
     mask *delta_mask;             ///< which file to calculate delta sig when not using the default mask
     bool delta_diff;              ///< whether to save binary diff or whole file's data during a differential backup
@@ -160,6 +166,10 @@ struct line_param
     bool sizes_in_bytes;          ///< whether to display sizes in bytes of to the larges unit (Mo, Go, To,...)
     bool header_only;             ///< whether we just display the header of archives to be read
     bool zeroing_neg_dates;       ///< whether to automatically zeroing negative dates while reading inode from filesystem
+    bool physical_order;          ///< whether to fetch file data ahead in the order it lies on disk
+    bool memory_mapped;           ///< whether slices of local repositories may be memory mapped when reading an archive
+    U_I cache_size;               ///< size of the cache layer libdar adds over the slices
+    bool subtree_restricted;      ///< whether path filters have been given to build subtree
     string ignored_as_symlink;    ///< column separated list of absolute paths of links to follow rather to record as such
     modified_data_detection modet;///< how to detect that a file has changed since the archive of reference was done
     infinint iteration_count;     ///< iteration count used when creating/isolating/merging an encrypted archive (key derivation)
@@ -212,7 +212,8 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 							  sftp_pub_filekey,
 							  sftp_prv_filekey,
 							  sftp_known_hosts,
-							  param.remote.network_retry));
+							  param.remote.network_retry,
+							  param.remote.parallel_transfers));
 		if(!repo)
 		    throw Ememory("little_main");
 	    }
@@ -229,7 +230,8 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 							      sftp_pub_filekey,
 							      sftp_prv_filekey,
 							      sftp_known_hosts,
-							      param.ref_remote.network_retry));
+							      param.ref_remote.network_retry,
+							      param.ref_remote.parallel_transfers));
 		if(!ref_repo)
 		    throw Ememory("little_main");
 	    }
@@ -246,7 +248,8 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 							      sftp_pub_filekey,
 							      sftp_prv_filekey,
 							      sftp_known_hosts,
-							      param.aux_remote.network_retry));
+							      param.aux_remote.network_retry,
+							      param.aux_remote.parallel_transfers));
 		if(!aux_repo)
 		    throw Ememory("little_main");
 	    }
@@ -283,9 +286,13 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    read_options.set_execute(param.execute_ref);
 		    read_options.set_info_details(param.info_details);
 		    read_options.set_lax(param.lax);
+		    read_options.set_memory_mapped(param.memory_mapped);
 		    read_options.set_slice_min_digits(param.ref_num_digits);
 		    read_options.set_ignore_signature_check_failure(param.blind_signatures);
 		    read_options.set_multi_threaded(param.multi_threaded);
+		    read_options.set_multi_threaded_compress(param.compress_workers);
+		    read_options.set_multi_threaded_crypto(param.num_workers);
+		    read_options.set_cache_size(param.cache_size);
 		    if(param.sequential_read)
 		    {
 			if(param.op == merging)
@@ -336,9 +343,13 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 			read_options.set_execute(param.aux_execute);
 			read_options.set_info_details(param.info_details);
 			read_options.set_lax(param.lax);
+			read_options.set_memory_mapped(param.memory_mapped);
 			read_options.set_slice_min_digits(param.aux_num_digits);
 			read_options.set_ignore_signature_check_failure(param.blind_signatures);
 			read_options.set_multi_threaded(param.multi_threaded);
+			read_options.set_multi_threaded_compress(param.compress_workers);
+			read_options.set_multi_threaded_crypto(param.num_workers);
+			read_options.set_cache_size(param.cache_size);
 			if(param.sequential_read)
 			    throw Erange("little_main", gettext("Using sequential reading mode for archive source is not possible for merging operation"));
 			if(aux_repo)
@@ -390,6 +401,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    create_options.set_empty_dir(param.empty_dir);
 		    create_options.set_compression(param.algo);
 		    create_options.set_compression_level(param.compression_level);
+		    create_options.set_compression_block_size(param.compression_block_size);
 		    create_options.set_slicing(param.file_size, param.first_file_size);
 		    create_options.set_ea_mask(*param.ea_mask);
 		    create_options.set_execute(param.execute);
@@ -426,6 +438,10 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    create_options.set_slice_min_digits(param.num_digits);
 		    create_options.set_fsa_scope(param.scope);
 		    create_options.set_multi_threaded(param.multi_threaded);
+		    create_options.set_multi_threaded_compress(param.compress_workers);
+		    create_options.set_multi_threaded_crypto(param.num_workers);
+		    create_options.set_cache_size(param.cache_size);
+		    create_options.set_slices_in_flight(param.slices_in_flight);
 		    create_options.set_delta_signature(param.delta_sig);
 		    if(param.delta_sig_min_size > 0)
 			create_options.set_delta_sig_min_size(param.delta_sig_min_size);
@@ -436,6 +452,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    if(param.backup_hook_mask != nullptr)
 			create_options.set_backup_hook(param.backup_hook_execute, *param.backup_hook_mask);
 		    create_options.set_ignore_unknown_inode_type(param.ignore_unknown_inode);
+		    create_options.set_physical_order(param.physical_order);
 		    if(param.delta_mask != nullptr)
 			create_options.set_delta_mask(*param.delta_mask);
 		    if(repo)
@@ -493,6 +510,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    merge_options.set_empty_dir(param.empty_dir);
 		    merge_options.set_compression(param.algo);
 		    merge_options.set_compression_level(param.compression_level);
+		    merge_options.set_compression_block_size(param.compression_block_size);
 		    merge_options.set_slicing(param.file_size, param.first_file_size);
 		    merge_options.set_ea_mask(*param.ea_mask);
 		    merge_options.set_execute(param.execute);
@@ -518,6 +536,10 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    merge_options.set_slice_min_digits(param.num_digits);
 		    merge_options.set_fsa_scope(param.scope);
 		    merge_options.set_multi_threaded(param.multi_threaded);
+		    merge_options.set_multi_threaded_compress(param.compress_workers);
+		    merge_options.set_multi_threaded_crypto(param.num_workers);
+		    merge_options.set_cache_size(param.cache_size);
+		    merge_options.set_slices_in_flight(param.slices_in_flight);
 		    merge_options.set_delta_signature(param.delta_sig);
 		    if(param.delta_mask != nullptr)
 			merge_options.set_delta_mask(*param.delta_mask);
@@ -569,6 +591,10 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    repair_options.set_hash_algo(param.hash);
 		    repair_options.set_slice_min_digits(param.num_digits);
 		    repair_options.set_multi_threaded(param.multi_threaded);
+		    repair_options.set_multi_threaded_compress(param.compress_workers);
+		    repair_options.set_multi_threaded_crypto(param.num_workers);
+		    repair_options.set_cache_size(param.cache_size);
+		    repair_options.set_slices_in_flight(param.slices_in_flight);
 		    if(repo)
 			repair_options.set_entrepot(repo);
 
@@ -650,6 +676,10 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 			    isolate_options.set_user_comment(param.user_comment);
 			    isolate_options.set_sequential_marks(param.use_sequential_marks);
 			    isolate_options.set_multi_threaded(param.multi_threaded);
+			    isolate_options.set_multi_threaded_compress(param.compress_workers);
+			    isolate_options.set_multi_threaded_crypto(param.num_workers);
+			    isolate_options.set_cache_size(param.cache_size);
+			    isolate_options.set_slices_in_flight(param.slices_in_flight);
 
 				// copying delta sig is not possible in on-fly isolation,
 				// archive must be closed and re-open in read mode to be able
@@ -691,10 +721,14 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		read_options.set_execute(param.execute_ref);
 		read_options.set_info_details(param.info_details);
 		read_options.set_lax(param.lax);
+		read_options.set_memory_mapped(param.memory_mapped);
 		read_options.set_sequential_read(param.sequential_read);
 		read_options.set_slice_min_digits(param.ref_num_digits);
 		read_options.set_ignore_signature_check_failure(param.blind_signatures);
 		read_options.set_multi_threaded(param.multi_threaded);
+		read_options.set_multi_threaded_compress(param.compress_workers);
+		read_options.set_multi_threaded_crypto(param.num_workers);
+		read_options.set_cache_size(param.cache_size);
 		if(ref_repo)
 		    read_options.set_entrepot(ref_repo);
 		    // yes this is "ref_repo" where is located the -A-pointed-to archive
@@ -723,6 +757,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		isolate_options.set_pause(param.pause);
 		isolate_options.set_compression(param.algo);
 		isolate_options.set_compression_level(param.compression_level);
+		isolate_options.set_compression_block_size(param.compression_block_size);
 		isolate_options.set_slicing(param.file_size, param.first_file_size);
 		isolate_options.set_execute(param.execute);
 		isolate_options.set_crypto_algo(crypto);
@@ -741,6 +776,10 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		isolate_options.set_slice_min_digits(param.num_digits);
 		isolate_options.set_sequential_marks(param.use_sequential_marks);
 		isolate_options.set_multi_threaded(param.multi_threaded);
+		isolate_options.set_multi_threaded_compress(param.compress_workers);
+		isolate_options.set_multi_threaded_crypto(param.num_workers);
+		isolate_options.set_cache_size(param.cache_size);
+		isolate_options.set_slices_in_flight(param.slices_in_flight);
 		isolate_options.set_delta_signature(param.delta_sig);
 		if(param.delta_mask != nullptr)
 		    isolate_options.set_delta_mask(*param.delta_mask);
@@ -782,10 +821,14 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		read_options.set_execute(param.execute);
 		read_options.set_info_details(param.info_details);
 		read_options.set_lax(param.lax);
+		read_options.set_memory_mapped(param.memory_mapped);
 		read_options.set_sequential_read(param.sequential_read);
 		read_options.set_slice_min_digits(param.num_digits);
 		read_options.set_ignore_signature_check_failure(param.blind_signatures);
 		read_options.set_multi_threaded(param.multi_threaded);
+		read_options.set_multi_threaded_compress(param.compress_workers);
+		read_options.set_multi_threaded_crypto(param.num_workers);
+		read_options.set_cache_size(param.cache_size);
 		if(repo)
 		    read_options.set_entrepot(repo);
 
@@ -815,6 +858,9 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 			read_options.set_ref_entrepot(ref_repo);
 		}
 
+		if(param.subtree_restricted)
+		    read_options.set_subtree(*param.subtree, tools_relative2absolute_path(*param.fs_root, tools_getcwd()));
+
 		arch.reset(new (nothrow) archive(dialog,
 						 *param.sauv_root,
 						 param.filename,
@@ -861,6 +907,8 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		extract_options.set_only_deleted(param.only_deleted);
 		extract_options.set_ignore_deleted(param.not_deleted);
 		extract_options.set_fsa_scope(param.scope);
+		if(param.multi_threaded)
+		    extract_options.set_multi_threaded_restore(param.num_workers);
 
                 st = arch->op_extract(*param.fs_root,
 				      extract_options,
@@ -891,10 +939,14 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		read_options.set_execute(param.execute);
 		read_options.set_info_details(param.info_details);
 		read_options.set_lax(param.lax);
+		read_options.set_memory_mapped(param.memory_mapped);
 		read_options.set_sequential_read(param.sequential_read);
 		read_options.set_slice_min_digits(param.num_digits);
 		read_options.set_ignore_signature_check_failure(param.blind_signatures);
 		read_options.set_multi_threaded(param.multi_threaded);
+		read_options.set_multi_threaded_compress(param.compress_workers);
+		read_options.set_multi_threaded_crypto(param.num_workers);
+		read_options.set_cache_size(param.cache_size);
 		if(repo)
 		    read_options.set_entrepot(repo);
 
@@ -923,6 +975,10 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    if(ref_repo)
 			read_options.set_ref_entrepot(ref_repo);
 		}
+
+		if(param.subtree_restricted)
+		    read_options.set_subtree(*param.subtree, tools_relative2absolute_path(*param.fs_root, tools_getcwd()));
+
 		arch.reset(new (nothrow) archive(dialog,
 						 *param.sauv_root,
 						 param.filename,
@@ -974,10 +1030,14 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		read_options.set_execute(param.execute);
 		read_options.set_info_details(param.info_details);
 		read_options.set_lax(param.lax);
+		read_options.set_memory_mapped(param.memory_mapped);
 		read_options.set_sequential_read(param.sequential_read);
 		read_options.set_slice_min_digits(param.num_digits);
 		read_options.set_ignore_signature_check_failure(param.blind_signatures);
 		read_options.set_multi_threaded(param.multi_threaded);
+		read_options.set_multi_threaded_compress(param.compress_workers);
+		read_options.set_multi_threaded_crypto(param.num_workers);
+		read_options.set_cache_size(param.cache_size);
 		if(repo)
 		    read_options.set_entrepot(repo);
 
@@ -1006,6 +1066,8 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    if(ref_repo)
 			read_options.set_ref_entrepot(ref_repo);
 		}
+		if(param.subtree_restricted)
+		    read_options.set_subtree(*param.subtree, FAKE_ROOT);
 		arch.reset(new (nothrow) archive(dialog,
 						 *param.sauv_root,
 						 param.filename,
@@ -1050,13 +1112,19 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		read_options.set_execute(param.execute);
 		read_options.set_info_details(param.info_details);
 		read_options.set_lax(param.lax);
+		read_options.set_memory_mapped(param.memory_mapped);
 		read_options.set_sequential_read(param.sequential_read);
 		read_options.set_slice_min_digits(param.num_digits);
 		read_options.set_ignore_signature_check_failure(param.blind_signatures);
 		read_options.set_multi_threaded(param.multi_threaded);
+		read_options.set_multi_threaded_compress(param.compress_workers);
+		read_options.set_multi_threaded_crypto(param.num_workers);
+		read_options.set_cache_size(param.cache_size);
 		if(repo)
 		    read_options.set_entrepot(repo);
 		read_options.set_header_only(param.header_only);
+		if(param.subtree_restricted)
+		    read_options.set_subtree(*param.subtree, FAKE_ROOT);
 
 		arch.reset(new (nothrow) archive(dialog,
 						 *param.sauv_root,
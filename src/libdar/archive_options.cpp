@@ -32,6 +32,7 @@ extern "C"
 #include "tools.hpp"
 #include "hash_fichier.hpp"
 #include "nls_swap.hpp"
+#include "cache.hpp"
 
 using namespace std;
 
@@ -101,12 +102,12 @@ namespace libdar
 	/////////////////////////////////////////////////////////
 
     archive_options_read::archive_options_read(archive_options_read && ref) noexcept
-	: x_ref_chem("/")
+	: x_subtree_root("/"), x_ref_chem("/")
     {
 	move_from(std::move(ref));
     }
 
-    archive_options_read::archive_options_read() : x_ref_chem(default_ref_chem)
+    archive_options_read::archive_options_read() : x_subtree_root(FAKE_ROOT), x_ref_chem(default_ref_chem)
     {
 	clear();
     }
@@ -131,6 +132,11 @@ namespace libdar
 	    throw Ememory("archive_options_read::clear");
 	x_ignore_signature_check_failure = false;
 	x_multi_threaded = false;
+	x_multi_threaded_compress = 1;
+	x_multi_threaded_crypto = 1;
+	x_cache_size = cache::default_size;
+	unset_subtree();
+	x_memory_mapped = false;
 
 	    //
 	external_cat = false;
@@ -153,6 +159,24 @@ namespace libdar
 	x_ref_crypto_size = default_crypto_size;
     }
 
+    void archive_options_read::set_subtree(const mask & subtree, const path & root)
+    {
+	NLS_SWAP_IN;
+	try
+	{
+	    x_subtree.reset(subtree.clone());
+	    if(!x_subtree)
+		throw Ememory("archive_options_read::set_subtree");
+	    x_subtree_root = root;
+	}
+	catch(...)
+	{
+	    NLS_SWAP_OUT;
+	    throw;
+	}
+	NLS_SWAP_OUT;
+    }
+
     void archive_options_read::unset_external_catalogue()
     {
 	x_ref_chem = default_ref_chem;
@@ -214,6 +238,12 @@ namespace libdar
 	x_entrepot = ref.x_entrepot;
 	x_ignore_signature_check_failure = ref.x_ignore_signature_check_failure;
 	x_multi_threaded = ref.x_multi_threaded;
+	x_multi_threaded_compress = ref.x_multi_threaded_compress;
+	x_multi_threaded_crypto = ref.x_multi_threaded_crypto;
+	x_cache_size = ref.x_cache_size;
+	x_subtree = ref.x_subtree;
+	x_subtree_root = ref.x_subtree_root;
+	x_memory_mapped = ref.x_memory_mapped;
 	    //
 
 	external_cat = ref.external_cat;
@@ -245,6 +275,12 @@ namespace libdar
 	x_entrepot = move(ref.x_entrepot);
 	x_ignore_signature_check_failure = move(ref.x_ignore_signature_check_failure);
 	x_multi_threaded = move(ref.x_multi_threaded);
+	x_multi_threaded_compress = move(ref.x_multi_threaded_compress);
+	x_multi_threaded_crypto = move(ref.x_multi_threaded_crypto);
+	x_cache_size = move(ref.x_cache_size);
+	x_subtree = move(ref.x_subtree);
+	x_subtree_root = move(ref.x_subtree_root);
+	x_memory_mapped = move(ref.x_memory_mapped);
 
 	external_cat = move(ref.external_cat);
 	x_ref_chem = move(ref.x_ref_chem);
@@ -362,6 +398,10 @@ namespace libdar
 		throw Ememory("archive_options_create::clear");
 	    x_scope = all_fsa_families();
 	    x_multi_threaded = false;
+	    x_multi_threaded_compress = 1;
+	    x_multi_threaded_crypto = 1;
+	    x_cache_size = cache::default_size;
+	    x_slices_in_flight = 0;
 	    x_delta_diff = true;
 	    x_delta_signature = false;
 	    has_delta_mask_been_set = false;
@@ -372,6 +412,7 @@ namespace libdar
 	    x_iteration_count = default_iteration_count;
 	    x_kdf_hash = hash_algo::sha1;
 	    x_sig_block_len.reset();
+	    x_physical_order = false;
 	}
 	catch(...)
 	{
@@ -579,6 +620,7 @@ namespace libdar
 	x_empty_dir = ref.x_empty_dir;
 	x_compr_algo = ref.x_compr_algo;
 	x_compression_level = ref.x_compression_level;
+	x_compression_block_size = ref.x_compression_block_size;
 	x_file_size = ref.x_file_size;
 	x_first_file_size = ref.x_first_file_size;
 	x_execute = ref.x_execute;
@@ -619,6 +661,10 @@ namespace libdar
 	    throw Ememory("archive_options_create::copy_from");
 	x_scope = ref.x_scope;
 	x_multi_threaded = ref.x_multi_threaded;
+	x_multi_threaded_compress = ref.x_multi_threaded_compress;
+	x_multi_threaded_crypto = ref.x_multi_threaded_crypto;
+	x_cache_size = ref.x_cache_size;
+	x_slices_in_flight = ref.x_slices_in_flight;
 	x_delta_diff = ref.x_delta_diff;
 	x_delta_signature = ref.x_delta_signature;
 	x_delta_mask = ref.x_delta_mask->clone();
@@ -630,6 +676,7 @@ namespace libdar
 	x_iteration_count = ref.x_iteration_count;
 	x_kdf_hash = ref.x_kdf_hash;
 	x_sig_block_len = ref.x_sig_block_len;
+	x_physical_order = ref.x_physical_order;
     }
 
     void archive_options_create::move_from(archive_options_create && ref) noexcept
@@ -653,6 +700,7 @@ namespace libdar
 	x_empty_dir = move(ref.x_empty_dir);
 	x_compr_algo = move(ref.x_compr_algo);
 	x_compression_level = move(ref.x_compression_level);
+	x_compression_block_size = move(ref.x_compression_block_size);
 	x_file_size = move(ref.x_file_size);
 	x_first_file_size = move(ref.x_first_file_size);
 	x_execute = move(ref.x_execute);
@@ -688,6 +736,10 @@ namespace libdar
 	x_ignore_unknown = move(ref.x_ignore_unknown);
 	x_scope = move(ref.x_scope);
 	x_multi_threaded = move(ref.x_multi_threaded);
+	x_multi_threaded_compress = move(ref.x_multi_threaded_compress);
+	x_multi_threaded_crypto = move(ref.x_multi_threaded_crypto);
+	x_cache_size = move(ref.x_cache_size);
+	x_slices_in_flight = move(ref.x_slices_in_flight);
 	x_delta_diff = move(ref.x_delta_diff);
 	x_delta_signature = move(ref.x_delta_signature);
 	x_delta_mask = move(ref.x_delta_mask->clone());
@@ -699,6 +751,7 @@ namespace libdar
 	x_iteration_count = move(ref.x_iteration_count);
 	x_kdf_hash = move(ref.x_kdf_hash);
 	x_sig_block_len = move(ref.x_sig_block_len);
+	x_physical_order = move(ref.x_physical_order);
     }
 
 	/////////////////////////////////////////////////////////
@@ -766,6 +819,10 @@ namespace libdar
 	    if(!x_entrepot)
 		throw Ememory("archive_options_isolate::clear");
 	    x_multi_threaded = false;
+	    x_multi_threaded_compress = 1;
+	    x_multi_threaded_crypto = 1;
+	    x_cache_size = cache::default_size;
+	    x_slices_in_flight = 0;
 	    x_delta_signature = false;
 	    archive_option_clean_mask(x_delta_mask);
 	    has_delta_mask_been_set = false;
@@ -819,6 +876,7 @@ namespace libdar
 	x_pause = ref.x_pause;
 	x_algo = ref.x_algo;
 	x_compression_level = ref.x_compression_level;
+	x_compression_block_size = ref.x_compression_block_size;
 	x_file_size = ref.x_file_size;
 	x_first_file_size = ref.x_first_file_size;
 	x_execute = ref.x_execute;
@@ -841,6 +899,10 @@ namespace libdar
 	if(x_entrepot == nullptr)
 	    throw Ememory("archive_options_isolate::copy_from");
 	x_multi_threaded = ref.x_multi_threaded;
+	x_multi_threaded_compress = ref.x_multi_threaded_compress;
+	x_multi_threaded_crypto = ref.x_multi_threaded_crypto;
+	x_cache_size = ref.x_cache_size;
+	x_slices_in_flight = ref.x_slices_in_flight;
 	x_delta_signature = ref.x_delta_signature;
 	x_delta_mask = ref.x_delta_mask->clone();
 	has_delta_mask_been_set = ref.has_delta_mask_been_set;
@@ -860,6 +922,7 @@ namespace libdar
 	x_pause = move(ref.x_pause);
 	x_algo = move(ref.x_algo);
 	x_compression_level = move(ref.x_compression_level);
+	x_compression_block_size = move(ref.x_compression_block_size);
 	x_file_size = move(ref.x_file_size);
 	x_first_file_size = move(ref.x_first_file_size);
 	x_execute = move(ref.x_execute);
@@ -877,6 +940,10 @@ namespace libdar
 	x_slice_min_digits = move(ref.x_slice_min_digits);
 	x_sequential_marks = move(ref.x_sequential_marks);
 	x_multi_threaded = move(ref.x_multi_threaded);
+	x_multi_threaded_compress = move(ref.x_multi_threaded_compress);
+	x_multi_threaded_crypto = move(ref.x_multi_threaded_crypto);
+	x_cache_size = move(ref.x_cache_size);
+	x_slices_in_flight = move(ref.x_slices_in_flight);
 	x_delta_signature = move(ref.x_delta_signature);
 	has_delta_mask_been_set = move(ref.has_delta_mask_been_set);
 	x_delta_sig_min_size = move(ref.x_delta_sig_min_size);
@@ -945,6 +1012,10 @@ namespace libdar
 		throw Ememory("archive_options_merge::clear");
 	    x_scope = all_fsa_families();
 	    x_multi_threaded = false;
+	    x_multi_threaded_compress = 1;
+	    x_multi_threaded_crypto = 1;
+	    x_cache_size = cache::default_size;
+	    x_slices_in_flight = 0;
 	    x_delta_signature = true;
 	    has_delta_mask_been_set = false;
 	    x_delta_sig_min_size = default_delta_sig_min_size;
@@ -1156,6 +1227,10 @@ namespace libdar
 	    x_slice_min_digits = ref.x_slice_min_digits;
 	    x_scope = ref.x_scope;
 	    x_multi_threaded = ref.x_multi_threaded;
+	    x_multi_threaded_compress = ref.x_multi_threaded_compress;
+	    x_multi_threaded_crypto = ref.x_multi_threaded_crypto;
+	    x_cache_size = ref.x_cache_size;
+	    x_slices_in_flight = ref.x_slices_in_flight;
 	    x_delta_signature = ref.x_delta_signature;
 	    has_delta_mask_been_set = ref.has_delta_mask_been_set;
 	    x_delta_sig_min_size = ref.x_delta_sig_min_size;
@@ -1191,6 +1266,7 @@ namespace libdar
 	x_empty_dir = move(ref.x_empty_dir);
 	x_compr_algo = move(ref.x_compr_algo);
 	x_compression_level = move(ref.x_compression_level);
+	x_compression_block_size = move(ref.x_compression_block_size);
 	x_file_size = move(ref.x_file_size);
 	x_first_file_size = move(ref.x_first_file_size);
 	x_execute = move(ref.x_execute);
@@ -1213,6 +1289,10 @@ namespace libdar
 	x_slice_min_digits = move(ref.x_slice_min_digits);
 	x_scope = move(ref.x_scope);
 	x_multi_threaded = move(ref.x_multi_threaded);
+	x_multi_threaded_compress = move(ref.x_multi_threaded_compress);
+	x_multi_threaded_crypto = move(ref.x_multi_threaded_crypto);
+	x_cache_size = move(ref.x_cache_size);
+	x_slices_in_flight = move(ref.x_slices_in_flight);
 	x_delta_signature = move(ref.x_delta_signature);
 	has_delta_mask_been_set = move(ref.has_delta_mask_been_set);
 	x_delta_sig_min_size = move(ref.x_delta_sig_min_size);
@@ -1256,6 +1336,7 @@ namespace libdar
 	    x_only_deleted = false;
 	    x_ignore_deleted = false;
 	    x_scope = all_fsa_families();
+	    x_multi_threaded_restore = 1;
 	}
 	catch(...)
 	{
@@ -1387,6 +1468,7 @@ namespace libdar
 	    x_only_deleted = ref.x_only_deleted;
 	    x_ignore_deleted = ref.x_ignore_deleted;
 	    x_scope = ref.x_scope;
+	    x_multi_threaded_restore = ref.x_multi_threaded_restore;
 	}
 	catch(...)
 	{
@@ -1416,6 +1498,7 @@ namespace libdar
 	x_only_deleted = move(ref.x_only_deleted);
 	x_ignore_deleted = move(ref.x_ignore_deleted);
 	x_scope = move(ref.x_scope);
+	x_multi_threaded_restore = move(ref.x_multi_threaded_restore);
     }
 
 	/////////////////////////////////////////////////////////
@@ -1976,6 +2059,10 @@ namespace libdar
             if(x_entrepot == nullptr)
                 throw Ememory("archive_options_repair::clear");
             x_multi_threaded = false;
+            x_multi_threaded_compress = 1;
+            x_multi_threaded_crypto = 1;
+            x_cache_size = cache::default_size;
+            x_slices_in_flight = 0;
         }
         catch(...)
         {
@@ -2012,6 +2099,10 @@ namespace libdar
 	x_slice_min_digits = ref.x_slice_min_digits;
 	x_entrepot = ref.x_entrepot;
 	x_multi_threaded = ref.x_multi_threaded;
+	x_multi_threaded_compress = ref.x_multi_threaded_compress;
+	x_multi_threaded_crypto = ref.x_multi_threaded_crypto;
+	x_cache_size = ref.x_cache_size;
+	x_slices_in_flight = ref.x_slices_in_flight;
     }
 
     void archive_options_repair::move_from(archive_options_repair && ref) noexcept
@@ -2041,6 +2132,10 @@ namespace libdar
 	x_hash = move(ref.x_hash);
 	x_slice_min_digits = move(ref.x_slice_min_digits);
 	x_multi_threaded = move(ref.x_multi_threaded);
+	x_multi_threaded_compress = move(ref.x_multi_threaded_compress);
+	x_multi_threaded_crypto = move(ref.x_multi_threaded_crypto);
+	x_cache_size = move(ref.x_cache_size);
+	x_slices_in_flight = move(ref.x_slices_in_flight);
     }
 
 } // end of namespace
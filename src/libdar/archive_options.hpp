@@ -67,7 +67,7 @@ namespace libdar
 	archive_options_read();
 
 	    /// the copy constructor, assignment operator and destructor
-	archive_options_read(const archive_options_read & ref) : x_ref_chem(ref.x_ref_chem) { copy_from(ref); };
+	archive_options_read(const archive_options_read & ref) : x_subtree_root(ref.x_subtree_root), x_ref_chem(ref.x_ref_chem) { copy_from(ref); };
 	archive_options_read(archive_options_read && ref) noexcept;
 	archive_options_read & operator = (const archive_options_read & ref) { copy_from(ref); return *this; };
 	archive_options_read & operator = (archive_options_read && ref) noexcept { move_from(std::move(ref)); return *this; };
@@ -159,6 +159,42 @@ namespace libdar
 	    /// whether libdar is allowed to create several thread to work possilbiy faster on multicore CPU (need libthreadar to be effective)
 	void set_multi_threaded(bool val) { x_multi_threaded = val; };
 
+	    /// number of threads to use for compression or decompression (default is 1, requires libthreadar)
+	void set_multi_threaded_compress(U_I num) { x_multi_threaded_compress = num; };
+
+	    /// number of threads to use for ciphering or deciphering (default is 1, requires libthreadar)
+	void set_multi_threaded_crypto(U_I num) { x_multi_threaded_crypto = num; };
+
+	    /// size in bytes of the cache layer libdar adds over the slices when no encryption is used (default is 102400)
+
+	    /// \note large values (several MiB) reduce the number of requests on high latency storage
+	void set_cache_size(U_I size) { x_cache_size = size; };
+
+	    /// only keep in memory the part of the catalogue covered by the given mask
+
+	    /// \param[in] subtree the mask the path of entries are checked against
+	    /// \param[in] root the path entries are relative to when checked against subtree
+	    /// \note this reduces the memory requirement of the catalogue of a large archive when only a
+	    /// small part of it is to be listed, tested, compared or restored. The whole catalogue is still
+	    /// read and parsed, so the time to open the archive is not reduced. The resulting archive object must then only be used for such operations, with the same subtree
+	    /// and root given in their options (root is the filesystem root given for comparison and
+	    /// restoration, and libdar::FAKE_ROOT else). Hard linked inodes are kept in memory in any case.
+	    /// \note this has no effect in sequential read mode
+	void set_subtree(const mask & subtree, const path & root);
+
+	    /// have the whole catalogue loaded in memory (the default)
+	void unset_subtree() { x_subtree.reset(); x_subtree_root = FAKE_ROOT; };
+
+	    /// whether slices read from a local repository may be memory mapped (false by default)
+
+	    /// \note the data of files is then copied from the mapped slices without intermediate
+	    /// buffers when the archive is neither compressed nor ciphered. A slice truncated or
+	    /// on a failing media leads the process to be killed by a SIGBUS signal instead of
+	    /// reporting an error, for that reason this option is ignored in lax mode
+	    /// \note restored files are then written with copy_file_range() from the mapped slices
+	    /// when possible, this is not done when slices are not memory mapped
+	void set_memory_mapped(bool val) { x_memory_mapped = val; };
+
 
 	    //////// what follows concerne the use of an external catalogue instead of the archive's internal one
 
@@ -219,6 +255,12 @@ namespace libdar
 	const std::shared_ptr<entrepot> & get_entrepot() const { return x_entrepot; };
 	bool get_ignore_signature_check_failure() const { return x_ignore_signature_check_failure; };
 	bool get_multi_threaded() const { return x_multi_threaded; };
+	U_I get_multi_threaded_compress() const { return x_multi_threaded_compress; };
+	U_I get_multi_threaded_crypto() const { return x_multi_threaded_crypto; };
+	U_I get_cache_size() const { return x_cache_size; };
+	const mask *get_subtree() const { return x_subtree.get(); };
+	const path & get_subtree_root() const { return x_subtree_root; };
+	bool get_memory_mapped() const { return x_memory_mapped; };
 
 	    // All methods that follow concern the archive where to fetch the (isolated) catalogue from
 	bool is_external_catalogue_set() const { return external_cat; };
@@ -247,6 +289,12 @@ namespace libdar
 	std::shared_ptr<entrepot> x_entrepot;
 	bool x_ignore_signature_check_failure;
 	bool x_multi_threaded;
+	U_I x_multi_threaded_compress;
+	U_I x_multi_threaded_crypto;
+	U_I x_cache_size;
+	std::shared_ptr<mask> x_subtree;  ///< nullptr to load the whole catalogue
+	path x_subtree_root;
+	bool x_memory_mapped;
 
 
 	    // external catalogue relative fields
@@ -342,6 +390,12 @@ namespace libdar
 	    /// set the compression level (from 1 to 9)
 	void set_compression_level(U_I compression_level) { x_compression_level = compression_level; };
 
+	    /// set the size of compression blocks (zero, the default, for stream compression)
+
+	    /// \note when not zero, clear data is split in blocks of that size, each block being compressed
+	    /// independently of the others, which lets several threads compress concurrently
+	void set_compression_block_size(U_I block_size) { x_compression_block_size = block_size; };
+
 	    /// define the archive slicing
 
 	    /// \param[in] file_size set the slice size in byte (0 for a single slice whatever its size is)
@@ -494,6 +548,22 @@ namespace libdar
 	    /// whether libdar is allowed to spawn several threads to possibily work faster on multicore CPU (requires libthreadar)
 	void set_multi_threaded(bool val) { x_multi_threaded = val; };
 
+	    /// number of threads to use for compression or decompression (default is 1, requires libthreadar)
+	void set_multi_threaded_compress(U_I num) { x_multi_threaded_compress = num; };
+
+	    /// number of threads to use for ciphering or deciphering (default is 1, requires libthreadar)
+	void set_multi_threaded_crypto(U_I num) { x_multi_threaded_crypto = num; };
+
+	    /// size in bytes of the cache layer libdar adds over the slices when no encryption is used (default is 102400)
+
+	    /// \note large values (several MiB) reduce the number of requests on high latency storage
+	void set_cache_size(U_I size) { x_cache_size = size; };
+
+	    /// number of completed slices closed in background while the next ones are written (default is 0, requires libthreadar)
+
+	    /// \note the command given by set_execute() is then run by a separate thread too
+	void set_slices_in_flight(U_I num) { x_slices_in_flight = num; };
+
 	    /// whether binary delta has to be computed for differential/incremental backup
 
 	    /// \note this requires delta signature to be present in the archive of reference
@@ -532,6 +602,12 @@ namespace libdar
 	    /// block size to use to build delta signatures
 	void set_sig_block_len(delta_sig_block_size val) { val.check(); x_sig_block_len = val; };
 
+	    /// whether to fetch ahead the data of the next files in the order it is located on disk
+
+	    /// \note this reduces disk seeks between small files on rotating disks, files
+	    /// are still saved and recorded in the archive in the usual order
+	void set_physical_order(bool val) { x_physical_order = val; };
+
 
 	    /////////////////////////////////////////////////////////////////////
 	    // getting methods
@@ -550,6 +626,7 @@ namespace libdar
 	bool get_empty_dir() const { return x_empty_dir; };
 	compression get_compression() const { return x_compr_algo; };
 	U_I get_compression_level() const { return x_compression_level; };
+	U_I get_compression_block_size() const { return x_compression_block_size; };
 	const infinint & get_slice_size() const { return x_file_size; };
 	const infinint & get_first_slice_size() const { return x_first_file_size; };
 	const mask & get_ea_mask() const { if(x_ea_mask == nullptr) throw SRC_BUG; return *x_ea_mask; };
@@ -589,6 +666,10 @@ namespace libdar
 	const std::shared_ptr<entrepot> & get_entrepot() const { return x_entrepot; };
 	const fsa_scope & get_fsa_scope() const { return x_scope; };
 	bool get_multi_threaded() const { return x_multi_threaded; };
+	U_I get_multi_threaded_compress() const { return x_multi_threaded_compress; };
+	U_I get_multi_threaded_crypto() const { return x_multi_threaded_crypto; };
+	U_I get_cache_size() const { return x_cache_size; };
+	U_I get_slices_in_flight() const { return x_slices_in_flight; };
 	bool get_delta_diff() const { return x_delta_diff; };
 	bool get_delta_signature() const { return x_delta_signature; };
 	const mask & get_delta_mask() const { return *x_delta_mask; }
@@ -600,6 +681,7 @@ namespace libdar
 	const infinint & get_iteration_count() const { return x_iteration_count; };
 	hash_algo get_kdf_hash() const { return x_kdf_hash; };
 	delta_sig_block_size get_sig_block_len() const { return x_sig_block_len; };
+	bool get_physical_order() const { return x_physical_order; };
 
     private:
 	std::shared_ptr<archive> x_ref_arch; ///< just contains the address of an existing object, no local copy of object is done here
@@ -616,6 +698,7 @@ namespace libdar
 	bool x_empty_dir;
 	compression x_compr_algo;
 	U_I x_compression_level;
+	U_I x_compression_block_size;
 	infinint x_file_size;
 	infinint x_first_file_size;
 	mask * x_ea_mask;    ///< points to a local copy of mask (must be allocated / releases by the archive_option_create objects)
@@ -656,6 +739,10 @@ namespace libdar
 	std::shared_ptr<entrepot> x_entrepot;
 	fsa_scope x_scope;
 	bool x_multi_threaded;
+	U_I x_multi_threaded_compress;
+	U_I x_multi_threaded_crypto;
+	U_I x_cache_size;
+	U_I x_slices_in_flight;
 	bool x_delta_diff;
 	bool x_delta_signature;
 	mask *x_delta_mask;
@@ -667,6 +754,7 @@ namespace libdar
 	infinint x_iteration_count;
 	hash_algo x_kdf_hash;
 	delta_sig_block_size x_sig_block_len;
+	bool x_physical_order;
 
 	void nullifyptr() noexcept;
 	void destroy() noexcept;
@@ -722,6 +810,9 @@ namespace libdar
 	    /// the compression level (from 1 to 9)
 	void set_compression_level(U_I compression_level) { x_compression_level = compression_level; };
 
+	    /// the size of compression blocks (zero, the default, for stream compression)
+	void set_compression_block_size(U_I block_size) { x_compression_block_size = block_size; };
+
 	    /// define the archive slicing
 
 	    /// \param[in] file_size set the slice size in byte (0 for a single slice whatever its size is)
@@ -795,6 +886,22 @@ namespace libdar
 	    /// whether libdar is allowed to created several thread to work possibily faster on multicore CPU (require libthreadar)
 	void set_multi_threaded(bool val) { x_multi_threaded = val; };
 
+	    /// number of threads to use for compression or decompression (default is 1, requires libthreadar)
+	void set_multi_threaded_compress(U_I num) { x_multi_threaded_compress = num; };
+
+	    /// number of threads to use for ciphering or deciphering (default is 1, requires libthreadar)
+	void set_multi_threaded_crypto(U_I num) { x_multi_threaded_crypto = num; };
+
+	    /// size in bytes of the cache layer libdar adds over the slices when no encryption is used (default is 102400)
+
+	    /// \note large values (several MiB) reduce the number of requests on high latency storage
+	void set_cache_size(U_I size) { x_cache_size = size; };
+
+	    /// number of completed slices closed in background while the next ones are written (default is 0, requires libthreadar)
+
+	    /// \note the command given by set_execute() is then run by a separate thread too
+	void set_slices_in_flight(U_I num) { x_slices_in_flight = num; };
+
 	    /// whether signature to base binary delta on the future has to be calculated and stored beside saved files
 	void set_delta_signature(bool val) { x_delta_signature = val; };
 
@@ -824,6 +931,7 @@ namespace libdar
 	const infinint & get_pause() const { return x_pause; };
 	compression get_compression() const { return x_algo; };
 	U_I get_compression_level() const { return x_compression_level; };
+	U_I get_compression_block_size() const { return x_compression_block_size; };
 	const infinint & get_slice_size() const { return x_file_size; };
 	const infinint & get_first_slice_size() const { return x_first_file_size; };
 	const std::string & get_execute() const { return x_execute; };
@@ -842,6 +950,10 @@ namespace libdar
 	bool get_sequential_marks() const { return x_sequential_marks; };
 	const std::shared_ptr<entrepot> & get_entrepot() const { return x_entrepot; };
 	bool get_multi_threaded() const { return x_multi_threaded; };
+	U_I get_multi_threaded_compress() const { return x_multi_threaded_compress; };
+	U_I get_multi_threaded_crypto() const { return x_multi_threaded_crypto; };
+	U_I get_cache_size() const { return x_cache_size; };
+	U_I get_slices_in_flight() const { return x_slices_in_flight; };
 	bool get_delta_signature() const { return x_delta_signature; };
 	const mask & get_delta_mask() const { return *x_delta_mask; }
 	bool get_has_delta_mask_been_set() const { return has_delta_mask_been_set; };
@@ -858,6 +970,7 @@ namespace libdar
 	infinint x_pause;
 	compression x_algo;
 	U_I x_compression_level;
+	U_I x_compression_block_size;
 	infinint x_file_size;
 	infinint x_first_file_size;
 	std::string x_execute;
@@ -876,6 +989,10 @@ namespace libdar
 	bool x_sequential_marks;
 	std::shared_ptr<entrepot> x_entrepot;
 	bool x_multi_threaded;
+	U_I x_multi_threaded_compress;
+	U_I x_multi_threaded_crypto;
+	U_I x_cache_size;
+	U_I x_slices_in_flight;
 	bool x_delta_signature;
 	mask *x_delta_mask;
 	bool has_delta_mask_been_set;
@@ -959,6 +1076,12 @@ namespace libdar
 	    /// set the compression level (from 1 to 9)
 	void set_compression_level(U_I compression_level) { x_compression_level = compression_level; };
 
+	    /// set the size of compression blocks (zero, the default, for stream compression)
+
+	    /// \note when not zero, clear data is split in blocks of that size, each block being compressed
+	    /// independently of the others, which lets several threads compress concurrently
+	void set_compression_block_size(U_I block_size) { x_compression_block_size = block_size; };
+
 	    /// define the archive slicing
 
 	    /// \param[in] file_size set the slice size in byte (0 for a single slice whatever its size is)
@@ -1054,6 +1177,22 @@ namespace libdar
 	    /// whether libdar is allowed to spawn several threads to possibily work faster on multicore CPU (requires libthreadar)
 	void set_multi_threaded(bool val) { x_multi_threaded = val; };
 
+	    /// number of threads to use for compression or decompression (default is 1, requires libthreadar)
+	void set_multi_threaded_compress(U_I num) { x_multi_threaded_compress = num; };
+
+	    /// number of threads to use for ciphering or deciphering (default is 1, requires libthreadar)
+	void set_multi_threaded_crypto(U_I num) { x_multi_threaded_crypto = num; };
+
+	    /// size in bytes of the cache layer libdar adds over the slices when no encryption is used (default is 102400)
+
+	    /// \note large values (several MiB) reduce the number of requests on high latency storage
+	void set_cache_size(U_I size) { x_cache_size = size; };
+
+	    /// number of completed slices closed in background while the next ones are written (default is 0, requires libthreadar)
+
+	    /// \note the command given by set_execute() is then run by a separate thread too
+	void set_slices_in_flight(U_I num) { x_slices_in_flight = num; };
+
 	    /// whether signature to base binary delta on the future has to be calculated and stored beside saved files
 	    /// \note the default is true, which lead to preserve delta signature over merging, but not to calculate new ones
 	    /// unless a mask is given to set_delta_mask() in which case signature are dropped / preserved / added in regard to
@@ -1096,6 +1235,7 @@ namespace libdar
 	bool get_empty_dir() const { return x_empty_dir; };
 	compression get_compression() const { return x_compr_algo; };
 	U_I get_compression_level() const { return x_compression_level; };
+	U_I get_compression_block_size() const { return x_compression_block_size; };
 	const infinint & get_slice_size() const { return x_file_size; };
 	const infinint & get_first_slice_size() const { return x_first_file_size; };
 	const mask & get_ea_mask() const { if(x_ea_mask == nullptr) throw SRC_BUG; return *x_ea_mask; };
@@ -1121,6 +1261,10 @@ namespace libdar
 	const std::shared_ptr<entrepot> & get_entrepot() const { return x_entrepot; };
 	const fsa_scope & get_fsa_scope() const { return x_scope; };
 	bool get_multi_threaded() const { return x_multi_threaded; };
+	U_I get_multi_threaded_compress() const { return x_multi_threaded_compress; };
+	U_I get_multi_threaded_crypto() const { return x_multi_threaded_crypto; };
+	U_I get_cache_size() const { return x_cache_size; };
+	U_I get_slices_in_flight() const { return x_slices_in_flight; };
 	bool get_delta_signature() const { return x_delta_signature; };
 	const mask & get_delta_mask() const { return *x_delta_mask; }
 	bool get_has_delta_mask_been_set() const { return has_delta_mask_been_set; };
@@ -1145,6 +1289,7 @@ namespace libdar
 	bool x_empty_dir;
 	compression x_compr_algo;
 	U_I x_compression_level;
+	U_I x_compression_block_size;
 	infinint x_file_size;
 	infinint x_first_file_size;
 	mask * x_ea_mask;
@@ -1170,6 +1315,10 @@ namespace libdar
 	std::shared_ptr<entrepot> x_entrepot;
 	fsa_scope x_scope;
 	bool x_multi_threaded;
+	U_I x_multi_threaded_compress;
+	U_I x_multi_threaded_crypto;
+	U_I x_cache_size;
+	U_I x_slices_in_flight;
 	bool x_delta_signature;
 	mask *x_delta_mask;
 	bool has_delta_mask_been_set;
@@ -1276,6 +1425,11 @@ namespace libdar
 	    /// defines the FSA (Filesystem Specific Attribute) to only consider (by default all FSA activated at compilation time are considered)
 	void set_fsa_scope(const fsa_scope & scope) { x_scope = scope; };
 
+	    /// number of threads creating the small plain files and setting their attributes (default is 1, requires libthreadar)
+
+	    /// \note this is ignored when reading the archive in sequential mode and for flat restoration
+	void set_multi_threaded_restore(U_I num) { x_multi_threaded_restore = num; };
+
 
 	    /////////////////////////////////////////////////////////////////////
 	    // getting methods
@@ -1298,6 +1452,7 @@ namespace libdar
 	bool get_only_deleted() const { return x_only_deleted; };
 	bool get_ignore_deleted() const { return x_ignore_deleted; };
 	const fsa_scope & get_fsa_scope() const { return x_scope; };
+	U_I get_multi_threaded_restore() const { return x_multi_threaded_restore; };
 
     private:
 	mask * x_selection;
@@ -1318,6 +1473,7 @@ namespace libdar
 	bool x_only_deleted;
 	bool x_ignore_deleted;
 	fsa_scope x_scope;
+	U_I x_multi_threaded_restore;
 
 	void destroy() noexcept;
 	void nullifyptr() noexcept;
@@ -1731,6 +1887,22 @@ namespace libdar
 	    /// whether libdar is allowed to spawn several threads to possibily work faster on multicore CPU (requires libthreadar)
 	void set_multi_threaded(bool val) { x_multi_threaded = val; };
 
+	    /// number of threads to use for compression or decompression (default is 1, requires libthreadar)
+	void set_multi_threaded_compress(U_I num) { x_multi_threaded_compress = num; };
+
+	    /// number of threads to use for ciphering or deciphering (default is 1, requires libthreadar)
+	void set_multi_threaded_crypto(U_I num) { x_multi_threaded_crypto = num; };
+
+	    /// size in bytes of the cache layer libdar adds over the slices when no encryption is used (default is 102400)
+
+	    /// \note large values (several MiB) reduce the number of requests on high latency storage
+	void set_cache_size(U_I size) { x_cache_size = size; };
+
+	    /// number of completed slices closed in background while the next ones are written (default is 0, requires libthreadar)
+
+	    /// \note the command given by set_execute() is then run by a separate thread too
+	void set_slices_in_flight(U_I num) { x_slices_in_flight = num; };
+
 
 	    /////////////////////////////////////////////////////////////////////
 	    // getting methods
@@ -1760,6 +1932,10 @@ namespace libdar
 	infinint get_slice_min_digits() const { return x_slice_min_digits; };
 	const std::shared_ptr<entrepot> & get_entrepot() const { return x_entrepot; };
 	bool get_multi_threaded() const { return x_multi_threaded; };
+	U_I get_multi_threaded_compress() const { return x_multi_threaded_compress; };
+	U_I get_multi_threaded_crypto() const { return x_multi_threaded_crypto; };
+	U_I get_cache_size() const { return x_cache_size; };
+	U_I get_slices_in_flight() const { return x_slices_in_flight; };
 
     private:
 	bool x_allow_over;
@@ -1787,6 +1963,10 @@ namespace libdar
 	infinint x_slice_min_digits;
 	std::shared_ptr<entrepot> x_entrepot;
 	bool x_multi_threaded;
+	U_I x_multi_threaded_compress;
+	U_I x_multi_threaded_crypto;
+	U_I x_cache_size;
+	U_I x_slices_in_flight;
 
 	void nullifyptr() noexcept {};
 	void copy_from(const archive_options_repair & ref);
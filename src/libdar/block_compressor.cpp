@@ -0,0 +1,536 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_STRING_H
+#include <string.h>
+#endif
+} // end extern "C"
+
+#include <exception>
+
+#if HAVE_LIBTHREADAR_LIBTHREADAR_HPP
+#include <libthreadar/libthreadar.hpp>
+#endif
+
+#include "block_compressor.hpp"
+#include "compress_block_header.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+#ifdef LIBTHREADAR_AVAILABLE
+
+	/// thread compressing or uncompressing a single block of data at a time
+
+    class block_compressor_worker : public libthreadar::thread
+    {
+    public:
+	block_compressor_worker(compression algo, U_I level): engine(algo, level) { set_job(true, nullptr, 0, nullptr, 0, nullptr); };
+
+	    /// define the next job to run
+
+	    /// \param[in] compress whether to compress or uncompress
+	    /// \param[in] src the data to compress or uncompress
+	    /// \param[in] src_size amount of data in src
+	    /// \param[out] dst where to store the result
+	    /// \param[in] dst_size allocated size of dst
+	    /// \param[out] result where to store the amount of data produced in dst
+	void set_job(bool compress, const char *src, U_I src_size, char *dst, U_I dst_size, U_I *result)
+	{
+	    x_compress = compress;
+	    x_src = src;
+	    x_src_size = src_size;
+	    x_dst = dst;
+	    x_dst_size = dst_size;
+	    x_result = result;
+	};
+
+    protected:
+	virtual void inherited_run() override
+	{
+	    if(x_src == nullptr || x_dst == nullptr || x_result == nullptr)
+		throw SRC_BUG;
+	    if(x_compress)
+		*x_result = engine.compress_data(x_src, x_src_size, x_dst, x_dst_size);
+	    else
+		*x_result = engine.uncompress_data(x_src, x_src_size, x_dst, x_dst_size);
+	};
+
+    private:
+	compress_module engine;
+	bool x_compress;
+	const char *x_src;
+	U_I x_src_size;
+	char *x_dst;
+	U_I x_dst_size;
+	U_I *x_result;
+    };
+
+#else
+
+	// only used as pointed type in the workers deque which stays empty
+    class block_compressor_worker {};
+
+#endif
+
+    block_compressor::block_compressor(compression x_algo,
+				       U_I compression_level,
+				       U_I x_block_size,
+				       U_I num_workers,
+				       generic_file & compressed_side)
+    {
+	U_I num_blocks = 1;
+
+	algo = x_algo;
+	level = compression_level;
+	block_size = x_block_size;
+	zip_size = compress_module::get_max_compressing_size(block_size);
+	compressed = &compressed_side;
+	local = nullptr;
+	current = 0;
+	write_flushed = true;
+	read_block = 0;
+	read_offset = 0;
+	reached_eof = false;
+
+	if(block_size == 0)
+	    throw SRC_BUG;
+
+#ifdef LIBTHREADAR_AVAILABLE
+	if(num_workers > 1)
+	    num_blocks = num_workers;
+#endif
+
+	try
+	{
+	    for(U_I b = 0; b < 2; ++b)
+	    {
+		batches[b].blocks.resize(num_blocks);
+		for(U_I i = 0; i < num_blocks; ++i)
+		{
+		    batches[b].blocks[i].clear = nullptr;
+		    batches[b].blocks[i].zip = nullptr;
+		}
+		batches[b].launched = false;
+		batches[b].running = 0;
+		for(U_I i = 0; i < num_blocks; ++i)
+		{
+		    batches[b].blocks[i].clear = new (nothrow) char[block_size];
+		    batches[b].blocks[i].zip = new (nothrow) char[zip_size];
+		    if(batches[b].blocks[i].clear == nullptr || batches[b].blocks[i].zip == nullptr)
+			throw Ememory("block_compressor::block_compressor");
+		}
+		reset_batch(batches[b]);
+	    }
+
+#ifdef LIBTHREADAR_AVAILABLE
+	    if(num_blocks > 1)
+	    {
+		for(U_I i = 0; i < num_blocks; ++i)
+		{
+		    workers.push_back(nullptr);
+		    workers.back() = new (nothrow) block_compressor_worker(algo, level);
+		    if(workers.back() == nullptr)
+			throw Ememory("block_compressor::block_compressor");
+		}
+	    }
+	    else
+#endif
+	    {
+		local = new (nothrow) compress_module(algo, level);
+		if(local == nullptr)
+		    throw Ememory("block_compressor::block_compressor");
+	    }
+	}
+	catch(...)
+	{
+	    release();
+	    throw;
+	}
+    }
+
+    block_compressor::~block_compressor()
+    {
+	try
+	{
+	    drop_pending();
+	}
+	catch(...)
+	{
+		// ignore all exceptions
+	}
+	release();
+    }
+
+    void block_compressor::write(const char *a, U_I size)
+    {
+	U_I wrote = 0;
+
+	write_flushed = false;
+
+	while(wrote < size)
+	{
+	    batch & cur = batches[current];
+	    block & blk = cur.blocks[cur.num];
+	    U_I amount = block_size - blk.clear_size;
+
+	    if(amount > size - wrote)
+		amount = size - wrote;
+	    (void)memcpy(blk.clear + blk.clear_size, a + wrote, amount);
+	    blk.clear_size += amount;
+	    wrote += amount;
+
+	    if(blk.clear_size == block_size)
+	    {
+		++cur.num;
+		if(cur.num == batch_size())
+		{
+		    batch & prev = other();
+
+		    if(prev.launched)
+		    {
+			wait(prev);
+			write_batch(prev);
+		    }
+		    launch(cur, true);
+		    current = 1 - current;
+		    reset_batch(batches[current]);
+		}
+	    }
+	}
+    }
+
+    void block_compressor::flush_write()
+    {
+	compress_block_header bh;
+	batch & prev = other();
+	batch & cur = batches[current];
+
+	if(write_flushed)
+	    return;
+
+	if(prev.launched)
+	{
+	    wait(prev);
+	    write_batch(prev);
+	}
+
+	if(cur.num < batch_size() && cur.blocks[cur.num].clear_size > 0)
+	    ++cur.num;
+
+	if(cur.num > 0)
+	{
+	    launch(cur, true);
+	    wait(cur);
+	    write_batch(cur);
+	}
+
+	bh.type = compress_block_header::H_EOF;
+	bh.size = 0;
+	bh.dump(*compressed);
+	write_flushed = true;
+    }
+
+    void block_compressor::clean_write()
+    {
+	drop_pending();
+	reset_batch(batches[current]);
+    }
+
+    U_I block_compressor::read(char *a, U_I size)
+    {
+	U_I read = 0;
+
+	while(read < size)
+	{
+	    batch & cur = batches[current];
+
+	    if(read_block < cur.num)
+	    {
+		block & blk = cur.blocks[read_block];
+		U_I amount = blk.clear_size - read_offset;
+
+		if(amount > size - read)
+		    amount = size - read;
+		(void)memcpy(a + read, blk.clear + read_offset, amount);
+		read_offset += amount;
+		read += amount;
+		if(read_offset == blk.clear_size)
+		{
+		    ++read_block;
+		    read_offset = 0;
+		}
+	    }
+	    else // current batch exhausted
+	    {
+		batch & next = other();
+
+		if(next.launched) // prefetched batch
+		    wait(next);
+		else
+		{
+		    if(reached_eof)
+			break;
+		    read_batch(next);
+		    if(next.num == 0)
+			break;
+		    launch(next, false);
+		    wait(next);
+		}
+
+		current = 1 - current;
+		read_block = 0;
+		read_offset = 0;
+
+		    // reading the next batch while the current one is consumed
+		if(!reached_eof)
+		{
+		    read_batch(other());
+		    if(other().num > 0)
+			launch(other(), false);
+		}
+		else
+		    reset_batch(other());
+	    }
+	}
+
+	return read;
+    }
+
+    void block_compressor::flush_read()
+    {
+	reached_eof = false;
+    }
+
+    void block_compressor::clean_read()
+    {
+	drop_pending();
+	reset_batch(batches[current]);
+	read_block = 0;
+	read_offset = 0;
+    }
+
+    void block_compressor::reset_batch(batch & b)
+    {
+	if(b.launched)
+	    throw SRC_BUG;
+
+	b.num = 0;
+	for(U_I i = 0; i < b.blocks.size(); ++i)
+	{
+	    b.blocks[i].clear_size = 0;
+	    b.blocks[i].zip_size = 0;
+	}
+    }
+
+    void block_compressor::launch(batch & b, bool compress)
+    {
+	if(b.launched)
+	    throw SRC_BUG;
+
+	b.launched = true;
+	b.running = 0;
+
+	for(U_I i = 0; i < b.num; ++i)
+	{
+	    block & blk = b.blocks[i];
+
+	    if(!compress && blk.zip_size == 0)
+		continue; // block stored uncompressed, nothing to do
+
+	    if(local != nullptr)
+	    {
+		if(compress)
+		    blk.zip_size = local->compress_data(blk.clear, blk.clear_size, blk.zip, zip_size);
+		else
+		    blk.clear_size = local->uncompress_data(blk.zip, blk.zip_size, blk.clear, block_size);
+	    }
+	    else
+	    {
+#ifdef LIBTHREADAR_AVAILABLE
+		block_compressor_worker *w = workers[b.running];
+
+		if(w == nullptr)
+		    throw SRC_BUG;
+		if(compress)
+		    w->set_job(true, blk.clear, blk.clear_size, blk.zip, zip_size, &blk.zip_size);
+		else
+		    w->set_job(false, blk.zip, blk.zip_size, blk.clear, block_size, &blk.clear_size);
+		w->run();
+		++b.running;
+#else
+		throw SRC_BUG;
+#endif
+	    }
+	}
+    }
+
+    void block_compressor::wait(batch & b)
+    {
+	exception_ptr failed;
+
+	if(!b.launched)
+	    throw SRC_BUG;
+
+#ifdef LIBTHREADAR_AVAILABLE
+	for(U_I i = 0; i < b.running; ++i)
+	{
+	    try
+	    {
+		workers[i]->join();
+	    }
+	    catch(...)
+	    {
+		if(!failed)
+		    failed = current_exception();
+	    }
+	}
+#endif
+	b.running = 0;
+	b.launched = false;
+
+	if(failed)
+	    rethrow_exception(failed);
+    }
+
+    void block_compressor::write_batch(batch & b)
+    {
+	compress_block_header bh;
+
+	for(U_I i = 0; i < b.num; ++i)
+	{
+	    block & blk = b.blocks[i];
+
+	    if(blk.zip_size > 0)
+	    {
+		bh.type = compress_block_header::H_DATA;
+		bh.size = blk.zip_size;
+		bh.dump(*compressed);
+		compressed->write(blk.zip, blk.zip_size);
+	    }
+	    else
+	    {
+		bh.type = compress_block_header::H_STORED;
+		bh.size = blk.clear_size;
+		bh.dump(*compressed);
+		compressed->write(blk.clear, blk.clear_size);
+	    }
+	}
+
+	reset_batch(b);
+    }
+
+    void block_compressor::read_batch(batch & b)
+    {
+	compress_block_header bh;
+
+	reset_batch(b);
+
+	while(b.num < batch_size() && !reached_eof)
+	{
+	    block & blk = b.blocks[b.num];
+	    U_I size = 0;
+
+	    bh.set_from(*compressed);
+	    switch(bh.type)
+	    {
+	    case compress_block_header::H_EOF:
+		if(!bh.size.is_zero())
+		    throw Erange("block_compressor::read_batch", gettext("compressed data corruption detected"));
+		reached_eof = true;
+		break;
+	    case compress_block_header::H_DATA:
+		if(bh.size > zip_size || bh.size.is_zero())
+		    throw Erange("block_compressor::read_batch", gettext("data corruption detected: Too large block of compressed data"));
+		bh.size.unstack(size);
+		if(compressed->read(blk.zip, size) != size)
+		    throw Erange("block_compressor::read_batch", gettext("compressed data corruption detected"));
+		blk.zip_size = size;
+		++b.num;
+		break;
+	    case compress_block_header::H_STORED:
+		if(bh.size > block_size)
+		    throw Erange("block_compressor::read_batch", gettext("data corruption detected: Too large block of compressed data"));
+		bh.size.unstack(size);
+		if(compressed->read(blk.clear, size) != size)
+		    throw Erange("block_compressor::read_batch", gettext("compressed data corruption detected"));
+		blk.clear_size = size;
+		blk.zip_size = 0;
+		++b.num;
+		break;
+	    default:
+		throw Erange("block_compressor::read_batch", gettext("data corruption detected: Incoherence in compressed data"));
+	    }
+	}
+    }
+
+    void block_compressor::drop_pending()
+    {
+	batch & o = other();
+
+	if(o.launched)
+	{
+	    try
+	    {
+		wait(o);
+	    }
+	    catch(...)
+	    {
+		    // data is dropped, so are the errors met while processing it
+	    }
+	}
+	reset_batch(o);
+    }
+
+    void block_compressor::release()
+    {
+	for(U_I i = 0; i < workers.size(); ++i)
+	    if(workers[i] != nullptr)
+		delete workers[i];
+	workers.clear();
+
+	if(local != nullptr)
+	{
+	    delete local;
+	    local = nullptr;
+	}
+
+	for(U_I b = 0; b < 2; ++b)
+	{
+	    for(U_I i = 0; i < batches[b].blocks.size(); ++i)
+	    {
+		if(batches[b].blocks[i].clear != nullptr)
+		    delete [] batches[b].blocks[i].clear;
+		if(batches[b].blocks[i].zip != nullptr)
+		    delete [] batches[b].blocks[i].zip;
+	    }
+	    batches[b].blocks.clear();
+	}
+    }
+
+} // end of namespace
@@ -0,0 +1,155 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+    /// \file block_compressor.hpp
+    /// \brief compression by independent blocks, optionally spread over several threads
+    /// \ingroup Private
+
+#ifndef BLOCK_COMPRESSOR_HPP
+#define BLOCK_COMPRESSOR_HPP
+
+#include "../my_config.h"
+
+#include <deque>
+#include <vector>
+#include "integers.hpp"
+#include "generic_file.hpp"
+#include "compression.hpp"
+#include "compress_module.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+    class block_compressor_worker;
+
+	/// compression engine used by the compressor class in block compression mode
+
+	/// the clear stream is split in blocks of fixed size, each block is
+	/// compressed independently of the others and written to the compressed
+	/// side preceeded by a compress_block_header. When several workers are
+	/// used, a batch of as many blocks as workers is compressed (or uncompressed)
+	/// in parallel while the next batch is filled (or read) by the calling thread.
+	/// Blocks are always written and read back in order.
+	/// The end of a sequence of compressed data is marked by a H_EOF block header,
+	/// reading never goes past this mark.
+
+    class block_compressor
+    {
+    public:
+	    /// default size of the clear data blocks
+	static constexpr U_I default_block_size = 240*1024;
+
+	    /// constructor
+
+	    /// \param[in] algo compression algorithm to use
+	    /// \param[in] compression_level compression level to use
+	    /// \param[in] block_size size of the blocks of clear data
+	    /// \param[in] num_workers number of threads compressing/uncompressing concurrently (1 for no additional thread)
+	    /// \param[in] compressed_side where to write/read the compressed data to/from
+	    /// \note num_workers greater than one requires libthreadar, else it is ignored
+	block_compressor(compression algo,
+			 U_I compression_level,
+			 U_I block_size,
+			 U_I num_workers,
+			 generic_file & compressed_side);
+	block_compressor(const block_compressor & ref) = delete;
+	block_compressor(block_compressor && ref) noexcept = delete;
+	block_compressor & operator = (const block_compressor & ref) = delete;
+	block_compressor & operator = (block_compressor && ref) noexcept = delete;
+	~block_compressor();
+
+	U_I get_block_size() const { return block_size; };
+
+	    /// add clear data to be compressed
+	void write(const char *a, U_I size);
+
+	    /// compress and write all pending data followed by the end of data mark
+	void flush_write();
+
+	    /// drop clear data not yet compressed
+	void clean_write();
+
+	    /// read uncompressed data
+
+	    /// \return the amount of data read, less than size if end of compressed data has been reached
+	U_I read(char *a, U_I size);
+
+	    /// let reading continue after a end of compressed data mark
+	void flush_read();
+
+	    /// drop data read and uncompressed but not yet returned by read()
+	void clean_read();
+
+    private:
+	struct block
+	{
+	    char *clear;     ///< clear data of the block
+	    U_I clear_size;  ///< amount of clear data
+	    char *zip;       ///< compressed data of the block
+	    U_I zip_size;    ///< amount of compressed data, zero if the block is not compressed
+	};
+
+	struct batch
+	{
+	    std::vector<block> blocks; ///< blocks of the batch
+	    U_I num;                   ///< number of blocks in use
+	    bool launched;             ///< whether workers have been assigned to this batch and have not yet been waited for
+	    U_I running;               ///< number of workers assigned to this batch
+	};
+
+	compression algo;
+	U_I level;
+	U_I block_size;
+	U_I zip_size;                  ///< allocated size of each block's zip buffer
+	generic_file *compressed;
+	compress_module *local;        ///< used when no worker thread is available
+	std::deque<block_compressor_worker *> workers;
+
+	batch batches[2];              ///< the current batch and the one being processed by workers
+	U_I current;                   ///< index in batches of the batch being filled or read
+
+	    // write fields
+	bool write_flushed;            ///< whether data has been written since last flush_write()
+
+	    // read fields
+	U_I read_block;                ///< index of the block to read from in the current batch
+	U_I read_offset;               ///< offset of the next byte to read in that block
+	bool reached_eof;              ///< whether the H_EOF mark has been read from the compressed side
+
+	U_I batch_size() const { return batches[0].blocks.size(); };
+	batch & other() { return batches[1 - current]; };
+	void reset_batch(batch & b);           ///< mark all blocks of the batch empty
+	void launch(batch & b, bool compress); ///< compress or uncompress the blocks of the batch
+	void wait(batch & b);                  ///< wait for the workers to complete the batch
+	void write_batch(batch & b);           ///< write the compressed blocks of the batch to the compressed side
+	void read_batch(batch & b);            ///< read blocks from the compressed side up to a whole batch or the H_EOF mark
+	void drop_pending();                   ///< wait for and discard the batch processed by workers if any
+	void release();
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
@@ -71,11 +71,13 @@ namespace libdar
 	ref = & hidden;
 	buffer = nullptr;
 	alloc_buffer(x_size);
+	begin = 0;
 	next = 0;
 	last = 0;
 	first_to_write = size;
 	buffer_offset = ref->get_position();
 	shifted_mode = shift_mode;
+	lent_through = false;
     }
 
     cache::~cache()
@@ -172,7 +174,7 @@ namespace libdar
 
 	    if(need_flush_write())
 		flush_write();
-	    next = last = 0;
+	    next = last = begin = 0;
 	    ret = ref->skip(pos);
 	    buffer_offset = ref->get_position();
 
@@ -201,8 +203,8 @@ namespace libdar
 
 	if(buffer_offset + last < eof_offset)
 	{
+	    clear_buffer(); // this moves buffer_offset by "next" bytes
 	    buffer_offset = eof_offset;
-	    clear_buffer();
 	}
 	else
 	{
@@ -327,9 +329,12 @@ namespace libdar
 		U_I avail = last - next;
 		U_I min = avail > needed ? needed : avail;
 
+		if(min > contiguous(next))
+		    min = contiguous(next); // the rest will be copied at next loop from the beginning of the ring buffer
+
 		if(min > 0)
 		{
-		    (void)memcpy(a+ret, buffer + next, min);
+		    (void)memcpy(a+ret, at(next), min);
 		    ret += min;
 		    next += min;
 		}
@@ -343,6 +348,51 @@ namespace libdar
     }
 
 
+    bool cache::inherited_read_lend(const char * & ptr, U_I & x_size)
+    {
+	if(next >= last) // no more data to read from cache
+	{
+	    if(need_flush_write())
+		return false; // inherited_read() takes care of the pending data
+
+	    if(!eof_offset.is_zero() && buffer_offset + last >= eof_offset)
+	    {
+		x_size = 0;
+		return true;
+	    }
+
+		// the lower layer is at the current position, the data it
+		// lends is passed through without being stored in the cache
+
+	    clear_buffer();
+	    if(ref->read_lend(ptr, x_size))
+	    {
+		buffer_offset += x_size;
+		lent_through = true;
+		return true;
+	    }
+
+	    fulfill_read(); // may fail if underlying is write_only (exception thrown)
+	    if(next >= last) // could not read anymore data
+	    {
+		x_size = 0;
+		return true;
+	    }
+	}
+
+	    // lending the data from the cache
+
+	if(x_size > last - next)
+	    x_size = last - next;
+	if(x_size > contiguous(next))
+	    x_size = contiguous(next); // the rest will be lent at next call from the beginning of the ring buffer
+	ptr = at(next);
+	next += x_size;
+	lent_through = false;
+
+	return true;
+    }
+
     void cache::inherited_write(const char *a, U_I x_size)
     {
 	U_I wrote = 0;
@@ -378,7 +428,7 @@ namespace libdar
 		    // we write directly to the lower layer
 
 		buffer_offset += next;
-		next = last = 0;
+		next = last = begin = 0;
 		try
 		{
 		    ref->skip(buffer_offset);
@@ -402,9 +452,11 @@ namespace libdar
 	    else // filling cache with data
 	    {
 		U_I min = remaining < avail ? remaining : avail;
+		if(min > contiguous(next))
+		    min = contiguous(next); // the rest will be copied at next loop from the beginning of the ring buffer
 		if(first_to_write >= last)
 		    first_to_write = next;
-		(void)memcpy(buffer + next, a + wrote, min);
+		(void)memcpy(at(next), a + wrote, min);
 		wrote += min;
 		next += min;
 		if(last < next)
@@ -451,7 +503,8 @@ namespace libdar
 	if(first_to_write < shift)
 	    throw SRC_BUG;
 
-	(void)memmove(buffer, buffer + shift, last - shift);
+	    // dropping the first "shift" bytes of the ring buffer, no data has to be moved
+	begin = shift < size - begin ? begin + shift : shift - (size - begin);
 	if(first_to_write < size)
 	    first_to_write -= shift;
 	next -= shift;
@@ -464,7 +517,7 @@ namespace libdar
 	if(need_flush_write())
 	    throw SRC_BUG;
 	buffer_offset += next;
-	next = last = 0;
+	next = last = begin = 0;
     }
 
     void cache::flush_write()
@@ -476,8 +529,18 @@ namespace libdar
 
 	if(need_flush_write()) // we have something to flush
 	{
+	    U_I pos = first_to_write;
+
 	    ref->skip(buffer_offset + first_to_write);
-	    ref->write(buffer + first_to_write, last - first_to_write);
+	    while(pos < last) // at most two writes, if data wraps at the end of the ring buffer
+	    {
+		U_I len = last - pos;
+
+		if(len > contiguous(pos))
+		    len = contiguous(pos);
+		ref->write(at(pos), len);
+		pos += len;
+	    }
 	}
 	first_to_write = size;
 
@@ -559,8 +622,18 @@ namespace libdar
 	    if(!ref->skip(buffer_offset + last))
 		throw SRC_BUG;
 	}
-	lu = ref->read(buffer + last, size - last); // may fail if underlying is write_only or user aborted
-	last += lu;
+	do // at most two reads, if free space wraps at the end of the ring buffer
+	{
+	    U_I len = size - last;
+
+	    if(len > contiguous(last))
+		len = contiguous(last);
+	    lu = ref->read(at(last), len); // may fail if underlying is write_only or user aborted
+	    last += lu;
+	    if(lu < len)
+		break;
+	}
+	while(last < size);
     }
 
     U_I cache::available_in_cache(skippability direction) const
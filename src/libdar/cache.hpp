@@ -52,9 +52,11 @@ namespace libdar
     class cache : public generic_file
     {
     public:
+	static constexpr U_I default_size = 102400; ///< size of the cache when not specified
+
 	cache(generic_file & hidden, 	          ///< is the file to cache, it is never deleted by the cache object,
-	      bool shift_mode,                    ///< if true, when all cached data has been read, half of the data is flushed from the cache, the other half is shifted and new data take place to fill the cache. This is necessary for sequential reading, but has some CPU overhead.
-	      U_I size = 102400                   ///< is the (fixed) size of the cache
+	      bool shift_mode,                    ///< if true, when all cached data has been read, half of the data is flushed from the cache, the other half is kept and new data take place to fill the cache. This is necessary for sequential reading. As the cache is a ring buffer, no data is copied for that.
+	      U_I size = default_size             ///< is the (fixed) size of the cache, large values (several MiB) bring no extra CPU overhead
 	    );
 	cache(const cache & ref) = delete;
 	cache(cache && ref) = delete;
@@ -75,6 +77,8 @@ namespace libdar
 	    // inherited from generic_file
 	virtual void inherited_read_ahead(const infinint & amount) override;
 	virtual U_I inherited_read(char *a, U_I size) override;
+	virtual bool inherited_read_lend(const char * & ptr, U_I & size) override;
+	virtual bool inherited_lent_from(S_I & fd, infinint & offset) const override { return lent_through && ref->lent_from(fd, offset); };
 	virtual void inherited_write(const char *a, U_I size) override;
 	virtual void inherited_sync_write() override { flush_write(); };
 	virtual void inherited_flush_read() override { flush_write(); clear_buffer(); };
@@ -82,17 +86,21 @@ namespace libdar
 
     private:
 	generic_file *ref;                ///< underlying file, (not owned by "this', not to be delete by "this")
-	char *buffer;                     ///< data in transit
+	char *buffer;                     ///< data in transit, used as a ring buffer
 	U_I size;                         ///< allocated size
 	U_I half;                         ///< precalculated half = size / 2
+	U_I begin;                        ///< index in buffer of the first byte of cached data, next, last and first_to_write are relative to it
 	U_I next;                         ///< next to read or next place to write to
 	U_I last;                         ///< first byte of invalid data in the cache. we have: next <= last < size
 	U_I first_to_write;               ///< position of the first byte that need to be written. if greater than last, no byte need writing
 	infinint buffer_offset;           ///< position of the first byte in buffer
 	bool shifted_mode;                ///< whether to half flush and shift or totally flush data
 	infinint eof_offset;              ///< size of the underlying file (read-only mode), set to zero if unknown
+	bool lent_through;                ///< whether the data lent by the last call to read_lend() came from the underlying file
 
 	bool need_flush_write() const { return first_to_write < last; };
+	char *at(U_I pos) const { return buffer + (pos < size - begin ? begin + pos : pos - (size - begin)); }; ///< address in buffer of the byte at cache position pos
+	U_I contiguous(U_I pos) const { return pos < size - begin ? size - begin - pos : size - (pos - (size - begin)); }; ///< number of bytes from cache position pos up to the end of buffer
 	void alloc_buffer(size_t x_size); ///< allocate x_size byte in buffer field and set size accordingly
 	void release_buffer();            ///< release memory set buffer to nullptr and size to zero
 	void shift_by_half();
@@ -27,12 +27,28 @@ extern "C"
 
 #include "cat_all_entrees.hpp"
 #include "tools.hpp"
+#include "mask.hpp"
+
+#include <algorithm>
 
 using namespace std;
 
 namespace libdar
 {
 
+	/// add to size and storage_size what the given entry counts for in the sizes of its parent directory
+    static void add_size_of(const cat_nomme *child, infinint & size, infinint & storage_size);
+
+	/// whether the given inode has changed since the archive of reference
+    static bool inode_has_changed(const cat_inode *ino);
+
+#ifdef LIBDAR_FAST_DIR
+	/// ordering of the children by name
+    static bool name_less(const cat_nomme *a, const cat_nomme *b) { return a->get_name() < b->get_name(); };
+    static bool name_lower(const cat_nomme *a, const string & name) { return a->get_name() < name; };
+    static bool name_equal(const cat_nomme *a, const cat_nomme *b) { return a->get_name() == b->get_name(); };
+#endif
+
 	// static field of class cat_directory
 
     const cat_eod cat_directory::fin;
@@ -49,11 +65,13 @@ namespace libdar
 	parent = nullptr;
 #ifdef LIBDAR_FAST_DIR
 	fils.clear();
+	fils_added.clear();
 #endif
 	ordered_fils.clear();
-	it = ordered_fils.begin();
+	next_read = 0;
 	set_saved_status(saved_status::saved);
 	recursive_has_changed = true;
+	dropped_changed = false;
 	updated_sizes = false;
     }
 
@@ -99,7 +117,9 @@ namespace libdar
 				 compression default_algo,
 				 bool lax,
 				 bool only_detruit,
-				 bool small) : cat_inode(dialog, pdesc, reading_ver, saved, small)
+				 bool small,
+				 cat_subtree *subtree,
+				 bool catalogue_root) : cat_inode(dialog, pdesc, reading_ver, saved, small)
     {
 	cat_entree *p;
 	cat_nomme *t;
@@ -108,13 +128,29 @@ namespace libdar
 	cat_mirage *m;
 	cat_eod *fin = nullptr;
 	bool lax_end = false;
+	bool path_grown = subtree != nullptr && !catalogue_root;
+	bool parent_out = false;
+	string tmp;
+	infinint dropped_size = 0;
+	infinint dropped_storage_size = 0;
+
+	if(path_grown)
+	{
+	    subtree->where += get_name();
+	    parent_out = subtree->out;
+	    if(!parent_out && !subtree->subtree->is_covered(subtree->where))
+		subtree->out = true;
+	}
 
 	parent = nullptr;
 #ifdef LIBDAR_FAST_DIR
 	fils.clear();
+	fils_added.clear();
 #endif
 	ordered_fils.clear();
+	next_read = 0;
 	recursive_has_changed = true; // need to call recursive_has_changed_update() first if this fields has to be used
+	dropped_changed = false;
 	updated_sizes = false;
 
 	try
@@ -123,7 +159,7 @@ namespace libdar
 	    {
 		try
 		{
-		    p = cat_entree::read(dialog, pdesc, reading_ver, stats, corres, default_algo, lax, only_detruit, small);
+		    p = cat_entree::read(dialog, pdesc, reading_ver, stats, corres, default_algo, lax, only_detruit, small, subtree);
 		}
 		catch(Euser_abort & e)
 		{
@@ -152,19 +188,22 @@ namespace libdar
 		    x = dynamic_cast<cat_detruit *>(p);
 		    m = dynamic_cast<cat_mirage *>(p);
 
-		    if(!only_detruit || d != nullptr || x != nullptr || fin != nullptr || m != nullptr)
+		    if((!only_detruit || d != nullptr || x != nullptr || fin != nullptr || m != nullptr)
+		       && (subtree == nullptr || fin != nullptr || m != nullptr
+			   || (d != nullptr && !d->is_empty())
+			   || (t != nullptr && !subtree->out
+			       && (x != nullptr || subtree->subtree->is_covered(subtree->where.append(t->get_name()))))))
 		    {
 			    // we must add the cat_mirage object, else
 			    // we will trigger an incoherent catalogue structure
 			    // as the cat_mirage without inode cannot link to the cat_mirage with inode
 			    // carring the same etiquette if we destroy them right now.
+			    // For the same reason, out of subtree the cat_mirage objects
+			    // are kept as well as the directories leading to them. The cat_detruit
+			    // objects are kept in directories covered by subtree, where the
+			    // filtre_* routines account for them depending on their options.
 			if(t != nullptr) // p is a "cat_nomme"
-			{
-#ifdef LIBDAR_FAST_DIR
-			    fils[t->get_name()] = t;
-#endif
 			    ordered_fils.push_back(t);
-			}
 			if(d != nullptr) // p is a cat_directory
 			    d->parent = this;
 			if(t == nullptr && fin == nullptr)
@@ -172,6 +211,20 @@ namespace libdar
 		    }
 		    else
 		    {
+			if(subtree != nullptr && t != nullptr)
+			{
+				// the dropped entry still counts for the sizes
+				// and for the recursive_has_changed flag of this directory
+			    if(!subtree->out)
+				++subtree->dropped;
+			    add_size_of(t, dropped_size, dropped_storage_size);
+			    if(d != nullptr)
+			    {
+				d->recursive_has_changed_update();
+				dropped_changed |= d->get_recursive_has_changed();
+			    }
+			    dropped_changed |= inode_has_changed(dynamic_cast<cat_inode *>(t));
+			}
 			delete p;
 			p = nullptr;
 			d = nullptr;
@@ -192,10 +245,32 @@ namespace libdar
 		fin = nullptr;
 	    }
 
-	    it = ordered_fils.begin();
+		// the children are sorted by name once all read
+	    ordered_fils.shrink_to_fit();
+#ifdef LIBDAR_FAST_DIR
+	    fils_rebuild();
+#endif
+	    next_read = 0;
+	    if(subtree != nullptr)
+	    {
+		    // the sizes are computed now, while the dropped entries can be taken into account
+		recursive_update_sizes();
+		x_size += dropped_size;
+		x_storage_size += dropped_storage_size;
+	    }
+	    if(path_grown)
+	    {
+		subtree->where.pop(tmp);
+		subtree->out = parent_out;
+	    }
 	}
 	catch(Egeneric & e)
 	{
+	    if(path_grown)
+	    {
+		subtree->where.pop(tmp);
+		subtree->out = parent_out;
+	    }
 	    clear();
 	    throw;
 	}
@@ -218,7 +293,7 @@ namespace libdar
 
     void cat_directory::inherited_dump(const pile_descriptor & pdesc, bool small) const
     {
-	deque<cat_nomme *>::const_iterator x = ordered_fils.begin();
+	vector<cat_nomme *>::const_iterator x = ordered_fils.begin();
 
 	cat_inode::inherited_dump(pdesc, small);
 	if(!small)
@@ -251,39 +326,13 @@ namespace libdar
 	{
 	    x_size = 0;
 	    x_storage_size = 0;
-	    deque<cat_nomme *>::const_iterator it = ordered_fils.begin();
-	    const cat_directory *f_dir = nullptr;
-	    const cat_file *f_file = nullptr;
+	    vector<cat_nomme *>::const_iterator it = ordered_fils.begin();
 
 	    while(it != ordered_fils.end())
 	    {
 		if(*it == nullptr)
 		    throw SRC_BUG;
-		f_dir = dynamic_cast<const cat_directory *>(*it);
-		f_file = dynamic_cast<const cat_file *>(*it);
-		if(f_dir != nullptr)
-		{
-			// recursion occurs here
-			// by calling get_size() and get_storage_size() of child directories
-			/// which in turn will call the recursive_update_sizes() of child objects
-		    x_size += f_dir->get_size();
-		    x_storage_size += f_dir->get_storage_size();
-		}
-		else if(f_file != nullptr && (f_file->get_saved_status() == saved_status::saved || f_file->get_saved_status() == saved_status::delta))
-		{
-		    x_size += f_file->get_size();
-		    if(!f_file->get_storage_size().is_zero() || f_file->get_sparse_file_detection_read())
-			x_storage_size += f_file->get_storage_size();
-		    else
-			x_storage_size += f_file->get_size();
-			// in very first archive formats, storage_size was set to zero to
-			// indicate "no compression used"
-			// the only way to have zero as storage_size is either file size is
-			// zero or file is a sparse_file with only zeroed bytes. Sparse file
-			// were not taken into account in that old archive that set storage_size
-			// to zero to indicate the absence of compression
-		}
-
+		add_size_of(*it, x_size, x_storage_size);
 		++it;
 	    }
 	    updated_sizes = true;
@@ -315,7 +364,7 @@ namespace libdar
 	    if(a_dir != nullptr && d != nullptr) // both directories : merging them
 	    {
 		a_dir = d; // updates the inode part, does not touch the cat_directory specific part as defined in the cat_directory::operator =
-		deque<cat_nomme *>::iterator xit = d->ordered_fils.begin();
+		vector<cat_nomme *>::iterator xit = d->ordered_fils.begin();
 		while(xit != d->ordered_fils.end())
 		{
 		    const_cast<cat_directory *>(a_dir)->add_children(*xit);
@@ -326,6 +375,7 @@ namespace libdar
 		    // to avoid the destructor destroyed the director children that have been merged to the a_dir cat_directory
 #ifdef LIBDAR_FAST_DIR
 		d->fils.clear();
+		d->fils_added.clear();
 #endif
 		d->ordered_fils.clear();
 		delete r;
@@ -343,7 +393,7 @@ namespace libdar
 
 		    // adding the new object
 #ifdef LIBDAR_FAST_DIR
-		fils[r->get_name()] = r;
+		fils_add(r);
 #endif
 		ordered_fils.push_back(r);
 	    }
@@ -351,7 +401,7 @@ namespace libdar
 	else // no conflict: adding
 	{
 #ifdef LIBDAR_FAST_DIR
-	    fils[r->get_name()] = r;
+	    fils_add(r);
 #endif
 	    ordered_fils.push_back(r);
 	}
@@ -364,33 +414,31 @@ namespace libdar
 
     void cat_directory::reset_read_children() const
     {
-	it = ordered_fils.begin();
+	next_read = 0;
     }
 
     void cat_directory::end_read() const
     {
-	    // "moi" is necessary to avoid assigning a const_iterator to an iterator
-	cat_directory *moi = const_cast<cat_directory *>(this);
-	moi->it = moi->ordered_fils.end();
+	next_read = ordered_fils.size();
     }
 
     bool cat_directory::read_children(const cat_nomme *&r) const
     {
-	if(it != ordered_fils.end())
+	if(next_read < ordered_fils.size())
 	{
-	    if(*it == nullptr)
+	    r = ordered_fils[next_read];
+	    if(r == nullptr)
 		throw SRC_BUG;
-	    r = *it;
-	    ++it;
+	    ++next_read;
 	    return true;
 	}
 	else
 	    return false;
     }
 
-    void cat_directory::erase_ordered_fils(deque<cat_nomme *>::const_iterator debut, deque<cat_nomme *>::const_iterator fin)
+    void cat_directory::erase_ordered_fils(vector<cat_nomme *>::const_iterator debut, vector<cat_nomme *>::const_iterator fin)
     {
-	for(deque<cat_nomme *>::const_iterator ut = debut;
+	for(vector<cat_nomme *>::const_iterator ut = debut;
 	    ut != fin;
 	    ++ut)
 	    if(*ut != nullptr)
@@ -401,32 +449,12 @@ namespace libdar
 
     void cat_directory::tail_to_read_children()
     {
+	if(next_read < ordered_fils.size())
+	    erase_ordered_fils(ordered_fils.begin() + next_read, ordered_fils.end());
+	next_read = ordered_fils.size();
 #ifdef LIBDAR_FAST_DIR
-	map<string, cat_nomme *>::iterator dest;
-	deque<cat_nomme *>::const_iterator ordered_dest = it;
-
-	while(ordered_dest != ordered_fils.end())
-	{
-	    try
-	    {
-		if(*ordered_dest == nullptr)
-		    throw SRC_BUG;
-		dest = fils.find((*ordered_dest)->get_name());
-		if(dest == fils.end())
-		    throw SRC_BUG;
-		fils.erase(dest);
-		ordered_dest++;
-	    }
-	    catch(...)
-	    {
-		erase_ordered_fils(it, ordered_dest);
-		it = ordered_fils.end();
-		throw;
-	    }
-	}
+	fils_rebuild();
 #endif
-	erase_ordered_fils(it, ordered_fils.end());
-	it = ordered_fils.end();
 	recursive_flag_size_to_update();
     }
 
@@ -434,7 +462,7 @@ namespace libdar
     {
 
 	    // locating old object in ordered_fils
-	deque<cat_nomme *>::iterator ot = ordered_fils.begin();
+	vector<cat_nomme *>::iterator ot = ordered_fils.begin();
 
 	while(ot != ordered_fils.end() && *ot != nullptr && (*ot)->get_name() != name)
 	    ++ot;
@@ -447,37 +475,20 @@ namespace libdar
 
 
 #ifdef LIBDAR_FAST_DIR
-	    // localizing old object in fils
-	map<string, cat_nomme *>::iterator ut = fils.find(name);
-	if(ut == fils.end())
-	    throw SRC_BUG;
-
-	    // sanity checks
-	if(*ot != ut->second)
-	    throw SRC_BUG;
-
 	    // removing reference from fils
-	fils.erase(ut);
+	fils_remove(*ot);
 #endif
 
 	    // recording the address of the object to remove
 	cat_nomme *obj = *ot;
 
 	    // removing its reference from ordered_fils
-	    // and having "it" pointing to the entry following the
-	    // removed one, if it would have been the next entry to be read
-	if(it == ot)
-	    it = ordered_fils.erase(ot);
-	else // not removing the next to read object (the one pointed to by 'it')
-	{
-	    (void)ordered_fils.erase(ot);
-
-		// however if we remove the last item of the deque
-		// we must set 'it' to end() to avoid 'it' becoming
-		// a dangling pointer:
-	    if(ordered_fils.empty())
-		it = ordered_fils.end();
-	}
+	    // and keeping "next_read" on the same entry,
+	    // which is the entry following the removed one
+	    // if it would have been the next entry to be read
+	if((U_I)(ot - ordered_fils.begin()) < next_read)
+	    --next_read;
+	(void)ordered_fils.erase(ot);
 
 	    // destroying the object itself
 	delete obj;
@@ -486,7 +497,7 @@ namespace libdar
 
     void cat_directory::recursively_set_to_unsaved_data_and_FSA()
     {
-	deque<cat_nomme *>::iterator it = ordered_fils.begin();
+	vector<cat_nomme *>::iterator it = ordered_fils.begin();
 	cat_directory *n_dir = nullptr;
 	cat_inode *n_ino = nullptr;
 	cat_mirage *n_mir = nullptr;
@@ -531,7 +542,7 @@ namespace libdar
 
     void cat_directory::change_location(const smart_pointer<pile_descriptor> & pdesc)
     {
-	deque<cat_nomme *>::iterator tmp_it = ordered_fils.begin();
+	vector<cat_nomme *>::iterator tmp_it = ordered_fils.begin();
 
 	cat_nomme::change_location(pdesc);
 	while(tmp_it != ordered_fils.end())
@@ -549,40 +560,48 @@ namespace libdar
     	parent = nullptr;
 #ifdef LIBDAR_FAST_DIR
 	fils.clear();
+	fils_added.clear();
 #endif
 	ordered_fils.clear();
-	it = ordered_fils.begin();
+	next_read = 0;
 	updated_sizes = false;
+	dropped_changed = false;
     }
 
     void cat_directory::clear()
     {
 #ifdef LIBDAR_FAST_DIR
 	fils.clear();
+	fils_added.clear();
 #endif
 	erase_ordered_fils(ordered_fils.begin(), ordered_fils.end());
 	ordered_fils.clear();
-	it = ordered_fils.begin();
+	next_read = 0;
 	recursive_flag_size_to_update();
     }
 
     bool cat_directory::search_children(const string &name, const cat_nomme * & ptr) const
     {
 #ifdef LIBDAR_FAST_DIR
-	map<string, cat_nomme *>::const_iterator ut = fils.find(name);
+	vector<cat_nomme *>::const_iterator ut = lower_bound(fils.begin(), fils.end(), name, name_lower);
 
-	if(ut != fils.end())
+	if(ut != fils.end() && (*ut)->get_name() == name)
+	    ptr = *ut;
+	else
 	{
-	    if(ut->second == nullptr)
-		throw SRC_BUG;
-	    ptr = ut->second;
-	    if(ptr == nullptr)
-		throw SRC_BUG;
+	    map<string, cat_nomme *>::const_iterator at = fils_added.find(name);
+
+	    if(at != fils_added.end())
+	    {
+		ptr = at->second;
+		if(ptr == nullptr)
+		    throw SRC_BUG;
+	    }
+	    else
+		ptr = nullptr;
 	}
-	else
-	    ptr = nullptr;
 #else
-	deque<cat_nomme *>::const_iterator ot = ordered_fils.begin();
+	vector<cat_nomme *>::const_iterator ot = ordered_fils.begin();
 
 	while(ot != ordered_fils.end() && *ot != nullptr && (*ot)->get_name() != name)
 	    ++ot;
@@ -601,9 +620,9 @@ namespace libdar
 
     void cat_directory::recursive_has_changed_update() const
     {
-	deque<cat_nomme *>::const_iterator it = ordered_fils.begin();
+	vector<cat_nomme *>::const_iterator it = ordered_fils.begin();
 
-	recursive_has_changed = false;
+	recursive_has_changed = dropped_changed;
 	while(it != ordered_fils.end())
 	{
 	    const cat_directory *d = dynamic_cast<cat_directory *>(*it);
@@ -613,11 +632,8 @@ namespace libdar
 		d->recursive_has_changed_update();
 		recursive_has_changed |= d->get_recursive_has_changed();
 	    }
-	    if(ino != nullptr && !recursive_has_changed)
-		recursive_has_changed |=
-		    ino->get_saved_status() != saved_status::not_saved
-		    || ino->ea_get_saved_status() == ea_saved_status::full
-		    || ino->ea_get_saved_status() == ea_saved_status::removed;
+	    if(!recursive_has_changed)
+		recursive_has_changed |= inode_has_changed(ino);
 	    ++it;
 	}
     }
@@ -627,7 +643,7 @@ namespace libdar
 	infinint ret = ordered_fils.size();
 	const cat_directory *fils_dir = nullptr;
 
-	deque<cat_nomme *>::const_iterator ot = ordered_fils.begin();
+	vector<cat_nomme *>::const_iterator ot = ordered_fils.begin();
 	while(ot != ordered_fils.end())
 	{
 	    if(*ot == nullptr)
@@ -646,7 +662,7 @@ namespace libdar
     {
 	infinint ret = 0;
 
-	deque<cat_nomme *>::const_iterator it = ordered_fils.begin();
+	vector<cat_nomme *>::const_iterator it = ordered_fils.begin();
 
 	while(it != ordered_fils.end())
 	{
@@ -675,7 +691,7 @@ namespace libdar
     {
 	infinint ret = 0;
 
-	deque<cat_nomme *>::const_iterator it = ordered_fils.begin();
+	vector<cat_nomme *>::const_iterator it = ordered_fils.begin();
 
 	while(it != ordered_fils.end())
 	{
@@ -697,7 +713,7 @@ namespace libdar
 
     void cat_directory::get_etiquettes_found_in_tree(map<infinint, infinint> & already_found) const
     {
-	deque<cat_nomme *>::const_iterator it = ordered_fils.begin();
+	vector<cat_nomme *>::const_iterator it = ordered_fils.begin();
 
 	while(it != ordered_fils.end())
 	{
@@ -724,7 +740,7 @@ namespace libdar
 
     void cat_directory::remove_all_mirages_and_reduce_dirs()
     {
-	deque<cat_nomme *>::iterator curs = ordered_fils.begin();
+	vector<cat_nomme *>::iterator curs = ordered_fils.begin();
 
 	while(curs != ordered_fils.end())
 	{
@@ -744,29 +760,23 @@ namespace libdar
 
 	    if(m != nullptr || (d != nullptr && d->is_empty()))
 	    {
-#ifdef LIBDAR_FAST_DIR
-		map<string, cat_nomme *>::iterator monfils = fils.find(n->get_name());
-
-		if(monfils == fils.end())
-		    throw SRC_BUG;
-		if(monfils->second != *curs)
-		    throw SRC_BUG;
-		fils.erase(monfils);
-#endif
-		curs = ordered_fils.erase(curs);
-		    // curs now points to the next item
 		delete n;
+		*curs = nullptr; // removed from ordered_fils below
 	    }
-	    else
-		++curs;
+	    ++curs;
 	}
 
+	ordered_fils.erase(std::remove(ordered_fils.begin(), ordered_fils.end(), nullptr), ordered_fils.end());
+	next_read = 0;
+#ifdef LIBDAR_FAST_DIR
+	fils_rebuild();
+#endif
 	recursive_flag_size_to_update();
     }
 
     void cat_directory::set_all_mirage_s_inode_wrote_field_to(bool val) const
     {
-	deque <cat_nomme *>::const_iterator curs = ordered_fils.begin();
+	vector<cat_nomme *>::const_iterator curs = ordered_fils.begin();
 	const cat_mirage *mir = nullptr;
 	const cat_directory *dir = nullptr;
 
@@ -787,7 +797,7 @@ namespace libdar
 
     void cat_directory::set_all_mirage_s_inode_dumped_field_to(bool val) const
     {
-	deque<cat_nomme *>::const_iterator curs = ordered_fils.begin();
+	vector<cat_nomme *>::const_iterator curs = ordered_fils.begin();
 
 	while(curs != ordered_fils.end())
 	{
@@ -808,4 +818,97 @@ namespace libdar
     }
 
 
+#ifdef LIBDAR_FAST_DIR
+    void cat_directory::fils_add(cat_nomme *r)
+    {
+	fils_added[r->get_name()] = r;
+	if(fils_added.size() > FILS_ADDED_MAX + fils.size() / 8)
+	    fils_merge();
+    }
+
+    void cat_directory::fils_remove(const cat_nomme *r)
+    {
+	map<string, cat_nomme *>::iterator at = fils_added.find(r->get_name());
+
+	if(at != fils_added.end())
+	{
+	    if(at->second != r)
+		throw SRC_BUG;
+	    fils_added.erase(at);
+	}
+	else
+	{
+	    vector<cat_nomme *>::iterator ut = lower_bound(fils.begin(), fils.end(), r->get_name(), name_lower);
+
+	    if(ut == fils.end() || *ut != r)
+		throw SRC_BUG;
+	    fils.erase(ut);
+	}
+    }
+
+    void cat_directory::fils_merge()
+    {
+	vector<cat_nomme *>::difference_type middle = fils.size();
+
+	    // fils_added is sorted by name too, its entries are not already in fils
+	fils.reserve(fils.size() + fils_added.size());
+	for(map<string, cat_nomme *>::iterator at = fils_added.begin(); at != fils_added.end(); ++at)
+	    fils.push_back(at->second);
+	fils_added.clear();
+	inplace_merge(fils.begin(), fils.begin() + middle, fils.end(), name_less);
+    }
+
+    void cat_directory::fils_rebuild()
+    {
+	fils_added.clear();
+	fils.assign(ordered_fils.begin(), ordered_fils.end());
+	stable_sort(fils.begin(), fils.end(), name_less);
+
+	    // among entries of the same name, only the last added one can be looked up
+	reverse(fils.begin(), fils.end());
+	fils.erase(unique(fils.begin(), fils.end(), name_equal), fils.end());
+	reverse(fils.begin(), fils.end());
+	fils.shrink_to_fit();
+    }
+
+    const U_I cat_directory::FILS_ADDED_MAX = 64;
+#endif
+
+    static void add_size_of(const cat_nomme *child, infinint & size, infinint & storage_size)
+    {
+	const cat_directory *f_dir = dynamic_cast<const cat_directory *>(child);
+	const cat_file *f_file = dynamic_cast<const cat_file *>(child);
+
+	if(f_dir != nullptr)
+	{
+		// recursion occurs here
+		// by calling get_size() and get_storage_size() of child directories
+		/// which in turn will call the recursive_update_sizes() of child objects
+	    size += f_dir->get_size();
+	    storage_size += f_dir->get_storage_size();
+	}
+	else if(f_file != nullptr && (f_file->get_saved_status() == saved_status::saved || f_file->get_saved_status() == saved_status::delta))
+	{
+	    size += f_file->get_size();
+	    if(!f_file->get_storage_size().is_zero() || f_file->get_sparse_file_detection_read())
+		storage_size += f_file->get_storage_size();
+	    else
+		storage_size += f_file->get_size();
+		// in very first archive formats, storage_size was set to zero to
+		// indicate "no compression used"
+		// the only way to have zero as storage_size is either file size is
+		// zero or file is a sparse_file with only zeroed bytes. Sparse file
+		// were not taken into account in that old archive that set storage_size
+		// to zero to indicate the absence of compression
+	}
+    }
+
+    static bool inode_has_changed(const cat_inode *ino)
+    {
+	return ino != nullptr
+	    && (ino->get_saved_status() != saved_status::not_saved
+		|| ino->ea_get_saved_status() == ea_saved_status::full
+		|| ino->ea_get_saved_status() == ea_saved_status::removed);
+    }
+
 } // end of namespace
@@ -38,6 +38,7 @@ extern "C"
 #include <map>
 #endif
 #include <list>
+#include <vector>
 
 namespace libdar
 {
@@ -68,7 +69,9 @@ namespace libdar
 		      compression default_algo,
 		      bool lax,
 		      bool only_detruit, // objects of other class than detruit and cat_directory are not built in memory
-		      bool small);
+		      bool small,
+		      cat_subtree *subtree = nullptr, // if not nullptr, the part of the directory tree to build in memory
+		      bool catalogue_root = false); // if set, subtree->where is the path of this directory, not of its parent
 	cat_directory(const cat_directory &ref); // only the inode part is build, no children is duplicated (empty dir)
 	cat_directory(cat_directory && ref) noexcept;
 	cat_directory & operator = (const cat_directory & ref); // set the inode part *only* no subdirectories/subfiles are copies or removed.
@@ -161,18 +164,28 @@ namespace libdar
 	mutable bool updated_sizes;
         cat_directory *parent;
 #ifdef LIBDAR_FAST_DIR
-        std::map<std::string, cat_nomme *> fils; // used for fast lookup
+	std::vector<cat_nomme *> fils; ///< children sorted by name, used for fast lookup
+	std::map<std::string, cat_nomme *> fils_added; ///< children added since fils has last been sorted
 #endif
-	std::deque<cat_nomme *> ordered_fils;
-        mutable std::deque<cat_nomme *>::const_iterator it; ///< next entry to be returned by read_children
+	std::vector<cat_nomme *> ordered_fils; ///< children in the order they have been added
+	mutable U_I next_read;  ///< index in ordered_fils of the next entry to be returned by read_children
 	mutable bool recursive_has_changed;
+	bool dropped_changed;    ///< whether an entry not built in memory (see subtree at construction time) had changed
 
 	void init() noexcept;
 	void clear();
 	void recursive_update_sizes() const;
 	void recursive_flag_size_to_update() const;
-	void erase_ordered_fils(std::deque<cat_nomme *>::const_iterator debut,
-				std::deque<cat_nomme *>::const_iterator fin);
+	void erase_ordered_fils(std::vector<cat_nomme *>::const_iterator debut,
+				std::vector<cat_nomme *>::const_iterator fin);
+#ifdef LIBDAR_FAST_DIR
+	void fils_add(cat_nomme *r);
+	void fils_remove(const cat_nomme *r);
+	void fils_merge();
+	void fils_rebuild();
+
+	static const U_I FILS_ADDED_MAX; ///< minimum size of fils_added that triggers its merging into fils
+#endif
     };
 
 	/// @}
@@ -47,7 +47,8 @@ namespace libdar
 				 compression default_algo,
 				 bool lax,
 				 bool only_detruit,
-				 bool small)
+				 bool small,
+				 cat_subtree *subtree)
     {
         char type;
         saved_status saved;
@@ -114,7 +115,7 @@ namespace libdar
                 ret = new (nothrow) cat_prise(dialog, pdesc, reading_ver, saved, small);
                 break;
             case 'd':
-                ret = new (nothrow) cat_directory(dialog, pdesc, reading_ver, saved, stats, corres, default_algo, lax, only_detruit, small);
+                ret = new (nothrow) cat_directory(dialog, pdesc, reading_ver, saved, stats, corres, default_algo, lax, only_detruit, small, subtree);
                 break;
             case 'm':
                 ret = new (nothrow) cat_mirage(dialog, pdesc, reading_ver, saved, stats, corres, default_algo, cat_mirage::fmt_mirage, lax, small);
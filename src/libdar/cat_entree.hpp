@@ -43,16 +43,33 @@ extern "C"
 #include "entree_stats.hpp"
 #include "list_entry.hpp"
 #include "slice_layout.hpp"
+#include "path.hpp"
 
 #include <memory>
 
 namespace libdar
 {
     class cat_etoile;
+    class mask;
 
 	/// \addtogroup Private
 	/// @{
 
+	/// restricts the part of a catalogue built in memory when reading it from an archive
+
+	/// entries not covered by the subtree mask are dropped once read, except the cat_mirage
+	/// objects (the others pointing to the same inode may need them) and the directories leading to them.
+	/// The catalogue has no per-directory index, so all entries are still read and parsed.
+    struct cat_subtree
+    {
+	const mask *subtree;  ///< mask applied to the path of the entries
+	path where;           ///< path of the directory being read
+	bool out;             ///< whether the directory being read is not covered by subtree
+	infinint dropped;     ///< number of entries dropped from the directories covered by subtree
+
+	cat_subtree(const mask & x_subtree, const path & root): subtree(&x_subtree), where(root), out(false), dropped(0) {};
+    };
+
 
 	/// the root class from all other inherite for any entry in the catalogue
 
@@ -70,6 +87,7 @@ namespace libdar
 	    /// \param[in] lax whether to use relax mode
 	    /// \param[in] only_detruit whether to only consider detruit objects (in addition to the directory tree)
 	    /// \param[in] small whether the dump() to read has been done with the small argument set
+	    /// \param[in,out] subtree if not nullptr, the part of the catalogue to build in memory
         static cat_entree *read(const std::shared_ptr<user_interaction> & dialog,
 				const smart_pointer<pile_descriptor> & f,
 				const archive_version & reading_ver,
@@ -78,7 +96,8 @@ namespace libdar
 				compression default_algo,
 				bool lax,
 				bool only_detruit,
-				bool small);
+				bool small,
+				cat_subtree *subtree = nullptr);
 
 	    /// setup an object when read from filesystem
 	cat_entree(saved_status val): xsaved(val) {};
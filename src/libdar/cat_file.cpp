@@ -52,14 +52,11 @@ namespace libdar
 		       const path & che,
 		       const infinint & taille,
 		       const infinint & fs_device,
-		       bool x_furtive_read_mode) : cat_inode(xuid, xgid, xperm, last_access, last_modif, last_change, src, fs_device)
+		       bool x_furtive_read_mode) : cat_inode(xuid, xgid, xperm, last_access, last_modif, last_change, src, fs_device), offset(0), size(taille), storage_size(0)
     {
         chemin = (che.append(src)).display();
         status = from_path;
         set_saved_status(saved_status::saved);
-        offset = nullptr;
-        size = nullptr;
-        storage_size = nullptr;
         algo_read = compression::none; // field not used for backup
         algo_write = compression::none; // may be set later by change_compression_algo_write()
         furtive_read_mode = x_furtive_read_mode;
@@ -70,34 +67,6 @@ namespace libdar
 	delta_sig = nullptr;
 	delta_sig_read = false;
 	read_ver = macro_tools_supported_version;
-
-        try
-        {
-            offset = new (nothrow) infinint(0);
-            size = new (nothrow) infinint(taille);
-            storage_size = new (nothrow) infinint(0);
-            if(offset == nullptr || size == nullptr || storage_size == nullptr)
-                throw Ememory("cat_file::cat_file");
-        }
-        catch(...)
-        {
-            if(offset != nullptr)
-            {
-                delete offset;
-                offset = nullptr;
-            }
-            if(size != nullptr)
-            {
-                delete size;
-                size = nullptr;
-            }
-            if(storage_size != nullptr)
-            {
-                delete storage_size;
-                storage_size = nullptr;
-            }
-            throw;
-        }
     }
 
     cat_file::cat_file(const shared_ptr<user_interaction> & dialog,
@@ -105,13 +74,10 @@ namespace libdar
 		       const archive_version & reading_ver,
 		       saved_status saved,
 		       compression default_algo,
-		       bool small) : cat_inode(dialog, pdesc, reading_ver, saved, small)
+		       bool small) : cat_inode(dialog, pdesc, reading_ver, saved, small), offset(0), size(0), storage_size(0)
     {
         chemin = "";
         status = from_cat;
-        size = nullptr;
-        offset = nullptr;
-        storage_size = nullptr;
         check = nullptr;
         algo_read = default_algo;  // only used for archive format "03" and older
         algo_write = default_algo; // may be changed later using change_compression_algo_write()
@@ -133,23 +99,17 @@ namespace libdar
 
         try
         {
-            size = new (nothrow) infinint(*ptr);
-            if(size == nullptr)
-                throw Ememory("cat_file::cat_file(generic_file)");
+            size.read(*ptr);
 
             if(!small) // inode not partially dumped
             {
                 if(saved == saved_status::saved
 		    || saved == saved_status::delta)
                 {
-                    offset = new (nothrow) infinint(*ptr);
-                    if(offset == nullptr)
-                        throw Ememory("cat_file::cat_file(generic_file)");
+                    offset.read(*ptr);
                     if(reading_ver > 1)
                     {
-                        storage_size = new (nothrow) infinint(*ptr);
-                        if(storage_size == nullptr)
-                            throw Ememory("cat_file::cat_file(generic_file)");
+                        storage_size.read(*ptr);
                         if(reading_ver > 7)
                         {
                             char tmp;
@@ -172,9 +132,9 @@ namespace libdar
 			    algo_write = algo_read;
                         }
                         else
-                            if(storage_size->is_zero()) // in older archive storage_size was set to zero if data was not compressed
+                            if(storage_size.is_zero()) // in older archive storage_size was set to zero if data was not compressed
                             {
-                                *storage_size = *size;
+                                storage_size = size;
                                 algo_read = compression::none;
 				algo_write = algo_read;
                             }
@@ -186,10 +146,8 @@ namespace libdar
                     }
                     else // archive format version is "1"
                     {
-                        storage_size = new (nothrow) infinint(*size);
-                        if(storage_size == nullptr)
-                            throw Ememory("cat_file::cat_file(generic_file)");
-                        *storage_size *= 2;
+                        storage_size = size;
+                        storage_size *= 2;
                             // compressed file should be less larger than twice
                             // the original file
                             // (in case the compression is very bad
@@ -216,11 +174,6 @@ namespace libdar
 			    will_have_delta_signature_structure();
 			file_data_status_read &= ~FILE_DATA_HAS_DELTA_SIG;
 		    }
-
-                    offset = new (nothrow) infinint(0);
-                    storage_size = new (nothrow) infinint(0);
-                    if(offset == nullptr || storage_size == nullptr)
-                        throw Ememory("cat_file::cat_file(generic_file)");
                 }
 
 		    // treating case of version below 8 where CRC
@@ -283,15 +236,8 @@ namespace libdar
 		    }
 		}
 
-                    // Now that all data has been read, setting default value for the undumped ones:
-
-		offset = new (nothrow) infinint(0); // can only be set from post_constructor
-                if(offset == nullptr)
-                    throw Ememory("cat_file::cat_file(generic_file)");
-
-                storage_size = new (nothrow) infinint(0); // cannot know the storage_size at that time
-                if(storage_size == nullptr)
-                    throw Ememory("cat_file::cat_file(generic_file)");
+                    // Now that all data has been read, the undumped ones keep their default value:
+		    // offset can only be set from post_constructor and storage_size cannot be known at that time
 
                 check = nullptr;
             }
@@ -309,19 +255,13 @@ namespace libdar
 
 	pdesc.check(true);
 
-        if(offset == nullptr)
-            throw SRC_BUG;
-        else
-	    *offset = pdesc.esc->get_position(); // data follows right after the inode+file information+CRC
+	offset = pdesc.esc->get_position(); // data follows right after the inode+file information+CRC
     }
 
-    cat_file::cat_file(const cat_file & ref) : cat_inode(ref)
+    cat_file::cat_file(const cat_file & ref) : cat_inode(ref), offset(ref.offset), size(ref.size), storage_size(ref.storage_size)
     {
         status = ref.status;
         chemin = ref.chemin;
-        offset = nullptr;
-        size = nullptr;
-        storage_size = nullptr;
         check = nullptr;
         dirty = ref.dirty;
         algo_read = ref.algo_read;
@@ -352,11 +292,6 @@ namespace libdar
             }
             else
                 check = nullptr;
-            offset = new (nothrow) infinint(*ref.offset);
-            size = new (nothrow) infinint(*ref.size);
-            storage_size = new (nothrow) infinint(*ref.storage_size);
-            if(offset == nullptr || size == nullptr || storage_size == nullptr)
-                throw Ememory("cat_file::cat_file(cat_file)");
 
 	    if(ref.delta_sig != nullptr)
 	    {
@@ -398,7 +333,7 @@ namespace libdar
 
 	    // dumping th cat_file part of the inode
 
-        size->dump(*ptr);
+        size.dump(*ptr);
         if(!small)
         {
             if(get_saved_status() == saved_status::saved
@@ -406,8 +341,8 @@ namespace libdar
             {
                 char tmp = compression2char(algo_write);
 
-                offset->dump(*ptr);
-                storage_size->dump(*ptr);
+                offset.dump(*ptr);
+                storage_size.dump(*ptr);
                 ptr->write(&flags, sizeof(flags));
                 ptr->write(&tmp, sizeof(tmp));
             }
@@ -449,7 +384,7 @@ namespace libdar
     {
         const cat_file *tmp = dynamic_cast<const cat_file *>(&ref);
         if(tmp != nullptr)
-            return cat_inode::has_changed_since(*tmp, hourshift, what_to_check) || *size != *(tmp->size);
+            return cat_inode::has_changed_since(*tmp, hourshift, what_to_check) || size != tmp->size;
         else
             throw SRC_BUG;
     }
@@ -533,9 +468,9 @@ namespace libdar
 		if(mode != normal && mode != plain)
 		    throw SRC_BUG; // keep compressed/keep_hole is not possible on an inode take from a filesystem
 		ret = tmp = new (nothrow) fichier_local(chemin, furtive_read_mode);
-		if(tmp != nullptr)
-			// telling *tmp to flush the data from the cache as soon as possible
-		    tmp->fadvise(fichier_global::advise_dontneed);
+		    // the data is not dropped from the system cache here, this would
+		    // discard what has been read ahead (see filesystem_read_ahead),
+		    // the caller drops it once it has been read
 
 		if(delta_sig_mem || delta_ref)
 		{
@@ -634,7 +569,7 @@ namespace libdar
 			    {
 				if(get_compression_algo_read() == compression::none)
 				{
-				    generic_file *tmp = new (nothrow) tronc(get_pile(), *offset, *storage_size, gf_read_only);
+				    generic_file *tmp = new (nothrow) tronc(get_pile(), offset, storage_size, gf_read_only);
 				    if(tmp == nullptr)
 					throw Ememory("cat_file::get_data");
 				    try
@@ -649,7 +584,7 @@ namespace libdar
 				    data->skip(0);
 				}
 				else
-				    get_pile()->skip(*offset);
+				    get_pile()->skip(offset);
 			    }
 
 				// determining on which layer to rely on for the next to come sparse file
@@ -728,7 +663,7 @@ namespace libdar
 			    if(data->is_empty())
 			    {
 				tronc *tronc_tmp;
-				generic_file *tmp = tronc_tmp = new (nothrow) tronc(get_pile(), *offset, gf_read_only);
+				generic_file *tmp = tronc_tmp = new (nothrow) tronc(get_pile(), offset, gf_read_only);
 				if(tmp == nullptr)
 				    throw Ememory("cat_file::get_data");
 				if(tronc_tmp == nullptr)
@@ -776,7 +711,7 @@ namespace libdar
 	    chemin = ""; // smallest possible memory allocation
 	    break;
 	case from_cat:
-	    *offset = 0; // smallest possible memory allocation
+	    offset = 0; // smallest possible memory allocation
 		// warning, cannot change "size", as it is dump() in catalogue later
 	    break;
 	case empty:
@@ -792,7 +727,7 @@ namespace libdar
     {
 	if(status == empty)
 	    throw SRC_BUG;
-	*offset = r;
+	offset = r;
     }
 
     const infinint & cat_file::get_offset() const
@@ -800,9 +735,7 @@ namespace libdar
 	if(get_saved_status() != saved_status::saved
 	   && get_saved_status() != saved_status::delta)
 	    throw SRC_BUG;
-	if(offset == nullptr)
-	    throw SRC_BUG;
-	return *offset;
+	return offset;
     }
 
     void cat_file::set_crc(const crc &c)
@@ -842,13 +775,13 @@ namespace libdar
 			    crc *tmp = nullptr;
 
 				// first, recording storage_size (needed when isolating a catalogue in sequential read mode)
-			    if(storage_size->is_zero())
+			    if(storage_size.is_zero())
 			    {
 				infinint pos = get_escape_layer()->get_position();
-				if(pos < *offset)
+				if(pos < offset)
 				    throw SRC_BUG;
 				else
-				    *storage_size = pos - *offset;
+				    const_cast<cat_file *>(this)->storage_size = pos - offset;
 			    }
 			    else
 				throw SRC_BUG; // how is this possible ??? it should always be zero in sequential read mode !
@@ -1421,21 +1354,6 @@ namespace libdar
 
     void cat_file::detruit()
     {
-        if(offset != nullptr)
-        {
-            delete offset;
-            offset = nullptr;
-        }
-        if(size != nullptr)
-        {
-            delete size;
-            size = nullptr;
-        }
-        if(storage_size != nullptr)
-        {
-            delete storage_size;
-            storage_size = nullptr;
-        }
         if(check != nullptr)
         {
             delete check;
@@ -88,10 +88,10 @@ namespace libdar
         virtual bool has_changed_since(const cat_inode & ref,
 				       const infinint & hourshift,
 				       comparison_fields what_to_check) const override;
-        infinint get_size() const { return *size; };
-	void change_size(const infinint & s) const { *size = s; };
-        infinint get_storage_size() const { return *storage_size; };
-        void set_storage_size(const infinint & s) { *storage_size = s; };
+        infinint get_size() const { return size; };
+	void change_size(const infinint & s) const { size = s; };
+        infinint get_storage_size() const { return storage_size; };
+        void set_storage_size(const infinint & s) { storage_size = s; };
 
 	    /// check whether the object will be able to provide a object using get_data() method
 	bool can_get_data() const { return get_saved_status() == saved_status::saved || get_saved_status() == saved_status::delta || status == from_path; };
@@ -245,9 +245,9 @@ namespace libdar
 
     private:
 	std::string chemin;     ///< path to the data (when read from filesystem)
-        infinint *offset;       ///< start location of the data in 'loc'
-        infinint *size;         ///< size of the data (uncompressed)
-        infinint *storage_size; ///< how much data used in archive (after compression)
+        infinint offset;        ///< start location of the data in 'loc'
+        mutable infinint size;  ///< size of the data (uncompressed)
+        infinint storage_size;  ///< how much data used in archive (after compression)
         crc *check;             ///< crc computed on the data
 	bool dirty;             ///< true when a file has been modified at the time it was saved
         compression algo_read;  ///< which compression algorithm to use to read the file's data
@@ -105,9 +105,8 @@ namespace libdar
             last_acc = last_access;
             last_mod = last_modif;
 	    last_cha = last_change;
-            fs_dev = new (nothrow) infinint(fs_device);
-            if(fs_dev == nullptr)
-                throw Ememory("cat_inode::cat_inode");
+            fs_dev = fs_device;
+	    has_fs_dev = true;
         }
         catch(...)
         {
@@ -196,14 +195,13 @@ namespace libdar
 
 		if(ea_saved == ea_saved_status::full)
 		{
-		    ea_size = new (nothrow) infinint(*ptr);
-		    if(ea_size == nullptr)
-			throw Ememory("cat_inode::cat_inode(file)");
+		    ea_size.read(*ptr);
+		    has_ea_size = true;
 		}
 	    }
 	    else // archive format <= 7
 	    {
-		    // ea_size stays nullptr meaning EA size unknown (old format)
+		    // ea_size stays unset meaning EA size unknown (old format)
 		last_cha.nullify();
 	    }
 
@@ -212,9 +210,8 @@ namespace libdar
 		switch(ea_saved)
 		{
 		case ea_saved_status::full:
-		    ea_offset = new (nothrow) infinint(*ptr);
-		    if(ea_offset == nullptr)
-			throw Ememory("cat_inode::cat_inode(file)");
+		    ea_offset.read(*ptr);
+		    has_ea_offset = true;
 
 		    if(reading_ver <= 7)
 		    {
@@ -280,16 +277,14 @@ namespace libdar
 
 		if(fsa_saved !=  fsa_saved_status::none)
 		{
-		    fsa_families = new (nothrow) infinint(*ptr);
-		    if(fsa_families == nullptr)
-			throw Ememory("cat_inode::cat_inode(file)");
+		    fsa_families.read(*ptr);
+		    has_fsa_families = true;
 		}
 
 		if(fsa_saved ==  fsa_saved_status::full)
 		{
-		    fsa_size = new (nothrow) infinint(*ptr);
-		    if(fsa_size == nullptr)
-			throw Ememory("cat_inode::cat_inode(file)");
+		    fsa_size.read(*ptr);
+		    has_fsa_size = true;
 		}
 
 		if(!small)
@@ -297,9 +292,10 @@ namespace libdar
 		    switch(fsa_saved)
 		    {
 		    case  fsa_saved_status::full:
-			fsa_offset = new (nothrow) infinint(*ptr);
+			fsa_offset.read(*ptr);
+			has_fsa_offset = true;
 			fsa_crc = create_crc_from_file(*ptr);
-			if(fsa_offset == nullptr || fsa_crc == nullptr)
+			if(fsa_crc == nullptr)
 			    throw Ememory("cat_inode::cat_inode(file)");
 			break;
 		    case fsa_saved_status::partial:
@@ -586,9 +582,9 @@ namespace libdar
             switch(ea_saved)
             {
             case ea_saved_status::full:
-		if(ea_offset == nullptr)
+		if(!has_ea_offset)
 		    throw SRC_BUG;
-                ea_offset->dump(*ptr);
+                ea_offset.dump(*ptr);
                 if(ea_crc == nullptr)
                     throw SRC_BUG;
                 ea_crc->dump(*ptr);
@@ -607,15 +603,15 @@ namespace libdar
 
 	if(fsa_saved !=  fsa_saved_status::none)
 	{
-	    if(fsa_families == nullptr)
+	    if(!has_fsa_families)
 		throw SRC_BUG;
-	    fsa_families->dump(*ptr);
+	    fsa_families.dump(*ptr);
 	}
 	if(fsa_saved ==  fsa_saved_status::full)
 	{
-	    if(fsa_size == nullptr)
+	    if(!has_fsa_size)
 		throw SRC_BUG;
-	    fsa_size->dump(*ptr);
+	    fsa_size.dump(*ptr);
 	}
 
 	if(!small)
@@ -623,9 +619,9 @@ namespace libdar
 	    switch(fsa_saved)
 	    {
 	    case fsa_saved_status::full:
-		if(fsa_offset == nullptr)
+		if(!has_fsa_offset)
 		    throw SRC_BUG;
-		fsa_offset->dump(*ptr);
+		fsa_offset.dump(*ptr);
 		if(fsa_crc == nullptr)
 		    throw SRC_BUG;
 		fsa_crc->dump(*ptr);
@@ -654,16 +650,12 @@ namespace libdar
                 delete ea;
                 ea = nullptr;
             }
-	    if(ea_offset != nullptr)
-	    {
-		delete ea_offset;
-		ea_offset = nullptr;
-	    }
+	    has_ea_offset = false;
             break;
         case ea_saved_status::full:
             if(ea != nullptr)
                 throw SRC_BUG;
-	    if(ea_offset != nullptr)
+	    if(has_ea_offset)
 		throw SRC_BUG;
             break;
         default:
@@ -679,14 +671,8 @@ namespace libdar
 
         if(ref != nullptr && ea == nullptr)
         {
-	    if(ea_size != nullptr)
-	    {
-		delete ea_size;
-		ea_size = nullptr;
-	    }
-            ea_size = new (nothrow) infinint(ref->space_used());
-	    if(ea_size == nullptr)
-		throw Ememory("cat_inode::ea_attach");
+            ea_size = ref->space_used();
+	    has_ea_size = true;
             ea = ref;
         }
         else
@@ -710,11 +696,11 @@ namespace libdar
 		    {
 			if(!small_read) // direct read mode
 			{
-			    if(ea_offset == nullptr)
+			    if(!has_ea_offset)
 				throw SRC_BUG;
 			    get_pile()->flush_read_above(get_compressor_layer());
 			    get_compressor_layer()->resume_compression();
-			    get_pile()->skip(*ea_offset);
+			    get_pile()->skip(ea_offset);
 			}
 			else // sequential read mode
 			{
@@ -826,18 +812,17 @@ namespace libdar
     {
         if(ea_saved == ea_saved_status::full)
         {
-            if(ea_size == nullptr) // reading an old archive
+            if(!has_ea_size) // reading an old archive
             {
                 if(ea != nullptr)
 		{
-                    const_cast<cat_inode *>(this)->ea_size = new (nothrow) infinint (ea->space_used());
-		    if(ea_size == nullptr)
-			throw Ememory("cat_inode::ea_get_size");
+                    const_cast<cat_inode *>(this)->ea_size = ea->space_used();
+		    const_cast<cat_inode *>(this)->has_ea_size = true;
 		}
 		else // else we stick with value 0, meaning that we read an old archive
 		    return 0;
             }
-            return *ea_size;
+            return ea_size;
         }
         else
             throw SRC_BUG;
@@ -845,21 +830,15 @@ namespace libdar
 
     void cat_inode::ea_set_offset(const infinint & pos)
     {
-	if(ea_offset == nullptr)
-	{
-	    ea_offset = new (nothrow) infinint(pos);
-	    if(ea_offset == nullptr)
-		throw Ememory("cat_inode::ea_set_offset");
-	}
-	else
-	    *ea_offset = pos;
+	ea_offset = pos;
+	has_ea_offset = true;
     }
 
     bool cat_inode::ea_get_offset(infinint & val) const
     {
-	if(ea_offset != nullptr)
+	if(has_ea_offset)
 	{
-	    val = *ea_offset;
+	    val = ea_offset;
 	    return true;
 	}
 	else
@@ -967,16 +946,12 @@ namespace libdar
 		delete fsal;
 		fsal = nullptr;
 	    }
-	    if(fsa_offset != nullptr)
-	    {
-		delete fsa_offset;
-		fsa_offset = nullptr;
-	    }
+	    has_fsa_offset = false;
 	    break;
 	case fsa_saved_status::full:
 	    if(fsal != nullptr)
 		throw SRC_BUG;
-	    if(fsa_offset != nullptr)
+	    if(has_fsa_offset)
 		throw SRC_BUG;
 	    break;
 	default:
@@ -991,10 +966,8 @@ namespace libdar
 	if(fsa_saved != fsa_saved_status::partial)
 	    throw SRC_BUG;
 
-	if(fsa_families == nullptr)
-	    fsa_families = new(nothrow) infinint(fsa_scope_to_infinint(val));
-	else
-	    *fsa_families = fsa_scope_to_infinint(val);
+	fsa_families = fsa_scope_to_infinint(val);
+	has_fsa_families = true;
     }
 
     void cat_inode::fsa_attach(filesystem_specific_attribute_list *ref)
@@ -1004,37 +977,10 @@ namespace libdar
 
         if(ref != nullptr && fsal == nullptr)
         {
-	    if(fsa_size != nullptr)
-	    {
-		delete fsa_size;
-		fsa_size = nullptr;
-	    }
-	    if(fsa_families != nullptr)
-	    {
-		delete fsa_families;
-		fsa_families = nullptr;
-	    }
-	    try
-	    {
-		fsa_size = new (nothrow) infinint (ref->storage_size());
-		fsa_families = new(nothrow) infinint(fsa_scope_to_infinint(ref->get_fsa_families()));
-		if(fsa_size == nullptr || fsa_families == nullptr)
-		    throw Ememory("cat_inode::fsa_attach");
-	    }
-	    catch(...)
-	    {
-		if(fsa_size != nullptr)
-		{
-		    delete fsa_size;
-		    fsa_size = nullptr;
-		}
-		if(fsa_families != nullptr)
-		{
-		    delete fsa_families;
-		    fsa_families = nullptr;
-		}
-		throw;
-	    }
+	    fsa_size = ref->storage_size();
+	    has_fsa_size = true;
+	    fsa_families = fsa_scope_to_infinint(ref->get_fsa_families());
+	    has_fsa_families = true;
 	    fsal = ref;
         }
         else
@@ -1079,9 +1025,9 @@ namespace libdar
 
 			if(!small_read) // direct reading mode
 			{
-			    if(fsa_offset == nullptr)
+			    if(!has_fsa_offset)
 				throw SRC_BUG;
-			    reader->skip(*fsa_offset);
+			    reader->skip(fsa_offset);
 			}
 			else
 			{
@@ -1184,8 +1130,8 @@ namespace libdar
     infinint cat_inode::fsa_get_size() const
     {
         if(fsa_saved == fsa_saved_status::full)
-	    if(fsa_size != nullptr)
-		return *fsa_size;
+	    if(has_fsa_size)
+		return fsa_size;
 	    else
 		throw SRC_BUG;
         else
@@ -1194,21 +1140,15 @@ namespace libdar
 
     void cat_inode::fsa_set_offset(const infinint & pos)
     {
-	if(fsa_offset == nullptr)
-	{
-	    fsa_offset = new (nothrow) infinint(pos);
-	    if(fsa_offset == nullptr)
-		throw Ememory("cat_inode::fsa_set_offset");
-	}
-	else
-	    *fsa_offset = pos;
+	fsa_offset = pos;
+	has_fsa_offset = true;
     }
 
     bool cat_inode::fsa_get_offset(infinint & pos) const
     {
-	if(fsa_offset != nullptr)
+	if(has_fsa_offset)
 	{
-	    pos = *fsa_offset;
+	    pos = fsa_offset;
 	    return true;
 	}
 	else
@@ -1307,70 +1247,46 @@ namespace libdar
 
     void cat_inode::nullifyptr() noexcept
     {
-        ea_offset = nullptr;
 	ea = nullptr;
-	ea_size = nullptr;
         ea_crc = nullptr;
-	fsa_families = nullptr;
-	fsa_offset = nullptr;
 	fsal = nullptr;
-	fsa_size = nullptr;
 	fsa_crc = nullptr;
-        fs_dev = nullptr;
+	has_ea_offset = false;
+	has_ea_size = false;
+	has_fsa_families = false;
+	has_fsa_offset = false;
+	has_fsa_size = false;
+	has_fs_dev = false;
     }
 
     void cat_inode::destroy() noexcept
     {
-        if(ea_offset != nullptr)
-        {
-            delete ea_offset;
-            ea_offset = nullptr;
-        }
         if(ea != nullptr)
         {
             delete ea;
             ea = nullptr;
         }
-	if(ea_size != nullptr)
-	{
-	    delete ea_size;
-	    ea_size = nullptr;
-	}
         if(ea_crc != nullptr)
         {
             delete ea_crc;
             ea_crc = nullptr;
         }
-	if(fsa_families != nullptr)
-	{
-	    delete fsa_families;
-	    fsa_families = nullptr;
-	}
-	if(fsa_offset != nullptr)
-	{
-	    delete fsa_offset;
-	    fsa_offset = nullptr;
-	}
 	if(fsal != nullptr)
 	{
 	    delete fsal;
 	    fsal = nullptr;
 	}
-	if(fsa_size != nullptr)
-	{
-	    delete fsa_size;
-	    fsa_size = nullptr;
-	}
 	if(fsa_crc != nullptr)
 	{
 	    delete fsa_crc;
 	    fsa_crc = nullptr;
 	}
-        if(fs_dev != nullptr)
-        {
-            delete fs_dev;
-            fs_dev = nullptr;
-        }
+	has_ea_offset = false;
+	has_ea_size = false;
+	has_fsa_families = false;
+	has_fsa_offset = false;
+	has_fsa_size = false;
+	has_fs_dev = false;
     }
 
     template <class T> void copy_ptr(const T *src, T * & dst)
@@ -1398,9 +1314,11 @@ namespace libdar
 	    ea_saved = ref.ea_saved;
 	    fsa_saved = ref.fsa_saved;
 	    small_read = ref.small_read;
-	    copy_ptr(ref.ea_offset, ea_offset);
+	    ea_offset = ref.ea_offset;
+	    has_ea_offset = ref.has_ea_offset;
 	    copy_ptr(ref.ea, ea);
-	    copy_ptr(ref.ea_size, ea_size);
+	    ea_size = ref.ea_size;
+	    has_ea_size = ref.has_ea_size;
 	    if(ref.ea_crc != nullptr)
 	    {
 		ea_crc = (ref.ea_crc)->clone();
@@ -1409,10 +1327,13 @@ namespace libdar
 	    }
 	    else
 		ea_crc = nullptr;
-	    copy_ptr(ref.fsa_families, fsa_families);
-	    copy_ptr(ref.fsa_offset, fsa_offset);
+	    fsa_families = ref.fsa_families;
+	    has_fsa_families = ref.has_fsa_families;
+	    fsa_offset = ref.fsa_offset;
+	    has_fsa_offset = ref.has_fsa_offset;
 	    copy_ptr(ref.fsal, fsal);
-	    copy_ptr(ref.fsa_size, fsa_size);
+	    fsa_size = ref.fsa_size;
+	    has_fsa_size = ref.has_fsa_size;
 	    if(ref.fsa_crc != nullptr)
 	    {
 		fsa_crc = (ref.fsa_crc)->clone();
@@ -1421,7 +1342,8 @@ namespace libdar
 	    }
 	    else
 		fsa_crc = nullptr;
-	    copy_ptr(ref.fs_dev, fs_dev);
+	    fs_dev = ref.fs_dev;
+	    has_fs_dev = ref.has_fs_dev;
 	    edit = ref.edit;
 	}
 	catch(...)
@@ -1442,16 +1364,22 @@ namespace libdar
 	ea_saved = move(ref.ea_saved);
 	fsa_saved = move(ref.fsa_saved);
 	small_read = move(ref.small_read);
-	swap(ref.ea_offset, ea_offset);
+	ea_offset = move(ref.ea_offset);
+	has_ea_offset = ref.has_ea_offset;
 	swap(ref.ea, ea);
-	swap(ref.ea_size, ea_size);
+	ea_size = move(ref.ea_size);
+	has_ea_size = ref.has_ea_size;
 	swap(ref.ea_crc, ea_crc);
-	swap(ref.fsa_families, fsa_families);
-	swap(ref.fsa_offset, fsa_offset);
+	fsa_families = move(ref.fsa_families);
+	has_fsa_families = ref.has_fsa_families;
+	fsa_offset = move(ref.fsa_offset);
+	has_fsa_offset = ref.has_fsa_offset;
 	swap(ref.fsal, fsal);
-	swap(ref.fsa_size, fsa_size);
+	fsa_size = move(ref.fsa_size);
+	has_fsa_size = ref.has_fsa_size;
 	swap(ref.fsa_crc, fsa_crc);
-	swap(ref.fs_dev, fs_dev);
+	fs_dev = move(ref.fs_dev);
+	has_fs_dev = ref.has_fs_dev;
 	edit = move(ref.edit);
     }
 
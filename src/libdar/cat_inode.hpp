@@ -81,7 +81,7 @@ namespace libdar
         datetime get_last_modif() const { return last_mod; };
         void set_last_access(const datetime & x_time) { last_acc = x_time; };
         void set_last_modif(const datetime & x_time) { last_mod = x_time; };
-	infinint get_device() const { if(fs_dev == nullptr) throw SRC_BUG; return *fs_dev; };
+	infinint get_device() const { if(!has_fs_dev) throw SRC_BUG; return fs_dev; };
 
         bool same_as(const cat_inode & ref) const;
         bool is_more_recent_than(const cat_inode & ref, const infinint & hourshift) const;
@@ -147,7 +147,7 @@ namespace libdar
 	void fsa_set_saved_status(fsa_saved_status status);
 	fsa_saved_status fsa_get_saved_status() const { return fsa_saved; };
 	    /// gives the set of FSA family recorded for that inode
-	fsa_scope fsa_get_families() const { if(fsa_families == nullptr) throw SRC_BUG; return infinint_to_fsa_scope(*fsa_families); };
+	fsa_scope fsa_get_families() const { if(!has_fsa_families) throw SRC_BUG; return infinint_to_fsa_scope(fsa_families); };
 
 
 
@@ -184,21 +184,27 @@ namespace libdar
 	fsa_saved_status fsa_saved; ///< inode Filesystem Specific Attribute status
 
 	bool small_read;         ///< whether we the object has been built with sequential-reading
+	bool has_ea_offset;      ///< whether ea_offset is set
+	bool has_ea_size;        ///< whether ea_size is set (not set when reading old archive format)
+	bool has_fsa_families;   ///< whether fsa_families is set (not set in fsa_none mode)
+	bool has_fsa_offset;     ///< whether fsa_offset is set
+	bool has_fsa_size;       ///< whether fsa_size is set
+	bool has_fs_dev;         ///< whether fs_dev is set
 
             //  the following is used only if ea_saved == full
-        infinint *ea_offset;     ///< offset in archive where to find EA
+        infinint ea_offset;      ///< offset in archive where to find EA
         ea_attributs *ea;        ///< Extended Attributes read or to be written down
-	infinint *ea_size;       ///< storage size required by EA
+	infinint ea_size;        ///< storage size required by EA
             // the following is used if ea_saved == full or ea_saved == partial or
         crc *ea_crc;             ///< CRC computed on EA
 
-	infinint *fsa_families; ///< list of FSA families present for that inode (set to nullptr in fsa_none mode)
-	infinint *fsa_offset;    ///< offset in archive where to find FSA  # always allocated (to be reviewed)
+	infinint fsa_families;   ///< list of FSA families present for that inode
+	infinint fsa_offset;     ///< offset in archive where to find FSA
 	filesystem_specific_attribute_list *fsal; ///< Filesystem Specific Attributes read or to be written down # only allocated if fsa_saved if set to FULL
-	infinint *fsa_size;      ///< storage size required for FSA
+	infinint fsa_size;       ///< storage size required for FSA
 	crc *fsa_crc;            ///< CRC computed on FSA
 	    //
-	infinint *fs_dev;        ///< filesystem ID on which resides the inode (only used when read from filesystem)
+	infinint fs_dev;         ///< filesystem ID on which resides the inode (only used when read from filesystem)
 	archive_version edit;    ///< need to know EA and FSA format used in archive file
 
 
@@ -60,6 +60,7 @@ extern "C"
 #include <typeinfo>
 #include <algorithm>
 #include <map>
+#include <memory>
 #include "catalogue.hpp"
 #include "tools.hpp"
 #include "tronc.hpp"
@@ -97,6 +98,7 @@ namespace libdar
 	    current_read = contenu;
 	    sub_tree = nullptr;
 	    ref_data_name = data_name;
+	    subtree_dropped = 0;
 	}
 	catch(...)
 	{
@@ -114,9 +116,12 @@ namespace libdar
 			 compression default_algo,
 			 bool lax,
 			 const label & lax_layer1_data_name,
-			 bool only_detruit): mem_ui(ui), out_compare("/")
+			 bool only_detruit,
+			 const mask *subtree,
+			 const path & subtree_root): mem_ui(ui), out_compare("/")
     {
 	string tmp;
+	unique_ptr<cat_subtree> restriction;
 	saved_status st;
 	unsigned char base;
 	map <infinint, cat_etoile *> corres;
@@ -125,6 +130,14 @@ namespace libdar
 	contenu = nullptr;
 
 	pdesc.check(false);
+	subtree_dropped = 0;
+	if(subtree != nullptr)
+	{
+	    subtree_root.explode_undisclosed();
+	    restriction.reset(new (nothrow) cat_subtree(*subtree, subtree_root));
+	    if(!restriction)
+		throw Ememory("catalogue::catalogue");
+	}
 
 	try
 	{
@@ -167,11 +180,13 @@ namespace libdar
 		smart_pointer<pile_descriptor> spdesc(new (nothrow) pile_descriptor(pdesc));
 		if(spdesc.is_null())
 		    throw Ememory("catalogue::catalogue");
-		contenu = new (nothrow) cat_directory(ui, spdesc, reading_ver, st, stats, corres, default_algo, lax, only_detruit, false);
+		contenu = new (nothrow) cat_directory(ui, spdesc, reading_ver, st, stats, corres, default_algo, lax, only_detruit, false, restriction.get(), true);
 		if(contenu == nullptr)
 		    throw Ememory("catalogue::catalogue(path)");
 		if(only_detruit)
 		    contenu->remove_all_mirages_and_reduce_dirs();
+		if(restriction)
+		    subtree_dropped = restriction->dropped;
 		current_compare = contenu;
 		current_add = contenu;
 		current_read = contenu;
@@ -1351,6 +1366,7 @@ namespace libdar
 	entree_stats tmp_st = stats;
 	stats = ref.stats;
 	ref.stats = tmp_st;
+	swap(subtree_dropped, ref.subtree_dropped);
 
 	    // swapping label
 	label tmp_lab;
@@ -1388,6 +1404,7 @@ namespace libdar
 		sub_tree = nullptr;
 	    sub_count = ref.sub_count;
 	    stats = ref.stats;
+	    subtree_dropped = ref.subtree_dropped;
 	    ref_data_name = ref.ref_data_name;
 	}
 	catch(...)
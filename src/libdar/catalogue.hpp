@@ -69,7 +69,9 @@ namespace libdar
 		  compression default_algo,
 		  bool lax,
 		  const label & lax_layer1_data_name, // ignored unless in lax mode, in lax mode unless it is a cleared label, forces the catalogue label to be equal to the lax_layer1_data_name for it be considered a plain internal catalogue, even in case of corruption
-		  bool only_detruit = false); // if set to true, only directories and detruit objects are read from the archive
+		  bool only_detruit = false, // if set to true, only directories and detruit objects are read from the archive
+		  const mask *subtree = nullptr, // if not nullptr, only the entries covered by this mask are kept in memory (see cat_directory)
+		  const path & subtree_root = FAKE_ROOT); // path the entries paths are relative to when checked against subtree
         catalogue(const catalogue & ref) : mem_ui(ref), out_compare(ref.out_compare) { partial_copy_from(ref); };
 	catalogue(catalogue && ref) = delete;
         catalogue & operator = (const catalogue &ref);
@@ -191,6 +193,12 @@ namespace libdar
 
         entree_stats get_stats() const { return stats; };
 
+	    /// number of entries not kept in memory when reading the catalogue, out of the subtree given to the constructor
+
+	    /// \note the entries of a directory not covered by the subtree are not counted, only the directory
+	    /// itself is, the same way the filtre_* routines account for ignored entries
+	const infinint & get_subtree_dropped() const { return subtree_dropped; };
+
 	    /// whether the catalogue is empty or not
 	bool is_empty() const { if(contenu == nullptr) throw SRC_BUG; return contenu->is_empty(); };
 
@@ -258,6 +266,7 @@ namespace libdar
         path *sub_tree;                           ///< path to sub_tree
         mutable signed int sub_count;             ///< count the depth in of read routine in the sub_tree
         entree_stats stats;                       ///< statistics catalogue contents
+	infinint subtree_dropped;                 ///< number of entries dropped at reading time (see get_subtree_dropped())
 	label ref_data_name;                      ///< name of the archive where is located the data
 
         void partial_copy_from(const catalogue &ref);
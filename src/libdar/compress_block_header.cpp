@@ -0,0 +1,44 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include "compress_block_header.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+    void compress_block_header::dump(generic_file & f) const
+    {
+	f.write(&type, 1);
+	size.dump(f);
+    }
+
+    void compress_block_header::set_from(generic_file & f)
+    {
+	if(f.read(&type, 1) != 1)
+	    throw Erange("compress_block_header::set_from", gettext("compressed data corruption detected: missing block header"));
+	size.read(f);
+    }
+
+} // end of namespace
@@ -0,0 +1,66 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+    /// \file compress_block_header.hpp
+    /// \brief block header used for compression per block
+    /// \ingroup Private
+
+#ifndef COMPRESS_BLOCK_HEADER_HPP
+#define COMPRESS_BLOCK_HEADER_HPP
+
+#include "../my_config.h"
+
+#include "infinint.hpp"
+#include "generic_file.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+	/// block header used for compression per block
+
+	/// each block of compressed data is preceeded by such header
+	/// which gives the type of the block and the size of the data that follows.
+	/// This framing is used by the lzo stream compression and by the
+	/// block compression mode, where each block is compressed independently
+	/// of the others
+
+    struct compress_block_header
+    {
+	static constexpr char H_LZO = 1;    ///< lzo compressed block (lzo stream compression)
+	static constexpr char H_EOF = 2;    ///< end of compressed data, no data follows (size is zero)
+	static constexpr char H_DATA = 3;   ///< independently compressed block (block compression mode)
+	static constexpr char H_STORED = 4; ///< block stored uncompressed as compression would not reduce its size (block compression mode)
+
+	char type;             ///< let the possibility to extend this architecture
+	infinint size;         ///< size of the following block of data
+
+	void dump(generic_file & f) const;
+	void set_from(generic_file & f);
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
@@ -0,0 +1,577 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if LIBLZO2_AVAILABLE
+#if HAVE_LZO_LZO1X_H
+#include <lzo/lzo1x.h>
+#endif
+#endif
+
+#if HAVE_LZMA_H && LIBLZMA_AVAILABLE
+#include <lzma.h>
+#endif
+
+#if HAVE_ZSTD_H && LIBZSTD_AVAILABLE
+#include <zstd.h>
+#include <zstd_errors.h>
+#endif
+
+#if HAVE_LZ4_H && LIBLZ4_AVAILABLE
+#include <lz4.h>
+#endif
+} // end extern "C"
+
+#include "compress_module.hpp"
+#include "erreurs.hpp"
+#include "tools.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+    compress_module::compress_module(compression x_algo, U_I compression_level)
+    {
+	algo = x_algo;
+	level = compression_level;
+	zip = unzip = nullptr;
+	lzo_wrkmem = nullptr;
+	lz4_state = nullptr;
+#if HAVE_ZSTD_H && LIBZSTD_AVAILABLE
+	zstd_comp = nullptr;
+	zstd_decomp = nullptr;
+#endif
+
+	if(compression_level > compression_max_level(algo))
+	    throw SRC_BUG;
+
+	switch(algo)
+	{
+	case compression::none:
+	    throw SRC_BUG; // no block compression without compression
+	case compression::gzip:
+#if LIBZ_AVAILABLE
+	    break;
+#else
+	    throw Ecompilation(gettext("gzip compression (libz)"));
+#endif
+	case compression::bzip2:
+#if LIBBZ2_AVAILABLE
+	    break;
+#else
+	    throw Ecompilation(gettext("bzip2 compression (libbzip2)"));
+#endif
+	case compression::xz:
+#if LIBLZMA_AVAILABLE
+	    break;
+#else
+	    throw Ecompilation(gettext("xz compression (liblzma)"));
+#endif
+	case compression::lzo:
+	case compression::lzo1x_1_15:
+	case compression::lzo1x_1:
+#if LIBLZO2_AVAILABLE
+	    break;
+#else
+	    throw Ecompilation(gettext("lzo compression support (liblzo2)"));
+#endif
+	case compression::zstd:
+	case compression::zstd_long:
+#if HAVE_ZSTD_H && LIBZSTD_AVAILABLE
+	    break;
+#else
+	    throw Ecompilation(gettext("zstd compression support (libzstd)"));
+#endif
+	case compression::lz4:
+#if HAVE_LZ4_H && LIBLZ4_AVAILABLE
+	    break;
+#else
+	    throw Ecompilation(gettext("lz4 compression support (liblz4)"));
+#endif
+	default:
+	    throw SRC_BUG;
+	}
+    }
+
+    compress_module::~compress_module()
+    {
+	if(zip != nullptr)
+	{
+	    zip->compressEnd();
+	    delete zip;
+	}
+	if(unzip != nullptr)
+	{
+	    unzip->decompressEnd();
+	    delete unzip;
+	}
+	if(lzo_wrkmem != nullptr)
+	    delete [] lzo_wrkmem;
+	if(lz4_state != nullptr)
+	    delete [] lz4_state;
+#if HAVE_ZSTD_H && LIBZSTD_AVAILABLE
+	if(zstd_comp != nullptr)
+	    ZSTD_freeCCtx(zstd_comp);
+	if(zstd_decomp != nullptr)
+	    ZSTD_freeDCtx(zstd_decomp);
+#endif
+    }
+
+    U_I compress_module::get_max_compressing_size(U_I clear_size)
+    {
+	    // this is the worse case of lzo (see LZO's FAQ) which is
+	    // the only algorithm that does not check the available room
+	    // in the output buffer. For the other algorithms, the
+	    // compressed data must be smaller than clear_size to be kept.
+	return clear_size + clear_size/16 + 64 + 3;
+    }
+
+    U_I compress_module::compress_data(const char *normal, U_I normal_size, char *zip_buf, U_I zip_buf_size)
+    {
+	if(normal == nullptr || zip_buf == nullptr)
+	    throw SRC_BUG;
+
+	if(normal_size == 0)
+	    return 0;
+
+	switch(algo)
+	{
+	case compression::gzip:
+	case compression::bzip2:
+	    return wrap_compress(normal, normal_size, zip_buf, zip_buf_size);
+	case compression::xz:
+	    return xz_compress(normal, normal_size, zip_buf, zip_buf_size);
+	case compression::lzo:
+	case compression::lzo1x_1_15:
+	case compression::lzo1x_1:
+	    return lzo_compress(normal, normal_size, zip_buf, zip_buf_size);
+	case compression::zstd:
+	case compression::zstd_long:
+	    return zstd_compress(normal, normal_size, zip_buf, zip_buf_size);
+	case compression::lz4:
+	    return lz4_compress(normal, normal_size, zip_buf, zip_buf_size);
+	default:
+	    throw SRC_BUG;
+	}
+    }
+
+    U_I compress_module::uncompress_data(const char *zip_buf, U_I zip_buf_size, char *normal, U_I normal_size)
+    {
+	if(normal == nullptr || zip_buf == nullptr)
+	    throw SRC_BUG;
+
+	switch(algo)
+	{
+	case compression::gzip:
+	case compression::bzip2:
+	    return wrap_uncompress(zip_buf, zip_buf_size, normal, normal_size);
+	case compression::xz:
+	    return xz_uncompress(zip_buf, zip_buf_size, normal, normal_size);
+	case compression::lzo:
+	case compression::lzo1x_1_15:
+	case compression::lzo1x_1:
+	    return lzo_uncompress(zip_buf, zip_buf_size, normal, normal_size);
+	case compression::zstd:
+	case compression::zstd_long:
+	    return zstd_uncompress(zip_buf, zip_buf_size, normal, normal_size);
+	case compression::lz4:
+	    return lz4_uncompress(zip_buf, zip_buf_size, normal, normal_size);
+	default:
+	    throw SRC_BUG;
+	}
+    }
+
+    U_I compress_module::wrap_compress(const char *normal, U_I normal_size, char *zip_buf, U_I zip_buf_size)
+    {
+	U_I room = zip_buf_size < normal_size ? zip_buf_size : normal_size;
+	U_I ret;
+	S_I status;
+
+	if(zip == nullptr)
+	{
+	    zip = new (nothrow) wrapperlib(algo == compression::gzip ? zlib_mode : bzlib_mode);
+	    if(zip == nullptr)
+		throw Ememory("compress_module::wrap_compress");
+	    switch(zip->compressInit(level))
+	    {
+	    case WR_OK:
+		break;
+	    case WR_MEM_ERROR:
+		delete zip;
+		zip = nullptr;
+		throw Ememory("compress_module::wrap_compress");
+	    case WR_VERSION_ERROR:
+		delete zip;
+		zip = nullptr;
+		throw Erange("compress_module::wrap_compress", gettext("incompatible compression library version or unsupported feature required from compression library"));
+	    default:
+		delete zip;
+		zip = nullptr;
+		throw SRC_BUG;
+	    }
+	}
+
+	zip->set_next_in(normal);
+	zip->set_avail_in(normal_size);
+	zip->set_next_out(zip_buf);
+	zip->set_avail_out(room);
+
+	do
+	{
+	    status = zip->compress(WR_FINISH);
+	}
+	while(status == WR_OK && zip->get_avail_out() > 0);
+
+	switch(status)
+	{
+	case WR_STREAM_END:
+	    ret = zip->get_next_out() - zip_buf;
+	    break;
+	case WR_OK:
+	case WR_BUF_ERROR:
+	    ret = 0; // not enough room, compressed data would be larger than clear data
+	    break;
+	default:
+	    throw SRC_BUG;
+	}
+
+	if(zip->compressReset() != WR_OK)
+	    throw SRC_BUG;
+
+	return ret;
+    }
+
+    U_I compress_module::wrap_uncompress(const char *zip_buf, U_I zip_buf_size, char *normal, U_I normal_size)
+    {
+	U_I ret;
+	S_I status;
+
+	if(unzip == nullptr)
+	{
+	    unzip = new (nothrow) wrapperlib(algo == compression::gzip ? zlib_mode : bzlib_mode);
+	    if(unzip == nullptr)
+		throw Ememory("compress_module::wrap_uncompress");
+	    switch(unzip->decompressInit())
+	    {
+	    case WR_OK:
+		break;
+	    case WR_MEM_ERROR:
+		delete unzip;
+		unzip = nullptr;
+		throw Ememory("compress_module::wrap_uncompress");
+	    case WR_VERSION_ERROR:
+		delete unzip;
+		unzip = nullptr;
+		throw Erange("compress_module::wrap_uncompress", gettext("incompatible compression library version or unsupported feature required from compression library"));
+	    default:
+		delete unzip;
+		unzip = nullptr;
+		throw SRC_BUG;
+	    }
+	}
+
+	unzip->set_next_in(zip_buf);
+	unzip->set_avail_in(zip_buf_size);
+	unzip->set_next_out(normal);
+	unzip->set_avail_out(normal_size);
+
+	do
+	{
+	    status = unzip->decompress(WR_FINISH);
+	}
+	while(status == WR_OK && unzip->get_avail_out() > 0 && unzip->get_avail_in() > 0);
+
+	ret = unzip->get_next_out() - normal;
+
+	if(unzip->decompressReset() != WR_OK)
+	    throw SRC_BUG;
+
+	switch(status)
+	{
+	case WR_STREAM_END:
+	    break;
+	case WR_MEM_ERROR:
+	    throw Ememory("compress_module::wrap_uncompress");
+	default:
+	    throw Erange("compress_module::wrap_uncompress", gettext("compressed data corruption detected"));
+	}
+
+	return ret;
+    }
+
+    U_I compress_module::xz_compress(const char *normal, U_I normal_size, char *zip_buf, U_I zip_buf_size)
+    {
+#if LIBLZMA_AVAILABLE
+	lzma_options_lzma opt;
+	lzma_filter filters[2];
+	size_t out_pos = 0;
+	U_I room = zip_buf_size < normal_size ? zip_buf_size : normal_size;
+
+	if(lzma_lzma_preset(&opt, level))
+	    throw SRC_BUG;
+
+	    // a dictionary larger than the block to compress brings nothing but
+	    // consumes memory (up to 674 MiB per thread at level 9), we reduce it:
+	if(opt.dict_size > normal_size)
+	    opt.dict_size = normal_size < LZMA_DICT_SIZE_MIN ? LZMA_DICT_SIZE_MIN : normal_size;
+
+	filters[0].id = LZMA_FILTER_LZMA2;
+	filters[0].options = &opt;
+	filters[1].id = LZMA_VLI_UNKNOWN;
+	filters[1].options = nullptr;
+
+	switch(lzma_stream_buffer_encode(filters,
+					 LZMA_CHECK_CRC32,
+					 nullptr,
+					 (const uint8_t *)normal,
+					 normal_size,
+					 (uint8_t *)zip_buf,
+					 &out_pos,
+					 room))
+	{
+	case LZMA_OK:
+	    return out_pos;
+	case LZMA_BUF_ERROR:
+	    return 0; // not enough room, compressed data would be larger than clear data
+	case LZMA_MEM_ERROR:
+	    throw Ememory("compress_module::xz_compress");
+	default:
+	    throw SRC_BUG;
+	}
+#else
+	throw Efeature(gettext("xz compression"));
+#endif
+    }
+
+    U_I compress_module::xz_uncompress(const char *zip_buf, U_I zip_buf_size, char *normal, U_I normal_size)
+    {
+#if LIBLZMA_AVAILABLE
+	uint64_t memlimit = UINT64_MAX;
+	size_t in_pos = 0;
+	size_t out_pos = 0;
+
+	switch(lzma_stream_buffer_decode(&memlimit,
+					 0,
+					 nullptr,
+					 (const uint8_t *)zip_buf,
+					 &in_pos,
+					 zip_buf_size,
+					 (uint8_t *)normal,
+					 &out_pos,
+					 normal_size))
+	{
+	case LZMA_OK:
+	    return out_pos;
+	case LZMA_MEM_ERROR:
+	    throw Ememory("compress_module::xz_uncompress");
+	default:
+	    throw Erange("compress_module::xz_uncompress", gettext("compressed data corruption detected"));
+	}
+#else
+	throw Efeature(gettext("xz compression"));
+#endif
+    }
+
+    U_I compress_module::lzo_compress(const char *normal, U_I normal_size, char *zip_buf, U_I zip_buf_size)
+    {
+#if LIBLZO2_AVAILABLE
+	lzo_uint compr_size = zip_buf_size;
+	S_I status;
+
+	if(zip_buf_size < get_max_compressing_size(normal_size))
+	    throw SRC_BUG;
+
+	if(lzo_wrkmem == nullptr)
+	{
+	    switch(algo)
+	    {
+	    case compression::lzo:
+		lzo_wrkmem = new (nothrow) char[LZO1X_999_MEM_COMPRESS];
+		break;
+	    case compression::lzo1x_1_15:
+		lzo_wrkmem = new (nothrow) char[LZO1X_1_15_MEM_COMPRESS];
+		break;
+	    case compression::lzo1x_1:
+		lzo_wrkmem = new (nothrow) char[LZO1X_1_MEM_COMPRESS];
+		break;
+	    default:
+		throw SRC_BUG;
+	    }
+	    if(lzo_wrkmem == nullptr)
+		throw Ememory("compress_module::lzo_compress");
+	}
+
+	switch(algo)
+	{
+	case compression::lzo:
+	    status = lzo1x_999_compress_level((lzo_bytep)normal, normal_size, (lzo_bytep)zip_buf, &compr_size, lzo_wrkmem, nullptr, 0, 0, level);
+	    break;
+	case compression::lzo1x_1_15:
+	    status = lzo1x_1_15_compress((lzo_bytep)normal, normal_size, (lzo_bytep)zip_buf, &compr_size, lzo_wrkmem);
+	    break;
+	case compression::lzo1x_1:
+	    status = lzo1x_1_compress((lzo_bytep)normal, normal_size, (lzo_bytep)zip_buf, &compr_size, lzo_wrkmem);
+	    break;
+	default:
+	    throw SRC_BUG;
+	}
+
+	if(status != LZO_E_OK)
+	    throw Erange("compress_module::lzo_compress", tools_printf(gettext("Probable bug in liblzo2: lzo1x_*_compress returned unexpected code %d"), status));
+
+	return compr_size < normal_size ? compr_size : 0;
+#else
+	throw Efeature(gettext("lzo compression"));
+#endif
+    }
+
+    U_I compress_module::lzo_uncompress(const char *zip_buf, U_I zip_buf_size, char *normal, U_I normal_size)
+    {
+#if LIBLZO2_AVAILABLE
+	lzo_uint read = normal_size;
+	S_I status;
+
+	status = lzo1x_decompress_safe((lzo_bytep)zip_buf, zip_buf_size, (lzo_bytep)normal, &read, nullptr);
+
+	switch(status)
+	{
+	case LZO_E_OK:
+	    return read;
+	case LZO_E_INPUT_NOT_CONSUMED:
+	    throw SRC_BUG;
+	default:
+	    throw Erange("compress_module::lzo_uncompress", gettext("compressed data corruption detected"));
+	}
+#else
+	throw Efeature(gettext("lzo compression"));
+#endif
+    }
+
+    U_I compress_module::zstd_compress(const char *normal, U_I normal_size, char *zip_buf, U_I zip_buf_size)
+    {
+#if HAVE_ZSTD_H && LIBZSTD_AVAILABLE
+	U_I room = zip_buf_size < normal_size ? zip_buf_size : normal_size;
+	size_t ret;
+
+	if(zstd_comp == nullptr)
+	{
+	    zstd_comp = ZSTD_createCCtx();
+	    if(zstd_comp == nullptr)
+		throw Ememory("compress_module::zstd_compress");
+	    if(ZSTD_isError(ZSTD_CCtx_setParameter(zstd_comp, ZSTD_c_compressionLevel, level)))
+		throw SRC_BUG;
+	    if(algo == compression::zstd_long)
+	    {
+		if(ZSTD_isError(ZSTD_CCtx_setParameter(zstd_comp, ZSTD_c_enableLongDistanceMatching, 1)))
+		    throw Erange("compress_module::zstd_compress", gettext("incompatible compression library version or unsupported feature required from compression library"));
+	    }
+	}
+
+	ret = ZSTD_compress2(zstd_comp, zip_buf, room, normal, normal_size);
+	if(ZSTD_isError(ret))
+	{
+	    if(ZSTD_getErrorCode(ret) == ZSTD_error_dstSize_tooSmall)
+		return 0; // not enough room, compressed data would be larger than clear data
+	    if(ZSTD_getErrorCode(ret) == ZSTD_error_memory_allocation)
+		throw Ememory("compress_module::zstd_compress");
+	    throw Erange("compress_module::zstd_compress", tools_printf(gettext("Probable bug in libzstd: ZSTD_compress2 failed: %s"), ZSTD_getErrorName(ret)));
+	}
+
+	return ret < normal_size ? ret : 0;
+#else
+	throw Efeature(gettext("zstd compression"));
+#endif
+    }
+
+    U_I compress_module::zstd_uncompress(const char *zip_buf, U_I zip_buf_size, char *normal, U_I normal_size)
+    {
+#if HAVE_ZSTD_H && LIBZSTD_AVAILABLE
+	size_t ret;
+
+	if(zstd_decomp == nullptr)
+	{
+	    zstd_decomp = ZSTD_createDCtx();
+	    if(zstd_decomp == nullptr)
+		throw Ememory("compress_module::zstd_uncompress");
+	}
+
+	ret = ZSTD_decompressDCtx(zstd_decomp, normal, normal_size, zip_buf, zip_buf_size);
+	if(ZSTD_isError(ret))
+	{
+	    if(ZSTD_getErrorCode(ret) == ZSTD_error_memory_allocation)
+		throw Ememory("compress_module::zstd_uncompress");
+	    throw Erange("compress_module::zstd_uncompress", gettext("compressed data corruption detected"));
+	}
+
+	return ret;
+#else
+	throw Efeature(gettext("zstd compression"));
+#endif
+    }
+
+    U_I compress_module::lz4_compress(const char *normal, U_I normal_size, char *zip_buf, U_I zip_buf_size)
+    {
+#if HAVE_LZ4_H && LIBLZ4_AVAILABLE
+	U_I room = zip_buf_size < normal_size ? zip_buf_size : normal_size;
+	S_I ret;
+
+	if(lz4_state == nullptr)
+	{
+		// memory returned by new[] is suitably aligned for the lz4 state
+	    lz4_state = new (nothrow) char[LZ4_sizeofState()];
+	    if(lz4_state == nullptr)
+		throw Ememory("compress_module::lz4_compress");
+	}
+
+	    // lz4 has no compression level but an acceleration factor,
+	    // level 9 (the default) gives acceleration 1, level 1 gives 9
+	ret = LZ4_compress_fast_extState(lz4_state,
+					 normal,
+					 zip_buf,
+					 normal_size,
+					 room,
+					 10 - (level < 1 ? 1 : level));
+
+	return ret > 0 ? (U_I)ret : 0; // zero means not enough room
+#else
+	throw Efeature(gettext("lz4 compression"));
+#endif
+    }
+
+    U_I compress_module::lz4_uncompress(const char *zip_buf, U_I zip_buf_size, char *normal, U_I normal_size)
+    {
+#if HAVE_LZ4_H && LIBLZ4_AVAILABLE
+	S_I ret = LZ4_decompress_safe(zip_buf, normal, zip_buf_size, normal_size);
+
+	if(ret < 0)
+	    throw Erange("compress_module::lz4_uncompress", gettext("compressed data corruption detected"));
+
+	return ret;
+#else
+	throw Efeature(gettext("lz4 compression"));
+#endif
+    }
+
+} // end of namespace
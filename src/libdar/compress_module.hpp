@@ -0,0 +1,114 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+    /// \file compress_module.hpp
+    /// \brief compression and decompression of independent blocks of data
+    /// \ingroup Private
+
+#ifndef COMPRESS_MODULE_HPP
+#define COMPRESS_MODULE_HPP
+
+#include "../my_config.h"
+
+#include "integers.hpp"
+#include "compression.hpp"
+#include "wrapperlib.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+	/// compress or uncompress a whole block of data at once
+
+	/// contrary to the compressor class which works on a stream of data,
+	/// each call to compress_data() produces an autonomous block of compressed
+	/// data that can be uncompressed without any information about the
+	/// previous or following blocks. Such object is not thread-safe but
+	/// several compress_module objects can be used concurrently by different
+	/// threads.
+
+    class compress_module
+    {
+    public:
+	compress_module(compression algo, U_I compression_level = 9);
+	compress_module(const compress_module & ref) = delete;
+	compress_module(compress_module && ref) noexcept = delete;
+	compress_module & operator = (const compress_module & ref) = delete;
+	compress_module & operator = (compress_module && ref) noexcept = delete;
+	~compress_module();
+
+	compression get_algo() const { return algo; };
+
+	    /// the size of the buffer to provide to compress_data() for a block of clear_size bytes
+	static U_I get_max_compressing_size(U_I clear_size);
+
+	    /// compress a block of data
+
+	    /// \param[in] normal the clear data to compress
+	    /// \param[in] normal_size amount of clear data to compress
+	    /// \param[out] zip_buf where to store the compressed data
+	    /// \param[in] zip_buf_size allocated size of zip_buf, it must be at least get_max_compressing_size(normal_size)
+	    /// \return the size of the compressed data, or zero if the compressed data would not have
+	    /// been smaller than the clear data, in which case the block should better be stored uncompressed
+	U_I compress_data(const char *normal, U_I normal_size, char *zip_buf, U_I zip_buf_size);
+
+	    /// uncompress a block of data
+
+	    /// \param[in] zip_buf the compressed data
+	    /// \param[in] zip_buf_size amount of compressed data
+	    /// \param[out] normal where to store the uncompressed data
+	    /// \param[in] normal_size allocated size of normal
+	    /// \return the amount of clear data produced in normal
+	    /// \note an Erange exception is thrown if the compressed data is corrupted
+	    /// or would uncompress to more than normal_size bytes
+	U_I uncompress_data(const char *zip_buf, U_I zip_buf_size, char *normal, U_I normal_size);
+
+    private:
+	compression algo;
+	U_I level;
+	wrapperlib *zip;    ///< compression engine for gzip and bzip2, created at first use
+	wrapperlib *unzip;  ///< decompression engine for gzip and bzip2, created at first use
+	char *lzo_wrkmem;   ///< work memory for lzo compression, allocated at first use
+	char *lz4_state;    ///< work memory for lz4 compression, allocated at first use
+#if HAVE_ZSTD_H && LIBZSTD_AVAILABLE
+	ZSTD_CCtx *zstd_comp;   ///< zstd compression context, created at first use
+	ZSTD_DCtx *zstd_decomp; ///< zstd decompression context, created at first use
+#endif
+
+	U_I wrap_compress(const char *normal, U_I normal_size, char *zip_buf, U_I zip_buf_size);
+	U_I wrap_uncompress(const char *zip_buf, U_I zip_buf_size, char *normal, U_I normal_size);
+	U_I xz_compress(const char *normal, U_I normal_size, char *zip_buf, U_I zip_buf_size);
+	U_I xz_uncompress(const char *zip_buf, U_I zip_buf_size, char *normal, U_I normal_size);
+	U_I lzo_compress(const char *normal, U_I normal_size, char *zip_buf, U_I zip_buf_size);
+	U_I lzo_uncompress(const char *zip_buf, U_I zip_buf_size, char *normal, U_I normal_size);
+	U_I zstd_compress(const char *normal, U_I normal_size, char *zip_buf, U_I zip_buf_size);
+	U_I zstd_uncompress(const char *zip_buf, U_I zip_buf_size, char *normal, U_I normal_size);
+	U_I lz4_compress(const char *normal, U_I normal_size, char *zip_buf, U_I zip_buf_size);
+	U_I lz4_uncompress(const char *zip_buf, U_I zip_buf_size, char *normal, U_I normal_size);
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
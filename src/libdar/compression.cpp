@@ -52,6 +52,12 @@ namespace libdar
 	    return compression::lzo;
 	case 'x':
 	    return compression::xz;
+	case 'd':
+	    return compression::zstd;
+	case 'w':
+	    return compression::zstd_long;
+	case 'q':
+	    return compression::lz4;
         default :
             throw Erange("char2compression", gettext("unknown compression"));
         }
@@ -75,6 +81,12 @@ namespace libdar
 	    return 'j';
 	case compression::lzo1x_1:
 	    return 'k';
+	case compression::zstd:
+	    return 'd';
+	case compression::zstd_long:
+	    return 'w';
+	case compression::lz4:
+	    return 'q';
         default:
             throw Erange("compression2char", gettext("unknown compression"));
         }
@@ -98,6 +110,12 @@ namespace libdar
 	    return "lzop-1";
 	case compression::lzo1x_1:
 	    return "lzop-3";
+	case compression::zstd:
+	    return "zstd";
+	case compression::zstd_long:
+	    return "zstd-long";
+	case compression::lz4:
+	    return "lz4";
         default:
             throw Erange("compresion2string", gettext("unknown compression"));
         }
@@ -123,10 +141,31 @@ namespace libdar
 	if(a == "xz" || a == "lzma")
 	    return compression::xz;
 
+	if(a == "zstd" || a == "zstandard")
+	    return compression::zstd;
+
+	if(a == "zstd-long" || a == "zstdlong")
+	    return compression::zstd_long;
+
+	if(a == "lz4")
+	    return compression::lz4;
+
 	if(a == "none")
 	    return compression::none;
 
 	throw Erange("string2compression", tools_printf(gettext("unknown compression algorithm: %S"), &a));
     }
 
+    U_I compression_max_level(compression c)
+    {
+	switch(c)
+	{
+	case compression::zstd:
+	case compression::zstd_long:
+	    return 22;
+	default:
+	    return 9;
+	}
+    }
+
 } // end of namespace
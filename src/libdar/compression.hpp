@@ -28,6 +28,7 @@
 
 #include "../my_config.h"
 #include <string>
+#include "integers.hpp"
 
 namespace libdar
 {
@@ -41,7 +42,8 @@ namespace libdar
 	/// \note lzo1x_1_15 and lzo1x_1 should never be found in archive but instead lzo should
 	/// be put in place. In consequence, the two letters 'j' and 'k' reserved here, shall
 	/// well be modified to other value if necessary in the future, thus would not break
-	/// any backward compatibility.
+	/// any backward compatibility. The same applies to zstd_long and its letter 'w' for which
+	/// zstd is stored in the archive.
     enum class compression
     {
 	none = 'n',  ///< no compression
@@ -50,7 +52,10 @@ namespace libdar
 	lzo = 'l',   ///< lzo compression
 	xz = 'x',     ///< lzma compression
 	lzo1x_1_15 = 'j', ///< lzo degraded algo corresponding to lzop -1
-	lzo1x_1 = 'k' ///< lzo degraded algo corresponding to lzo -2 to lzo -6
+	lzo1x_1 = 'k', ///< lzo degraded algo corresponding to lzo -2 to lzo -6
+	zstd = 'd',  ///< zstandard compression
+	zstd_long = 'w', ///< zstandard compression with long distance matching (large window)
+	lz4 = 'q'    ///< lz4 compression (always used in block compression mode)
     };
 
 
@@ -66,6 +71,9 @@ namespace libdar
 	/// convert a string representing a compression algorithm to its enum compression value
     extern compression string2compression(const std::string & a); // throw Erange if an unknown string is given
 
+	/// the highest compression level supported by the given algorithm (the lowest being 1)
+    extern U_I compression_max_level(compression c);
+
 	/// @}
 
 } // end of namespace
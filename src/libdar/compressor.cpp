@@ -62,6 +62,7 @@ extern "C"
 
 #include "tools.hpp"
 #include "compressor.hpp"
+#include "compress_block_header.hpp"
 
 #define BUFFER_SIZE 102400
 #ifdef SSIZE_MAX
@@ -87,43 +88,59 @@ extern "C"
 #error "System's SSIZE_MAX too small to handle LZO compression"
 #endif
 
-#define BLOCK_HEADER_LZO 1
-#define BLOCK_HEADER_EOF 2
-
 using namespace std;
 
 namespace libdar
 {
 
-    compressor::compressor(compression algo, generic_file & compressed_side, U_I compression_level) : generic_file(compressed_side.get_mode())
+    compressor::compressor(compression algo, generic_file & compressed_side, U_I compression_level, U_I block_size, U_I num_workers) : generic_file(compressed_side.get_mode())
     {
-        init(algo, &compressed_side, compression_level);
+        init(algo, &compressed_side, compression_level, block_size, num_workers);
         compressed_owner = false;
     }
 
-    compressor::compressor(compression algo, generic_file *compressed_side, U_I compression_level) : generic_file(compressed_side->get_mode())
+    compressor::compressor(compression algo, generic_file *compressed_side, U_I compression_level, U_I block_size, U_I num_workers) : generic_file(compressed_side->get_mode())
     {
-        init(algo, compressed_side, compression_level);
+        init(algo, compressed_side, compression_level, block_size, num_workers);
         compressed_owner = true;
     }
 
-    void compressor::init(compression algo, generic_file *compressed_side, U_I compression_level)
+    void compressor::init(compression algo, generic_file *compressed_side, U_I compression_level, U_I x_block_size, U_I x_num_workers)
     {
             // these are eventually overwritten below
         wrapperlib_mode wr_mode = zlib_mode;
         current_algo = algo;
 	suspended = false;
 	current_level = compression_level;
+	block_size = x_block_size;
+	num_workers = x_num_workers;
 
         if(compressed_side == nullptr)
             throw SRC_BUG;
-        if(compression_level > 9)
+	    // the level is kept unchanged while compression is suspended
+        if(algo != compression::none && compression_level > compression_max_level(algo))
             throw SRC_BUG;
 
         compr = decompr = nullptr;
 	lzo_read_buffer = lzo_write_buffer = nullptr;
 	lzo_compressed = nullptr;
 	lzo_wrkmem = nullptr;
+	blocks = nullptr;
+
+	if(algo == compression::lz4 && block_size == 0)
+	    block_size = block_compressor::default_block_size;
+	    // lz4 is only supported in block compression mode
+
+	if(block_size > 0 && algo != compression::none)
+	{
+	    blocks = new (nothrow) block_compressor(algo, compression_level, block_size, num_workers, *compressed_side);
+	    if(blocks == nullptr)
+		throw Ememory("compressor::init");
+	    read_ptr = &compressor::block_read;
+	    write_ptr = &compressor::block_write;
+	    compressed = compressed_side;
+	    return;
+	}
 
         switch(algo)
         {
@@ -133,10 +150,16 @@ namespace libdar
             break;
         case compression::bzip2:
 	case compression::xz:
+	case compression::zstd:
+	case compression::zstd_long:
 	    if(algo == compression::bzip2)
 		wr_mode = bzlib_mode;
 	    if(algo == compression::xz)
 		wr_mode = xz_mode;
+	    if(algo == compression::zstd)
+		wr_mode = zstd_mode;
+	    if(algo == compression::zstd_long)
+		wr_mode = zstd_long_mode;
 
                 // NO BREAK !
         case compression::gzip:
@@ -296,11 +319,27 @@ namespace libdar
 	    delete [] lzo_compressed;
 	if(lzo_wrkmem != nullptr)
 	    delete [] lzo_wrkmem;
+	if(blocks != nullptr)
+	    delete blocks;
 	if(compressed_owner)
 	    if(compressed != nullptr)
 		delete compressed;
     }
 
+    compression compressor::get_algo() const
+    {
+	switch(current_algo)
+	{
+	case compression::lzo1x_1_15:
+	case compression::lzo1x_1:
+	    return compression::lzo;
+	case compression::zstd_long:
+	    return compression::zstd;
+	default:
+	    return current_algo;
+	}
+    }
+
     void compressor::suspend_compression()
     {
 	if(!suspended)
@@ -393,6 +432,16 @@ namespace libdar
 	    delete [] lzo_wrkmem;
 	    lzo_wrkmem = nullptr;
 	}
+
+	if(blocks != nullptr)
+	{
+	    compr_flush_write();
+	    clean_write();
+	    compr_flush_read();
+	    clean_read();
+	    delete blocks;
+	    blocks = nullptr;
+	}
     }
 
     void compressor::change_algo(compression new_algo, U_I new_compression_level)
@@ -407,7 +456,7 @@ namespace libdar
         local_terminate();
 
             // change to new algorithm
-        init(new_algo, compressed, new_compression_level);
+        init(new_algo, compressed, new_compression_level, block_size, num_workers);
     }
 
     compressor::xfer::xfer(U_I sz, wrapperlib_mode mode) : wrap(mode)
@@ -644,16 +693,19 @@ namespace libdar
 
 	if(lzo_write_buffer != nullptr && ! lzo_write_flushed) // lzo
 	{
-	    lzo_block_header lzo_bh;
+	    compress_block_header lzo_bh;
 
 	    lzo_compress_buffer_and_write();
-	    lzo_bh.type = BLOCK_HEADER_EOF;
+	    lzo_bh.type = compress_block_header::H_EOF;
 	    lzo_bh.size = 0;
 	    if(compressed == nullptr)
 		throw SRC_BUG;
 	    lzo_bh.dump(*compressed);
 	    lzo_write_flushed = true;
 	}
+
+	if(blocks != nullptr)
+	    blocks->flush_write();
     }
 
     void compressor::compr_flush_read()
@@ -666,6 +718,8 @@ namespace libdar
                 throw SRC_BUG;
             // keep in the buffer the bytes already read, these are discarded in case of a call to skip
 	lzo_read_reached_eof = false;
+	if(blocks != nullptr)
+	    blocks->flush_read();
     }
 
     void compressor::clean_read()
@@ -681,6 +735,9 @@ namespace libdar
 	    lzo_read_start = 0;
 	    lzo_read_size = 0;
 	}
+
+	if(blocks != nullptr)
+	    blocks->clean_read();
     }
 
     void compressor::clean_write()
@@ -705,13 +762,16 @@ namespace libdar
 
 	if(lzo_write_buffer != nullptr) // lzo
 	    lzo_write_size = 0;
+
+	if(blocks != nullptr)
+	    blocks->clean_write();
     }
 
 
     void compressor::lzo_compress_buffer_and_write()
     {
 #if LIBLZO2_AVAILABLE
-	lzo_block_header lzo_bh;
+	compress_block_header lzo_bh;
 	lzo_uint compr_size = LZO_COMPRESSED_BUFFER_SIZE;
 	S_I status;
 
@@ -740,7 +800,7 @@ namespace libdar
 	}
 
 	    // writing down the TL(V) before the compressed data
-	lzo_bh.type = BLOCK_HEADER_LZO;
+	lzo_bh.type = compress_block_header::H_LZO;
 	lzo_bh.size = compr_size;
 	if(compressed == nullptr)
 	    throw SRC_BUG;
@@ -757,7 +817,7 @@ namespace libdar
     void compressor::lzo_read_and_uncompress_to_buffer()
     {
 #if LIBLZO2_AVAILABLE
-	lzo_block_header lzo_bh;
+	compress_block_header lzo_bh;
 	lzo_uint compr_size;
 	int status;
 #if LZO1X_MEM_DECOMPRESS > 0
@@ -770,9 +830,9 @@ namespace libdar
 	    throw SRC_BUG;
 
 	lzo_bh.set_from(*compressed);
-	if(lzo_bh.type != BLOCK_HEADER_LZO && lzo_bh.type != BLOCK_HEADER_EOF)
+	if(lzo_bh.type != compress_block_header::H_LZO && lzo_bh.type != compress_block_header::H_EOF)
 	    throw Erange("compressor::lzo_read_and_uncompress_to_buffer", gettext("data corruption detected: Incoherence in LZO compressed data"));
-	if(lzo_bh.type == BLOCK_HEADER_EOF)
+	if(lzo_bh.type == compress_block_header::H_EOF)
 	{
 	    if(lzo_bh.size != 0)
 		throw Erange("compressor::lzo_read_and_uncompress_to_buffer", gettext("compressed data corruption detected"));
@@ -819,16 +879,4 @@ namespace libdar
 #endif
     }
 
-    void compressor::lzo_block_header::dump(generic_file & f)
-    {
-	f.write(&type, 1);
-	size.dump(f);
-    }
-
-    void compressor::lzo_block_header::set_from(generic_file & f)
-    {
-	f.read(&type, 1);
-	size.read(f);
-    }
-
 } // end of namespace
@@ -33,6 +33,7 @@
 #include "integers.hpp"
 #include "wrapperlib.hpp"
 #include "compression.hpp"
+#include "block_compressor.hpp"
 
 namespace libdar
 {
@@ -41,17 +42,21 @@ namespace libdar
 	/// \addtogroup Private
 	/// @{
 
-	/// compression class for gzip and bzip2 algorithms
+	/// compression class for gzip, bzip2, lzo, xz, zstd and lz4 algorithms
     class compressor : public generic_file
     {
     public :
-        compressor(compression algo, generic_file & compressed_side, U_I compression_level = 9);
+        compressor(compression algo, generic_file & compressed_side, U_I compression_level = 9, U_I block_size = 0, U_I num_workers = 1);
             // compressed_side is not owned by the object and will remains
             // after the objet destruction
 
-        compressor(compression algo, generic_file *compressed_side, U_I compression_level = 9);
+        compressor(compression algo, generic_file *compressed_side, U_I compression_level = 9, U_I block_size = 0, U_I num_workers = 1);
             // compressed_side is owned by the object and will be
             // deleted a destructor time
+	    //
+	    // when block_size is not zero, data is compressed per block of block_size
+	    // bytes, each block being compressed independently of the others, possibly
+	    // by different threads (num_workers) in parallel, see block_compressor class
 
 	compressor(const compressor & ref) = delete;
 	compressor(compressor && ref) = delete;
@@ -59,12 +64,15 @@ namespace libdar
 	compressor & operator = (compressor && ref) = delete;
         ~compressor();
 
-        compression get_algo() const { return (current_algo == compression::lzo1x_1_15 || current_algo == compression::lzo1x_1) ? compression::lzo : current_algo; };
+        compression get_algo() const;
 
 	void suspend_compression();
 	void resume_compression();
 	bool is_compression_suspended() const { return suspended; };
 
+	    /// the size of the compression blocks, zero when compressing as a single stream
+	U_I get_block_size() const { return block_size; };
+
 
             // inherited from generic file
 	virtual bool skippable(skippability direction, const infinint & amount) override { return compressed->skippable(direction, amount); };
@@ -76,6 +84,8 @@ namespace libdar
     protected :
 	virtual void inherited_read_ahead(const infinint & amount) override { compressed->read_ahead(amount); };
         virtual U_I inherited_read(char *a, U_I size) override { return (this->*read_ptr)(a, size); };
+	virtual bool inherited_read_lend(const char * & ptr, U_I & size) override { return read_ptr == &compressor::none_read && compressed->read_lend(ptr, size); };
+	virtual bool inherited_lent_from(S_I & fd, infinint & offset) const override { return read_ptr == &compressor::none_read && compressed->lent_from(fd, offset); };
         virtual void inherited_write(const char *a, U_I size) override { (this->*write_ptr)(a, size); };
 	virtual void inherited_sync_write() override { compr_flush_write(); };
 	virtual void inherited_flush_read() override { compr_flush_read(); clean_read(); };
@@ -92,16 +102,6 @@ namespace libdar
             ~xfer();
         };
 
-	struct lzo_block_header
-	{
-	    char type;             ///< let the possibility to extend this architecture (for now type is fixed)
-	    infinint size;         ///< size of the following compressed block of data
-
-	    void dump(generic_file & f);
-	    void set_from(generic_file & f);
-	};
-
-
         xfer *compr, *decompr;     ///< datastructure for bzip2 an gzip compression
 
 	char *lzo_read_buffer;     ///< stores clear data (uncompressed) read from the compressed generic_file
@@ -114,6 +114,10 @@ namespace libdar
 	char *lzo_compressed;      ///< compressed data just read or about to be written
 	char *lzo_wrkmem;          ///< work memory for LZO library
 
+	block_compressor *blocks;  ///< compression engine in block compression mode
+	U_I block_size;            ///< size of compression blocks, zero for stream compression
+	U_I num_workers;           ///< number of threads used in block compression mode
+
         generic_file *compressed;
         bool compressed_owner;
         compression current_algo;
@@ -121,7 +125,7 @@ namespace libdar
 	compression suspended_compr;
 	U_I current_level;
 
-        void init(compression algo, generic_file *compressed_side, U_I compression_level);
+        void init(compression algo, generic_file *compressed_side, U_I compression_level, U_I x_block_size, U_I x_num_workers);
         void local_terminate();
         U_I (compressor::*read_ptr) (char *a, U_I size);
         U_I none_read(char *a, U_I size);
@@ -129,6 +133,7 @@ namespace libdar
             // U_I zip_read(char *a, U_I size);
             // U_I bzip2_read(char *a, U_I size); // using gzip_read, same code thanks to wrapperlib
 	U_I lzo_read(char *a, U_I size);
+	U_I block_read(char *a, U_I size) { return blocks->read(a, size); };
 
         void (compressor::*write_ptr) (const char *a, U_I size);
         void none_write(const char *a, U_I size);
@@ -136,6 +141,7 @@ namespace libdar
             // void zip_write(char *a, U_I size);
             // void bzip2_write(char *a, U_I size); // using gzip_write, same code thanks to wrapperlib
 	void lzo_write(const char *a, U_I size);
+	void block_write(const char *a, U_I size) { blocks->write(a, size); };
 
 	void lzo_compress_buffer_and_write();
 	void lzo_read_and_uncompress_to_buffer();
@@ -47,6 +47,10 @@ extern "C"
 
 } // end extern "C"
 
+#if HAVE_X86_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
 #include <iostream>
 #include <sstream>
 
@@ -56,11 +60,31 @@ using namespace std;
 
 #define INFININT_MODE_START 10240
 
+    /// largest span (in bytes) of the local accumulator used by the fold_* routines
+#define FOLD_MAX_SPAN 512
+
 namespace libdar
 {
 
     static void n_compute(const char *buffer, U_I length, unsigned char * begin, unsigned char * & pointer, unsigned char * end, U_I crc_size);
 
+	// the fold_* routines XOR the largest possible leading part of buffer into
+	// the crc field, assuming the crc pointer is at the beginning of the field.
+	// The processed amount is returned, it is a multiple of crc_size so the
+	// crc pointer stays at the beginning of the field. The result is
+	// identical to what B_compute_block or T_compute would provide.
+
+    using fold_routine = U_I (*)(const char *buffer, U_I length, unsigned char *crc, U_I crc_size);
+
+    static U_I fold_span(U_I crc_size, U_I width);
+    static void fold_acc_to_crc(const unsigned char *acc, U_I span, unsigned char *crc, U_I crc_size);
+    static U_I fold_u64(const char *buffer, U_I length, unsigned char *crc, U_I crc_size);
+#if HAVE_X86_SIMD_DISPATCH
+    static U_I fold_sse2(const char *buffer, U_I length, unsigned char *crc, U_I crc_size) __attribute__((target("sse2")));
+    static U_I fold_avx2(const char *buffer, U_I length, unsigned char *crc, U_I crc_size) __attribute__((target("avx2")));
+#endif
+    static fold_routine fold_select();
+
 	/////////////////////////////////////////////
 	// some TEMPLATES and static routines first
 	//
@@ -166,8 +190,13 @@ namespace libdar
 
 	if(pointer == begin && cursor < length) // we can now use the optimized rountine relying on operation by block of bytes
 	{
+	    static const fold_routine fold = fold_select(); // the best routine the CPU supports
 	    U_I partial_cursor = 0;
 
+	    cursor += fold(buffer + cursor, length - cursor, begin, crc_size);
+	    if(cursor >= length)
+		return;
+
 		// But we cannot use optimized method on some systems if we are not aligned to the size boundary
 	    if(crc_size % 8 == 0 && (U_I)(buffer + cursor) % 8 == 0)
 		B_compute_block(U_64(0), buffer + cursor, length - cursor, begin, pointer, end, partial_cursor);
@@ -186,6 +215,233 @@ namespace libdar
 	    T_compute(buffer + cursor, length - cursor, begin, pointer, end);
     }
 
+    static U_I fold_span(U_I crc_size, U_I width)
+    {
+	U_I a = crc_size;
+	U_I b = width;
+
+	if(crc_size % width == 0)
+	    return crc_size; // the crc field itself is used as accumulator
+
+	while(b != 0) // computing the greatest common divisor of crc_size and width
+	{
+	    U_I tmp = a % b;
+	    a = b;
+	    b = tmp;
+	}
+
+	a = (crc_size / a) * width; // least common multiple of crc_size and width
+
+	return a <= FOLD_MAX_SPAN ? a : 0;
+    }
+
+    static void fold_acc_to_crc(const unsigned char *acc, U_I span, unsigned char *crc, U_I crc_size)
+    {
+	U_I c = 0;
+
+	for(U_I i = 0; i < span; ++i)
+	{
+	    crc[c] ^= acc[i];
+	    if(++c == crc_size)
+		c = 0;
+	}
+    }
+
+    static U_I fold_u64(const char *buffer, U_I length, unsigned char *crc, U_I crc_size)
+    {
+	const U_I width = sizeof(U_64);
+	U_I span = fold_span(crc_size, width);
+	U_I done = 0;
+	U_64 acc[FOLD_MAX_SPAN / sizeof(U_64)];
+	unsigned char *acc_ptr = span == crc_size ? crc : (unsigned char *)acc;
+	U_64 tmp, val;
+
+	    // memcpy() is used for memory access as neither buffer nor acc_ptr is
+	    // necessarily aligned, the compiler reduces it to a single load or store
+
+	if(span == 0 || length < span)
+	    return 0;
+
+	if(acc_ptr != crc)
+	    (void)memset(acc, 0, span);
+
+	if(span == width)
+	{
+		// single word accumulator, kept in registers
+
+	    U_64 acc0, acc1 = 0;
+
+	    (void)memcpy(&acc0, acc_ptr, width);
+	    while(done + 2*width <= length)
+	    {
+		(void)memcpy(&val, buffer + done, width);
+		acc0 ^= val;
+		(void)memcpy(&tmp, buffer + done + width, width);
+		acc1 ^= tmp;
+		done += 2*width;
+	    }
+	    if(done + width <= length)
+	    {
+		(void)memcpy(&val, buffer + done, width);
+		acc0 ^= val;
+		done += width;
+	    }
+	    acc0 ^= acc1;
+	    (void)memcpy(acc_ptr, &acc0, width);
+	}
+	else
+	{
+	    while(done + span <= length)
+	    {
+		for(U_I i = 0; i < span; i += width)
+		{
+		    (void)memcpy(&tmp, acc_ptr + i, width);
+		    (void)memcpy(&val, buffer + done + i, width);
+		    tmp ^= val;
+		    (void)memcpy(acc_ptr + i, &tmp, width);
+		}
+		done += span;
+	    }
+	}
+
+	if(acc_ptr != crc)
+	    fold_acc_to_crc(acc_ptr, span, crc, crc_size);
+
+	return done;
+    }
+
+#if HAVE_X86_SIMD_DISPATCH
+
+    static U_I fold_sse2(const char *buffer, U_I length, unsigned char *crc, U_I crc_size)
+    {
+	const U_I width = sizeof(__m128i);
+	U_I span = fold_span(crc_size, width);
+	U_I done = 0;
+	__m128i acc[FOLD_MAX_SPAN / sizeof(__m128i)];
+	unsigned char *acc_ptr = span == crc_size ? crc : (unsigned char *)acc;
+
+	if(span == 0 || length < span)
+	    return 0;
+
+	if(acc_ptr != crc)
+	    (void)memset(acc, 0, span);
+
+	if(span == width)
+	{
+		// single vector accumulator, kept in registers
+
+	    __m128i acc0 = _mm_loadu_si128((const __m128i *)acc_ptr);
+	    __m128i acc1 = _mm_setzero_si128();
+	    __m128i acc2 = _mm_setzero_si128();
+	    __m128i acc3 = _mm_setzero_si128();
+
+	    while(done + 4*width <= length)
+	    {
+		acc0 = _mm_xor_si128(acc0, _mm_loadu_si128((const __m128i *)(buffer + done)));
+		acc1 = _mm_xor_si128(acc1, _mm_loadu_si128((const __m128i *)(buffer + done + width)));
+		acc2 = _mm_xor_si128(acc2, _mm_loadu_si128((const __m128i *)(buffer + done + 2*width)));
+		acc3 = _mm_xor_si128(acc3, _mm_loadu_si128((const __m128i *)(buffer + done + 3*width)));
+		done += 4*width;
+	    }
+	    while(done + width <= length)
+	    {
+		acc0 = _mm_xor_si128(acc0, _mm_loadu_si128((const __m128i *)(buffer + done)));
+		done += width;
+	    }
+	    acc0 = _mm_xor_si128(_mm_xor_si128(acc0, acc1), _mm_xor_si128(acc2, acc3));
+	    _mm_storeu_si128((__m128i *)acc_ptr, acc0);
+	}
+	else
+	{
+	    while(done + span <= length)
+	    {
+		for(U_I i = 0; i < span; i += width)
+		{
+		    __m128i *ptr = (__m128i *)(acc_ptr + i);
+		    _mm_storeu_si128(ptr, _mm_xor_si128(_mm_loadu_si128(ptr), _mm_loadu_si128((const __m128i *)(buffer + done + i))));
+		}
+		done += span;
+	    }
+	}
+
+	if(acc_ptr != crc)
+	    fold_acc_to_crc(acc_ptr, span, crc, crc_size);
+
+	return done;
+    }
+
+    static U_I fold_avx2(const char *buffer, U_I length, unsigned char *crc, U_I crc_size)
+    {
+	const U_I width = sizeof(__m256i);
+	U_I span = fold_span(crc_size, width);
+	U_I done = 0;
+	__m256i acc[FOLD_MAX_SPAN / sizeof(__m256i)];
+	unsigned char *acc_ptr = span == crc_size ? crc : (unsigned char *)acc;
+
+	if(span == 0 || length < span)
+	    return 0;
+
+	if(acc_ptr != crc)
+	    (void)memset(acc, 0, span);
+
+	if(span == width)
+	{
+		// single vector accumulator, kept in registers
+
+	    __m256i acc0 = _mm256_loadu_si256((const __m256i *)acc_ptr);
+	    __m256i acc1 = _mm256_setzero_si256();
+	    __m256i acc2 = _mm256_setzero_si256();
+	    __m256i acc3 = _mm256_setzero_si256();
+
+	    while(done + 4*width <= length)
+	    {
+		acc0 = _mm256_xor_si256(acc0, _mm256_loadu_si256((const __m256i *)(buffer + done)));
+		acc1 = _mm256_xor_si256(acc1, _mm256_loadu_si256((const __m256i *)(buffer + done + width)));
+		acc2 = _mm256_xor_si256(acc2, _mm256_loadu_si256((const __m256i *)(buffer + done + 2*width)));
+		acc3 = _mm256_xor_si256(acc3, _mm256_loadu_si256((const __m256i *)(buffer + done + 3*width)));
+		done += 4*width;
+	    }
+	    while(done + width <= length)
+	    {
+		acc0 = _mm256_xor_si256(acc0, _mm256_loadu_si256((const __m256i *)(buffer + done)));
+		done += width;
+	    }
+	    acc0 = _mm256_xor_si256(_mm256_xor_si256(acc0, acc1), _mm256_xor_si256(acc2, acc3));
+	    _mm256_storeu_si256((__m256i *)acc_ptr, acc0);
+	}
+	else
+	{
+	    while(done + span <= length)
+	    {
+		for(U_I i = 0; i < span; i += width)
+		{
+		    __m256i *ptr = (__m256i *)(acc_ptr + i);
+		    _mm256_storeu_si256(ptr, _mm256_xor_si256(_mm256_loadu_si256(ptr), _mm256_loadu_si256((const __m256i *)(buffer + done + i))));
+		}
+		done += span;
+	    }
+	}
+
+	if(acc_ptr != crc)
+	    fold_acc_to_crc(acc_ptr, span, crc, crc_size);
+
+	return done;
+    }
+
+#endif
+
+    static fold_routine fold_select()
+    {
+#if HAVE_X86_SIMD_DISPATCH
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx2"))
+	    return &fold_avx2;
+	if(__builtin_cpu_supports("sse2"))
+	    return &fold_sse2;
+#endif
+	return &fold_u64;
+    }
+
     template <class P> bool T_compare(P me_begin, P me_end, P you_begin, P you_end)
     {
 	P me = me_begin;
@@ -409,8 +665,11 @@ namespace libdar
 	    // the following trick is to have cyclic aligned at its boundary size
 	    // (its allocated address is a multiple of it size)
 	    // some CPU need that (sparc), and it does not hurt for other ones.
+	    // small_cyclic being a U_64 is aligned for any of these sizes
 
-	if(width % 8 == 0)
+	if(width <= sizeof(small_cyclic))
+	    cyclic = (unsigned char *)(&small_cyclic);
+	else if(width % 8 == 0)
 	    cyclic = (unsigned char *)(new (nothrow) U_64[width/8]);
 	else if(width % 4 == 0)
 	    cyclic = (unsigned char *)(new (nothrow) U_32[width/4]);
@@ -445,11 +704,31 @@ namespace libdar
 	pointer = cyclic;
     }
 
+    void crc_n::move_from(crc_n && ref) noexcept
+    {
+	U_I pos = ref.pointer - ref.cyclic;
+
+	size = ref.size;
+	if(ref.cyclic == (unsigned char *)(&ref.small_cyclic))
+	{
+	    small_cyclic = ref.small_cyclic;
+	    cyclic = (unsigned char *)(&small_cyclic);
+	}
+	else
+	{
+	    cyclic = ref.cyclic;
+	    ref.cyclic = nullptr;
+	}
+	pointer = cyclic + pos;
+	ref.destroy();
+    }
+
     void crc_n::destroy()
     {
 	if(cyclic != nullptr)
 	{
-	    delete [] cyclic;
+	    if(cyclic != (unsigned char *)(&small_cyclic))
+		delete [] cyclic;
 	    cyclic = nullptr;
 	}
 	size = 0;
@@ -118,9 +118,9 @@ namespace libdar
 	crc_n(U_I width);
 	crc_n(U_I width, proto_generic_file & f);
 	crc_n(const crc_n & ref) { copy_from(ref); };
-	crc_n(crc_n && ref) noexcept = default;
+	crc_n(crc_n && ref) noexcept { move_from(std::move(ref)); };
 	crc_n & operator = (const crc_n & ref);
-	crc_n & operator = (crc_n && ref) noexcept = default;
+	crc_n & operator = (crc_n && ref) noexcept { if(this != &ref) { destroy(); move_from(std::move(ref)); } return *this; };
 	~crc_n() { destroy(); };
 
 	bool operator == (const crc & ref) const override;
@@ -139,11 +139,13 @@ namespace libdar
 
 	U_I size;                                   ///< size of checksum (non infinint mode)
 	unsigned char *pointer;                     ///< points to the next byte to modify (non infinint mode)
-	unsigned char *cyclic;                      ///< the checksum storage (non infinint mode)
+	unsigned char *cyclic;                      ///< the checksum storage (non infinint mode), points to small_cyclic if it fits there
+	U_64 small_cyclic;                          ///< storage of checksums up to 8 bytes, the width of the CRC of files smaller than 2 GiB
 
 	void alloc(U_I width);
 	void copy_from(const crc_n & ref);
 	void copy_data_from(const crc_n & ref);
+	void move_from(crc_n && ref) noexcept;
 	void destroy();
     };
 
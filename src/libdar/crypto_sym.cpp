@@ -65,14 +65,11 @@ namespace libdar
 			   const std::string & salt,
 			   infinint iteration_count,
 			   hash_algo kdf_hash,
-			   bool use_pkcs5)
-	: tronconneuse(block_size, encrypted_side, no_initial_shift, reading_ver)
+			   bool use_pkcs5,
+			   U_I num_workers)
+	: tronconneuse(block_size, encrypted_side, no_initial_shift, reading_ver, num_workers)
     {
 #if CRYPTO_AVAILABLE
-	ivec = nullptr;
-	clef = nullptr;
-	essiv_clef = nullptr;
-
 	if(reading_ver <= 5)
 	    throw Erange("crypto_sym::blowfish", gettext("Current implementation of blowfish encryption is not compatible with old (weak) implementation, use dar-2.3.x software or later (or other software based on libdar-4.4.x or greater) to read this archive"));
 
@@ -98,11 +95,6 @@ namespace libdar
 	    if(algo_block_size == 0)
 		throw SRC_BUG;
 
-		// initializing ivec in secure memory
-	    ivec = (unsigned char *)gcry_malloc_secure(algo_block_size);
-	    if(ivec == nullptr)
-		throw Esecu_memory("crypto_sym::crypto_sym");
-
 	    try
 	    {
 		if(use_pkcs5)
@@ -118,23 +110,39 @@ namespace libdar
 		else
 		    hashed_password = password;
 
-		    // key handle initialization
+		    // the key derivation is done once, each worker gets its own handles
+
+		for(U_I i = 0; i < get_num_workers(); ++i)
+		{
+		    contexts.push_back(context());
+		    context & ctx = contexts.back();
+
+		    ctx.clef = nullptr;
+		    ctx.essiv_clef = nullptr;
+
+			// initializing ivec in secure memory
+		    ctx.ivec = (unsigned char *)gcry_malloc_secure(algo_block_size);
+		    if(ctx.ivec == nullptr)
+			throw Esecu_memory("crypto_sym::crypto_sym");
 
-		err = gcry_cipher_open(&clef, algo_id, GCRY_CIPHER_MODE_CBC, GCRY_CIPHER_SECURE);
-		if(err != GPG_ERR_NO_ERROR)
-		    throw Erange("crypto_sym::crypto_sym",tools_printf(gettext("Error while opening libgcrypt key handle: %s/%s"),
-								       gcry_strsource(err),
-								       gcry_strerror(err)));
+			// key handle initialization
 
-		    // assigning key to the handle
+		    err = gcry_cipher_open(&ctx.clef, algo_id, GCRY_CIPHER_MODE_CBC, GCRY_CIPHER_SECURE);
+		    if(err != GPG_ERR_NO_ERROR)
+			throw Erange("crypto_sym::crypto_sym",tools_printf(gettext("Error while opening libgcrypt key handle: %s/%s"),
+									   gcry_strsource(err),
+									   gcry_strerror(err)));
 
-		err = gcry_cipher_setkey(clef, (const void *)hashed_password.c_str(), hashed_password.get_size());
-		if(err != GPG_ERR_NO_ERROR)
-		    throw Erange("crypto_sym::crypto_sym",tools_printf(gettext("Error while assigning key to libgcrypt key handle: %s/%s"), gcry_strsource(err),gcry_strerror(err)));
+			// assigning key to the handle
 
-		    // essiv initialization
+		    err = gcry_cipher_setkey(ctx.clef, (const void *)hashed_password.c_str(), hashed_password.get_size());
+		    if(err != GPG_ERR_NO_ERROR)
+			throw Erange("crypto_sym::crypto_sym",tools_printf(gettext("Error while assigning key to libgcrypt key handle: %s/%s"), gcry_strsource(err),gcry_strerror(err)));
 
-		dar_set_essiv(hashed_password, essiv_clef, get_reading_version(), algo);
+			// essiv initialization
+
+		    dar_set_essiv(hashed_password, ctx.essiv_clef, get_reading_version(), algo);
+		}
 	    }
 	    catch(...)
 	    {
@@ -262,15 +270,19 @@ namespace libdar
     void crypto_sym::detruit()
     {
 #if CRYPTO_AVAILABLE
-	if(clef != nullptr)
-	    gcry_cipher_close(clef);
-	if(essiv_clef != nullptr)
-	    gcry_cipher_close(essiv_clef);
-	if(ivec != nullptr)
+	for(deque<context>::iterator it = contexts.begin(); it != contexts.end(); ++it)
 	{
-	    (void)memset(ivec, 0, algo_block_size);
-	    gcry_free(ivec);
+	    if(it->clef != nullptr)
+		gcry_cipher_close(it->clef);
+	    if(it->essiv_clef != nullptr)
+		gcry_cipher_close(it->essiv_clef);
+	    if(it->ivec != nullptr)
+	    {
+		(void)memset(it->ivec, 0, algo_block_size);
+		gcry_free(it->ivec);
+	    }
 	}
+	contexts.clear();
 #endif
     }
 
@@ -292,7 +304,24 @@ namespace libdar
 				  const char *clear_buf, const U_32 clear_size, const U_32 clear_allocated,
 				  char *crypt_buf, U_32 crypt_size)
     {
+	return encrypt_data_by(0, block_num, clear_buf, clear_size, clear_allocated, crypt_buf, crypt_size);
+    }
+
+    U_32 crypto_sym::decrypt_data(const infinint & block_num, const char *crypt_buf, const U_32 crypt_size, char *clear_buf, U_32 clear_size)
+    {
+	return decrypt_data_by(0, block_num, crypt_buf, crypt_size, clear_buf, clear_size);
+    }
+
+    U_32 crypto_sym::encrypt_data_by(U_I worker,
+				     const infinint & block_num,
+				     const char *clear_buf, const U_32 clear_size, const U_32 clear_allocated,
+				     char *crypt_buf, U_32 crypt_size)
+    {
 #if CRYPTO_AVAILABLE
+	if(worker >= contexts.size())
+	    throw SRC_BUG;
+
+	context & ctx = contexts[worker];
 	U_32 size_to_fill = encrypted_block_size_for(clear_size);
 
 	    // sanity checks
@@ -310,14 +339,14 @@ namespace libdar
 	    gcry_error_t err;
 
 	    stic.dump((unsigned char *)(const_cast<char *>(clear_buf + clear_size)), (U_32)(clear_allocated - clear_size));
-	    err = gcry_cipher_reset(clef);
+	    err = gcry_cipher_reset(ctx.clef);
 	    if(err != GPG_ERR_NO_ERROR)
 		throw Erange("crypto_sym::crypto_encrypt_data",tools_printf(gettext("Error while resetting encryption key for a new block: %s/%s"), gcry_strsource(err),gcry_strerror(err)));
-	    make_ivec(block_num, ivec, algo_block_size, essiv_clef);
-	    err = gcry_cipher_setiv(clef, (const void *)ivec, algo_block_size);
+	    make_ivec(block_num, ctx.ivec, algo_block_size, ctx.essiv_clef);
+	    err = gcry_cipher_setiv(ctx.clef, (const void *)ctx.ivec, algo_block_size);
 	    if(err != GPG_ERR_NO_ERROR)
 		throw Erange("crypto_sym::crypto_encrypt_data",tools_printf(gettext("Error while setting IV for current block: %s/%s"), gcry_strsource(err),gcry_strerror(err)));
-	    err = gcry_cipher_encrypt(clef, (unsigned char *)crypt_buf, size_to_fill, (const unsigned char *)clear_buf, size_to_fill);
+	    err = gcry_cipher_encrypt(ctx.clef, (unsigned char *)crypt_buf, size_to_fill, (const unsigned char *)clear_buf, size_to_fill);
 	    if(err != GPG_ERR_NO_ERROR)
 		throw Erange("crypto_sym::crypto_encrypt_data",tools_printf(gettext("Error while cyphering data: %s/%s"), gcry_strsource(err),gcry_strerror(err)));
 	    return size_to_fill;
@@ -329,19 +358,27 @@ namespace libdar
 #endif
     }
 
-    U_32 crypto_sym::decrypt_data(const infinint & block_num, const char *crypt_buf, const U_32 crypt_size, char *clear_buf, U_32 clear_size)
+    U_32 crypto_sym::decrypt_data_by(U_I worker,
+				     const infinint & block_num,
+				     const char *crypt_buf, const U_32 crypt_size,
+				     char *clear_buf, U_32 clear_size)
     {
 #if CRYPTO_AVAILABLE
 	gcry_error_t err;
 
+	if(worker >= contexts.size())
+	    throw SRC_BUG;
+
+	context & ctx = contexts[worker];
+
 	if(crypt_size == 0)
 	    return 0; // nothing to decipher
 
-	make_ivec(block_num, ivec, algo_block_size, essiv_clef);
-	err = gcry_cipher_setiv(clef, (const void *)ivec, algo_block_size);
+	make_ivec(block_num, ctx.ivec, algo_block_size, ctx.essiv_clef);
+	err = gcry_cipher_setiv(ctx.clef, (const void *)ctx.ivec, algo_block_size);
 	if(err != GPG_ERR_NO_ERROR)
 	    throw Erange("crypto_sym::crypto_encrypt_data",tools_printf(gettext("Error while setting IV for current block: %s/%s"), gcry_strsource(err),gcry_strerror(err)));
-	err = gcry_cipher_decrypt(clef, (unsigned char *)clear_buf, crypt_size, (const unsigned char *)crypt_buf, crypt_size);
+	err = gcry_cipher_decrypt(ctx.clef, (unsigned char *)clear_buf, crypt_size, (const unsigned char *)crypt_buf, crypt_size);
 	if(err != GPG_ERR_NO_ERROR)
 	    throw Erange("crypto_sym::crypto_encrypt_data",tools_printf(gettext("Error while decyphering data: %s/%s"), gcry_strsource(err),gcry_strerror(err)));
 	elastic stoc = elastic((unsigned char *)clear_buf, crypt_size, elastic_backward, get_reading_version());
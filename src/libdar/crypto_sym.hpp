@@ -38,6 +38,7 @@ extern "C"
 
 #include "../my_config.h"
 #include <string>
+#include <deque>
 
 #include "tronconneuse.hpp"
 #include "secu_string.hpp"
@@ -73,7 +74,8 @@ namespace libdar
 		   const std::string & salt, //< not used is use_pkcs5 below is not set
 		   infinint iteration_count, //< not used if use_pkcs5 is not set
 		   hash_algo kdf_hash,       //< not used if use_pkcs5 is not set
-		   bool use_pkcs5);     //< must be set to true when password is human defined to add a key derivation
+		   bool use_pkcs5,      //< must be set to true when password is human defined to add a key derivation
+		   U_I num_workers = 1); //< number of blocks to cipher/decipher concurrently
 	crypto_sym(const crypto_sym & ref) = delete;
 	crypto_sym(crypto_sym && ref) = delete;
 	crypto_sym & operator = (const crypto_sym & ref) = delete;
@@ -101,14 +103,28 @@ namespace libdar
 	virtual U_32 decrypt_data(const infinint & block_num,
 			  const char *crypt_buf, const U_32 crypt_size,
 			  char *clear_buf, U_32 clear_size) override;
+	virtual U_32 encrypt_data_by(U_I worker,
+				     const infinint & block_num,
+				     const char *clear_buf, const U_32 clear_size, const U_32 clear_allocated,
+				     char *crypt_buf, U_32 crypt_size) override;
+	virtual U_32 decrypt_data_by(U_I worker,
+				     const infinint & block_num,
+				     const char *crypt_buf, const U_32 crypt_size,
+				     char *clear_buf, U_32 clear_size) override;
 
     private:
 #if CRYPTO_AVAILABLE
-	gcry_cipher_hd_t clef;       ///< used to encrypt/decrypt the data
-	gcry_cipher_hd_t essiv_clef; ///< used to build the Initialization Vector
+	    /// ciphering context, one per worker as libgcrypt handles cannot be used concurrently
+	struct context
+	{
+	    gcry_cipher_hd_t clef;       ///< used to encrypt/decrypt the data
+	    gcry_cipher_hd_t essiv_clef; ///< used to build the Initialization Vector
+	    unsigned char *ivec;         ///< algo_block_size allocated in secure memory to be used as Initial Vector
+	};
+
+	std::deque<context> contexts;   ///< contexts indexed by worker number
 #endif
 	size_t algo_block_size;         ///< the block size of the algorithm (main key)
-	unsigned char *ivec;            ///< algo_block_size allocated in secure memory to be used as Initial Vector
 	U_I algo_id;                    ///< algo ID in libgcrypt
 
 	void detruit();
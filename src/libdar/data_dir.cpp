@@ -56,14 +56,14 @@ namespace libdar
 
     data_dir::data_dir(const string &name) : data_tree(name)
     {
-	rejetons.clear();
+	clear_children();
     }
 
     data_dir::data_dir(generic_file &f, unsigned char db_version) : data_tree(f, db_version)
     {
 	infinint tmp = infinint(f); // number of children
 	data_tree *entry = nullptr;
-	rejetons.clear();
+	clear_children();
 
 	try
 	{
@@ -72,14 +72,14 @@ namespace libdar
 		entry = read_next_in_list_from_file(f, db_version);
 		if(entry == nullptr)
 		    throw Erange("data_dir::data_dir", gettext("Unexpected end of file"));
-		rejetons.push_back(entry);
+		add_child(entry);
 		entry = nullptr;
 		--tmp;
 	    }
 	}
 	catch(...)
 	{
-	    deque<data_tree *>::iterator next = rejetons.begin();
+	    list<data_tree *>::iterator next = rejetons.begin();
 	    while(next != rejetons.end())
 	    {
 		delete *next;
@@ -94,17 +94,17 @@ namespace libdar
 
     data_dir::data_dir(const data_dir & ref) : data_tree(ref)
     {
-	rejetons.clear();
+	clear_children();
     }
 
     data_dir::data_dir(const data_tree & ref) : data_tree(ref)
     {
-	rejetons.clear();
+	clear_children();
     }
 
     data_dir::~data_dir()
     {
-	deque<data_tree *>::iterator next = rejetons.begin();
+	list<data_tree *>::iterator next = rejetons.begin();
 	while(next != rejetons.end())
 	{
 	    delete *next;
@@ -115,7 +115,7 @@ namespace libdar
 
     void data_dir::dump(generic_file & f) const
     {
-	deque<data_tree *>::const_iterator it = rejetons.begin();
+	list<data_tree *>::const_iterator it = rejetons.begin();
 	infinint tmp = rejetons.size();
 
 	data_tree::dump(f);
@@ -268,7 +268,18 @@ namespace libdar
 
     const data_tree *data_dir::read_child(const string & name) const
     {
-	deque<data_tree *>::const_iterator it = rejetons.begin();
+#ifdef LIBDAR_FAST_DIR
+	map<string, list<data_tree *>::iterator>::const_iterator it = index.find(name);
+
+	if(it == index.end())
+	    return nullptr;
+	else
+	    if(*(it->second) == nullptr)
+		throw SRC_BUG;
+	    else
+		return *(it->second);
+#else
+	list<data_tree *>::const_iterator it = rejetons.begin();
 
 	while(it != rejetons.end() && *it != nullptr && (*it)->get_name() != name)
 	    ++it;
@@ -280,11 +291,12 @@ namespace libdar
 		throw SRC_BUG;
 	    else
 		return *it;
+#endif
     }
 
     void data_dir::read_all_children(vector<string> & fils) const
     {
-	deque<data_tree *>::const_iterator it = rejetons.begin();
+	list<data_tree *>::const_iterator it = rejetons.begin();
 
 	fils.clear();
 	while(it != rejetons.end())
@@ -293,7 +305,7 @@ namespace libdar
 
     bool data_dir::check_order(user_interaction & dialog, const path & current_path, bool & initial_warn) const
     {
-	deque<data_tree *>::const_iterator it = rejetons.begin();
+	list<data_tree *>::const_iterator it = rejetons.begin();
 	bool ret = data_tree::check_order(dialog, current_path, initial_warn);
 	path subpath = current_path.display() == "." ? get_name() : current_path.append(get_name());
 
@@ -341,7 +353,7 @@ namespace libdar
 
     void data_dir::finalize_except_self(const archive_num & archive, const datetime & deleted_date, const archive_num & ignore_archives_greater_or_equal)
     {
-	deque<data_tree *>::iterator it = rejetons.begin();
+	list<data_tree *>::iterator it = rejetons.begin();
 
 	while(it != rejetons.end())
 	{
@@ -354,9 +366,10 @@ namespace libdar
 	    }
 	    catch(Edata & e)
 	    {
-		delete (*it);
-		rejetons.erase(it);
-		it = rejetons.begin();
+		data_tree *tmp = *it;
+
+		it = erase_child(it);
+		delete tmp;
 	    }
 	}
     }
@@ -364,7 +377,7 @@ namespace libdar
 
     bool data_dir::remove_all_from(const archive_num & archive_to_remove, const archive_num & last_archive)
     {
-	deque<data_tree *>::iterator it = rejetons.begin();
+	list<data_tree *>::iterator it = rejetons.begin();
 
 	while(it != rejetons.end())
 	{
@@ -372,10 +385,10 @@ namespace libdar
 		throw SRC_BUG;
 	    if((*it)->remove_all_from(archive_to_remove, last_archive))
 	    {
-		delete *it; // release the memory used by the object
-		*it = nullptr;
-		rejetons.erase(it); // remove the entry from the deque
-		it = rejetons.begin(); // does not seems "it" points to the next item after erase, so we restart from the beginning
+		data_tree *tmp = *it;
+
+		it = erase_child(it); // remove the entry from the deque, "it" now points to the next item
+		delete tmp; // release the memory used by the object
 	    }
 	    else
 		++it;
@@ -389,7 +402,7 @@ namespace libdar
 			archive_num num,
 			string marge) const
     {
-	deque<data_tree *>::const_iterator it = rejetons.begin();
+	list<data_tree *>::const_iterator it = rejetons.begin();
 	set<archive_num> ou_data;
 	archive_num ou_ea;
 	bool data, ea;
@@ -430,7 +443,7 @@ namespace libdar
 
     void data_dir::apply_permutation(archive_num src, archive_num dst)
     {
-	deque<data_tree *>::iterator it = rejetons.begin();
+	list<data_tree *>::iterator it = rejetons.begin();
 
 	data_tree::apply_permutation(src, dst);
 	while(it != rejetons.end())
@@ -443,7 +456,7 @@ namespace libdar
 
     void data_dir::skip_out(archive_num num)
     {
-	deque<data_tree *>::iterator it = rejetons.begin();
+	list<data_tree *>::iterator it = rejetons.begin();
 
 	data_tree::skip_out(num);
 	while(it != rejetons.end())
@@ -458,7 +471,7 @@ namespace libdar
 					     deque<infinint> & total_data,
 					     deque<infinint> & total_ea) const
     {
-	deque<data_tree *>::const_iterator it = rejetons.begin();
+	list<data_tree *>::const_iterator it = rejetons.begin();
 
 	data_tree::compute_most_recent_stats(data, ea, total_data, total_ea);
 	while(it != rejetons.end())
@@ -472,8 +485,10 @@ namespace libdar
     {
 	while(rejetons.begin() != rejetons.end() && *(rejetons.begin()) != nullptr && (*(rejetons.begin()))->fix_corruption())
 	{
-	    delete *(rejetons.begin());
-	    rejetons.erase(rejetons.begin());
+	    data_tree *tmp = *(rejetons.begin());
+
+	    erase_child(rejetons.begin());
+	    delete tmp;
 	}
 
 	if(rejetons.begin() != rejetons.end())
@@ -579,12 +594,40 @@ namespace libdar
     {
 	if(fils == nullptr)
 	    throw SRC_BUG;
+#ifdef LIBDAR_FAST_DIR
+	string name = fils->get_name();
+
+	if(index.find(name) != index.end())
+	    throw Erange("data_dir::add_child", tools_printf(gettext("Corrupted database: two entries named %S in the same directory"), &name));
 	rejetons.push_back(fils);
+	try
+	{
+	    index[name] = prev(rejetons.end());
+	}
+	catch(...)
+	{
+	    rejetons.pop_back();
+	    throw;
+	}
+#else
+	rejetons.push_back(fils);
+#endif
     }
 
     void data_dir::remove_child(const string & name)
     {
-	deque<data_tree *>::iterator it = rejetons.begin();
+#ifdef LIBDAR_FAST_DIR
+	map<string, list<data_tree *>::iterator>::iterator ut = index.find(name);
+
+	if(ut != index.end())
+	{
+	    if(*(ut->second) == nullptr)
+		throw SRC_BUG;
+	    rejetons.erase(ut->second);
+	    index.erase(ut);
+	}
+#else
+	list<data_tree *>::iterator it = rejetons.begin();
 
 	while(it != rejetons.end() && *it != nullptr && (*it)->get_name() != name)
 	    ++it;
@@ -594,8 +637,26 @@ namespace libdar
 	    if(*it == nullptr)
 		throw SRC_BUG;
 	    else
-		rejetons.erase(it);
+		erase_child(it);
 	}
+#endif
+    }
+
+    list<data_tree *>::iterator data_dir::erase_child(list<data_tree *>::iterator it)
+    {
+#ifdef LIBDAR_FAST_DIR
+	if(*it != nullptr)
+	    index.erase((*it)->get_name());
+#endif
+	return rejetons.erase(it);
+    }
+
+    void data_dir::clear_children()
+    {
+	rejetons.clear();
+#ifdef LIBDAR_FAST_DIR
+	index.clear();
+#endif
     }
 
     data_tree *data_dir::read_next_in_list_from_file(generic_file & f, unsigned char db_version)
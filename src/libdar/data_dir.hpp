@@ -31,7 +31,11 @@
 
 #include <string>
 #include <deque>
+#include <list>
 #include <vector>
+#ifdef LIBDAR_FAST_DIR
+#include <map>
+#endif
 #include "infinint.hpp"
 #include "generic_file.hpp"
 #include "user_interaction.hpp"
@@ -57,7 +61,7 @@ namespace libdar
 	data_dir(const data_tree & ref);
 	data_dir(const data_dir & ref);
 	data_dir(data_dir && ref) = default;
-	data_dir & operator = (const data_dir & ref) { rejetons.clear(); return *this; };
+	data_dir & operator = (const data_dir & ref) { clear_children(); return *this; };
 	data_dir & operator = (data_dir && ref) noexcept = default;
 	~data_dir();
 
@@ -112,10 +116,15 @@ namespace libdar
 	static data_dir *data_tree_read(generic_file & f, unsigned char db_version);
 
     private:
-	std::deque<data_tree *> rejetons;          //< subdir and subfiles of the current dir
+	std::list<data_tree *> rejetons;          //< subdir and subfiles of the current dir
+#ifdef LIBDAR_FAST_DIR
+	std::map<std::string, std::list<data_tree *>::iterator> index;  //< position in rejetons of each child, by name
+#endif
 
-	void add_child(data_tree *fils);          //< "this" is now responsible of "fils" disalocation
+	void add_child(data_tree *fils);          //< "this" is now responsible of "fils" disalocation, throws Erange if a child has the same name
 	void remove_child(const std::string & name);
+	std::list<data_tree *>::iterator erase_child(std::list<data_tree *>::iterator it); //< remove from rejetons and index, without releasing the object
+	void clear_children();                    //< forget all children without releasing them
 	data_tree *find_or_addition(const std::string & name, bool is_dir, const archive_num & archive);
 
 	    /// read signature and depening on it run data_tree or data_dir constructor
@@ -93,6 +93,13 @@ namespace libdar
 	    /// full path of current directory + anything necessary to provide URL formated information
 	virtual std::string get_url() const = 0;
 
+	    /// number of files that can be transferred to or from the repository at the same time
+
+	    /// \note when greater than one, slices are written to local temporary files that are uploaded
+	    /// several at a time once completed, and the next slices are fetched ahead in local temporary
+	    /// files when slices are read in sequence (this requires libthreadar)
+	virtual U_I get_parallel_transfers() const { return 1; };
+
 	    /// set default ownership for files to be created thanks to the open() methods
 	void set_user_ownership(const std::string & x_user) { user = x_user; };
 	void set_group_ownership(const std::string & x_group) { group = x_group; };
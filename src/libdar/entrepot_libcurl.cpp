@@ -49,8 +49,11 @@ namespace libdar
 				       const string & sftp_pub_keyfile,   //< where to fetch the public key (sftp only)
 				       const string & sftp_prv_keyfile,   //< where to fetch the private key (sftp only)
 				       const string & sftp_known_hosts,   //< location of the known_hosts file (empty string to disable this security check)
-				       U_I waiting_time)
+				       U_I waiting_time,
+				       U_I parallel_transfers)
     {
+	parallel = parallel_transfers > 0 ? parallel_transfers : 1;
+
 #if defined ( LIBCURL_AVAILABLE ) && defined ( LIBTHREADAR_AVAILABLE )
 
 	NLS_SWAP_IN;
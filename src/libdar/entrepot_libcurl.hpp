@@ -64,7 +64,8 @@ namespace libdar
 			 const std::string & sftp_pub_keyfile,   ///< where to fetch the public key (sftp only)
 			 const std::string & sftp_prv_keyfile,   ///< where to fetch the private key (sftp only)
 			 const std::string & sftp_known_hosts,   ///< location of the known_hosts file (empty string to disable this security check)
-			 U_I waiting_time                        ///< time in second to wait before retrying in case of network error
+			 U_I waiting_time,                       ///< time in second to wait before retrying in case of network error
+			 U_I parallel_transfers = 1              ///< number of slices to transfer at the same time (see entrepot::get_parallel_transfers())
 	    );
 	entrepot_libcurl(const entrepot_libcurl & ref) = default;
 	entrepot_libcurl(entrepot_libcurl && ref) noexcept = default;
@@ -81,6 +82,7 @@ namespace libdar
 	    /// \note this is expected to have a double slash after the host:port
 	    /// like ftp://www.some.where:8021//tmp/sub/dir5A
 	virtual std::string get_url() const override;
+	virtual U_I get_parallel_transfers() const override { return parallel; };
 	virtual const path & get_location() const override;
 	virtual const path & get_root() const override;
 	virtual void read_dir_reset() const override;
@@ -103,6 +105,8 @@ namespace libdar
 	virtual void read_dir_flush() override;
 
     private:
+	U_I parallel;
+
 #if defined ( LIBCURL_AVAILABLE ) && defined ( LIBTHREADAR_AVAILABLE )
 	class i_entrepot_libcurl;
 	std::shared_ptr<i_entrepot_libcurl> pimpl;
@@ -52,6 +52,7 @@ namespace libdar
     entrepot_local::entrepot_local(const std::string & user, const std::string & group, bool x_furtive_mode)
     {
 	furtive_mode = x_furtive_mode;
+	memory_mapped = false;
 	contents = nullptr;
 	set_user_ownership(user);
 	set_group_ownership(group);
@@ -93,14 +94,12 @@ namespace libdar
 	    throw SRC_BUG;
 	if(contents == nullptr)
 	    return false;
-	if(contents->fichier.empty())
+	if(!me->contents->read(filename))
 	{
 	    delete contents;
 	    me->contents = nullptr;
 	    return false;
 	}
-	filename = contents->fichier.front();
-	me->contents->fichier.pop_front();
 	return true;
     }
 
@@ -113,21 +112,26 @@ namespace libdar
 						   bool erase) const
     {
 	fichier_global *ret = nullptr;
+	fichier_local *tmp = nullptr;
 	string fullname = (get_full_path().append(filename)).display();
 	U_I perm = force_permission ? permission : 0666;
 
 
-	ret = new (nothrow) fichier_local(dialog,
-					  fullname,
-					  mode,
-					  perm,
-					  fail_if_exists,
-					  erase,
-					  false);
+	ret = tmp = new (nothrow) fichier_local(dialog,
+						fullname,
+						mode,
+						perm,
+						fail_if_exists,
+						erase,
+						false);
 	if(ret == nullptr)
 	    throw Ememory("entrepot_local::inherited_open");
 	try
 	{
+		// slices are not modified while being read, the data they
+		// carry can be lent straight from a mapping of the file
+	    if(mode == gf_read_only && memory_mapped)
+		tmp->allow_mmap(true);
 	    if(force_permission)
 		ret->change_permission(permission); // this is necessary if the file already exists
 	    if(get_user_ownership() != "" || get_group_ownership() != "")
@@ -56,7 +56,7 @@ namespace libdar
     public:
 	entrepot_local(const std::string & user, const std::string & group, bool x_furtive_mode);
 	entrepot_local(const entrepot_local & ref): entrepot(ref) { copy_from(ref); };
-	entrepot_local(entrepot_local && ref) noexcept: entrepot(std::move(ref)) { nullifyptr(); move_from(std::move(ref)); };
+	entrepot_local(entrepot_local && ref) noexcept: entrepot(std::move(ref)) { nullifyptr(); furtive_mode = false; memory_mapped = false; move_from(std::move(ref)); };
 	entrepot_local & operator = (const entrepot_local & ref);
 	entrepot_local & operator = (entrepot_local && ref) noexcept { entrepot::operator = (std::move(ref)); move_from(std::move(ref)); return *this; };
 	~entrepot_local() { detruit(); };
@@ -68,6 +68,9 @@ namespace libdar
 
 	virtual entrepot *clone() const override { return new (std::nothrow) entrepot_local(*this); };
 
+	    /// whether slices opened read-only may be memory mapped (see fichier_local::allow_mmap())
+	void set_memory_mapped(bool mode) { memory_mapped = mode; };
+
     protected:
 	virtual fichier_global *inherited_open(const std::shared_ptr<user_interaction> & dialog,
 					       const std::string & filename,
@@ -82,11 +85,12 @@ namespace libdar
 
     private:
 	bool furtive_mode;
+	bool memory_mapped;
 	etage *contents;
 
 	void nullifyptr() noexcept { contents = nullptr; };
-	void copy_from(const entrepot_local & ref) { furtive_mode = ref.furtive_mode; contents = nullptr; };
-	void move_from(entrepot_local && ref) noexcept { std::swap(contents, ref.contents), std::swap(furtive_mode, ref.furtive_mode); };
+	void copy_from(const entrepot_local & ref) { furtive_mode = ref.furtive_mode; memory_mapped = ref.memory_mapped; contents = nullptr; };
+	void move_from(entrepot_local && ref) noexcept { std::swap(contents, ref.contents), std::swap(furtive_mode, ref.furtive_mode); std::swap(memory_mapped, ref.memory_mapped); };
 	void detruit() { if(contents != nullptr) { delete contents; contents = nullptr; } };
     };
 
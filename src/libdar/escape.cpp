@@ -683,6 +683,61 @@ namespace libdar
 	return returned;
     }
 
+    bool escape::inherited_read_lend(const char * & ptr, U_I & size)
+    {
+	const char *below;
+	U_I lu;
+	U_I clean;
+
+	if(already_read != read_buffer_size)
+	    return false; // data in transit in read_buffer is provided by inherited_read()
+
+	if(read_eof)
+	{
+	    size = 0; // eof reached. (real eof or next to read is a real mark)
+	    return true;
+	}
+
+	    // no more data than what read_buffer can hold is asked to the layer below,
+	    // for the data following a mark to be moved to read_buffer if one is met
+
+	if(size > READ_BUFFER_SIZE)
+	    size = READ_BUFFER_SIZE;
+	lu = size;
+
+	if(!x_below->read_lend(below, lu))
+	    return false;
+	below_position += lu;
+
+	if(lu == 0)
+	{
+	    read_eof = true;
+	    size = 0;
+	    return true;
+	}
+
+	clean = trouve_amorce(below, lu, fixed_sequence);
+	if(clean < lu)
+	{
+		// a mark or the start of a mark has been found, the data from there
+		// is moved to read_buffer for inherited_read() to analyse it
+		// the same way it does for the data it reads directly into the caller buffer
+
+	    read_buffer_size = lu - clean;
+	    escape_seq_offset_in_buffer = 0;
+	    already_read = 0;
+	    (void)memcpy(read_buffer, below + clean, read_buffer_size);
+
+	    if(clean == 0)
+		return false; // the read position did not change, inherited_read() takes over from here
+	}
+
+	ptr = below;
+	size = clean;
+
+	return true;
+    }
+
     void escape::inherited_write(const char *a, U_I size)
     {
 	U_I written = 0;
@@ -1037,69 +1092,71 @@ namespace libdar
 
     U_I escape::trouve_amorce(const char *a, U_I size, const unsigned char escape_sequence[ESCAPE_SEQUENCE_LENGTH])
     {
-	U_I ret = 0; // points to the start of the escape sequence
 	U_I curs = 0; // points to current byte considered
-	U_I amorce = 0; // points to the byte to compare in the fixed sequence
-	U_I found = ESCAPE_SEQUENCE_LENGTH - 1; // maximum number of byte to compare in fixed sequence
+	const U_I found = ESCAPE_SEQUENCE_LENGTH - 1; // maximum number of byte to compare in fixed sequence
 
-	while(curs < size && amorce < found)
+	    // memchr() locates the candidates for the first byte of the sequence
+	    // (it is vectorized by the C library), then the candidate is verified
+	    // for the rest of the fixed sequence, or up to the end of the "a" buffer
+	    // (partial escape sequence) in which case it is also returned
+
+	while(curs < size)
 	{
-	    if((unsigned char)a[curs] == escape_sequence[amorce])
-	    {
-		if(amorce == 0)
-		    ret = curs;
-		++amorce;
-	    }
-	    else
-		if(amorce > 0)
-		{
-		    curs -= amorce;
-		    amorce = 0;
-		}
+	    const char *hit = (const char *)memchr(a + curs, escape_sequence[0], size - curs);
+	    U_I len;
 
+	    if(hit == nullptr)
+		break;
+	    curs = hit - a;
+	    len = size - curs < found ? size - curs : found;
+	    if(memcmp(hit, escape_sequence, len) == 0)
+		return curs;
 	    ++curs;
 	}
 
-	if(curs >= size) // reached the end of the field
-	    if(amorce == 0) // and no start of escape sequence could be found
-		ret = size;
-	    // else we return the start of the escape sequence found (or partial escape sequence if found at the end of the "a" buffer
-
-	return ret;
+	return size;
     }
 
 
     U_I escape::remove_data_marks_and_stop_at_first_real_mark(char *a, U_I size, U_I & delta, const unsigned char escape_sequence[ESCAPE_SEQUENCE_LENGTH])
     {
-	bool loop = false;
-	U_I ret = 0;
+	U_I src = 0; // next byte to consider in the original data
+	U_I dst = 0; // where to place it once data marks have been removed
 
 	delta = 0;
 
-	do
+	    // unescaped data is compacted as we go, so each byte is moved at most once
+	    // whatever the number of data marks found in the buffer
+
+	while(true)
 	{
-	    ret += trouve_amorce(a + ret, size - ret, escape_sequence);
+	    U_I next = src + trouve_amorce(a + src, size - src, escape_sequence);
 
-	    if(ret < size) // start of escape sequence found
-		if(ret + ESCAPE_SEQUENCE_LENGTH <= size) // we can determin the nature of the escape sequence
-		    if(char2type(a[ret + ESCAPE_SEQUENCE_LENGTH - 1]) == seqt_not_a_sequence)
-		    {
-			(void)memmove(a + ret + ESCAPE_SEQUENCE_LENGTH - 1, a + ret + ESCAPE_SEQUENCE_LENGTH, size - ret - ESCAPE_SEQUENCE_LENGTH);
-			++delta;
-			--size; // this modification is local to this method.
-			loop = true;
-			ret += ESCAPE_SEQUENCE_LENGTH - 1; // skipping one byte, as this is the escape data byte of which we just removed the protection
-		    }
-		    else
-			loop = false; // real mark found
-		else
-		    loop = false; // cannot know whether this is a real mark or just escaped data
+	    if(dst != src)
+		(void)memmove(a + dst, a + src, next - src);
+	    dst += next - src;
+	    src = next;
+
+	    if(src < size // start of escape sequence found
+	       && src + ESCAPE_SEQUENCE_LENGTH <= size // we can determin the nature of the escape sequence
+	       && char2type(a[src + ESCAPE_SEQUENCE_LENGTH - 1]) == seqt_not_a_sequence)
+	    {
+		    // keeping the escaped data byte and removing its protection
+
+		if(dst != src)
+		    (void)memmove(a + dst, a + src, ESCAPE_SEQUENCE_LENGTH - 1);
+		dst += ESCAPE_SEQUENCE_LENGTH - 1;
+		src += ESCAPE_SEQUENCE_LENGTH;
+		++delta;
+	    }
 	    else
-		loop = false; // no mark found
+		break; // no mark, real mark found, or cannot know whether this is a real mark or just escaped data
 	}
-	while(loop);
 
-	return ret;
+	if(dst != src)
+	    (void)memmove(a + dst, a + src, size - src);
+
+	return dst;
     }
 
 } // end of namespace
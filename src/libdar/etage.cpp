@@ -94,6 +94,9 @@ namespace libdar
 	// check if the given file is a tag tellig if the current directory is a cache directory
     static bool cache_directory_tagging_check(const char *cpath, const char *filename);
 
+	// type of the entry as provided by readdir(), without any additional system call
+    static etage::entry_type entry_type_of(const struct dirent *ent);
+
 
     etage::etage(user_interaction &ui,
 		 const char *dirname,
@@ -104,6 +107,9 @@ namespace libdar
     {
         struct dirent *ret;
 	DIR *tmp = nullptr;
+
+	dir = nullptr;
+	fd = -1;
 #if FURTIVE_READ_MODE_AVAILABLE
 	int fddir = -1;
 
@@ -147,6 +153,8 @@ namespace libdar
 		throw Erange("etage::etage" , string(gettext("Error opening directory: ")) + dirname + " : " + tools_strerror_r(errno));
 
 	    fichier.clear();
+	    fichier_type.clear();
+	    read_ahead = 0;
 
 #if HAVE_READDIR_R && (CAN_USE_READDIR_R == 1)
     	    U_64 max_alloc_filename;
@@ -171,9 +179,13 @@ namespace libdar
 
 		    if(strcmp(ret->d_name, ".") != 0 && strcmp(ret->d_name, "..") != 0)
 		    {
-			if(cache_directory_tagging)
+			entry_type type = entry_type_of(ret);
+
+			    // the tag can only be a plain file (or a symlink to it)
+			if(cache_directory_tagging && type != entry_type::directory && type != entry_type::other)
 			    is_cache_dir = cache_directory_tagging_check(dirname, ret->d_name);
 			fichier.push_back(string(ret->d_name));
+			fichier_type.push_back(type);
 		    }
 
 #if HAVE_READDIR_R && (CAN_USE_READDIR_R == 1)
@@ -188,12 +200,22 @@ namespace libdar
 	    tools_release_struct_dirent(ret);
 	    ret = nullptr;
 #endif
-	    closedir(tmp);
+#if HAVE_FSTATAT
+	    if(!is_cache_dir && !fichier.empty())
+	    {
+		    // keeping the directory open to access its entries relatively to it
+		dir = tmp;
+		fd = dirfd(tmp);
+	    }
+	    else
+#endif
+		closedir(tmp);
 	    tmp = nullptr;
 
 	    if(is_cache_dir)
 	    {
 		fichier.clear();
+		fichier_type.clear();
 		ui.message(tools_printf(gettext("Detected Cache Directory Tagging Standard for %s, the contents of that directory will not be saved"), dirname));
 		    // drop all the contents of the directory because it follows the Cache Directory Tagging Standard
 	    }
@@ -205,10 +227,91 @@ namespace libdar
 	{
 	    if(tmp != nullptr)
 		closedir(tmp);
+	    close_fd();
 	    throw;
 	}
     }
 
+    etage::etage(user_interaction & ui,
+		 const char *dirname,
+		 deque<string> && contents,
+		 deque<entry_type> && types,
+		 const datetime & x_last_acc,
+		 const datetime & x_last_mod,
+		 bool cache_directory_tagging)
+    {
+	if(contents.size() != types.size())
+	    throw SRC_BUG;
+
+	fichier = move(contents);
+	fichier_type = move(types);
+	read_ahead = 0;
+	dir = nullptr;
+	fd = -1;
+
+	if(cache_directory_tagging)
+	{
+	    for(deque<string>::const_iterator it = fichier.begin(); it != fichier.end(); ++it)
+	    {
+		if(cache_directory_tagging_check(dirname, it->c_str()))
+		{
+		    fichier.clear();
+		    fichier_type.clear();
+		    ui.message(tools_printf(gettext("Detected Cache Directory Tagging Standard for %s, the contents of that directory will not be saved"), dirname));
+			// drop all the contents of the directory because it follows the Cache Directory Tagging Standard
+		    break;
+		}
+	    }
+	}
+
+#if HAVE_FSTATAT
+	if(!fichier.empty())
+	{
+	    int flags = O_RDONLY|O_BINARY;
+
+#ifdef O_DIRECTORY
+	    flags |= O_DIRECTORY;
+#endif
+	    fd = ::open(dirname, flags); // failure is not an error, entries will then be accessed by their path
+	}
+#endif
+
+	last_mod = x_last_mod;
+	last_acc = x_last_acc;
+    }
+
+    etage::etage(etage && ref) noexcept
+    {
+	fichier = move(ref.fichier);
+	fichier_type = move(ref.fichier_type);
+	read_ahead = ref.read_ahead;
+	dir = ref.dir;
+	fd = ref.fd;
+	ref.dir = nullptr;
+	ref.fd = -1;
+	last_mod = move(ref.last_mod);
+	last_acc = move(ref.last_acc);
+    }
+
+    etage & etage::operator = (etage && ref) noexcept
+    {
+	if(this != &ref)
+	{
+	    close_fd();
+	    fichier = move(ref.fichier);
+	    fichier_type = move(ref.fichier_type);
+	    read_ahead = ref.read_ahead;
+	    dir = ref.dir;
+	    fd = ref.fd;
+	    ref.dir = nullptr;
+	    ref.fd = -1;
+	    last_mod = move(ref.last_mod);
+	    last_acc = move(ref.last_acc);
+	}
+
+	return *this;
+    }
+
     bool etage::read(string & ref)
     {
         if(fichier.empty())
@@ -217,10 +320,40 @@ namespace libdar
 	{
 	    ref = fichier.front();
 	    fichier.pop_front();
+	    fichier_type.pop_front();
+	    if(read_ahead > 0)
+		--read_ahead;
 	    return true;
 	}
     }
 
+    void etage::close_fd()
+    {
+	if(dir != nullptr)
+	{
+	    closedir((DIR *)dir); // also closes fd
+	    dir = nullptr;
+	}
+	else
+	    if(fd >= 0)
+		close(fd);
+	fd = -1;
+    }
+
+    etage::entry_type etage::type_of(const struct stat & inode)
+    {
+	if(inode.st_mode == 0)
+	    return etage::entry_type::unknown;
+	else if(S_ISDIR(inode.st_mode))
+	    return etage::entry_type::directory;
+	else if(S_ISREG(inode.st_mode))
+	    return etage::entry_type::regular;
+	else if(S_ISLNK(inode.st_mode))
+	    return etage::entry_type::symlink;
+	else
+	    return etage::entry_type::other;
+    }
+
 	///////////////////////////////////////////
 	////////////// static functions ///////////
 	///////////////////////////////////////////
@@ -276,4 +409,25 @@ namespace libdar
 	return ret;
     }
 
+    static etage::entry_type entry_type_of(const struct dirent *ent)
+    {
+#if defined(DT_UNKNOWN) && defined(DT_DIR) && defined(DT_REG) && defined(DT_LNK)
+	switch(ent->d_type)
+	{
+	case DT_UNKNOWN:
+	    return etage::entry_type::unknown;
+	case DT_DIR:
+	    return etage::entry_type::directory;
+	case DT_REG:
+	    return etage::entry_type::regular;
+	case DT_LNK:
+	    return etage::entry_type::symlink;
+	default:
+	    return etage::entry_type::other;
+	}
+#else
+	return etage::entry_type::unknown;
+#endif
+    }
+
 } // end of namespace
@@ -28,6 +28,18 @@
 #define ETAGE_HPP
 
 #include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+} // end extern "C"
+
 #include <deque>
 #include <string>
 #include "datetime.hpp"
@@ -48,24 +60,50 @@ namespace libdar
 
     struct etage
     {
-	etage() { fichier.clear(); last_mod = datetime(0); last_acc = datetime(0); }; // required to fake an empty dir when one is impossible to open
+	    /// type of an entry as reported by the system when reading the directory
+	enum class entry_type { unknown, directory, regular, symlink, other };
+
+	etage() { fichier.clear(); fichier_type.clear(); read_ahead = 0; fd = -1; dir = nullptr; last_mod = datetime(0); last_acc = datetime(0); }; // required to fake an empty dir when one is impossible to open
         etage(user_interaction & ui,
 	      const char *dirname,
 	      const datetime & x_last_acc,
 	      const datetime & x_last_mod,
 	      bool cache_directory_tagging,
 	      bool furtive_read_mode);
-	etage(const etage & ref) = default;
-	etage(etage && ref) = default;
-	etage & operator = (const etage & ref) = default;
-	etage & operator = (etage && ref) noexcept = default;
-	~etage() = default;
+
+	    /// build from the contents of the directory already read (see filesystem_scanner)
+
+	    /// \param[in] types the type of each entry of contents in the same order, only used
+	    /// as a hint to read files ahead, the inodes are read again by the walk
+	etage(user_interaction & ui,
+	      const char *dirname,
+	      std::deque<std::string> && contents,
+	      std::deque<entry_type> && types,
+	      const datetime & x_last_acc,
+	      const datetime & x_last_mod,
+	      bool cache_directory_tagging);
+	etage(const etage & ref) = delete;
+	etage(etage && ref) noexcept;
+	etage & operator = (const etage & ref) = delete;
+	etage & operator = (etage && ref) noexcept;
+	~etage() { close_fd(); };
 
         bool read(std::string & ref);
 
+	    /// type of an entry from its inode as given by lstat(), unknown if st_mode is zero
+	static entry_type type_of(const struct stat & inode);
+
         std::deque<std::string> fichier; ///< holds the list of entry in the directory
+	std::deque<entry_type> fichier_type; ///< type of each entry of fichier, in the same order
+	U_I read_ahead;                 ///< number of entries at the front of fichier already given for reading ahead
+	int fd;                         ///< file descriptor of the directory to access its entries with the *at() system calls, -1 if not available
         datetime last_mod;              ///< the last_lod of the directory itself
 	datetime last_acc;              ///< the last_acc of the directory itself
+
+    private:
+	void *dir;                      ///< the DIR structure fd comes from, if any (void * to not expose dirent.h)
+
+	void close_fd();
     };
 
 	/// @}
@@ -60,7 +60,16 @@ namespace libdar
 						  wait_delay(waiting),
 						  interthread(10, tampon_size),
 						  synchronize(2),
-						  x_proto(proto)
+						  x_proto(proto),
+						  requests(0),
+						  ranged(false),
+						  has_last_end(false),
+						  last_end(0),
+						  window(0),
+						  hint_end(0),
+						  range_buf(nullptr),
+						  range_size(0),
+						  range_filled(0)
     {
 	CURLcode err;
 
@@ -154,13 +163,13 @@ namespace libdar
 	catch(...)
 	{
 	    (void)curl_easy_setopt(ehandle.get_handle(), CURLOPT_QUOTE, nullptr);
-	    (void)curl_easy_setopt(ehandle.get_handle(), CURLOPT_NOBODY, 0);
+	    unset_nobody();
 	    if(headers != nullptr)
 		curl_slist_free_all(headers);
 	    throw;
 	}
 	(void)curl_easy_setopt(ehandle.get_handle(), CURLOPT_QUOTE, nullptr);
-	(void)curl_easy_setopt(ehandle.get_handle(), CURLOPT_NOBODY, 0);
+	unset_nobody();
 	if(headers != nullptr)
 	    curl_slist_free_all(headers);
     }
@@ -186,6 +195,8 @@ namespace libdar
 	    do
 	    {
 		err = curl_easy_perform(ehandle.get_handle());
+		if(err == CURLE_REMOTE_FILE_NOT_FOUND)
+		    break; // recent libcurl reports a missing file this way
 		fichier_libcurl_check_wait_or_throw(get_pointer(),
 						    err,
 						    wait_delay,
@@ -194,17 +205,22 @@ namespace libdar
 	    }
 	    while(err != CURLE_OK);
 
-	    err = curl_easy_getinfo(ehandle.get_handle(), CURLINFO_CONTENT_LENGTH_DOWNLOAD, &filesize);
-	    if(filesize == -1) // file does not exist
+	    if(err == CURLE_REMOTE_FILE_NOT_FOUND)
 		filesize = 0;
+	    else
+	    {
+		err = curl_easy_getinfo(ehandle.get_handle(), CURLINFO_CONTENT_LENGTH_DOWNLOAD, &filesize);
+		if(filesize == -1) // file does not exist
+		    filesize = 0;
 
-	    if(err != CURLE_OK)
-		throw Erange("fichier_libcurl::get_size()",
-			     tools_printf(gettext("Error met while fetching file size: %s"),
-					  curl_easy_strerror(err)));
+		if(err != CURLE_OK)
+		    throw Erange("fichier_libcurl::get_size()",
+				 tools_printf(gettext("Error met while fetching file size: %s"),
+					      curl_easy_strerror(err)));
+	    }
 	    me->maxpos = tools_double2infinint(filesize);
 	    me->has_maxpos = true;
-	    (void)curl_easy_setopt(ehandle.get_handle(), CURLOPT_NOBODY, 0);
+	    me->unset_nobody();
 	}
 
 	return maxpos;
@@ -240,6 +256,31 @@ namespace libdar
 	switch(get_mode())
 	{
 	case gf_read_only:
+	    if(!ranged && !metadatamode && pos > current_offset && pos - current_offset <= merge_gap())
+	    {
+		    // close forward skip while streaming, dropping the
+		    // data in between is cheaper than a new request
+		U_I step;
+		U_I lu;
+
+		do
+		{
+		    infinint gap = pos - current_offset;
+
+		    step = 0;
+		    if(gap < infinint(tampon_size))
+			gap.unstack(step);
+		    else
+			step = tampon_size;
+		    stream_read(meta_tampon, step, lu);
+		}
+		while(current_offset < pos && lu > 0);
+
+		if(current_offset == pos)
+		    break;
+		    // else eof was met, continuing with a plain skip
+	    }
+
 	    switch_to_metadata(true); // necessary to stop current subthread and change easy_handle offset
 	    current_offset = pos;
 	    if(get_mode() == gf_write_only)
@@ -254,6 +295,13 @@ namespace libdar
 	    }
 	    if(get_mode() != gf_write_only)
 		flush_read();
+	    if(!ranged)
+	    {
+		    // random access: from now on data is fetched by ranges
+		(void)get_size();
+		ranged = true;
+	    }
+	    hint_end = 0;
 	    break;
 	case gf_write_only:
 	    throw Erange("fichier_libcurl::skip", string(gettext("libcurl does not allow skipping in write mode")));
@@ -304,7 +352,19 @@ namespace libdar
 
     void fichier_libcurl::inherited_read_ahead(const infinint & amount)
     {
-	relaunch_thread(amount);
+	if(ranged)
+	{
+	    if(amount.is_zero() || amount > infinint(ranged_max_blocks) * infinint(ranged_block_size))
+	    {
+		    // large amount of data to read, streaming is faster
+		ranged = false;
+		relaunch_thread(amount);
+	    }
+	    else
+		hint_end = current_offset + amount;
+	}
+	else
+	    relaunch_thread(amount);
     }
 
     void fichier_libcurl::inherited_sync_write()
@@ -396,6 +456,27 @@ namespace libdar
     }
 
     bool fichier_libcurl::fichier_global_inherited_read(char *a, U_I size, U_I & read, std::string & message)
+    {
+	read = 0;
+
+	if(ranged)
+	    ranged_read(a, size, read);
+
+	if(!ranged && read < size)
+	{
+		// either not in ranged read mode or we have
+		// just left it and need to stream the rest
+
+	    U_I streamed = 0;
+
+	    stream_read(a + read, size - read, streamed);
+	    read += streamed;
+	}
+
+	return true;
+    }
+
+    void fichier_libcurl::stream_read(char *a, U_I size, U_I & read)
     {
 	char *ptr;
 	unsigned int ptr_size;
@@ -448,8 +529,6 @@ namespace libdar
 	    }
 	}
 	while(read < size && (is_running() || interthread.is_not_empty()));
-
-	return true;
     }
 
     void fichier_libcurl::inherited_run()
@@ -483,6 +562,7 @@ namespace libdar
 	    {
 		do
 		{
+		    ++requests;
 		    err = curl_easy_perform(ehandle.get_handle());
 		    if(!end_data_mode)
 			fichier_libcurl_check_wait_or_throw(thread_ui,
@@ -505,6 +585,7 @@ namespace libdar
 			set_range(subthread_cur_offset, local_network_block);
 			try
 			{
+			    ++requests;
 			    err = curl_easy_perform(ehandle.get_handle());
 			    if(err == CURLE_BAD_DOWNLOAD_RESUME)
 				err = CURLE_OK;
@@ -598,6 +679,16 @@ namespace libdar
 			 tools_printf(gettext("Error while seeking in file on remote repository: %s"), curl_easy_strerror(err)));
     }
 
+    void fichier_libcurl::unset_nobody()
+    {
+	(void)curl_easy_setopt(ehandle.get_handle(), CURLOPT_NOBODY, 0);
+
+	    // libcurl turns the handle back to a download when
+	    // CURLOPT_NOBODY is unset, data would no more be uploaded
+	if(get_mode() != gf_read_only)
+	    (void)curl_easy_setopt(ehandle.get_handle(), CURLOPT_UPLOAD, 1L);
+    }
+
     void fichier_libcurl::switch_to_metadata(bool mode)
     {
 	CURLcode err;
@@ -702,6 +793,7 @@ namespace libdar
 	{
 		// ignore all errors
 	}
+	ranged_purge();
     }
 
     void fichier_libcurl::run_thread()
@@ -897,6 +989,25 @@ namespace libdar
 	return 0;
     }
 
+    size_t fichier_libcurl::write_range_callback(char *buffer, size_t size, size_t nmemb, void *userp)
+    {
+	size_t amount = size * nmemb;
+	fichier_libcurl *me = (fichier_libcurl *)(userp);
+	size_t room;
+
+	if(me == nullptr || me->range_buf == nullptr)
+	    throw SRC_BUG;
+
+	room = me->range_size - me->range_filled;
+	if(room > amount)
+	    room = amount;
+	memcpy(me->range_buf + me->range_filled, buffer, room);
+	me->range_filled += room;
+
+	    // anything beyond the requested range is dropped
+	return amount;
+    }
+
     void fichier_libcurl_check_wait_or_throw(const shared_ptr<user_interaction> & dialog,
 					     CURLcode err,
 					     U_I wait_seconds,
@@ -1007,6 +1118,255 @@ namespace libdar
 	}
     }
 
+    void fichier_libcurl::ranged_read(char *a, U_I size, U_I & read)
+    {
+	ranged_block *blk;
+	infinint tmp;
+	U_I delta;
+	U_I step;
+
+	read = 0;
+	while(ranged && read < size && (!has_maxpos || current_offset < maxpos))
+	{
+	    blk = ranged_find(current_offset, true);
+	    if(blk == nullptr)
+	    {
+		ranged_fetch(size - read);
+		if(!ranged)
+		    break; // data will now be streamed
+		blk = ranged_find(current_offset, true);
+		if(blk == nullptr)
+		    break; // nothing could be fetched, eof
+	    }
+
+	    tmp = current_offset - blk->offset;
+	    delta = 0;
+	    tmp.unstack(delta);
+	    if(!tmp.is_zero())
+		throw SRC_BUG;
+
+	    if(delta >= blk->size)
+		break; // current_offset is past the end of a short block, eof
+
+	    step = blk->size - delta;
+	    if(step > size - read)
+		step = size - read;
+	    memcpy(a + read, blk->data + delta, step);
+	    read += step;
+	    current_offset += step;
+	}
+    }
+
+    void fichier_libcurl::ranged_fetch(U_I needed)
+    {
+	const infinint block_size = ranged_block_size;
+	infinint start = current_offset - (current_offset % block_size);
+	infinint end;
+	infinint tmp;
+	bool sequential = false;
+	CURLcode err;
+	U_I len = 0;
+
+	if(has_last_end && last_end == start)
+	{
+		// reading sequentially, streaming is faster
+	    ranged = false;
+	    return;
+	}
+
+	    // merging a miss close to the previous range
+
+	if(has_last_end && last_end < start && start - last_end <= merge_gap())
+	{
+	    tmp = last_end;
+	    while(tmp < start && ranged_find(tmp, false) == nullptr)
+		tmp += block_size;
+	    if(tmp == start)
+	    {
+		start = last_end;
+		sequential = true;
+	    }
+	}
+
+	if(!sequential && x_proto == proto_ftp)
+	{
+		// a FTP range is a transfer aborted once enough data has
+		// been received, followed by a new login. Streaming costs
+		// a single request and goes on without a new one if reads
+		// are sequential from here
+	    ranged = false;
+	    return;
+	}
+
+	if(sequential)
+	{
+	    if(window >= ranged_max_blocks)
+	    {
+		    // reading almost sequentially, streaming is now faster
+		ranged = false;
+		return;
+	    }
+	    window *= 2;
+	    if(window > ranged_max_blocks)
+		window = ranged_max_blocks;
+	}
+	else
+	    window = 1;
+
+	    // computing the range to fetch
+
+	end = start + infinint(window) * block_size;
+	tmp = current_offset + needed;
+	if(end < tmp)
+	    end = tmp;
+	if(end < hint_end)
+	    end = hint_end;
+	tmp = end % block_size;
+	if(!tmp.is_zero())
+	    end += block_size - tmp;
+	tmp = start + infinint(ranged_max_blocks) * block_size;
+	if(end > tmp)
+	    end = tmp;
+	if(has_maxpos && end > maxpos)
+	    end = maxpos;
+	if(end <= current_offset)
+	    return; // eof
+	hint_end = 0;
+
+	    // not fetching again blocks we already have
+
+	tmp = start + block_size;
+	while(tmp < end && ranged_find(tmp, false) == nullptr)
+	    tmp += block_size;
+	if(tmp < end)
+	    end = tmp;
+
+	tmp = end - start;
+	tmp.unstack(len);
+	if(!tmp.is_zero())
+	    throw SRC_BUG;
+	window = (len + ranged_block_size - 1) / ranged_block_size;
+
+	    // fetching the range
+
+	switch_to_metadata(true);
+	range_buf = new (nothrow) char[len];
+	if(range_buf == nullptr)
+	    throw Ememory("fichier_libcurl::ranged_fetch");
+	range_size = len;
+
+	try
+	{
+	    err = curl_easy_setopt(ehandle.get_handle(), CURLOPT_WRITEFUNCTION, write_range_callback);
+	    if(err != CURLE_OK)
+		throw Erange("fichier_libcurl::ranged_fetch",
+			     tools_printf(gettext("Error met while setting libcurl for reading data file: %s"),
+					  curl_easy_strerror(err)));
+	    set_range(start, len);
+
+	    do
+	    {
+		range_filled = 0;
+		++requests;
+		err = curl_easy_perform(ehandle.get_handle());
+		if(err == CURLE_BAD_DOWNLOAD_RESUME)
+		    err = CURLE_OK;
+		fichier_libcurl_check_wait_or_throw(get_pointer(),
+						    err,
+						    wait_delay,
+						    tools_printf(gettext("Error met while reading a block of data: %s"),
+								 curl_easy_strerror(err)));
+	    }
+	    while(err != CURLE_OK);
+
+	    unset_range();
+	    err = curl_easy_setopt(ehandle.get_handle(), CURLOPT_WRITEFUNCTION, write_meta_callback);
+	    if(err != CURLE_OK)
+		throw Erange("fichier_libcurl::ranged_fetch",
+			     tools_printf(gettext("Error met while setting libcurl for reading data file: %s"),
+					  curl_easy_strerror(err)));
+
+		// storing the fetched data in blocks, the last block
+		// of the range ends up at the front of the lru list
+
+	    U_I offset = 0;
+	    ranged_block blk;
+
+	    while(offset < range_filled)
+	    {
+		blk.offset = start + offset;
+		blk.size = range_filled - offset;
+		if(blk.size > ranged_block_size)
+		    blk.size = ranged_block_size;
+		blk.data = new (nothrow) char[blk.size];
+		if(blk.data == nullptr)
+		    throw Ememory("fichier_libcurl::ranged_fetch");
+		memcpy(blk.data, range_buf + offset, blk.size);
+		try
+		{
+		    lru.push_front(blk);
+		}
+		catch(...)
+		{
+		    delete [] blk.data;
+		    throw;
+		}
+		offset += blk.size;
+	    }
+
+	    while(lru.size() > ranged_lru_blocks)
+	    {
+		delete [] lru.back().data;
+		lru.pop_back();
+	    }
+
+	    last_end = start + range_filled;
+	    has_last_end = true;
+	}
+	catch(...)
+	{
+	    (void)curl_easy_setopt(ehandle.get_handle(), CURLOPT_RANGE, nullptr);
+	    (void)curl_easy_setopt(ehandle.get_handle(), CURLOPT_WRITEFUNCTION, write_meta_callback);
+	    delete [] range_buf;
+	    range_buf = nullptr;
+	    throw;
+	}
+
+	delete [] range_buf;
+	range_buf = nullptr;
+    }
+
+    fichier_libcurl::ranged_block *fichier_libcurl::ranged_find(const infinint & offset, bool touch)
+    {
+	list<ranged_block>::iterator it = lru.begin();
+
+	while(it != lru.end() && (offset < it->offset || offset >= it->offset + it->size))
+	    ++it;
+
+	if(it == lru.end())
+	    return nullptr;
+
+	if(touch && it != lru.begin())
+	    lru.splice(lru.begin(), lru, it);
+
+	return &(*it);
+    }
+
+    infinint fichier_libcurl::merge_gap() const
+    {
+	if(x_proto == proto_ftp)
+	    return infinint(ranged_merge_blocks_ftp) * infinint(ranged_block_size);
+	else
+	    return infinint(ranged_merge_blocks) * infinint(ranged_block_size);
+    }
+
+    void fichier_libcurl::ranged_purge()
+    {
+	for(list<ranged_block>::iterator it = lru.begin(); it != lru.end(); ++it)
+	    delete [] it->data;
+	lru.clear();
+    }
+
 #endif
 
 } // end of namespace
@@ -40,6 +40,8 @@ extern "C"
 } // end extern "C"
 
 #include <string>
+#include <list>
+#include <atomic>
 #ifdef LIBTHREADAR_AVAILABLE
 #include <libthreadar/libthreadar.hpp>
 #endif
@@ -112,6 +114,12 @@ namespace libdar
         virtual bool skip_relative(S_I x) override;
         virtual infinint get_position() const override { return current_offset; };
 
+	    /// number of data transfers requested to the remote server so far
+
+	    /// \note this counts the ranged requests as well as each (re)start of the
+	    /// streamed transfer, it is only provided for statistics and testing
+	U_I get_request_count() const { return requests; };
+
     protected:
 	    // inherited from generic_file grand-parent class
 	virtual void inherited_read_ahead(const infinint & amount) override;
@@ -149,6 +157,18 @@ namespace libdar
 	    //   libcurl has returned it keeps trace of the amount of data sent to interthread.
 	    // - "network_block" is set by the main thread to define the amount of data to be fetched. It
 	    //   it used to setup libcurl and is read by the subthread for control/validation purposes
+	    //
+	    // ranged read mode:
+	    // once skip() has been called in read-only mode, data is no more streamed
+	    // but fetched by the main thread with ranged requests of whole blocks, kept in
+	    // the "lru" list. A miss located a few blocks after the last fetched range is
+	    // merged with that range and the amount fetched at once doubles at each such
+	    // merge, it also follows the amount given to read_ahead(). A miss just at the
+	    // end of the last range, a merge that would need more than ranged_max_blocks,
+	    // or a read_ahead() larger than that make data streamed again. With FTP, any miss that
+	    // is not merged is streamed too, a range costing there at least as much as a stream. While streaming, a skip()
+	    // forward closer than the merge gap drops the data in between rather than
+	    // starting a new request, any other skip() returns to ranged read mode.
 
 	bool end_data_mode;               ///< true if subthread has been requested to end
 	bool sub_is_dying;                ///< is set by subthread when about to end
@@ -167,9 +187,34 @@ namespace libdar
 	libthreadar::fast_tampon<char> interthread; ///< data channel for reading or writing with subthread
 	libthreadar::barrier synchronize; ///< used to be sure subthread has been launched
 	mycurl_protocol x_proto;          ///< used to workaround some libcurl strange behavoir for some protocols
+	std::atomic<U_I> requests;        ///< number of data transfers requested so far
+
+	struct ranged_block
+	{
+	    infinint offset;              ///< offset in the file of the first byte of the block
+	    U_I size;                     ///< amount of data in the block (less than ranged_block_size at end of file)
+	    char *data;                   ///< block content
+	};
+
+	static const U_I ranged_block_size = 65536;  ///< size of the blocks fetched in ranged read mode
+	static const U_I ranged_max_blocks = 32;     ///< maximum number of blocks fetched by a single request
+	static const U_I ranged_lru_blocks = 64;     ///< maximum number of blocks kept in memory
+	static const U_I ranged_merge_blocks = 2;    ///< maximum gap in blocks for a miss to be merged with the previous range
+	static const U_I ranged_merge_blocks_ftp = 8; ///< same as ranged_merge_blocks for FTP where each request opens a new session
+
+	bool ranged;                      ///< whether data is read in ranged read mode
+	std::list<ranged_block> lru;      ///< blocks fetched in ranged read mode, most recently used first
+	bool has_last_end;                ///< whether last_end is set
+	infinint last_end;                ///< offset following the last range fetched
+	U_I window;                       ///< number of blocks fetched by the last request
+	infinint hint_end;                ///< offset up to which read_ahead() announced data will be read
+	char *range_buf;                  ///< buffer the current ranged request fills
+	U_I range_size;                   ///< size of range_buf
+	U_I range_filled;                 ///< amount of data received in range_buf so far
 
 	void set_range(const infinint & begin, const infinint & range_size); ///< set range in easyhandle
 	void unset_range();  ///< unset range in easyhandler
+	void unset_nobody(); ///< unset nobody in easyhandle, keeping the upload mode when writing
 	void switch_to_metadata(bool mode);///< set to true to get or set file's metadata, false to read/write file's data
 	void detruit();     ///< get ready for object destruction
 	void run_thread();  ///< run subthread with the previously defined parameters
@@ -178,11 +223,18 @@ namespace libdar
 	void initialize_subthread(); ///< subthread routine to init itself
 	void finalize_subthread();   ///< subthread routine to end itself
 	void set_subthread(U_I & needed_bytes); ///< set parameters and run subthtread if necessary
+	void stream_read(char *a, U_I size, U_I & read); ///< read data streamed by the subthread
+	void ranged_read(char *a, U_I size, U_I & read); ///< read data in ranged read mode
+	void ranged_fetch(U_I needed);    ///< fetch the block at current_offset and the following ones, may leave ranged read mode
+	ranged_block *ranged_find(const infinint & offset, bool touch); ///< look for the block containing offset, nullptr if not fetched
+	void ranged_purge();              ///< release all fetched blocks
+	infinint merge_gap() const;       ///< distance under which two reads are served by a single request
 
 	static size_t write_data_callback(char *buffer, size_t size, size_t nmemb, void *userp);
 	static size_t read_data_callback(char *bufptr, size_t size, size_t nitems, void *userp);
        	static size_t write_meta_callback(char *buffer, size_t size, size_t nmemb, void *userp);
 	static size_t read_meta_callback(char *bufptr, size_t size, size_t nitems, void *userp);
+	static size_t write_range_callback(char *buffer, size_t size, size_t nmemb, void *userp);
     };
 
 	/// helper function to handle libcurl error code
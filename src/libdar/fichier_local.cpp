@@ -69,6 +69,10 @@ extern "C"
 #include <limits.h>
 #endif
 
+#if HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
 } // end extern "C"
 
 #include "infinint.hpp"
@@ -115,6 +119,23 @@ namespace libdar
 	fichier_local::open(chemin, gf_read_only, 0, false, false, furtive_mode);
     }
 
+    fichier_local::fichier_local(const shared_ptr<user_interaction> & dialog,
+				 S_I fd,
+				 gf_mode m) : fichier_global(dialog, m)
+    {
+	if(fd < 0)
+	    throw SRC_BUG;
+
+	filedesc = fd;
+	adv = advise_normal;
+	mmap_allowed = false;
+	map_base = nullptr;
+	map_offset = 0;
+	map_len = 0;
+	lent_offset = 0;
+	copy_range = true;
+    }
+
     void fichier_local::change_ownership(const std::string & user, const std::string & group)
     {
 	if(is_terminated())
@@ -307,6 +328,142 @@ namespace libdar
         return true; // we never make partial reading, here
     }
 
+    bool fichier_local::inherited_read_lend(const char * & ptr, U_I & size)
+    {
+#if HAVE_SYS_MMAN_H && HAVE_MMAP
+	off_t pos;
+
+	if(!mmap_allowed)
+	    return false;
+
+#ifdef MUTEX_WORKS
+	check_self_cancellation();
+#endif
+	pos = lseek(filedesc, 0, SEEK_CUR);
+	if(pos < 0)
+	    throw Erange("fichier_local::inherited_read_lend", string(gettext("Error getting file reading position: ")) + tools_strerror_r(errno));
+
+	if(map_base == nullptr
+	   || pos < map_offset
+	   || pos >= map_offset + (off_t)(map_len))
+	{
+	    struct stat dat;
+	    off_t window_offset = pos - pos % mmap_window;
+	    void *tmp;
+
+	    unmap();
+	    if(fstat(filedesc, &dat) < 0)
+		throw Erange("fichier_local::inherited_read_lend", string(gettext("Error getting size of file: ")) + tools_strerror_r(errno));
+
+	    if(!S_ISREG(dat.st_mode))
+	    {
+		mmap_allowed = false;
+		return false;
+	    }
+
+	    if(pos >= dat.st_size)
+	    {
+		size = 0;
+		return true; // EOF
+	    }
+	    map_len = dat.st_size - window_offset > (off_t)(mmap_window) ? mmap_window : (U_I)(dat.st_size - window_offset);
+	    tmp = mmap(nullptr, map_len, PROT_READ, MAP_SHARED, filedesc, window_offset);
+	    if(tmp == MAP_FAILED)
+	    {
+		    // falling back to read() for the rest of the file
+		map_len = 0;
+		mmap_allowed = false;
+		return false;
+	    }
+	    map_base = (char *)tmp;
+	    map_offset = window_offset;
+	}
+
+	if(size > (U_I)(map_offset + map_len - pos))
+	    size = map_offset + map_len - pos;
+	ptr = map_base + (pos - map_offset);
+	lent_offset = pos;
+
+	if(lseek(filedesc, pos + size, SEEK_SET) < 0)
+	    throw Erange("fichier_local::inherited_read_lend", string(gettext("Error while reading from file: ")) + tools_strerror_r(errno));
+
+	return true;
+#else
+	return false;
+#endif
+    }
+
+    bool fichier_local::inherited_lent_from(S_I & fd, infinint & offset) const
+    {
+	if(map_base == nullptr)
+	    return false;
+
+	fd = filedesc;
+	offset = lent_offset;
+
+	return true;
+    }
+
+    U_I fichier_local::inherited_write_lent(S_I fd, const infinint & offset, U_I size)
+    {
+#if HAVE_COPY_FILE_RANGE
+	U_I copied = 0;
+	off_t off_in = 0;
+	infinint tmp = offset;
+	ssize_t ret;
+
+	if(!copy_range)
+	    return 0;
+
+	tmp.unstack(off_in);
+	if(!tmp.is_zero())
+	    return 0; // offset too large for the system
+
+#ifdef MUTEX_WORKS
+	check_self_cancellation();
+#endif
+
+	    // the system copies the data between the two files without passing it
+	    // through user space, sharing the disk blocks (reflink) when the filesystem
+	    // supports it and the offsets are aligned the same way
+
+	while(copied < size)
+	{
+	    ret = copy_file_range(fd, &off_in, filedesc, nullptr, size - copied, 0);
+	    if(ret < 0)
+	    {
+		switch(errno)
+		{
+		case EINTR:
+		    continue;
+		case EXDEV:
+		case EINVAL:
+		case ENOSYS:
+		case EOPNOTSUPP:
+		case EBADF:
+		    copy_range = false; // not supported between these files, write() will be used from now on
+		    break;
+		default:
+		    break; // the remaining data is written by write(), which reports the error if any
+		}
+		break;
+	    }
+	    else
+		if(ret == 0)
+		    break; // source file shorter than expected, leaving write() do the job with the lent data
+		else
+		    copied += ret;
+	}
+
+	if(copied > 0 && adv == advise_dontneed)
+	    fadvise(adv);
+
+	return copied;
+#else
+	return 0;
+#endif
+    }
+
     U_I fichier_local::fichier_global_inherited_write(const char *a, U_I size)
     {
         ssize_t ret;
@@ -375,6 +532,12 @@ namespace libdar
 	U_I o_mode = O_BINARY;
 	const char *name = chemin.c_str();
 	adv = advise_normal;
+	mmap_allowed = false;
+	map_base = nullptr;
+	map_offset = 0;
+	map_len = 0;
+	lent_offset = 0;
+	copy_range = true;
 
         switch(m)
         {
@@ -456,6 +619,13 @@ namespace libdar
 
     void fichier_local::copy_from(const fichier_local & ref)
     {
+	adv = ref.adv;
+	mmap_allowed = ref.mmap_allowed;
+	map_base = nullptr; // the mapping is not shared, a new one will be created on demand
+	map_offset = 0;
+	map_len = 0;
+	lent_offset = ref.lent_offset;
+	copy_range = ref.copy_range;
 	filedesc = dup(ref.filedesc);
 	if(filedesc < 0)
 	{
@@ -468,6 +638,26 @@ namespace libdar
     {
 	swap(filedesc, ref.filedesc);
 	swap(adv, ref.adv);
+	swap(mmap_allowed, ref.mmap_allowed);
+	swap(map_base, ref.map_base);
+	swap(map_offset, ref.map_offset);
+	swap(map_len, ref.map_len);
+	swap(lent_offset, ref.lent_offset);
+	swap(copy_range, ref.copy_range);
+    }
+
+    void fichier_local::unmap()
+    {
+#if HAVE_SYS_MMAN_H && HAVE_MMAP
+	if(map_base != nullptr)
+	{
+	    (void)munmap(map_base, map_len);
+	    map_base = nullptr;
+	    map_len = 0;
+	    if(adv == advise_dontneed)
+		fadvise(adv);
+	}
+#endif
     }
 
     int fichier_local::advise_to_int(advise arg) const
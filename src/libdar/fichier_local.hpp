@@ -70,11 +70,16 @@ namespace libdar
 	    /// \note can only build a read-only object
 	fichier_local(const std::string & chemin, bool furtive_mode = false);
 
+	    /// constructor from an already opened filedescriptor
+
+	    /// \note the object takes ownership of fd and closes it when destroyed
+	fichier_local(const std::shared_ptr<user_interaction> & dialog, S_I fd, gf_mode m);
+
 	    /// copy constructor
 	fichier_local(const fichier_local & ref) : fichier_global(ref) { copy_from(ref); };
 
 	    /// move constructor
-	fichier_local(fichier_local && ref) noexcept: fichier_global(std::move(ref)) { move_from(std::move(ref)); };
+	fichier_local(fichier_local && ref) noexcept: fichier_global(std::move(ref)) { filedesc = -1; adv = advise_normal; mmap_allowed = false; map_base = nullptr; map_offset = 0; map_len = 0; lent_offset = 0; copy_range = true; move_from(std::move(ref)); };
 
 	    /// assignment operator
 	fichier_local & operator = (const fichier_local & ref) { detruit(); fichier_local::operator = (ref); copy_from(ref); return *this; };
@@ -105,6 +110,14 @@ namespace libdar
         virtual bool skip_relative(S_I x) override;
         virtual infinint get_position() const override;
 
+	    /// let read_lend() provide data straight from a memory mapping of the file
+
+	    /// \note the file is mapped by windows of mmap_window bytes, only while read_lend()
+	    /// is used, read() still relies on read(2). This must only be set on files that
+	    /// are not expected to be truncated while being read, as accessing a mapping past
+	    /// the end of the file would lead the process to receive a SIGBUS signal
+	void allow_mmap(bool mode) { mmap_allowed = mode; if(!mode) unmap(); };
+
 	    /// provide the low level filedescriptor to the call and terminate()
 
 	    /// \note this is the caller duty to close() the provided filedescriptor
@@ -113,17 +126,28 @@ namespace libdar
     protected :
 	    // inherited from generic_file grand-parent class
 	virtual void inherited_read_ahead(const infinint & amount) override {}; // nothing done, calling readahead(2) could be added in the future
+	virtual bool inherited_read_lend(const char * & ptr, U_I & size) override;
+	virtual bool inherited_lent_from(S_I & fd, infinint & offset) const override;
+	virtual U_I inherited_write_lent(S_I fd, const infinint & offset, U_I size) override;
 	virtual void inherited_sync_write() override { fsync(); };
 	virtual void inherited_flush_read() override {}; // nothing stored in transit in this object
-	virtual void inherited_terminate() override { if(adv == advise_dontneed) fadvise(adv); };
+	virtual void inherited_terminate() override { unmap(); if(adv == advise_dontneed) fadvise(adv); };
 
 	    // inherited from fichier_global parent class
 	virtual U_I fichier_global_inherited_write(const char *a, U_I size) override;
         virtual bool fichier_global_inherited_read(char *a, U_I size, U_I & read, std::string & message) override;
 
     private :
+	static constexpr U_I mmap_window = 16*1024*1024; ///< size of the mapped part of the file, must be a multiple of the page size
+
         S_I filedesc;
 	advise adv;
+	bool mmap_allowed;  ///< whether read_lend() may use a mapping of the file
+	char *map_base;     ///< address of the currently mapped window or nullptr
+	off_t map_offset;   ///< offset in the file of the mapped window
+	U_I map_len;        ///< length of the mapped window
+	off_t lent_offset;  ///< offset in the file of the data lent by the last call to read_lend()
+	bool copy_range;    ///< whether copy_file_range() can be tried to write data lent from another file
 
 	void open(const std::string & chemin,
 		  gf_mode m,
@@ -134,7 +158,8 @@ namespace libdar
 
 	void copy_from(const fichier_local & ref);
 	void move_from(fichier_local && ref) noexcept;
-	void detruit() { if(filedesc >= 0) close(filedesc); filedesc = -1; };
+	void detruit() { unmap(); if(filedesc >= 0) close(filedesc); filedesc = -1; };
+	void unmap();
 	int advise_to_int(advise arg) const;
 
 	    /// sync the data to disk
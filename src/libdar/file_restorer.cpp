@@ -0,0 +1,394 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include "file_restorer.hpp"
+#include "erreurs.hpp"
+#include "tools.hpp"
+#include "fichier_local.hpp"
+#include "ea_filesystem.hpp"
+#include "filesystem_tools.hpp"
+#include "user_interaction_blind.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+	/// thread running file_restorer::work()
+
+    class file_restorer_worker : public libthreadar::thread
+    {
+    public:
+	file_restorer_worker(file_restorer & owner): ref(owner) {};
+
+    protected:
+	virtual void inherited_run() override { ref.work(); };
+
+    private:
+	file_restorer & ref;
+    };
+
+	/// keeps the messages a worker would have shown, answers no to any question
+
+    class file_restorer_messages : public user_interaction_blind
+    {
+    public:
+	deque<string> messages;
+
+    protected:
+	virtual void inherited_message(const string & message) override { messages.push_back(message); };
+    };
+
+
+    file_restorer::file_restorer(U_I x_workers,
+				 U_I x_max_pending,
+				 const mask & x_ea_mask,
+				 comparison_fields x_what_to_check,
+				 const fsa_scope & x_scope): lock(2)
+    {
+	max_pending = x_max_pending;
+	ea_mask = &x_ea_mask;
+	what_to_check = x_what_to_check;
+	scope = x_scope;
+	running = 0;
+	stopping = false;
+
+	if(max_pending == 0 || x_workers == 0)
+	    throw SRC_BUG;
+
+	try
+	{
+	    for(U_I i = 0; i < x_workers; ++i)
+	    {
+		file_restorer_worker *tmp = new (nothrow) file_restorer_worker(*this);
+		if(tmp == nullptr)
+		    throw Ememory("file_restorer::file_restorer");
+		workers.push_back(tmp);
+		tmp->run();
+	    }
+	}
+	catch(...)
+	{
+	    release();
+	    throw;
+	}
+    }
+
+    file_restorer::~file_restorer()
+    {
+	release();
+    }
+
+    void file_restorer::push(const string & chem,
+			     const cat_inode & ino,
+			     const ea_attributs *ea,
+			     const filesystem_specific_attribute_list *fsa,
+			     memory_file *data)
+    {
+	job added;
+
+	if(data == nullptr)
+	    throw SRC_BUG;
+
+	added.chem = chem;
+	added.ino = &ino;
+	added.ea = ea;
+	added.fsa = fsa;
+	added.data = data;
+
+	lock.lock();
+	try
+	{
+	    while(!error && todo.size() + running >= max_pending)
+		lock.wait(1);
+	    check_error();
+	    todo.push_back(added);
+	    lock.signal(0);
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    delete data;
+	    throw;
+	}
+	lock.unlock();
+    }
+
+    void file_restorer::wait(U_I pending)
+    {
+	lock.lock();
+	try
+	{
+	    while(!error && todo.size() + running > pending)
+		lock.wait(1);
+	    check_error();
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    throw;
+	}
+	lock.unlock();
+    }
+
+    bool file_restorer::get_result(result & res)
+    {
+	bool ret = false;
+
+	lock.lock();
+	try
+	{
+	    check_error();
+	    if(!done.empty())
+	    {
+		res = move(done.front());
+		done.pop_front();
+		ret = true;
+	    }
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    throw;
+	}
+	lock.unlock();
+
+	return ret;
+    }
+
+    void file_restorer::work()
+    {
+	try
+	{
+	    while(true)
+	    {
+		job current;
+		result res;
+
+		current.data = nullptr;
+		lock.lock();
+		try
+		{
+		    while(!stopping && !error && todo.empty())
+			lock.wait(0);
+
+		    if(!stopping && !error)
+		    {
+			current = todo.front();
+			todo.pop_front();
+			++running;
+		    }
+		}
+		catch(...)
+		{
+		    lock.unlock();
+		    throw;
+		}
+		lock.unlock();
+
+		if(current.data == nullptr)
+		    return; // stopping
+
+		try
+		{
+		    restore(current, res);
+		}
+		catch(...)
+		{
+		    delete current.data;
+		    throw;
+		}
+		delete current.data;
+
+		lock.lock();
+		try
+		{
+		    --running;
+		    done.push_back(move(res));
+		    lock.signal(1);
+		}
+		catch(...)
+		{
+		    lock.unlock();
+		    throw;
+		}
+		lock.unlock();
+	    }
+	}
+	catch(...)
+	{
+		// the exception is thrown back to the
+		// caller by push(), wait() or get_result(),
+		// nothing is done anymore
+	    lock.lock();
+	    if(!error)
+		error = current_exception();
+	    lock.broadcast(0);
+	    lock.signal(1);
+	    lock.unlock();
+	}
+    }
+
+    void file_restorer::restore(const job & current, result & res)
+    {
+	shared_ptr<file_restorer_messages> ui(new (nothrow) file_restorer_messages());
+
+	if(!ui)
+	    throw Ememory("file_restorer::restore");
+
+	res.chem = current.chem;
+	res.ea_restored = false;
+	res.fsa_restored = false;
+	res.error.clear();
+
+	try
+	{
+		// 1 - restoring data
+
+	    fichier_local dest = fichier_local(ui, current.chem, gf_write_only, 0700, false, true, false);
+
+	    current.data->skip(0);
+	    current.data->copy_to(dest);
+	    dest.fadvise(fichier_global::advise_dontneed);
+	    dest.terminate();
+
+		// 2 - restoring EA
+
+	    if(current.ea != nullptr)
+	    {
+		try
+		{
+		    (void)ea_filesystem_write_ea(current.chem, *current.ea, *ea_mask);
+		    res.ea_restored = true;
+		}
+		catch(Erange & e)
+		{
+		    ui->message(tools_printf(gettext("Restoration of EA for %S aborted: "), &current.chem) + e.get_message());
+		}
+	    }
+
+		// 3 - restoring FSA but the linux immutable flag
+
+	    if(current.fsa != nullptr)
+	    {
+		try
+		{
+		    res.fsa_restored = current.fsa->set_fsa_to_filesystem_for(current.chem, scope, *ui, false);
+		}
+		catch(Erange & e)
+		{
+		    ui->message(tools_printf(gettext("Restoration of FSA for %S aborted: "), &current.chem) + e.get_message());
+		}
+	    }
+
+		// 4 - restoring dates
+
+	    filesystem_tools_make_date(*current.ino, current.chem, what_to_check, scope);
+
+		// 5 - restoring permission and ownership
+
+	    filesystem_tools_make_owner_perm(*ui, *current.ino, current.chem, what_to_check, scope);
+
+		// 6 - re-setting EA to set back linux capabilities lost by the change of ownership
+
+	    if(current.ea != nullptr)
+	    {
+		try
+		{
+		    (void)ea_filesystem_write_ea(current.chem, *current.ea, *ea_mask);
+		}
+		catch(Erange & e)
+		{
+			// same error as the first time, already reported
+		}
+	    }
+
+		// 7 - setting the linux immutable flag if present
+
+	    if(current.fsa != nullptr)
+	    {
+		try
+		{
+		    res.fsa_restored = current.fsa->set_fsa_to_filesystem_for(current.chem, scope, *ui, true);
+		}
+		catch(Erange & e)
+		{
+		    ui->message(tools_printf(gettext("Restoration of linux immutable FSA for %S aborted: "), &current.chem) + e.get_message());
+		}
+	    }
+	}
+	catch(Ebug & e)
+	{
+	    throw;
+	}
+	catch(Egeneric & e)
+	{
+	    res.error = e.get_message();
+	}
+
+	res.messages = move(ui->messages);
+    }
+
+    void file_restorer::check_error()
+    {
+	if(error)
+	    rethrow_exception(error);
+    }
+
+    void file_restorer::release()
+    {
+	lock.lock();
+	stopping = true;
+	lock.broadcast(0);
+	lock.unlock();
+
+	for(deque<file_restorer_worker *>::iterator wt = workers.begin(); wt != workers.end(); ++wt)
+	{
+	    if(*wt != nullptr)
+	    {
+		try
+		{
+		    (*wt)->join();
+		}
+		catch(...)
+		{
+			// ignore all exceptions
+		}
+		delete *wt;
+		*wt = nullptr;
+	    }
+	}
+	workers.clear();
+
+	for(deque<job>::iterator it = todo.begin(); it != todo.end(); ++it)
+	{
+	    if(it->data != nullptr)
+	    {
+		delete it->data;
+		it->data = nullptr;
+	    }
+	}
+	todo.clear();
+    }
+
+} // end of namespace
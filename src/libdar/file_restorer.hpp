@@ -0,0 +1,160 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+    /// \file file_restorer.hpp
+    /// \brief creates restored plain files and sets their attributes, in separated threads
+    /// \ingroup Private
+
+#ifndef FILE_RESTORER_HPP
+#define FILE_RESTORER_HPP
+
+#include "../my_config.h"
+
+#if HAVE_LIBTHREADAR_LIBTHREADAR_HPP
+#include <libthreadar/libthreadar.hpp>
+#endif
+
+#include <deque>
+#include <exception>
+#include <string>
+#include "integers.hpp"
+#include "mask.hpp"
+#include "archive_aux.hpp"
+#include "memory_file.hpp"
+#include "cat_inode.hpp"
+#include "fsa_family.hpp"
+#include "ea.hpp"
+#include "filesystem_specific_attribute.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+    class file_restorer_worker;
+
+	/// restores plain files which data has already been read from the archive
+
+	/// filesystem_restore reads the data of small files from the archive into memory,
+	/// then gives them here: several threads create the files, write their data
+	/// and set their EA, FSA, dates, ownership and permission the way filesystem_restore
+	/// does for a file it restores itself. The inode given with a file is only read
+	/// from the threads, its EA and FSA must have been fetched from the archive before.
+	/// Messages the threads would have shown are kept with the result of the file,
+	/// for the caller to show them from its own thread.
+
+    class file_restorer
+    {
+    public:
+	    /// what has been done for a file
+	struct result
+	{
+	    std::string chem;                     ///< path of the restored file
+	    bool ea_restored;                     ///< whether EA have been restored
+	    bool fsa_restored;                    ///< whether FSA have been restored
+	    std::deque<std::string> messages;     ///< messages to show to the user
+	    std::string error;                    ///< why the file could not be restored, empty if it has been
+	};
+
+	    /// constructor
+
+	    /// \param[in] workers number of threads to restore files
+	    /// \param[in] max_pending maximum number of files given and not yet restored
+	    /// \param[in] ea_mask EA to consider, the object must survive the file_restorer
+	    /// \param[in] what_to_check fields to restore
+	    /// \param[in] scope FSA families to consider
+	file_restorer(U_I workers,
+		      U_I max_pending,
+		      const mask & ea_mask,
+		      comparison_fields what_to_check,
+		      const fsa_scope & scope);
+	file_restorer(const file_restorer & ref) = delete;
+	file_restorer(file_restorer && ref) noexcept = delete;
+	file_restorer & operator = (const file_restorer & ref) = delete;
+	file_restorer & operator = (file_restorer && ref) noexcept = delete;
+
+	    /// destructor
+
+	    /// files not yet started are not restored, use wait() before for them to be
+	~file_restorer();
+
+	    /// give a file to restore
+
+	    /// \param[in] chem full path of the file to create
+	    /// \param[in] ino inode of the file, must survive until the result of the file has been fetched
+	    /// \param[in] ea EA to set to the file or nullptr if none
+	    /// \param[in] fsa FSA to set to the file or nullptr if none
+	    /// \param[in] data the file data, the object passes under the responsibility of the file_restorer
+	    /// \note waits for a file to be restored when max_pending would be exceeded
+	void push(const std::string & chem,
+		  const cat_inode & ino,
+		  const ea_attributs *ea,
+		  const filesystem_specific_attribute_list *fsa,
+		  memory_file *data);
+
+	    /// wait for the files to be restored
+
+	    /// \param[in] pending the number of files that may still not be restored when returning
+	void wait(U_I pending);
+
+	    /// fetch the result of a restored file
+
+	    /// \return false if no file has been restored since last call, res is then left unchanged
+	    /// \note results are provided in the order the files were restored which is not always
+	    /// the order they were given
+	bool get_result(result & res);
+
+    private:
+	struct job
+	{
+	    std::string chem;
+	    const cat_inode *ino;
+	    const ea_attributs *ea;
+	    const filesystem_specific_attribute_list *fsa;
+	    memory_file *data;
+	};
+
+	U_I max_pending;
+	const mask *ea_mask;
+	comparison_fields what_to_check;
+	fsa_scope scope;
+	libthreadar::condition lock;           ///< protects the following fields, instance 0 is used by the workers, instance 1 by push() and wait()
+	std::deque<job> todo;                  ///< files not yet started
+	U_I running;                           ///< number of files being restored
+	std::deque<result> done;               ///< files restored and not yet fetched
+	std::exception_ptr error;              ///< unexpected exception met by a worker, all workers then stop
+	bool stopping;                         ///< set when the workers have to end
+	std::deque<file_restorer_worker *> workers;
+
+	void work();                           ///< the routine the workers run
+	void restore(const job & current, result & res); ///< restore a file
+	void check_error();                    ///< throw the exception met by a worker, if any (lock must be acquired)
+	void release();
+
+	friend class file_restorer_worker;
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
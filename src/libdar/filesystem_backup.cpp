@@ -120,6 +120,11 @@ extern "C"
 #include "generic_rsync.hpp"
 #include "null_file.hpp"
 
+#if defined( LIBTHREADAR_AVAILABLE ) && HAVE_FDOPENDIR && HAVE_FSTATAT
+#define FILESYSTEM_SCANNER_AVAILABLE
+#include "filesystem_scanner.hpp"
+#endif
+
 #ifndef UNIX_PATH_MAX
 #define UNIX_PATH_MAX 104
 #endif
@@ -139,12 +144,15 @@ namespace libdar
 					 bool x_cache_directory_tagging,
 					 infinint & root_fs_device,
 					 bool x_ignore_unknown,
-					 const fsa_scope & scope):
+					 const fsa_scope & scope,
+					 bool multi_threaded,
+					 bool physical_order):
 	filesystem_hard_link_read(dialog, x_furtive_read_mode, scope)
     {
 	fs_root = nullptr;
 	current_dir = nullptr;
 	ea_mask = nullptr;
+	scan = nullptr;
 	try
 	{
 	    fs_root = filesystem_tools_get_root_with_symlink(*dialog, root, x_info_details);
@@ -160,6 +168,17 @@ namespace libdar
 	    ea_mask = x_ea_mask.clone();
 	    if(ea_mask == nullptr)
 		throw Ememory("filesystem_backup::filesystem_backup");
+	    ahead.set_physical_order(physical_order);
+#ifdef FILESYSTEM_SCANNER_AVAILABLE
+		// reading a directory ahead modifies its last access time before
+		// we record it, which is only acceptable if it is not restored
+	    if(multi_threaded && (alter_atime || furtive_read_mode))
+	    {
+		scan = new (nothrow) filesystem_scanner(furtive_read_mode);
+		if(scan == nullptr)
+		    throw Ememory("filesystem_backup::filesystem_backup");
+	    }
+#endif
 	    reset_read(root_fs_device);
 	}
 	catch(...)
@@ -171,6 +190,13 @@ namespace libdar
 
     void filesystem_backup::detruire()
     {
+#ifdef FILESYSTEM_SCANNER_AVAILABLE
+	if(scan != nullptr)
+	{
+	    delete scan;
+	    scan = nullptr;
+	}
+#endif
         if(fs_root != nullptr)
         {
             delete fs_root;
@@ -191,6 +217,10 @@ namespace libdar
     void filesystem_backup::reset_read(infinint & root_fs_device)
     {
         corres_reset();
+#ifdef FILESYSTEM_SCANNER_AVAILABLE
+	if(scan != nullptr && current_dir != nullptr)
+	    scan->forget(*fs_root);
+#endif
         if(current_dir != nullptr)
             delete current_dir;
         current_dir = new (nothrow) path(*fs_root);
@@ -209,6 +239,10 @@ namespace libdar
 	    {
 		pile.push_back(etage(get_ui(), tmp, ref_dir->get_last_access(), ref_dir->get_last_modif(), cache_directory_tagging, furtive_read_mode));
 		root_fs_device = ref_dir->get_device();
+#ifdef FILESYSTEM_SCANNER_AVAILABLE
+		if(scan != nullptr)
+		    scan->schedule(*current_dir, pile.back().fichier, pile.back().fichier_type);
+#endif
 	    }
 	    else
 		if(ref == nullptr)
@@ -257,6 +291,10 @@ namespace libdar
 		    if(!alter_atime && !furtive_read_mode)
 			tools_noexcept_make_date(current_dir->display(), false, inner.last_acc, inner.last_mod, inner.last_mod);
                     pile.pop_back();
+#ifdef FILESYSTEM_SCANNER_AVAILABLE
+		    if(scan != nullptr)
+			scan->forget(*current_dir);
+#endif
                     if(pile.empty())
                         return false; // end of filesystem
 		    else
@@ -274,7 +312,7 @@ namespace libdar
 
                         if(!no_dump_check || !filesystem_tools_is_nodump_flag_set(get_ui(), *current_dir, name, info_details))
                         {
-			    ref = make_read_entree(*current_dir, name, true, *ea_mask);
+			    ref = make_read_entree(*current_dir, name, true, *ea_mask, inner.fd);
 
 			    try
 			    {
@@ -288,12 +326,32 @@ namespace libdar
 
 				    try
 				    {
-					pile.push_back(etage(get_ui(),
-							     ptr_name,
-							     ref_dir->get_last_access(),
-							     ref_dir->get_last_modif(),
-							     cache_directory_tagging,
-							     furtive_read_mode));
+					deque<string> contents;
+					deque<etage::entry_type> types;
+
+#ifdef FILESYSTEM_SCANNER_AVAILABLE
+					if(scan != nullptr && scan->take(*current_dir, contents, types))
+					    pile.push_back(etage(get_ui(),
+								 ptr_name,
+								 move(contents),
+								 move(types),
+								 ref_dir->get_last_access(),
+								 ref_dir->get_last_modif(),
+								 cache_directory_tagging));
+					else
+#endif
+					{
+					    pile.push_back(etage(get_ui(),
+								 ptr_name,
+								 ref_dir->get_last_access(),
+								 ref_dir->get_last_modif(),
+								 cache_directory_tagging,
+								 furtive_read_mode));
+#ifdef FILESYSTEM_SCANNER_AVAILABLE
+					    if(scan != nullptr)
+						scan->schedule(*current_dir, pile.back().fichier, pile.back().fichier_type);
+#endif
+					}
 				    }
 				    catch(Egeneric & e)
 				    {
@@ -364,6 +422,33 @@ namespace libdar
             return true;
     }
 
+    void filesystem_backup::read_ahead_next_files()
+    {
+	if(pile.empty() || current_dir == nullptr)
+	    return;
+
+	etage & inner = pile.back();
+	U_I window = ahead.get_max_files();
+
+	if(window > inner.fichier.size())
+	    window = inner.fichier.size();
+
+	    // waiting for half of the window to be consumed before
+	    // asking for more, to not start a thread for each file
+
+	if(inner.read_ahead * 2 > window || inner.read_ahead >= window)
+	    return;
+
+	vector<string> paths;
+
+	for(U_I i = inner.read_ahead; i < window; ++i)
+	    if(inner.fichier_type[i] == etage::entry_type::regular
+	       || inner.fichier_type[i] == etage::entry_type::unknown)
+		paths.push_back(current_dir->append(inner.fichier[i]).display());
+	inner.read_ahead = window;
+	ahead.fetch(paths);
+    }
+
     void filesystem_backup::skip_read_to_parent_dir()
     {
         string tmp;
@@ -375,6 +460,10 @@ namespace libdar
 	    if(!alter_atime && !furtive_read_mode)
 		tools_noexcept_make_date(current_dir->display(), false, pile.back().last_acc, pile.back().last_mod, pile.back().last_mod);
             pile.pop_back();
+#ifdef FILESYSTEM_SCANNER_AVAILABLE
+	    if(scan != nullptr)
+		scan->forget(*current_dir);
+#endif
         }
 
         if(! current_dir->pop(tmp))
@@ -45,11 +45,15 @@ extern "C"
 #include "etage.hpp"
 #include "cat_entree.hpp"
 #include "filesystem_hard_link_read.hpp"
+#include "filesystem_read_ahead.hpp"
 
 #include <set>
 
 namespace libdar
 {
+
+    class filesystem_scanner;
+
 	/// \addtogroup Private
 	/// @{
 
@@ -68,7 +72,9 @@ namespace libdar
 			  bool x_cache_directory_tagging,
 			  infinint & root_fs_device,
 			  bool x_ignore_unknown,
-			  const fsa_scope & scope);
+			  const fsa_scope & scope,
+			  bool multi_threaded = false,
+			  bool physical_order = false);
         filesystem_backup(const filesystem_backup & ref) = delete;
 	filesystem_backup(filesystem_backup && ref) = delete;
         filesystem_backup & operator = (const filesystem_backup & ref) = delete;
@@ -80,6 +86,12 @@ namespace libdar
         void skip_read_to_parent_dir();
             //  continue reading in parent directory and
             // ignore all entry not yet read of current directory
+
+	    /// ask the system to fetch the data of the next files of the current directory
+
+	    /// \note to be called when the data of the file last returned by read() is about to be
+	    /// saved, for the data of the following files to be loaded while this one is processed
+	void read_ahead_next_files();
     private:
 
         path *fs_root;           //< filesystem's root to consider
@@ -92,6 +104,8 @@ namespace libdar
         path *current_dir;       //< needed to translate from an hard linked inode to an  already allocated object
         std::deque<etage> pile;  //< to store the contents of a directory
 	bool ignore_unknown;     //< whether to ignore unknown inode types
+	filesystem_read_ahead ahead; //< fetches in background the data of the next files
+	filesystem_scanner *scan; //< reads directories ahead, nullptr if not used
 
         void detruire();
     };
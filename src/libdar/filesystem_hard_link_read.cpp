@@ -131,7 +131,7 @@ namespace libdar
 			  cat_inode *ino,
 			  const mask & ea_mask);
 
-    cat_nomme *filesystem_hard_link_read::make_read_entree(const path & lieu, const string & name, bool see_hard_link, const mask & ea_mask)
+    cat_nomme *filesystem_hard_link_read::make_read_entree(const path & lieu, const string & name, bool see_hard_link, const mask & ea_mask, int lieu_fd)
     {
 	const string display = name.empty() ? lieu.display() : (lieu.append(name)).display();
         const char *ptr_name = display.c_str();
@@ -144,6 +144,11 @@ namespace libdar
 	    int val = 0;
 	    bool use_stat = ignore_if_symlink(display);
 
+#if HAVE_FSTATAT
+	    if(lieu_fd >= 0 && !name.empty())
+		val = fstatat(lieu_fd, name.c_str(), &buf, use_stat ? 0 : AT_SYMLINK_NOFOLLOW);
+	    else
+#endif
 	    if(use_stat)
 		val = stat(ptr_name, &buf);
 	    else
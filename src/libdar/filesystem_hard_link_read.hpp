@@ -102,7 +102,8 @@ namespace libdar
         cat_nomme *make_read_entree(const path & lieu,         ///< path of the file to read
 				    const std::string & name,  ///< name of the file to read
 				    bool see_hard_link,        ///< whether we want to detect hard_link and eventually return a cat_mirage object (not necessary when diffing an archive with filesystem)
-				    const mask & ea_mask       ///< which EA to consider when creating the object
+				    const mask & ea_mask,      ///< which EA to consider when creating the object
+				    int lieu_fd = -1           ///< if not negative, file descriptor of lieu, the inode is then read relatively to it
 	    );
 
 	bool get_ask_before_zeroing_neg_dates() const { return ask_before_zeroing_neg_dates; };
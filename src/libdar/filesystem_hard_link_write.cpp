@@ -348,66 +348,16 @@ namespace libdar
 		}
 		else if(ref_fil != nullptr)
 		{
-		    generic_file *ou;
-		    infinint seek;
-
 		    fichier_local dest = fichier_local(get_pointer(), display, gf_write_only, 0700, false, true, false);
 			// the implicit destruction of dest (exiting the block)
 			// will close the 'ret' file descriptor (see ~fichier_local())
-		    ou = ref_fil->get_data(cat_file::normal, nullptr, 0, nullptr);
-
-		    try
-		    {
-			const crc *crc_ori = nullptr;
-			crc *crc_dyn = nullptr;
-			infinint crc_size;
-
-			try
-			{
-
-			    if(!ref_fil->get_crc_size(crc_size))
-				crc_size = tools_file_size_to_crc_size(ref_fil->get_size());
-
-			    ou->skip(0);
-			    ou->read_ahead(ref_fil->get_storage_size());
-			    ou->copy_to(dest, crc_size, crc_dyn);
 
-			    if(crc_dyn == nullptr)
-				throw SRC_BUG;
-
-			    if(ref_fil->get_crc(crc_ori))
-			    {
-				if(crc_ori == nullptr)
-				    throw SRC_BUG;
-				if(typeid(*crc_dyn) != typeid(*crc_ori))
-				    throw SRC_BUG;
-				if(*crc_dyn != *crc_ori)
-				    throw Erange("filesystem_hard_link_write::make_file", gettext("Bad CRC, data corruption occurred"));
-				    // else nothing to do, nor to signal
-			    }
-				// else this is a very old archive
-			}
-			catch(...)
-			{
-			    if(crc_dyn != nullptr)
-				delete crc_dyn;
-			    throw;
-			}
-			if(crc_dyn != nullptr)
-			    delete crc_dyn;
+		    copy_data_to(*ref_fil, dest);
 
-			    // nop we do not sync before, so maybe some pages
-			    // will be kept in cache for Linux, maybe not for
-			    // other systems that support fadvise(2)
-			dest.fadvise(fichier_global::advise_dontneed);
-		    }
-		    catch(...)
-		    {
-			if(ou != nullptr)
-			    delete ou;
-			throw;
-		    }
-		    delete ou;
+			// nop we do not sync before, so maybe some pages
+			// will be kept in cache for Linux, maybe not for
+			// other systems that support fadvise(2)
+		    dest.fadvise(fichier_global::advise_dontneed);
 		    ret = 0; // to report a successful operation at the end of the if/else if chain
 		}
 		else if(ref_lie != nullptr)
@@ -483,6 +433,60 @@ namespace libdar
 	while(ret < 0 && errno == ENOSPC);
     }
 
+    void filesystem_hard_link_write::copy_data_to(const cat_file & ref, generic_file & dest)
+    {
+	generic_file *ou = ref.get_data(cat_file::normal, nullptr, 0, nullptr);
+
+	if(ou == nullptr)
+	    throw SRC_BUG;
+
+	try
+	{
+	    const crc *crc_ori = nullptr;
+	    crc *crc_dyn = nullptr;
+	    infinint crc_size;
+
+	    try
+	    {
+		if(!ref.get_crc_size(crc_size))
+		    crc_size = tools_file_size_to_crc_size(ref.get_size());
+
+		ou->skip(0);
+		ou->read_ahead(ref.get_storage_size());
+		ou->copy_to(dest, crc_size, crc_dyn);
+
+		if(crc_dyn == nullptr)
+		    throw SRC_BUG;
+
+		if(ref.get_crc(crc_ori))
+		{
+		    if(crc_ori == nullptr)
+			throw SRC_BUG;
+		    if(typeid(*crc_dyn) != typeid(*crc_ori))
+			throw SRC_BUG;
+		    if(*crc_dyn != *crc_ori)
+			throw Erange("filesystem_hard_link_write::copy_data_to", gettext("Bad CRC, data corruption occurred"));
+			// else nothing to do, nor to signal
+		}
+		    // else this is a very old archive
+	    }
+	    catch(...)
+	    {
+		if(crc_dyn != nullptr)
+		    delete crc_dyn;
+		throw;
+	    }
+	    if(crc_dyn != nullptr)
+		delete crc_dyn;
+	}
+	catch(...)
+	{
+	    delete ou;
+	    throw;
+	}
+	delete ou;
+    }
+
     void filesystem_hard_link_write::clear_corres_if_pointing_to(const infinint & ligne, const string & path)
     {
         map<infinint, corres_ino_ea>::iterator it = corres_write.find(ligne);
@@ -91,6 +91,13 @@ namespace libdar
         void make_file(const cat_nomme * ref,
 		       const path & ou);
 
+	    /// copy the data of a plain file from the archive to the given file, checking its CRC
+
+	    /// \param[in] ref the plain file whose data is to be restored
+	    /// \param[in,out] dest where to copy the data to
+	    /// \note an Erange exception is thrown if the CRC does not match
+	void copy_data_to(const cat_file & ref, generic_file & dest);
+
 	    /// add the given EA matching the given mask to the file pointed to by "e" and spot
 
 	    /// \param[in] e may be an inode or a hard link to an inode,
@@ -0,0 +1,292 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif
+
+#if HAVE_SYS_IOCTL_H
+#include <sys/ioctl.h>
+#endif
+
+#if HAVE_LINUX_FS_H
+#include <linux/fs.h>
+#endif
+
+#if HAVE_LINUX_FIEMAP_H
+#include <linux/fiemap.h>
+#endif
+} // end extern "C"
+
+#include <algorithm>
+
+#if HAVE_LIBTHREADAR_LIBTHREADAR_HPP
+#include <libthreadar/libthreadar.hpp>
+#endif
+
+#include "filesystem_read_ahead.hpp"
+#include "cygwin_adapt.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+    static void read_ahead_files(const vector<string> & paths, U_I max_size, bool physical_order);
+#if HAVE_POSIX_FADVISE
+    static int open_for_read_ahead(const string & chemin, U_I max_size, struct stat & buf);
+#endif
+
+#ifdef LIBTHREADAR_AVAILABLE
+
+	/// thread asking the system to fetch the data of a list of files
+
+    class filesystem_read_ahead_worker : public libthreadar::thread
+    {
+    public:
+	filesystem_read_ahead_worker(U_I max_size): x_max_size(max_size), x_physical_order(false) {};
+
+	void set_job(const vector<string> & paths, bool physical_order) { x_paths = paths; x_physical_order = physical_order; };
+
+    protected:
+	virtual void inherited_run() override { read_ahead_files(x_paths, x_max_size, x_physical_order); };
+
+    private:
+	U_I x_max_size;
+	bool x_physical_order;
+	vector<string> x_paths;
+    };
+
+#else
+
+	// only used as pointed type, which stays nullptr
+    class filesystem_read_ahead_worker {};
+
+#endif
+
+    filesystem_read_ahead::filesystem_read_ahead(U_I x_max_files, U_I x_max_size)
+    {
+	max_files = x_max_files;
+	max_size = x_max_size;
+	physical_order = false;
+	worker = nullptr;
+
+#ifdef LIBTHREADAR_AVAILABLE
+	worker = new (nothrow) filesystem_read_ahead_worker(max_size);
+	if(worker == nullptr)
+	    throw Ememory("filesystem_read_ahead::filesystem_read_ahead");
+#endif
+    }
+
+    filesystem_read_ahead::~filesystem_read_ahead()
+    {
+	if(worker != nullptr)
+	{
+	    wait_worker();
+	    delete worker;
+	    worker = nullptr;
+	}
+    }
+
+    void filesystem_read_ahead::set_physical_order(bool mode)
+    {
+	physical_order = mode;
+	if(physical_order && max_files < physical_order_max_files)
+	    max_files = physical_order_max_files;
+    }
+
+    void filesystem_read_ahead::fetch(const vector<string> & paths)
+    {
+#if HAVE_POSIX_FADVISE
+	if(paths.empty())
+	    return;
+
+#ifdef LIBTHREADAR_AVAILABLE
+	if(worker != nullptr)
+	{
+	    wait_worker();
+	    worker->set_job(paths, physical_order);
+	    worker->run();
+	    return;
+	}
+#endif
+	    // no thread available, asking the system directly:
+	    // posix_fadvise() does not wait for the data to be read
+
+	read_ahead_files(paths, max_size, physical_order);
+#endif
+    }
+
+    void filesystem_read_ahead::wait_worker()
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	try
+	{
+	    worker->join();
+	}
+	catch(...)
+	{
+		// reading ahead is only a hint to the system,
+		// failures are not reported
+	}
+#endif
+    }
+
+#if HAVE_POSIX_FADVISE
+
+	/// position of the data of a file on disk, used to sort files in physical order
+
+    struct location
+    {
+	bool by_inode;  ///< where is an inode number, files located this way come after the others
+	U_64 where;     ///< physical offset of the first extent or inode number
+	int fd;
+	off_t size;
+
+	location(bool x_by_inode, U_64 x_where, int x_fd, off_t x_size): by_inode(x_by_inode), where(x_where), fd(x_fd), size(x_size) {};
+	bool operator < (const location & ref) const { return by_inode < ref.by_inode || (by_inode == ref.by_inode && where < ref.where); };
+    };
+
+    static location locate(int fd, const struct stat & buf)
+    {
+#if HAVE_LINUX_FS_H && HAVE_LINUX_FIEMAP_H && defined(FS_IOC_FIEMAP)
+	    // room for the fiemap header followed by a single extent, aligned for both
+	U_64 storage[(sizeof(struct fiemap) + sizeof(struct fiemap_extent)) / sizeof(U_64) + 1];
+	struct fiemap *map = (struct fiemap *)(storage);
+
+	(void)memset(storage, 0, sizeof(storage));
+	map->fm_start = 0;
+	map->fm_length = ~(U_64)(0);
+	map->fm_extent_count = 1;
+
+	if(ioctl(fd, FS_IOC_FIEMAP, map) == 0
+	   && map->fm_mapped_extents > 0
+	   && (map->fm_extents[0].fe_flags & (FIEMAP_EXTENT_UNKNOWN|FIEMAP_EXTENT_DELALLOC|FIEMAP_EXTENT_DATA_INLINE)) == 0)
+	    return location(false, map->fm_extents[0].fe_physical, fd, buf.st_size);
+#endif
+	    // inode numbers roughly follow the data location on many
+	    // filesystems, which is better than no order at all
+	return location(true, (U_64)(buf.st_ino), fd, buf.st_size);
+    }
+
+#endif
+
+    static void read_ahead_files(const vector<string> & paths, U_I max_size, bool physical_order)
+    {
+#if HAVE_POSIX_FADVISE
+	struct stat buf;
+	int fd;
+
+	if(!physical_order)
+	{
+	    for(vector<string>::const_iterator it = paths.begin(); it != paths.end(); ++it)
+	    {
+		fd = open_for_read_ahead(*it, max_size, buf);
+		if(fd >= 0)
+		{
+		    (void)posix_fadvise(fd, 0, buf.st_size, POSIX_FADV_WILLNEED);
+		    close(fd);
+		}
+	    }
+	}
+	else
+	{
+		// all files are opened first to know where their data lies, then
+		// their data is asked for sorted by disk location, so the disk
+		// head moves in one direction for the whole set of files
+
+	    vector<location> found;
+
+	    found.reserve(paths.size()); // push_back() below will not throw and leak file descriptors
+	    for(vector<string>::const_iterator it = paths.begin(); it != paths.end(); ++it)
+	    {
+		fd = open_for_read_ahead(*it, max_size, buf);
+		if(fd >= 0)
+		    found.push_back(locate(fd, buf));
+	    }
+
+	    sort(found.begin(), found.end());
+
+	    for(vector<location>::iterator it = found.begin(); it != found.end(); ++it)
+	    {
+		(void)posix_fadvise(it->fd, 0, it->size, POSIX_FADV_WILLNEED);
+		close(it->fd);
+	    }
+	}
+#endif
+    }
+
+#if HAVE_POSIX_FADVISE
+
+    static int open_for_read_ahead(const string & chemin, U_I max_size, struct stat & buf)
+    {
+	int fd;
+
+	    // lstat() first, opening a device or a named pipe may block or have side effects
+
+	if(lstat(chemin.c_str(), &buf) < 0
+	   || !S_ISREG(buf.st_mode)
+	   || buf.st_size <= 0
+	   || (U_I)(buf.st_size) > max_size)
+	    return -1;
+
+	    // O_NONBLOCK in case the file has been replaced by a named pipe since lstat()
+
+	fd = ::open(chemin.c_str(), O_RDONLY|O_BINARY|O_NONBLOCK);
+	if(fd < 0)
+	    return -1;
+
+	if(fstat(fd, &buf) != 0
+	   || !S_ISREG(buf.st_mode)
+	   || buf.st_size <= 0
+	   || (U_I)(buf.st_size) > max_size)
+	{
+	    close(fd);
+	    return -1;
+	}
+
+	return fd;
+    }
+
+#endif
+
+} // end of namespace
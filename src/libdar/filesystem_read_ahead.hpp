@@ -0,0 +1,112 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+    /// \file filesystem_read_ahead.hpp
+    /// \brief asks the system to fetch in advance the data of the files about to be saved
+    /// \ingroup Private
+
+#ifndef FILESYSTEM_READ_AHEAD_HPP
+#define FILESYSTEM_READ_AHEAD_HPP
+
+#include "../my_config.h"
+
+#include <string>
+#include <vector>
+#include "integers.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+    class filesystem_read_ahead_worker;
+
+	/// fetches in background the data of the next plain files to be saved
+
+	/// while the data of a file is read, compressed and written to the archive,
+	/// the next files are opened and posix_fadvise(POSIX_FADV_WILLNEED) is
+	/// called on them for the system to load their data in its page cache, so
+	/// disk (or network) accesses overlap with compression. When libthreadar
+	/// is available, the opening and the advice are done by a separated thread,
+	/// which keeps the latency of open() and stat() away from the main thread.
+	/// The amount of data asked ahead is bounded: only plain files not
+	/// larger than max_size are considered, larger files are left to the
+	/// sequential read-ahead of the system.
+	/// In physical order mode, the files of each request are fetched in the order
+	/// their data is located on disk (first extent, or inode number if this is
+	/// not available) rather than in the order they will be read, to avoid head
+	/// seeks between small files on rotating disks; more files are then requested
+	/// at a time.
+	/// \note reading ahead this way does not modify the last access time of files
+
+    class filesystem_read_ahead
+    {
+    public:
+	    /// default number of files to fetch ahead
+	static constexpr U_I default_max_files = 16;
+
+	    /// default size above which a file is not fetched ahead
+	static constexpr U_I default_max_size = 1048576;
+
+	    /// number of files fetched ahead in physical order mode
+	static constexpr U_I physical_order_max_files = 64;
+
+	    /// constructor
+
+	    /// \param[in] max_files maximum number of files fetched ahead
+	    /// \param[in] max_size files larger than that are ignored
+	filesystem_read_ahead(U_I max_files = default_max_files, U_I max_size = default_max_size);
+	filesystem_read_ahead(const filesystem_read_ahead & ref) = delete;
+	filesystem_read_ahead(filesystem_read_ahead && ref) noexcept = delete;
+	filesystem_read_ahead & operator = (const filesystem_read_ahead & ref) = delete;
+	filesystem_read_ahead & operator = (filesystem_read_ahead && ref) noexcept = delete;
+	~filesystem_read_ahead();
+
+	    /// the maximum number of files to give at once to fetch()
+	U_I get_max_files() const { return max_files; };
+
+	    /// whether to fetch files in the order of their data on disk
+	void set_physical_order(bool mode);
+
+	    /// ask the data of the given files to be fetched
+
+	    /// \param[in] paths the files to fetch, in the order they will be read
+	    /// \note waits for the previous request to complete, but not for this one.
+	    /// Entries that are not plain files, that are too large or that cannot
+	    /// be opened are silently ignored
+	void fetch(const std::vector<std::string> & paths);
+
+    private:
+	U_I max_files;
+	U_I max_size;
+	bool physical_order;
+	filesystem_read_ahead_worker *worker; ///< nullptr when libthreadar is not available
+
+	    /// wait for the worker to complete, ignoring errors
+	void wait_worker();
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
@@ -122,6 +122,11 @@ extern "C"
 #include "cat_signature.hpp"
 #include "compile_time_features.hpp"
 #include "op_tools.hpp"
+#include "memory_file.hpp"
+
+#ifdef LIBTHREADAR_AVAILABLE
+#include "file_restorer.hpp"
+#endif
 
 #ifndef UNIX_PATH_MAX
 #define UNIX_PATH_MAX 104
@@ -141,7 +146,8 @@ namespace libdar
 					   bool x_empty,
 					   const crit_action *x_overwrite,
 					   bool x_only_overwrite,
-					   const fsa_scope & scope):
+					   const fsa_scope & scope,
+					   U_I restore_threads):
 	filesystem_hard_link_write(dialog),
 	filesystem_hard_link_read(dialog, compile_time::furtive_read(), scope)
     {
@@ -149,6 +155,7 @@ namespace libdar
 	ea_mask = nullptr;
 	current_dir = nullptr;
 	overwrite = nullptr;
+	restorer = nullptr;
 	try
 	{
 	    fs_root = filesystem_tools_get_root_with_symlink(*dialog, root, x_info_details);
@@ -176,6 +183,25 @@ namespace libdar
 	only_overwrite = x_only_overwrite;
 	reset_write();
 	zeroing_negative_dates_without_asking(); // when reading existing inode to evaluate overwriting action
+
+#ifdef LIBTHREADAR_AVAILABLE
+	if(restore_threads > 1 && !empty)
+	{
+	    try
+	    {
+		    // a few files per thread are kept ready, so the threads do
+		    // not wait for the data of the next file to be read
+		restorer = new (nothrow) file_restorer(restore_threads, restore_threads * 4, *ea_mask, what_to_check, get_fsa_scope());
+		if(restorer == nullptr)
+		    throw Ememory("filesystem_restore::filesystem_restore");
+	    }
+	    catch(...)
+	    {
+		detruire();
+		throw;
+	    }
+	}
+#endif
     }
 
     void filesystem_restore::reset_write()
@@ -218,19 +244,33 @@ namespace libdar
 	if(x_eod != nullptr)
 	{
 	    string tmp;
+	    bool deferred = false;
+
 	    current_dir->pop(tmp);
 	    if(!stack_dir.empty())
 	    {
+		deferred = stack_dir.back().get_deferred();
 		if(!empty && stack_dir.back().get_restore_date())
 		{
 		    string chem = (current_dir->append(stack_dir.back().get_name())).display();
-		    filesystem_tools_make_date(stack_dir.back(), chem, what_to_check, get_fsa_scope());
-		    filesystem_tools_make_owner_perm(get_ui(), stack_dir.back(), chem, what_to_check, get_fsa_scope());
+		    if(deferred)
+			    // files of this directory may not be restored yet,
+			    // its dates and permissions are set by wait_deferred()
+			deferred_dir.push_back(pair<string, stack_dir_t>(chem, stack_dir.back()));
+		    else
+		    {
+			filesystem_tools_make_date(stack_dir.back(), chem, what_to_check, get_fsa_scope());
+			filesystem_tools_make_owner_perm(get_ui(), stack_dir.back(), chem, what_to_check, get_fsa_scope());
+		    }
 		}
 	    }
 	    else
 		throw SRC_BUG;
 	    stack_dir.pop_back();
+	    if(deferred && !stack_dir.empty())
+		    // the permissions of the parent directory must not
+		    // prevent the deferred files to be written
+		stack_dir.back().set_deferred();
 	    return;
 	}
 
@@ -306,6 +346,15 @@ namespace libdar
 			if(info_details)
 			    get_ui().message(string(gettext("Restoring file's data: ")) + spot_display);
 
+			if(defer(x_nom, x_fil, spot_display))
+			{
+			    data_created = true;
+			    data_restored = done_data_deferred;
+			    if(!stack_dir.empty())
+				stack_dir.back().set_restore_date(true);
+			    return;
+			}
+
 			    // 1 - restoring data
 
 			if(!empty)
@@ -1178,6 +1227,133 @@ namespace libdar
 	return ret;
     }
 
+    bool filesystem_restore::get_deferred(string & chem,
+					  bool & ea_restored,
+					  bool & fsa_restored,
+					  string & error)
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	file_restorer::result res;
+
+	if(restorer == nullptr || !restorer->get_result(res))
+	    return false;
+
+	for(deque<string>::iterator it = res.messages.begin(); it != res.messages.end(); ++it)
+	    get_ui().message(*it);
+	chem = res.chem;
+	ea_restored = res.ea_restored;
+	fsa_restored = res.fsa_restored;
+	error = res.error;
+
+	return true;
+#else
+	return false;
+#endif
+    }
+
+    void filesystem_restore::wait_deferred()
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	if(restorer != nullptr)
+	    restorer->wait(0);
+#endif
+
+	restore_deferred_dir();
+    }
+
+    bool filesystem_restore::defer(const cat_nomme *x_nom, const cat_file *x_fil, const string & spot)
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	const ea_attributs *ea = nullptr;
+	const filesystem_specific_attribute_list *fsa = nullptr;
+	memory_file *data = nullptr;
+
+	if(restorer == nullptr
+	   || empty
+	   || x_fil == nullptr
+	   || dynamic_cast<const cat_mirage *>(x_nom) != nullptr  // hard links need the inode to be restored first
+	   || x_fil->get_saved_status() != saved_status::saved
+	   || x_fil->get_sparse_file_detection_read()             // holes would be restored as zeroed data
+	   || x_fil->get_size() > infinint(deferred_max_size))
+	    return false;
+
+	    // EA and FSA are read from the archive here as the threads must not access it,
+	    // in case of failure, the file is restored as usually for the error to be reported
+
+	try
+	{
+	    if(x_fil->ea_get_saved_status() == ea_saved_status::full
+	       || x_fil->ea_get_saved_status() == ea_saved_status::removed)
+		ea = x_fil->get_ea();
+	    if(x_fil->fsa_get_saved_status() == fsa_saved_status::full)
+	    {
+		fsa = x_fil->get_fsa();
+		if(fsa == nullptr)
+		    throw SRC_BUG;
+	    }
+	}
+	catch(Erange & e)
+	{
+	    return false;
+	}
+
+	if(info_details)
+	{
+	    if(ea != nullptr)
+		get_ui().message(string(gettext("Restoring file's EA: ")) + spot);
+	    if(fsa != nullptr)
+	    {
+		get_ui().message(string(gettext("Restoring file's FSA: ")) + spot);
+		if(fsa->has_linux_immutable_set())
+		    get_ui().message(string(gettext("Restoring linux immutable FSA for ")) + spot);
+	    }
+	}
+
+	data = new (nothrow) memory_file();
+	if(data == nullptr)
+	    throw Ememory("filesystem_restore::defer");
+
+	try
+	{
+	    copy_data_to(*x_fil, *data);
+	}
+	catch(...)
+	{
+	    delete data;
+	    throw;
+	}
+
+	restorer->push(spot, *x_fil, ea, fsa, data);
+	if(!stack_dir.empty())
+	    stack_dir.back().set_deferred();
+
+	return true;
+#else
+	return false;
+#endif
+    }
+
+    void filesystem_restore::release_restorer()
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	if(restorer != nullptr)
+	{
+	    delete restorer;
+	    restorer = nullptr;
+	}
+#endif
+    }
+
+    void filesystem_restore::restore_deferred_dir()
+    {
+	while(!deferred_dir.empty())
+	{
+	    filesystem_tools_make_date(deferred_dir.front().second, deferred_dir.front().first, what_to_check, get_fsa_scope());
+	    filesystem_tools_make_owner_perm(get_ui(), deferred_dir.front().second, deferred_dir.front().first, what_to_check, get_fsa_scope());
+	    deferred_dir.pop_front();
+	}
+    }
+
     void filesystem_restore::detruire()
     {
         if(fs_root != nullptr)
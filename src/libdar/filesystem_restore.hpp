@@ -50,6 +50,8 @@ extern "C"
 
 namespace libdar
 {
+    class file_restorer;
+
 	/// \addtogroup Private
 	/// @{
 
@@ -59,6 +61,9 @@ namespace libdar
     {
     public:
 	    /// constructor
+
+	    /// \note when restore_threads is greater than 1, that number of threads restores the
+	    /// small plain files which do not exist yet (requires libthreadar, ignored else)
         filesystem_restore(const std::shared_ptr<user_interaction> & dialog,
 			   const path & root,
 			   bool x_warn_overwrite,
@@ -69,7 +74,8 @@ namespace libdar
 			   bool empty,
 			   const crit_action *x_overwrite,
 			   bool x_only_overwrite,
-			   const fsa_scope & scope);
+			   const fsa_scope & scope,
+			   U_I restore_threads);
 
 	    /// copy constructor is forbidden
         filesystem_restore(const filesystem_restore & ref) = delete;
@@ -84,7 +90,7 @@ namespace libdar
 	filesystem_restore & operator = (filesystem_restore && ref) = delete;
 
 	    /// destructor
-        ~filesystem_restore() { restore_stack_dir_ownership(); detruire(); };
+        ~filesystem_restore() { release_restorer(); restore_deferred_dir(); restore_stack_dir_ownership(); detruire(); };
 
 	    /// reset the writing process for the current object
         void reset_write();
@@ -94,7 +100,8 @@ namespace libdar
 	    done_data_restored,     //< data has been restored to filesystem
 	    done_no_change_no_data, //< no change in filesystem because no data present in archive
 	    done_no_change_policy,  //< no change in filesystem because of overwiting policy decision
-	    done_data_removed       //< data (= whole inode) removed from filesystem
+	    done_data_removed,      //< data (= whole inode) removed from filesystem
+	    done_data_deferred      //< data is being restored by another thread, see get_deferred()
 	};
 
 	    /// restore a libdar object to a filesystem entry both data and EA
@@ -122,18 +129,45 @@ namespace libdar
 	    /// actions to take about overwriting... anoying for the user
 	void ignore_overwrite_restrictions_for_next_write() { ignore_over_restricts = true; };
 
+	    /// fetch what has been done for a file which restoration has been deferred
+
+	    /// \param[out] chem the path of the file
+	    /// \param[out] ea_restored true if EA have been restored
+	    /// \param[out] fsa_restored true if FSA have been restored
+	    /// \param[out] error is empty if the file has been restored, else it tells why it could not
+	    /// \return false if no deferred restoration completed since last call, out parameters are then undefined
+	    /// \note messages about the file are shown from here
+	bool get_deferred(std::string & chem,
+			  bool & ea_restored,
+			  bool & fsa_restored,
+			  std::string & error);
+
+	    /// wait for all deferred restorations to complete then restore the dates and permissions of their directories
+
+	    /// \note get_deferred() has to be called afterward to fetch what has been done for these last files
+	void wait_deferred();
+
+	    /// maximum size of a file for its restoration to be deferred
+	static constexpr U_I deferred_max_size = 1048576;
+
+
 
     private:
 	class stack_dir_t : public cat_directory
 	{
 	public:
-	    stack_dir_t(const cat_directory & ref, bool restore) : cat_directory(ref) { restore_date = restore; };
+	    stack_dir_t(const cat_directory & ref, bool restore) : cat_directory(ref) { restore_date = restore; deferred = false; };
 
 	    bool get_restore_date() const { return restore_date; };
 	    void set_restore_date(bool val) { restore_date = val; };
 
+		/// whether the restoration of a file of this directory or of a subdirectory has been deferred
+	    bool get_deferred() const { return deferred; };
+	    void set_deferred() { deferred = true; };
+
 	private:
 	    bool restore_date;
+	    bool deferred;
 	};
 
         path *fs_root;
@@ -148,14 +182,23 @@ namespace libdar
 	bool ignore_over_restricts;
 	const crit_action *overwrite;
 	bool only_overwrite;
+	file_restorer *restorer;         ///< restores small files in separated threads, nullptr if not used
+	std::deque<std::pair<std::string, stack_dir_t> > deferred_dir; ///< directories which dates and permissions are set once deferred restorations are completed
 
         void detruire();
+	void release_restorer();
+	void restore_deferred_dir();
 	void restore_stack_dir_ownership();
 	user_interaction & get_ui() const { return filesystem_hard_link_read::get_ui(); };
 	std::shared_ptr<user_interaction> get_pointer() const { return filesystem_hard_link_read::get_pointer(); };
 
 	    // subroutines of write()
 
+	    /// read the data, EA and FSA of a file not existing in filesystem and give them to the file_restorer
+
+	    /// \return false if the restoration of that file cannot be deferred, nothing has been done then
+	bool defer(const cat_nomme *x_nom, const cat_file *x_fil, const std::string & spot);
+
 	    /// perform action due to the overwriting policy when the "to be added" entry is a detruit object
 	void action_over_remove(const cat_inode *in_place,
 				const cat_detruit *to_be_added,
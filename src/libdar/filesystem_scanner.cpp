@@ -0,0 +1,489 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif
+
+#if HAVE_DIRENT_H
+#include <dirent.h>
+#endif
+} // end extern "C"
+
+#include "filesystem_scanner.hpp"
+#include "cygwin_adapt.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+	/// thread running filesystem_scanner::work()
+
+    class filesystem_scanner_worker : public libthreadar::thread
+    {
+    public:
+	filesystem_scanner_worker(filesystem_scanner & owner): ref(owner) {};
+
+    protected:
+	virtual void inherited_run() override { ref.work(); };
+
+    private:
+	filesystem_scanner & ref;
+    };
+
+
+    filesystem_scanner::filesystem_scanner(bool x_furtive_read_mode,
+					   U_I num_workers,
+					   U_I x_max_ahead): lock(2)
+    {
+	furtive_read_mode = x_furtive_read_mode;
+	max_ahead = x_max_ahead;
+	ahead = 0;
+	sequence = 0;
+	stopping = false;
+
+	try
+	{
+	    for(U_I i = 0; i < num_workers; ++i)
+	    {
+		workers.push_back(nullptr);
+		workers.back() = new (nothrow) filesystem_scanner_worker(*this);
+		if(workers.back() == nullptr)
+		    throw Ememory("filesystem_scanner::filesystem_scanner");
+		workers.back()->run();
+	    }
+	}
+	catch(...)
+	{
+	    release();
+	    throw;
+	}
+    }
+
+    filesystem_scanner::~filesystem_scanner()
+    {
+	release();
+    }
+
+    void filesystem_scanner::schedule(const path & chemin,
+				      const deque<string> & contents,
+				      const deque<etage::entry_type> & types)
+    {
+	const string key = chemin.display();
+
+	lock.lock();
+	try
+	{
+	    if(!stopping && jobs.find(key) == jobs.end())
+	    {
+		job & added = jobs[key];
+
+		added.status = state::queued;
+		added.listed = true;
+		added.where.push_back(~(U_I)(0) - (++sequence));
+		added.contents = contents;
+		added.types = types;
+		todo.insert(pair<rank, path>(added.where, chemin));
+		lock.signal(0);
+	    }
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    throw;
+	}
+	lock.unlock();
+    }
+
+    bool filesystem_scanner::take(const path & chemin, deque<string> & contents, deque<etage::entry_type> & types)
+    {
+	const string key = chemin.display();
+	bool ret = false;
+
+	lock.lock();
+	try
+	{
+	    map<string, job>::iterator it = jobs.find(key);
+	    bool was_full = ahead >= max_ahead;
+
+	    while(it != jobs.end()
+		  && it->second.status == state::running
+		  && !it->second.listed
+		  && !stopping)
+	    {
+		lock.wait(1);
+		it = jobs.find(key);
+	    }
+
+	    if(it != jobs.end())
+	    {
+		if(it->second.status == state::ready)
+		{
+		    contents.swap(it->second.contents);
+		    types.swap(it->second.types);
+		    ret = true;
+		}
+		    // else, queued, failed or still running (scanner
+		    // stopping): the caller reads it by itself
+		drop(it);
+		if(was_full && ahead < max_ahead)
+		    lock.signal(0);
+	    }
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    throw;
+	}
+	lock.unlock();
+
+	return ret;
+    }
+
+    void filesystem_scanner::forget(const path & chemin)
+    {
+	const string key = chemin.display();
+	const string prefix = prefix_of(key);
+
+	lock.lock();
+	try
+	{
+	    map<string, job>::iterator it = jobs.find(key);
+	    bool was_full = ahead >= max_ahead;
+
+	    if(it != jobs.end())
+		drop(it);
+
+	    it = jobs.lower_bound(prefix);
+	    while(it != jobs.end() && it->first.compare(0, prefix.size(), prefix) == 0)
+		drop(it++);
+
+	    if(was_full && ahead < max_ahead)
+		lock.broadcast(0);
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    throw;
+	}
+	lock.unlock();
+    }
+
+    void filesystem_scanner::work()
+    {
+	try
+	{
+	    while(true)
+	    {
+		path where("/");
+		rank pos;
+		string key;
+		bool list = true;
+		bool success = false;
+		bool found = false;
+		deque<string> contents;
+		deque<etage::entry_type> types;
+		deque<string> subdirs;
+
+		    // picking the next directory to read
+
+		lock.lock();
+		try
+		{
+		    while(!found && !stopping)
+		    {
+			if(todo.empty())
+			    lock.wait(0);
+			else
+			{
+			    map<string, job>::iterator it = jobs.find(todo.begin()->second.display());
+
+			    if(it == jobs.end() || it->second.status != state::queued)
+				throw SRC_BUG; // todo and jobs are not coherent
+			    if(!it->second.listed && ahead >= max_ahead)
+				lock.wait(0);
+			    else
+			    {
+				found = true;
+				where = todo.begin()->second;
+				pos = it->second.where;
+				key = it->first;
+				it->second.status = state::running;
+				if(it->second.listed)
+				{
+				    list = false;
+				    contents = it->second.contents;
+				    types = it->second.types;
+				}
+				else
+				    ++ahead;
+				todo.erase(todo.begin());
+			    }
+			}
+		    }
+		}
+		catch(...)
+		{
+		    lock.unlock();
+		    throw;
+		}
+		lock.unlock();
+
+		if(!found)
+		    return; // stopping
+
+		success = scan(key, list, contents, types, subdirs);
+
+		    // recording the result
+
+		lock.lock();
+		try
+		{
+		    map<string, job>::iterator it = jobs.find(key);
+
+		    if(it != jobs.end() && it->second.status == state::running)
+		    {
+			if(success)
+			{
+			    U_I pushed = 0;
+
+			    pos.push_back(0);
+			    for(deque<string>::iterator sub = subdirs.begin(); sub != subdirs.end(); ++sub)
+			    {
+				path subpath = where.append(*sub);
+				string subkey = subpath.display();
+
+				if(jobs.find(subkey) == jobs.end())
+				{
+				    job & added = jobs[subkey];
+
+				    added.status = state::queued;
+				    added.listed = false;
+				    added.where = pos;
+				    todo.insert(pair<rank, path>(pos, subpath));
+				    ++pushed;
+				}
+				++pos.back();
+			    }
+
+			    if(pushed > 1)
+				lock.broadcast(0);
+			    else
+				if(pushed == 1)
+				    lock.signal(0);
+			}
+
+			if(it->second.listed)
+			    jobs.erase(it);
+			else
+			{
+			    if(success)
+			    {
+				it->second.contents.swap(contents);
+				it->second.types.swap(types);
+				it->second.status = state::ready;
+			    }
+			    else
+				it->second.status = state::failed;
+			    lock.broadcast(1);
+			}
+		    }
+			// else the job has been forgotten while running, dropping the result
+		}
+		catch(...)
+		{
+		    lock.unlock();
+		    throw;
+		}
+		lock.unlock();
+	    }
+	}
+	catch(...)
+	{
+		// no more reading ahead, take() will let the
+		// walk read directories by itself from now on
+	    lock.lock();
+	    stopping = true;
+	    lock.broadcast(0);
+	    lock.broadcast(1);
+	    lock.unlock();
+	}
+    }
+
+    void filesystem_scanner::drop(map<string, job>::iterator it)
+    {
+	if(it->second.status == state::queued)
+	    todo.erase(it->second.where);
+	else
+	{
+	    if(!it->second.listed)
+	    {
+		if(ahead == 0)
+		    throw SRC_BUG;
+		--ahead;
+	    }
+	}
+	jobs.erase(it);
+    }
+
+    bool filesystem_scanner::scan(const string & chemin,
+				  bool list,
+				  deque<string> & contents,
+				  deque<etage::entry_type> & types,
+				  deque<string> & subdirs) const
+    {
+#if HAVE_FDOPENDIR && HAVE_FSTATAT
+	int flags = O_RDONLY|O_BINARY;
+	DIR *dir = nullptr;
+	struct dirent *ent = nullptr;
+	struct stat buf;
+	int fd = -1;
+
+#ifdef O_DIRECTORY
+	flags |= O_DIRECTORY;
+#endif
+#if FURTIVE_READ_MODE_AVAILABLE
+	if(furtive_read_mode)
+	    flags |= O_NOATIME;
+#else
+	if(furtive_read_mode)
+	    return false;
+#endif
+
+	fd = ::open(chemin.c_str(), flags);
+	if(fd < 0)
+	    return false; // the walk will report the error if it happens again
+
+	dir = fdopendir(fd);
+	if(dir == nullptr)
+	{
+	    close(fd);
+	    return false;
+	}
+
+	try
+	{
+	    if(list)
+	    {
+		while((ent = readdir(dir)) != nullptr)
+		    if(strcmp(ent->d_name, ".") != 0 && strcmp(ent->d_name, "..") != 0)
+			contents.push_back(string(ent->d_name));
+	    }
+
+		// the inodes are fetched relatively to the directory. When the directory
+		// has been listed here, all entries are read to bring their inode in the
+		// system cache and give their type to the walk, else only the entries
+		// readdir() did not give the type of have to be read to find the subdirectories.
+		// The walk reads each inode again, it may have changed since.
+
+	    if(!list && types.size() != contents.size())
+		throw SRC_BUG;
+
+	    for(U_I i = 0; i < contents.size(); ++i)
+	    {
+		if(!list && types[i] != etage::entry_type::unknown)
+		{
+		    if(types[i] == etage::entry_type::directory)
+			subdirs.push_back(contents[i]);
+		}
+		else
+		{
+		    if(fstatat(dirfd(dir), contents[i].c_str(), &buf, AT_SYMLINK_NOFOLLOW) != 0)
+			buf.st_mode = 0; // unknown type
+		    else
+			if(S_ISDIR(buf.st_mode))
+			    subdirs.push_back(contents[i]);
+		    if(list)
+			types.push_back(etage::type_of(buf));
+		}
+	    }
+	}
+	catch(...)
+	{
+	    closedir(dir);
+	    throw;
+	}
+	closedir(dir);
+
+	return true;
+#else
+	return false;
+#endif
+    }
+
+    void filesystem_scanner::release()
+    {
+	lock.lock();
+	stopping = true;
+	lock.broadcast(0);
+	lock.broadcast(1);
+	lock.unlock();
+
+	for(deque<filesystem_scanner_worker *>::iterator it = workers.begin(); it != workers.end(); ++it)
+	{
+	    if(*it != nullptr)
+	    {
+		try
+		{
+		    (*it)->join();
+		}
+		catch(...)
+		{
+			// ignore all exceptions
+		}
+		delete *it;
+		*it = nullptr;
+	    }
+	}
+	workers.clear();
+    }
+
+    string filesystem_scanner::prefix_of(const string & chemin)
+    {
+	if(!chemin.empty() && chemin[chemin.size() - 1] == '/')
+	    return chemin;
+	else
+	    return chemin + "/";
+    }
+
+} // end of namespace
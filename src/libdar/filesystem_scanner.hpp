@@ -0,0 +1,163 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+    /// \file filesystem_scanner.hpp
+    /// \brief reads directories ahead of the filesystem walk, using several threads
+    /// \ingroup Private
+
+#ifndef FILESYSTEM_SCANNER_HPP
+#define FILESYSTEM_SCANNER_HPP
+
+#include "../my_config.h"
+
+#if HAVE_LIBTHREADAR_LIBTHREADAR_HPP
+#include <libthreadar/libthreadar.hpp>
+#endif
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include "integers.hpp"
+#include "path.hpp"
+#include "etage.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+    class filesystem_scanner_worker;
+
+	/// reads the contents of directories before the filesystem walk reaches them
+
+	/// a pool of threads lists the directories the walk is about to enter and
+	/// stats their entries (relatively to the directory file descriptor), to
+	/// find the subdirectories to read next. The walk (see filesystem_backup) stays
+	/// in the calling thread: it takes the contents of each directory it enters
+	/// with the type of its entries if this one has been read ahead, and reads
+	/// it itself else, so entries are still provided in the same order. The walk
+	/// reads each inode again when it reaches it, the stat done here
+	/// brings the inodes in the system cache but may be outdated by then. Directories are read ahead in the order the walk will
+	/// enter them, at most max_ahead of them waiting
+	/// to be taken at any time.
+	/// \note reading a directory modifies its last access time unless
+	/// furtive_read_mode is used.
+
+    class filesystem_scanner
+    {
+    public:
+	    /// default number of threads reading directories
+	static constexpr U_I default_num_workers = 4;
+
+	    /// default number of directories read in advance
+	static constexpr U_I default_max_ahead = 64;
+
+	    /// constructor
+
+	    /// \param[in] furtive_read_mode whether to open directories with O_NOATIME
+	    /// \param[in] num_workers number of threads to read directories
+	    /// \param[in] max_ahead maximum number of directories read and not yet taken
+	filesystem_scanner(bool furtive_read_mode,
+			   U_I num_workers = default_num_workers,
+			   U_I max_ahead = default_max_ahead);
+	filesystem_scanner(const filesystem_scanner & ref) = delete;
+	filesystem_scanner(filesystem_scanner && ref) noexcept = delete;
+	filesystem_scanner & operator = (const filesystem_scanner & ref) = delete;
+	filesystem_scanner & operator = (filesystem_scanner && ref) noexcept = delete;
+	~filesystem_scanner();
+
+	    /// give a directory read by the caller for its subdirectories to be read ahead
+
+	    /// \param[in] chemin the directory read by the caller
+	    /// \param[in] contents the entries of the directory
+	    /// \param[in] types the type of each entry as given by readdir(), only
+	    /// the entries of unknown type are read to find the subdirectories
+	void schedule(const path & chemin,
+		      const std::deque<std::string> & contents,
+		      const std::deque<etage::entry_type> & types);
+
+	    /// provide the contents of a directory if it has been read ahead
+
+	    /// \param[in] chemin the directory to read
+	    /// \param[out] contents the entries of the directory
+	    /// \param[out] types the type of each entry in the same order, as
+	    /// given by lstat() when the directory has been read ahead, unknown for
+	    /// an entry that could not be read
+	    /// \return false if the directory has not been read ahead or could
+	    /// not be read, the caller has then to read it by itself
+	    /// \note waits for the directory to be read if this is in progress
+	bool take(const path & chemin, std::deque<std::string> & contents, std::deque<etage::entry_type> & types);
+
+	    /// drop what has been read ahead under the given directory, which the walk leaves
+	void forget(const path & chemin);
+
+    private:
+	enum class state { queued, running, ready, failed };
+
+	    /// position of a directory in the walk
+
+	    /// the rank of a subdirectory is the rank of its parent followed by the
+	    /// index of the subdirectory in the parent, comparing ranks thus gives the
+	    /// order in which the walk enters directories. Directories given by
+	    /// schedule() start a new sequence which comes before all the others,
+	    /// as the walk is currently there.
+	typedef std::vector<U_I> rank;
+
+	struct job
+	{
+	    state status;
+	    bool listed;                     ///< whether contents has been provided by schedule() (only subdirectories are to be found)
+	    rank where;                      ///< key of the job in todo
+	    std::deque<std::string> contents;
+	    std::deque<etage::entry_type> types; ///< type of the entries provided by schedule() or found by the scanner
+	};
+
+	bool furtive_read_mode;
+	U_I max_ahead;
+	libthreadar::condition lock;           ///< protects the following fields, instance 0 is used by workers, instance 1 by take()
+	std::map<rank, path> todo;             ///< directories to read, the first to be entered by the walk first
+	U_I sequence;                          ///< number of calls to schedule()
+	std::map<std::string, job> jobs;       ///< status and result of the directories in todo or read ahead
+	U_I ahead;                             ///< number of directories being read or read and not yet taken
+	bool stopping;                         ///< set when the workers have to end
+	std::deque<filesystem_scanner_worker *> workers;
+
+	void work();                           ///< the routine the workers run
+	void drop(std::map<std::string, job>::iterator it); ///< remove the entry, with lock acquired
+	bool scan(const std::string & chemin,
+		  bool list,
+		  std::deque<std::string> & contents,
+		  std::deque<etage::entry_type> & types,
+		  std::deque<std::string> & subdirs) const;
+	void release();
+
+	static std::string prefix_of(const std::string & chemin);
+
+	friend class filesystem_scanner_worker;
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
@@ -166,6 +166,11 @@ namespace libdar
 			      const shared_ptr<user_interaction> & dialog,
 			      bool verbose);
 
+	/// update statistics and report errors for the files which restoration has been deferred and is now completed
+    static void collect_deferred(filesystem_restore & fs,
+				 user_interaction & dialog,
+				 statistics & st);
+
     void filtre_restore(const shared_ptr<user_interaction> & dialog,
 			const mask & filtre,
 			const mask & subtree,
@@ -187,7 +192,8 @@ namespace libdar
 			archive_options_extract::t_dirty dirty,
 			bool only_deleted,
 			bool not_deleted,
-			const fsa_scope & scope)
+			const fsa_scope & scope,
+			U_I restore_threads)
     {
 	defile juillet = fs_racine; // 'juillet' is in reference to 14th of July ;-) when takes place the "defile'" on the Champs-Elysees.
 	const cat_eod tmp_eod;
@@ -219,9 +225,13 @@ namespace libdar
 				  empty,
 				  &overwrite,
 				  only_deleted,
-				  scope);
+				  scope,
+				  flat || cat.get_escape_layer() != nullptr ? 1 : restore_threads);
 		// if only_deleted, we set the filesystem to only overwrite mode (no creatation if not existing)
 		// we also filter to only restore directories and detruit objects.
+		// files may be restored by other threads only in direct access mode (the file
+		// must be restored before looking for another copy of it in sequential read mode)
+		// and not in flat mode where two files of the same name could be restored at the same time
 
 	    st.clear();
 	    cat.reset_read();
@@ -413,6 +423,8 @@ namespace libdar
 			    case filesystem_restore::done_data_removed:
 				st.incr_deleted();
 				break;
+			    case filesystem_restore::done_data_deferred:
+				break; // statistics updated by collect_deferred()
 			    default:
 				throw SRC_BUG;
 			    }
@@ -512,7 +524,12 @@ namespace libdar
 			fs.write(e, tmp, notusedhere, notusedhere, notusedhere, notusedhere); // cat_eod; don't care returned value
 		    }
 		}
+
+		collect_deferred(fs, *dialog, st);
 	    }
+
+	    fs.wait_deferred();
+	    collect_deferred(fs, *dialog, st);
 	}
 	catch(...)
 	{
@@ -566,7 +583,9 @@ namespace libdar
 			   bool auto_zeroing_neg_dates,
 			   const set<string> & ignored_symlinks,
 			   modified_data_detection mod_data_detect,
-			   const delta_sig_block_size & delta_sig_block_len)
+			   const delta_sig_block_size & delta_sig_block_len,
+			   bool multi_threaded,
+			   bool physical_order)
     {
 	if(!dialog)
 	    throw SRC_BUG; // dialog points to nothing
@@ -601,7 +620,9 @@ namespace libdar
 			     cache_directory_tagging,
 			     root_fs_device,
 			     ignore_unknown,
-			     scope);
+			     scope,
+			     multi_threaded,
+			     physical_order);
 	thread_cancellation thr_cancel;
 	infinint skipped_dump, fs_errors;
 	infinint wasted_bytes = 0;
@@ -906,6 +927,12 @@ namespace libdar
 
 					    // PERFORMING ACTION FOR ENTRY (cat_entree dump, eventually data dump)
 
+					if(e_file != nullptr
+					   && (e_file->get_saved_status() == saved_status::saved
+					       || e_file->get_saved_status() == saved_status::delta))
+					    fs.read_ahead_next_files();
+					    // the data of the next files get loaded while this one is saved
+
 					if(!save_inode(dialog,
 						       juillet.get_string(),
 						       e,
@@ -4629,4 +4656,31 @@ namespace libdar
 	return furtive;
     }
 
+    static void collect_deferred(filesystem_restore & fs,
+				 user_interaction & dialog,
+				 statistics & st)
+    {
+	string chem;
+	string error;
+	bool ea_restored;
+	bool fsa_restored;
+
+	while(fs.get_deferred(chem, ea_restored, fsa_restored, error))
+	{
+	    if(error.empty())
+	    {
+		st.incr_treated();
+		if(ea_restored)
+		    st.incr_ea_treated();
+		if(fsa_restored)
+		    st.incr_fsa_treated();
+	    }
+	    else
+	    {
+		dialog.message(string(gettext("Error while restoring ")) + chem + " : " + error);
+		st.incr_errored();
+	    }
+	}
+    }
+
 } // end of namespace
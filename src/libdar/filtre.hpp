@@ -62,7 +62,8 @@ namespace libdar
  			       archive_options_extract::t_dirty dirty, ///< whether to restore dirty files
 			       bool only_deleted,         ///< whether to only consider deleted files
 			       bool not_deleted,          ///< wether to consider deleted files
-			       const fsa_scope & scope    ///< scope of FSA to take into account
+			       const fsa_scope & scope,   ///< scope of FSA to take into account
+			       U_I restore_threads        ///< number of threads restoring small plain files, 1 for none (ignored in sequential read and flat mode)
 	);
 
     extern void filtre_sauvegarde(const std::shared_ptr<user_interaction> & dialog,
@@ -107,7 +108,9 @@ namespace libdar
 				  bool auto_zeroing_neg_dates,
 				  const std::set<std::string> & ignored_symlinks,
 				  modified_data_detection mod_data_detect,
-				  const delta_sig_block_size & delta_sig_block_len);
+				  const delta_sig_block_size & delta_sig_block_len,
+				  bool multi_threaded,      // whether directories can be read ahead by other threads
+				  bool physical_order);     // whether to fetch file data ahead in the order it lies on disk
 
     extern void filtre_difference(const std::shared_ptr<user_interaction> & dialog,
 				  const mask &filtre,
@@ -162,6 +162,30 @@ namespace libdar
             return (this->*active_read)(a, size);
     }
 
+    bool generic_file::read_lend(const char * & ptr, U_I & size)
+    {
+	if(terminated)
+	    throw SRC_BUG;
+
+	if(size == 0)
+	    throw SRC_BUG;
+
+        if(rw == gf_write_only)
+            throw Erange("generic_file::read_lend", gettext("Reading a write only generic_file"));
+
+	if(!inherited_read_lend(ptr, size))
+	    return false;
+
+	if(active_read == &generic_file::read_crc)
+	{
+	    if(checksum == nullptr)
+		throw SRC_BUG;
+	    checksum->compute(ptr, size);
+	}
+
+	return true;
+    }
+
     void generic_file::write(const char *a, U_I size)
     {
 	if(terminated)
@@ -172,6 +196,30 @@ namespace libdar
             (this->*active_write)(a, size);
     }
 
+    void generic_file::write_lent(const char *a, U_I size, S_I fd, const infinint & offset)
+    {
+	U_I copied;
+
+	if(terminated)
+	    throw SRC_BUG;
+        if(rw == gf_read_only)
+            throw Erange("generic_file::write", gettext("Writing to a read only generic_file"));
+
+	copied = inherited_write_lent(fd, offset, size);
+	if(copied > size)
+	    throw SRC_BUG;
+
+	if(active_write == &generic_file::write_crc)
+	{
+	    if(checksum == nullptr)
+		throw SRC_BUG;
+	    checksum->compute(a, copied);
+	}
+
+	if(copied < size)
+	    (this->*active_write)(a + copied, size - copied);
+    }
+
     void generic_file::write(const string & arg)
     {
 	if(terminated)
@@ -201,7 +249,11 @@ namespace libdar
     void generic_file::copy_to(generic_file & ref)
     {
         char buffer[BUFFER_SIZE];
+	const char *data;
+	bool lent;
         U_I lu;
+	S_I fd;
+	infinint offset;
 
 	if(terminated)
 	    throw SRC_BUG;
@@ -210,7 +262,13 @@ namespace libdar
         {
 	    try
 	    {
-		lu = this->read(buffer, BUFFER_SIZE);
+		lu = BUFFER_SIZE;
+		lent = read_lend(data, lu);
+		if(!lent)
+		{
+		    lu = this->read(buffer, BUFFER_SIZE);
+		    data = buffer;
+		}
 	    }
 	    catch(Egeneric & e)
 	    {
@@ -221,7 +279,10 @@ namespace libdar
 	    {
 		try
 		{
-		    ref.write(buffer, lu);
+		    if(lent && lent_from(fd, offset))
+			ref.write_lent(data, lu, fd, offset);
+		    else
+			ref.write(data, lu);
 		}
 		catch(Egeneric & e)
 		{
@@ -246,18 +307,28 @@ namespace libdar
     U_32 generic_file::copy_to(generic_file & ref, U_32 size)
     {
         char buffer[BUFFER_SIZE];
-        S_I lu = 1, pas;
+	const char *data;
+	bool lent;
+        U_I lu = 1, pas;
         U_32 wrote = 0;
+	S_I fd;
+	infinint offset;
 
 	if(terminated)
 	    throw SRC_BUG;
 
         while(wrote < size && lu > 0)
         {
-            pas = size > BUFFER_SIZE ? BUFFER_SIZE : size;
+            pas = size - wrote > BUFFER_SIZE ? BUFFER_SIZE : size - wrote;
 	    try
 	    {
-		lu = read(buffer, pas);
+		lu = pas;
+		lent = read_lend(data, lu);
+		if(!lent)
+		{
+		    lu = read(buffer, pas);
+		    data = buffer;
+		}
 	    }
 	    catch(Egeneric & e)
 	    {
@@ -268,7 +339,10 @@ namespace libdar
             {
 		try
 		{
-		    ref.write(buffer, lu);
+		    if(lent && lent_from(fd, offset))
+			ref.write_lent(data, lu, fd, offset);
+		    else
+			ref.write(data, lu);
 		}
 		catch(Egeneric & e)
 		{
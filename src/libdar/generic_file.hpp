@@ -125,6 +125,27 @@ namespace libdar
 	    /// read data from the generic_file inherited from proto_generic_file
         virtual U_I read(char *a, U_I size) override;
 
+	    /// read data without copying it, when the implementation can provide it in place
+
+	    /// \param[out] ptr points to the data provided, which stays valid up to the next call
+	    /// of any method of this object
+	    /// \param[in,out] size maximum amount of data wanted (must not be zero), set to the
+	    /// amount of data provided, which may be less than requested without meaning EOF
+	    /// (zero meaning EOF)
+	    /// \return false if no data could be lent, in which case the read position is unchanged
+	    /// and the caller has to use read() instead
+	    /// \note data is lent by inherited classes that can point to it in place (mapped file,
+	    /// internal buffer) or that can pass through what the layer below lends without
+	    /// transforming it
+	bool read_lend(const char * & ptr, U_I & size);
+
+	    /// tells where the data provided by the last successful call to read_lend() is stored
+
+	    /// \param[out] fd file descriptor of the file the lent data has been taken from unchanged
+	    /// \param[out] offset offset of the lent data in that file
+	    /// \return false if the lent data is not known to be stored as is in a file
+	bool lent_from(S_I & fd, infinint & offset) const { if(terminated) throw SRC_BUG; return inherited_lent_from(fd, offset); };
+
 	    /// write data to the generic_file inherited from proto_generic_file
         virtual void write(const char *a, U_I size) override;
 
@@ -133,6 +154,16 @@ namespace libdar
 	    /// \note throws a exception if not all data could be written as expected
         void write(const std::string & arg);
 
+	    /// write data that is also stored as is in a file at a given offset
+
+	    /// \param[in] a the data to write
+	    /// \param[in] size amount of data to write
+	    /// \param[in] fd file descriptor of the file the same data is stored in
+	    /// \param[in] offset offset of the data in that file
+	    /// \note the result is the same as write(a, size), but the implementation may let
+	    /// the system copy the data from the given file rather than from memory
+	void write_lent(const char *a, U_I size, S_I fd, const infinint & offset);
+
 	    /// skip back one char, read on char and skip back one char
         S_I read_back(char &a);
 
@@ -265,6 +296,19 @@ namespace libdar
 	    /// Any problem shall be reported by throwing an exception.
         virtual U_I inherited_read(char *a, U_I size) = 0;
 
+	    /// implementation of read_lend() operation
+
+	    /// \param[out] ptr where the data is provided
+	    /// \param[in,out] size the maximum amount of data to provide, set to the amount provided
+	    /// \return false if the data cannot be lent, the read position must then be unchanged
+	    /// \note the default implementation does not lend any data, read() is used instead
+	virtual bool inherited_read_lend(const char * & ptr, U_I & size) { return false; };
+
+	    /// implementation of lent_from() operation
+
+	    /// \note the default implementation does not know where the lent data comes from
+	virtual bool inherited_lent_from(S_I & fd, infinint & offset) const { return false; };
+
 	    /// implementation of the write() operation
 
 	    /// \param[in] a what data to write
@@ -272,6 +316,16 @@ namespace libdar
 	    /// \note must either write all data or report an error by throwing an exception
         virtual void inherited_write(const char *a, U_I size) = 0;
 
+	    /// implementation of the write_lent() operation
+
+	    /// \param[in] fd file descriptor of the file to copy the data from
+	    /// \param[in] offset where the data to write is located in that file
+	    /// \param[in] size amount of data to write
+	    /// \return the amount of data copied from the file, the remaining data will be
+	    /// written calling inherited_write()
+	    /// \note the default implementation does not copy anything
+	virtual U_I inherited_write_lent(S_I fd, const infinint & offset, U_I size) { return 0; };
+
 
 	    /// write down any pending data
 
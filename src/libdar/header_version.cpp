@@ -33,6 +33,7 @@ extern "C"
 #include "integers.hpp"
 #include "tools.hpp"
 #include "deci.hpp"
+#include "block_compressor.hpp"
 
 #define LIBDAR_URL_VERSION "http://dar.linux.free.fr/pre-release/doc/Notes.html#Dar_version_naming"
 
@@ -55,6 +56,7 @@ namespace libdar
 	iteration_count = PRE_FORMAT_10_ITERATION;
 	kdf_hash = hash_algo::sha1; // used by default
 	salt = "";
+	compr_bs = 0;
     }
 
     void header_version::read(generic_file & f, user_interaction & dialog, bool lax_mode)
@@ -316,6 +318,26 @@ namespace libdar
 	    kdf_hash = hash_algo::sha1;
 	}
 
+	if((flag & FLAG_HAS_COMPRESS_BS) != 0)
+	{
+	    infinint bs(f); // reading the compression block size from file
+
+	    compr_bs = 0;
+	    bs.unstack(compr_bs);
+	    if(!bs.is_zero() || compr_bs == 0)
+	    {
+		if(lax_mode)
+		{
+		    dialog.message(gettext("LAX MODE: invalid compression block size, assuming data corruption occurred, using the default block size"));
+		    compr_bs = block_compressor::default_block_size;
+		}
+		else
+		    throw Erange("header_version::read", gettext("Invalid or too large compression block size for this system"));
+	    }
+	}
+	else
+	    compr_bs = 0;
+
 	ctrl = f.get_crc();
 	if(ctrl == nullptr)
 	    throw SRC_BUG;
@@ -414,6 +436,9 @@ namespace libdar
 	if(salt.size() > 0)
 	    flag[1] |= (FLAG_HAS_KDF_PARAM >> 8);
 
+	if(compr_bs > 0)
+	    flag[1] |= (FLAG_HAS_COMPRESS_BS >> 8);
+
 	if(flag[1] > 0)
 	    flag[1] |= FLAG_HAS_AN_EXTENDED_SIZE;
 	    // and we will drop two bytes for the flag
@@ -457,6 +482,9 @@ namespace libdar
 	    f.write((char *)&tmp_hash, 1);
 	}
 
+	if(compr_bs > 0)
+	    infinint(compr_bs).dump(f);
+
 	ctrl = f.get_crc();
 	if(ctrl == nullptr)
 	    throw SRC_BUG;
@@ -509,6 +537,8 @@ namespace libdar
 
 	dialog.printf(gettext("Archive version format               : %s"), get_edition().display().c_str());
 	dialog.printf(gettext("Compression algorithm used           : %S"), &algo);
+	if(compr_bs > 0)
+	    dialog.printf(gettext("Compression block size               : %u bytes"), compr_bs);
 	dialog.printf(gettext("Symmetric key encryption used        : %S"), &sym_str);
 	dialog.printf(gettext("Asymmetric key encryption used       : %S"), &asym);
 	dialog.printf(gettext("Archive is signed                    : %S"), &xsigned);
@@ -537,6 +567,7 @@ namespace libdar
 	arch_signed = false;
 	iteration_count = PRE_FORMAT_10_ITERATION;
 	kdf_hash = hash_algo::sha1;
+	compr_bs = 0;
     }
 
     void header_version::copy_from(const header_version & ref)
@@ -568,6 +599,7 @@ namespace libdar
 	salt = ref.salt;
 	iteration_count = ref.iteration_count;
 	kdf_hash = ref.kdf_hash;
+	compr_bs = ref.compr_bs;
     }
 
     void header_version::move_from(header_version && ref) noexcept
@@ -585,6 +617,7 @@ namespace libdar
 	salt = move(ref.salt);
 	iteration_count = move(ref.iteration_count);
 	kdf_hash = move(ref.kdf_hash);
+	compr_bs = move(ref.compr_bs);
     }
 
     void header_version::detruit()
@@ -64,6 +64,7 @@ namespace libdar
 
 	void set_edition(const archive_version & ed) { edition = ed; };
 	void set_compression_algo(const compression & zip) { algo_zip = zip; };
+	void set_compression_block_size(U_I bs) { compr_bs = bs; };
 	void set_command_line(const std::string & line) { cmd_line = line; };
 	void set_initial_offset(const infinint & offset) { initial_offset = offset; };
 	void set_sym_crypto_algo(const crypto_algo & algo) { sym = algo; };
@@ -87,6 +88,7 @@ namespace libdar
 
 	const archive_version & get_edition() const { return edition; };
 	compression get_compression_algo() const { return algo_zip; };
+	U_I get_compression_block_size() const { return compr_bs; };
 	const std::string & get_command_line() const { return cmd_line; };
 	const infinint & get_initial_offset() const { return initial_offset; };
 
@@ -126,6 +128,7 @@ namespace libdar
 	std::string salt;        ///< used for key derivation
 	infinint iteration_count;///< used for key derivation
 	hash_algo kdf_hash;      ///< used for key derivation
+	U_I compr_bs;            ///< size of compression blocks, zero if data is compressed as a stream
 
 	void nullifyptr() noexcept { crypted_key = nullptr; ref_layout = nullptr; };
 	void copy_from(const header_version & ref);
@@ -144,6 +147,7 @@ namespace libdar
 	static constexpr U_I FLAG_HAS_AN_EXTENDED_SIZE = 0x01; ///< the flag is two bytes length
 	static constexpr U_I FLAG_ARCHIVE_IS_SIGNED = 0x0200;  ///< archive is signed
 	static constexpr U_I FLAG_HAS_KDF_PARAM = 0x0400;     ///< archive header contains salt and non default interaction count
+	static constexpr U_I FLAG_HAS_COMPRESS_BS = 0x0800;   ///< archive header contains the size of compression blocks
 	static constexpr U_I FLAG_HAS_AN_SECOND_EXTENDED_SIZE = 0x0101; ///< reserved for future use
 
 	    //
@@ -103,6 +103,11 @@ namespace libdar
 	    lax_read_mode = options.get_lax();
 	    sequential_read = options.get_sequential_read(); // updating the archive object's field
 	    where->set_location(chem);
+		// a truncated or unreadable mapped slice kills the process with
+		// SIGBUS, which lax mode is expected to survive
+	    entrepot_local *where_local = dynamic_cast<entrepot_local *>(where.get());
+	    if(where_local != nullptr)
+		where_local->set_memory_mapped(options.get_memory_mapped() && !options.get_lax());
 
 	    try
 	    {
@@ -131,6 +136,9 @@ namespace libdar
 					 gnupg_signed,
 					 slices,
 					 options.get_multi_threaded(),
+					 options.get_multi_threaded_crypto(),
+					 options.get_multi_threaded_compress(),
+					 options.get_cache_size(),
 					 options.get_header_only());
 
 		if(options.get_header_only())
@@ -187,6 +195,9 @@ namespace libdar
 						     tmp1_signatories,
 						     ignored,
 						     options.get_multi_threaded(),
+						     options.get_multi_threaded_crypto(),
+						     options.get_multi_threaded_compress(),
+						     options.get_cache_size(),
 						     false);
 				// we do not comparing the signatories of the archive of reference with the current archive
 				// for example the isolated catalogue might be unencrypted and thus not signed
@@ -231,7 +242,9 @@ namespace libdar
 								   local_cat_size,
 								   ref_second_terminateur_offset,
 								   tmp2_signatories,
-								   false); // never relaxed checking for external catalogue
+								   false, // never relaxed checking for external catalogue
+								   options.get_subtree(),
+								   options.get_subtree_root());
 		    if(!same_signatories(tmp1_signatories, tmp2_signatories))
 			dialog->pause(gettext("Archive of reference is not signed properly (no the same signatories for the archive and the internal catalogue), do we continue?"));
 		    if(cat == nullptr)
@@ -264,7 +277,9 @@ namespace libdar
 								 local_cat_size,
 								 second_terminateur_offset,
 								 tmp1_signatories,
-								 options.get_lax());
+								 options.get_lax(),
+								 options.get_subtree(),
+								 options.get_subtree_root());
 			    if(!same_signatories(tmp1_signatories, gnupg_signed))
 			    {
 				string msg = gettext("Archive internal catalogue is not identically signed as the archive itself, this might be the sign the archive has been compromised");
@@ -443,6 +458,7 @@ namespace libdar
 				   options.get_empty_dir(),
 				   options.get_compression(),
 				   options.get_compression_level(),
+				   options.get_compression_block_size(),
 				   options.get_slice_size(),
 				   options.get_first_slice_size(),
 				   options.get_ea_mask(),
@@ -479,6 +495,10 @@ namespace libdar
 				   options.get_ignore_unknown_inode_type(),
 				   options.get_fsa_scope(),
 				   options.get_multi_threaded(),
+				   options.get_multi_threaded_crypto(),
+				   options.get_multi_threaded_compress(),
+				   options.get_cache_size(),
+				   options.get_slices_in_flight(),
 				   options.get_delta_signature(),
 				   options.get_has_delta_mask_been_set(),
 				   options.get_delta_mask(),
@@ -490,6 +510,7 @@ namespace libdar
 				   options.get_iteration_count(),
 				   options.get_kdf_hash(),
 				   options.get_sig_block_len(),
+				   options.get_physical_order(),
 				   progressive_report);
 		exploitable = false;
 		stack.terminate();
@@ -525,6 +546,7 @@ namespace libdar
 	catalogue *ref_cat2 = nullptr;
 	shared_ptr<archive> ref_arch2 = options.get_auxiliary_ref();
 	compression algo_kept = compression::none;
+	U_I block_size_kept = 0;
 	shared_ptr<entrepot> sauv_path_t = options.get_entrepot();
 
 	cat = nullptr;
@@ -545,8 +567,8 @@ namespace libdar
 		    // sanity checks as much as possible to avoid libdar crashing due to bad arguments
 		    // useless arguments are not reported.
 
-		if(options.get_compression_level() > 9 || options.get_compression_level() < 1)
-		    throw Elibcall("op_merge", gettext("Compression_level must be between 1 and 9 included"));
+		if(options.get_compression_level() > compression_max_level(options.get_compression()) || options.get_compression_level() < 1)
+		    throw Elibcall("op_merge", tools_printf(gettext("Compression_level must be between 1 and %u included"), compression_max_level(options.get_compression())));
 		if(options.get_slice_size().is_zero() && !options.get_first_slice_size().is_zero())
 		    throw Elibcall("op_merge", gettext("\"first_file_size\" cannot be different from zero if \"file_size\" is equal to zero"));
 		if(options.get_crypto_size() < 10 && options.get_crypto_algo() != crypto_algo::none)
@@ -611,6 +633,11 @@ namespace libdar
 			   && ref_arch2->pimpl->ver.get_compression_algo() != compression::none
 			   && options.get_keep_compressed())
 			    throw Efeature(gettext("the \"Keep file compressed\" feature is not possible when merging two archives using different compression algorithms (This is for a future version of dar). You can still merge these two archives but without keeping file compressed (thus you will probably like to use compression (-z or -y options) for the resulting archive"));
+			if(ref_arch1->pimpl->ver.get_compression_block_size() != ref_arch2->pimpl->ver.get_compression_block_size()
+			   && ref_arch1->pimpl->ver.get_compression_algo() != compression::none
+			   && ref_arch2->pimpl->ver.get_compression_algo() != compression::none
+			   && options.get_keep_compressed())
+			    throw Efeature(gettext("the \"Keep file compressed\" feature is not possible when merging two archives using different compression block sizes. You can still merge these two archives but without keeping file compressed"));
 		    }
 
 		if(options.get_keep_compressed())
@@ -619,12 +646,16 @@ namespace libdar
 			throw SRC_BUG;
 
 		    algo_kept = ref_arch1->pimpl->ver.get_compression_algo();
+		    block_size_kept = ref_arch1->pimpl->ver.get_compression_block_size();
 		    if(algo_kept == compression::none && ref_cat2 != nullptr)
 		    {
 			if(!ref_arch2)
 			    throw SRC_BUG;
 			else
+			{
 			    algo_kept = ref_arch2->pimpl->ver.get_compression_algo();
+			    block_size_kept = ref_arch2->pimpl->ver.get_compression_block_size();
+			}
 		    }
 		}
 
@@ -662,6 +693,7 @@ namespace libdar
 				 options.get_empty_dir(),
 				 options.get_keep_compressed() ? algo_kept : options.get_compression(),
 				 options.get_compression_level(),
+				 options.get_keep_compressed() ? block_size_kept : options.get_compression_block_size(),
 				 options.get_slice_size(),
 				 options.get_first_slice_size(),
 				 options.get_ea_mask(),
@@ -700,6 +732,10 @@ namespace libdar
 				 false,   // ignore_unknown
 				 options.get_fsa_scope(),
 				 options.get_multi_threaded(),
+				 options.get_multi_threaded_crypto(),
+				 options.get_multi_threaded_compress(),
+				 options.get_cache_size(),
+				 options.get_slices_in_flight(),
 				 options.get_delta_signature(),
 				 options.get_has_delta_mask_been_set(), // build delta sig
 				 options.get_delta_mask(), // delta_mask
@@ -711,6 +747,7 @@ namespace libdar
 				 options.get_iteration_count(),
 				 options.get_kdf_hash(),
 				 options.get_sig_block_len(),
+				 false,   // physical_order, no file read from filesystem
 				 st_ptr);
 
 		exploitable = false;
@@ -815,6 +852,7 @@ namespace libdar
 			     false,               // empty_dir
 			     src.pimpl->ver.get_compression_algo(),
 			     9,                   // we keep the data compressed this parameter has no importance
+			     src.pimpl->ver.get_compression_block_size(), // compressed data is kept as is, so are its compression blocks
 			     options_repair.get_slice_size(),
 			     options_repair.get_first_slice_size(),
 			     bool_mask(true),     // ea_mask
@@ -853,6 +891,10 @@ namespace libdar
 			     false,               // ignore_unknown
 			     all_fsa_families(),  // fsa_scope
 			     options_repair.get_multi_threaded(),
+			     options_repair.get_multi_threaded_crypto(),
+			     options_repair.get_multi_threaded_compress(),
+			     options_repair.get_cache_size(),
+			     options_repair.get_slices_in_flight(),
 			     true,                // delta_signature
 			     false,               // build_delta_signature
 			     bool_mask(true),     // delta_mask
@@ -864,6 +906,7 @@ namespace libdar
 			     src.pimpl->ver.get_iteration_count(),
 			     src.pimpl->ver.get_kdf_hash(),
 			     delta_sig_block_size(), // sig block size is not used for repairing, build_delta_sig is set to false above
+			     false,               // physical_order
 			     &not_filled);        // statistics
 
 		// stealing src's catalogue, our's is still empty at this step
@@ -947,7 +990,9 @@ namespace libdar
 			       options.get_dirty_behavior(),
 			       options.get_only_deleted(),
 			       options.get_ignore_deleted(),
-			       options.get_fsa_scope());
+			       options.get_fsa_scope(),
+			       options.get_multi_threaded_restore());
+		st_ptr->add_to_ignored(get_cat().get_subtree_dropped());
 	    }
 	    catch(Euser_abort & e)
 	    {
@@ -1340,6 +1385,7 @@ namespace libdar
 				  options.get_compare_symlink_date(),
 				  options.get_fsa_scope(),
 				  isolated_mode);
+		st_ptr->add_to_ignored(get_cat().get_subtree_dropped());
             }
             catch(Euser_abort & e)
             {
@@ -1416,6 +1462,7 @@ namespace libdar
 			cat->reset_read();
 		    }
 		    else
+		    {
 			filtre_test(get_pointer(),
 				    options.get_selection(),
 				    options.get_subtree(),
@@ -1426,6 +1473,8 @@ namespace libdar
 				    options.get_display_skipped(),
 				    options.get_empty(),
 				    *st_ptr);
+			st_ptr->add_to_skipped(get_cat().get_subtree_dropped());
+		    }
 		}
 		catch(Erange & e)
 		{
@@ -1517,6 +1566,7 @@ namespace libdar
 				      options.get_pause(),
 				      options.get_compression(),
 				      options.get_compression_level(),
+				      options.get_compression_block_size(),
 				      options.get_slice_size(),
 				      options.get_first_slice_size(),
 				      options.get_execute(),
@@ -1535,7 +1585,11 @@ namespace libdar
 				      isol_data_name,
 				      options.get_iteration_count(),
 				      options.get_kdf_hash(),
-				      options.get_multi_threaded());
+				      options.get_multi_threaded(),
+				      options.get_multi_threaded_crypto(),
+				      options.get_multi_threaded_compress(),
+				      options.get_cache_size(),
+				      options.get_slices_in_flight());
 
 	    if(cat == nullptr)
 		throw SRC_BUG;
@@ -1887,6 +1941,7 @@ namespace libdar
 						bool empty_dir,
 						compression algo,
 						U_I compression_level,
+						U_I compression_block_size,
 						const infinint & file_size,
 						const infinint & first_file_size,
 						const mask & ea_mask,
@@ -1923,6 +1978,10 @@ namespace libdar
 						bool ignore_unknown,
 						const fsa_scope & scope,
 						bool multi_threaded,
+						U_I multi_threaded_crypto,
+						U_I multi_threaded_compress,
+						U_I cache_size,
+						U_I slices_in_flight,
 						bool delta_signature,
 						bool build_delta_sig,
 						const mask & delta_mask,
@@ -1934,6 +1993,7 @@ namespace libdar
 						const infinint & iteration_count,
 						hash_algo kdf_hash,
 						const delta_sig_block_size & sig_block_len,
+						bool physical_order,
 						statistics * progressive_report)
     {
         statistics st = false;  // false => no lock for this internal object
@@ -1942,8 +2002,8 @@ namespace libdar
             // sanity checks as much as possible to avoid libdar crashing due to bad arguments
             // useless arguments are not reported.
 
-        if(compression_level > 9 || compression_level < 1)
-            throw Elibcall("op_create_in", gettext("Compression_level must be between 1 and 9 included"));
+        if(compression_level > compression_max_level(algo) || compression_level < 1)
+            throw Elibcall("op_create_in", tools_printf(gettext("Compression_level must be between 1 and %u included"), compression_max_level(algo)));
         if(file_size.is_zero() && !first_file_size.is_zero())
             throw Elibcall("op_create_in", gettext("\"first_file_size\" cannot be different from zero if \"file_size\" is equal to zero"));
         if(crypto_size < 10 && crypto != crypto_algo::none)
@@ -2048,6 +2108,7 @@ namespace libdar
 			 empty_dir,
 			 algo,
 			 compression_level,
+			 compression_block_size,
 			 file_size,
 			 first_file_size,
 			 ea_mask,
@@ -2086,6 +2147,10 @@ namespace libdar
 			 ignore_unknown,
 			 scope,
 			 multi_threaded,
+			 multi_threaded_crypto,
+			 multi_threaded_compress,
+			 cache_size,
+			 slices_in_flight,
 			 delta_signature,
 			 build_delta_sig,
 			 delta_mask,
@@ -2097,6 +2162,7 @@ namespace libdar
 			 iteration_count,
 			 kdf_hash,
 			 sig_block_len,
+			 physical_order,
 			 st_ptr);
 
 	return *st_ptr;
@@ -2124,6 +2190,7 @@ namespace libdar
 					      bool empty_dir,
 					      compression algo,
 					      U_I compression_level,
+					      U_I compression_block_size,
 					      const infinint & file_size,
 					      const infinint & first_file_size,
 					      const mask & ea_mask,
@@ -2162,6 +2229,10 @@ namespace libdar
 					      bool ignore_unknown,
 					      const fsa_scope & scope,
 					      bool multi_threaded,
+					      U_I multi_threaded_crypto,
+					      U_I multi_threaded_compress,
+					      U_I cache_size,
+					      U_I slices_in_flight,
 					      bool delta_signature,
 					      bool build_delta_sig,
 					      const mask & delta_mask,
@@ -2173,6 +2244,7 @@ namespace libdar
 					      const infinint & iteration_count,
 					      hash_algo kdf_hash,
 					      const delta_sig_block_size & sig_block_len,
+					      bool physical_order,
 					      statistics * st_ptr)
     {
 	try
@@ -2215,6 +2287,7 @@ namespace libdar
 					  pause,
 					  algo,
 					  compression_level,
+					  compression_block_size,
 					  file_size,
 					  first_file_size,
 					  execute,
@@ -2233,7 +2306,11 @@ namespace libdar
 					  internal_name, // data_name is equal to internal_name in the current situation
 					  iteration_count,
 					  kdf_hash,
-					  multi_threaded);
+					  multi_threaded,
+					  multi_threaded_crypto,
+					  multi_threaded_compress,
+					  cache_size,
+					  slices_in_flight);
 
 		    // ********** building the catalogue (empty for now) ************************* //
 		datetime root_mtime;
@@ -2359,7 +2436,9 @@ namespace libdar
 					      zeroing_neg_date,
 					      ignored_symlinks,
 					      mod_data_detect,
-					      sig_block_len);
+					      sig_block_len,
+					      multi_threaded,
+					      physical_order);
 				// build_delta_sig is not used for archive creation it is always implied when delta_signature is set
 			}
 			catch(...)
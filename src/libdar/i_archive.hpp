@@ -245,6 +245,7 @@ namespace libdar
 				bool empty_dir,
 				compression algo,
 				U_I compression_level,
+				U_I compression_block_size,
 				const infinint & file_size,
 				const infinint & first_file_size,
 				const mask & ea_mask,
@@ -281,6 +282,10 @@ namespace libdar
 				bool ignore_unknown,
 				const fsa_scope & scope,
 				bool multi_threaded,
+				U_I multi_threaded_crypto,
+				U_I multi_threaded_compress,
+				U_I cache_size,
+				U_I slices_in_flight,
 				bool delta_signature,
 				bool build_delta_sig,
 				const mask & delta_mask,
@@ -292,6 +297,7 @@ namespace libdar
 				const infinint & iteration_count,
 				hash_algo kdf_hash,
 				const delta_sig_block_size & sig_block_len,
+				bool physical_order,
 				statistics * progressive_report);
 
 	void op_create_in_sub(operation op,                     ///< the filter operation to bind to
@@ -316,6 +322,7 @@ namespace libdar
 			      bool empty_dir,                   ///< whether to store excluded dir as empty directories
 			      compression algo,                 ///< compression algorithm
 			      U_I compression_level,            ///< compression level (range 1 to 9)
+			      U_I compression_block_size,       ///< size of compression blocks (zero for stream compression)
 			      const infinint & file_size,       ///< slice size
 			      const infinint & first_file_size, ///< first slice size
 			      const mask & ea_mask,             ///< Extended Attribute to consider
@@ -354,6 +361,10 @@ namespace libdar
 			      bool ignore_unknown,                        ///< whether to warn when an unknown inode type is met
 			      const fsa_scope & scope,                    ///< FSA scope for the operation
 			      bool multi_threaded,              ///< whether libdar is allowed to spawn several thread to possibily work faster on multicore CPU
+			      U_I multi_threaded_crypto,      ///< number of threads to use for ciphering
+			      U_I multi_threaded_compress,      ///< number of threads to use for compression
+			      U_I cache_size,                   ///< size of the cache layer
+			      U_I slices_in_flight,             ///< number of completed slices closed in background
 			      bool delta_signature,             ///< whether to calculate and store binary delta signature for each saved file
 			      bool build_delta_sig,             ///< whether to rebuild delta sig accordingly to delta_mask
 			      const mask & delta_mask,          ///< which files to consider delta signature for
@@ -365,6 +376,7 @@ namespace libdar
 			      const infinint & iteration_count, ///< for key derivation
 			      hash_algo kdf_hash,               ///< hash used for key derivation
 			      const delta_sig_block_size & sign_block_len, ///< block len for signature
+			      bool physical_order,              ///< whether to fetch file data ahead in the order it lies on disk
 			      statistics * st_ptr             ///< statistics must not be nullptr !
 	    );
 
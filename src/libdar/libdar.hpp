@@ -84,5 +84,6 @@
 #include "user_interaction_callback.hpp"
 #include "user_interaction_blind.hpp"
 #include "shell_interaction_emulator.hpp"
+#include "pattern_set_mask.hpp"
 
 #endif
@@ -43,6 +43,7 @@ extern "C"
 #include "path.hpp"
 #include "mask.hpp"
 #include "mask_list.hpp"
+#include "pattern_set_mask.hpp"
 #include "integers.hpp"
 #include "infinint.hpp"
 #include "statistics.hpp"
@@ -270,6 +271,9 @@ namespace libdar5
 	// from mask_list.hpp
     using libdar::mask_list;
 
+	// from pattern_set_mask.hpp
+    using libdar::pattern_set_mask;
+
 	// from hash_fichier.hpp
     using libdar::hash_algo;
     constexpr hash_algo hash_none = hash_algo::none;
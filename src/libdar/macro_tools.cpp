@@ -61,6 +61,7 @@ extern "C"
 #include "entrepot_libcurl.hpp"
 #include "scrambler.hpp"
 #include "hash_fichier.hpp"
+#include "block_compressor.hpp"
 #include "tools.hpp"
 
 #ifdef LIBTHREADAR_AVAILABLE
@@ -81,7 +82,7 @@ namespace libdar
 
 	/// this is the archive version format generated by the application
 	/// this is also the highest version of format that can be read
-    const archive_version macro_tools_supported_version = archive_version(10,1);
+    const archive_version macro_tools_supported_version = archive_version(11,0);
 
 
     static void version_check(user_interaction & dialog, const header_version & ver);
@@ -118,7 +119,9 @@ namespace libdar
 					      infinint &cat_size,
 					      const infinint & second_terminateur_offset,
 					      list<signator> & signatories,
-					      bool lax_mode)
+					      bool lax_mode,
+					      const mask *subtree,
+					      const path & subtree_root)
     {
 	return macro_tools_get_derivated_catalogue_from(dialog,
 							stack,
@@ -128,7 +131,9 @@ namespace libdar
 							cat_size,
 							second_terminateur_offset,
 							signatories,
-							lax_mode);
+							lax_mode,
+							subtree,
+							subtree_root);
     }
 
     catalogue *macro_tools_get_derivated_catalogue_from(const shared_ptr<user_interaction> & dialog,
@@ -139,7 +144,9 @@ namespace libdar
 							infinint &cat_size,
 							const infinint & second_terminateur_offset,
 							list<signator> & signatories,
-							bool lax_mode)
+							bool lax_mode,
+							const mask *subtree,
+							const path & subtree_root)
     {
         terminateur term;
         catalogue *ret = nullptr;
@@ -189,7 +196,9 @@ namespace libdar
 					     signatories,
 					     lax_mode,
 					     label_zero,
-					     false); // only_detruit
+					     false, // only_detruit
+					     subtree,
+					     subtree_root);
 
 	    if(ret == nullptr)
 		throw Ememory("get_catalogue_from");
@@ -223,7 +232,9 @@ namespace libdar
 					  list<signator> & signatories,
 					  bool lax_mode,
 					  const label & lax_layer1_data_name,
-					  bool only_detruits)
+					  bool only_detruits,
+					  const mask *subtree,
+					  const path & subtree_root)
     {
         catalogue *ret = nullptr;
 	memory_file hash_to_compare;
@@ -281,7 +292,9 @@ namespace libdar
 					      ver.get_compression_algo(),
 					      lax_mode,
 					      lax_layer1_data_name,
-					      only_detruits);
+					      only_detruits,
+					      subtree,
+					      subtree_root);
 		if(ret == nullptr)
 		    throw Ememory("macro_tools_read_catalogue");
 		try
@@ -383,6 +396,9 @@ namespace libdar
 				  list<signator> & gnupg_signed,
 				  slice_layout & sl,
 				  bool multi_threaded,
+				  U_I multi_threaded_crypto,
+				  U_I multi_threaded_compress,
+				  U_I cache_size,
 				  bool header_only)
     {
 	secu_string real_pass = pass;
@@ -394,6 +410,8 @@ namespace libdar
 #else
 	bool libcurl_repo = false;
 #endif
+	    // the zapette, used to read through dar_slave, fetches data ahead when asked to
+	bool zapette_repo = basename == "-" && !sequential_read;
 	string salt;
 
 	if(!dialog)
@@ -401,7 +419,7 @@ namespace libdar
 
 	stack.clear();
 #ifdef LIBTHREADAR_AVAILABLE
-	if(!multi_threaded && !libcurl_repo)
+	if(!multi_threaded && !libcurl_repo && !zapette_repo)
 	    stack.ignore_read_ahead(true);
 	else
 	    stack.ignore_read_ahead(false);
@@ -492,7 +510,7 @@ namespace libdar
 	    else
 	    {
 		    // we always ignore read_ahead as no slave thread will exist for LEVEL1 layer
-		tmp->ignore_read_ahead(!libcurl_repo);
+		tmp->ignore_read_ahead(!libcurl_repo && !zapette_repo);
 		stack.push(tmp, LIBDAR_STACK_LABEL_LEVEL1);
 		tmp = nullptr;
 	    }
@@ -559,7 +577,7 @@ namespace libdar
 		    throw Ememory("macro_tools_open_archive");
 		else
 		{
-		    tmp->ignore_read_ahead(!libcurl_repo);
+		    tmp->ignore_read_ahead(!libcurl_repo && !zapette_repo);
 			// no slave thread used below in the stack
 		    stack.clear_label(LIBDAR_STACK_LABEL_LEVEL1);
 		    stack.push(tmp, LIBDAR_STACK_LABEL_LEVEL1);
@@ -627,7 +645,7 @@ namespace libdar
 
 			// adding the cache layer only if no escape layer will tape place
 			// over. escape layer act a bit like a cache, making caching here useless
-		    tmp = tmp_cache = new (nothrow) cache (*(stack.top()), false);
+		    tmp = tmp_cache = new (nothrow) cache (*(stack.top()), false, cache_size);
 		    if(tmp == nullptr)
 			dialog->message(gettext("Failed opening the cache layer, lack of memory, archive read performances will not be optimized"));
 		}
@@ -661,7 +679,8 @@ namespace libdar
 							     ver.get_salt(),
 							     ver.get_iteration_count(),
 							     ver.get_kdf_hash(),
-							     ver.get_crypted_key() == nullptr);
+							     ver.get_crypted_key() == nullptr,
+							     multi_threaded_crypto);
 		    if(tmp_ptr != nullptr)
 			tmp_ptr->set_initial_shift(ver.get_initial_offset());
 		}
@@ -677,7 +696,8 @@ namespace libdar
 							     ver.get_salt(),
 							     ver.get_iteration_count(),
 							     ver.get_kdf_hash(),
-							     ver.get_crypted_key() == nullptr);
+							     ver.get_crypted_key() == nullptr,
+							     multi_threaded_crypto);
 
 		    if(tmp_ptr != nullptr)
 		    {
@@ -711,7 +731,7 @@ namespace libdar
 	    else
 	    {
 		    // we always ignore read ahead as encryption layer above sar/zapette/triial_sar has no slave thread below
-		tmp->ignore_read_ahead(!libcurl_repo);
+		tmp->ignore_read_ahead(!libcurl_repo && !zapette_repo);
 		stack.push(tmp);
 		tmp = nullptr;
 	    }
@@ -784,16 +804,16 @@ namespace libdar
 		    throw Ememory("open_archive");
 #ifdef LIBTHREADAR_AVAILABLE
 		if(!multi_threaded)
-		    tmp->ignore_read_ahead(!libcurl_repo);
+		    tmp->ignore_read_ahead(!libcurl_repo && !zapette_repo);
 		else
 		{
 		    if(second_terminateur_offset.is_zero()) // archive read from the beginning (sequential read)
-			tmp->ignore_read_ahead(!libcurl_repo);  // we avoid transmitting read_ahead request to the below thread
+			tmp->ignore_read_ahead(!libcurl_repo && !zapette_repo);  // we avoid transmitting read_ahead request to the below thread
 			// which has been configured with an endless read ahead, new read_ahead would abort configured
 			// endlessly read_ahead.
 		}
 #else
-		tmp->ignore_read_ahead(!libcurl_repo);
+		tmp->ignore_read_ahead(!libcurl_repo && !zapette_repo);
 #endif
 		stack.push(tmp);
 		tmp = nullptr;
@@ -827,7 +847,11 @@ namespace libdar
 
 	    version_check(*dialog, ver);
 
-	    tmp = new (nothrow) compressor(ver.get_compression_algo(), *(stack.top()));
+	    tmp = new (nothrow) compressor(ver.get_compression_algo(),
+					   *(stack.top()),
+					   9,
+					   ver.get_compression_block_size(),
+					   multi_threaded_compress);
 
 	    if(tmp == nullptr)
 		throw Ememory("open_archive");
@@ -835,9 +859,9 @@ namespace libdar
 	    {
 #ifdef LIBTHREADAR_AVAILABLE
 		if(!multi_threaded)
-		    tmp->ignore_read_ahead(!libcurl_repo);
+		    tmp->ignore_read_ahead(!libcurl_repo && !zapette_repo);
 #else
-		tmp->ignore_read_ahead(!libcurl_repo);
+		tmp->ignore_read_ahead(!libcurl_repo && !zapette_repo);
 #endif
 		stack.push(tmp, LIBDAR_STACK_LABEL_UNCOMPRESSED);
 		tmp = nullptr;
@@ -1070,6 +1094,7 @@ namespace libdar
 				   const infinint & pause,
 				   compression algo,
 				   U_I compression_level,
+				   U_I compression_block_size,
 				   const infinint & file_size,
 				   const infinint & first_file_size,
 				   const string & execute,
@@ -1088,7 +1113,11 @@ namespace libdar
 				   const label & data_name,
 				   const infinint & iteration_count,
 				   hash_algo kdf_hash,
-				   bool multi_threaded)
+				   bool multi_threaded,
+				   U_I multi_threaded_crypto,
+				   U_I multi_threaded_compress,
+				   U_I cache_size,
+				   U_I slices_in_flight)
     {
 #if GPGME_SUPPORT
 	U_I gnupg_key_size;
@@ -1188,7 +1217,8 @@ namespace libdar
 							  hash,
 							  slice_min_digits,
 							  false,
-							  execute);
+							  execute,
+							  slices_in_flight);
 
 			if(tmp_sar != nullptr)
 			    slicing = tmp_sar->get_slicing();
@@ -1210,7 +1240,7 @@ namespace libdar
 		    if(info_details)
 			dialog->message(gettext("Adding cache layer over pipe to provide limited skippability..."));
 
-		    cache *c_tmp = new (nothrow) cache(*(layers.top()), true);
+		    cache *c_tmp = new (nothrow) cache(*(layers.top()), true, cache_size);
 		    if(c_tmp == nullptr)
 			throw Ememory("op_create_in_sub");
 		    else
@@ -1230,6 +1260,14 @@ namespace libdar
 		ver.set_compression_algo(algo);
 		if(algo == compression::lzo1x_1_15 || algo == compression::lzo1x_1)
 		    ver.set_compression_algo(compression::lzo);
+		if(algo == compression::zstd_long)
+		    ver.set_compression_algo(compression::zstd);
+		if(algo == compression::lz4 && compression_block_size == 0)
+		    compression_block_size = block_compressor::default_block_size;
+		    // lz4 is only supported in block compression mode
+		if(algo == compression::none)
+		    compression_block_size = 0;
+		ver.set_compression_block_size(compression_block_size);
 		ver.set_command_line(user_comment);
 		ver.set_sym_crypto_algo(crypto);
 		ver.set_tape_marks(add_marks_for_sequential_reading);
@@ -1441,7 +1479,8 @@ namespace libdar
 						   salt,
 						   iteration_count,
 						   kdf_hash,
-						   gnupg_recipients.empty());
+						   gnupg_recipients.empty(),
+						   multi_threaded_crypto);
 
 #ifdef LIBDAR_NO_OPTIMIZATION
 		    tools_secu_string_show(*dialog, string("real_pass used: "), real_pass);
@@ -1452,7 +1491,7 @@ namespace libdar
 		    {
 			if(info_details)
 			    dialog->message(gettext("Adding a new layer on top: Caching layer for better performances..."));
-			tmp = new (nothrow) cache(*(layers.top()), false);
+			tmp = new (nothrow) cache(*(layers.top()), false, cache_size);
 		    }
 		    else
 			tmp = nullptr; // a cache is already present just below
@@ -1539,7 +1578,11 @@ namespace libdar
 
 		if(info_details && algo != compression::none)
 		    dialog->message(gettext("Adding a new layer on top: compression..."));
-		tmp = new (nothrow) compressor(algo, *(layers.top()), compression_level);
+		tmp = new (nothrow) compressor(algo,
+					       *(layers.top()),
+					       compression_level,
+					       compression_block_size,
+					       multi_threaded_compress);
 		if(tmp == nullptr)
 		    throw Ememory("op_create_in_sub");
 		else
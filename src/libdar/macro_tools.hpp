@@ -132,6 +132,9 @@ namespace libdar
 					 std::list<signator> & gnupg_signed, ///< list of existing signature found for that archive (valid or not)
 					 slice_layout & sl,    ///< slicing layout of the archive
 					 bool multi_threaded,  ///< true if several thread shall be run concurrently by libdar
+					 U_I multi_threaded_crypto, ///< number of threads to use for deciphering
+					 U_I multi_threaded_compress, ///< number of threads to use for decompression (block compression mode only)
+					 U_I cache_size,       ///< size of the cache layer added when no encryption is used
 					 bool header_only      ///< if true, stop the process before openning the encryption layer
 	);
         // all allocated objects (ret1, ret2, scram), must be deleted when no more needed by the caller of this routine
@@ -145,7 +148,9 @@ namespace libdar
 							       infinint &cat_size, // return size of archive in file (not in memory !)
 							       const infinint & second_terminateur_offset, // location of the second terminateur (zero if none exist)
 							       std::list<signator> & signatories, // returns the list of signatories (empty if archive is was not signed)
-							       bool lax_mode);         // whether to do relaxed checkings
+							       bool lax_mode,          // whether to do relaxed checkings
+							       const mask *subtree = nullptr, // if not nullptr, only entries covered by subtree are kept in memory
+							       const path & subtree_root = FAKE_ROOT); // path entries are relative to when checked against subtree
 
 	/// uses terminator to skip to the position where to find the catalogue and read it
     extern catalogue *macro_tools_get_catalogue_from(const std::shared_ptr<user_interaction> & dialog,
@@ -155,7 +160,9 @@ namespace libdar
                                                      infinint &cat_size, // return size of archive in file (not in memory !)
 						     const infinint & second_terminateur_offset,
 						     std::list<signator> & signatories, // returns the list of signatories (empty if archive is was not signed)
-						     bool lax_mode);
+						     bool lax_mode,
+						     const mask *subtree = nullptr, // if not nullptr, only entries covered by subtree are kept in memory
+						     const path & subtree_root = FAKE_ROOT); // path entries are relative to when checked against subtree
 
 	/// read the catalogue from cata_stack assuming the cata_stack is positionned at the beginning of the area containing archive's dumped data
     extern catalogue *macro_tools_read_catalogue(const std::shared_ptr<user_interaction> & dialog,
@@ -165,7 +172,9 @@ namespace libdar
 						 std::list<signator> & signatories,
 						 bool lax_mode,
 						 const label & lax_layer1_data_name,
-						 bool only_detruits);
+						 bool only_detruits,
+						 const mask *subtree = nullptr,
+						 const path & subtree_root = FAKE_ROOT);
 
     extern catalogue *macro_tools_lax_search_catalogue(const std::shared_ptr<user_interaction> & dialog,
 						       pile & stack,
@@ -194,6 +203,7 @@ namespace libdar
 	/// \param[in]  pause how many slices to wait before pausing (0 to never wait)
 	/// \param[in]  algo compression algorithm
 	/// \param[in]  compression_level compression level
+	/// \param[in]  compression_block_size size of compression blocks (zero for stream compression)
 	/// \param[in]  file_size size of the slices
 	/// \param[in]  first_file_size size of the first slice
 	/// \param[in]  execute command to execute after each slice creation
@@ -213,6 +223,9 @@ namespace libdar
 	/// \param[in]  iteration_count used for key derivation when passphrase is human provided
 	/// \param[in]  kdf_hash hash algorithm used for the key derivation function
 	/// \param[in]  multi_threaded true if libdar can spawn several thread to work
+	/// \param[in]  multi_threaded_crypto number of threads to use for ciphering
+	/// \param[in]  multi_threaded_compress number of threads to use for compression, if greater than one
+	/// and compression_block_size is zero, block compression is used with the default block size
 	///
 	/// \note the stack has the following contents depending on given options
 	///
@@ -253,6 +266,7 @@ namespace libdar
 					  const infinint & pause,
 					  compression algo,
 					  U_I compression_level,
+					  U_I compression_block_size,
 					  const infinint & file_size,
 					  const infinint & first_file_size,
 					  const std::string & execute,
@@ -271,7 +285,11 @@ namespace libdar
 					  const label & data_name,
 					  const infinint & iteration_count,
 					  hash_algo kdf_hash,
-					  bool multi_threaded);
+					  bool multi_threaded,
+					  U_I multi_threaded_crypto,
+					  U_I multi_threaded_compress,
+					  U_I cache_size,
+					  U_I slices_in_flight);
 
 	/// dumps the catalogue and close all the archive layers to terminate the archive
 
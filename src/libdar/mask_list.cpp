@@ -39,8 +39,22 @@ extern "C"
 #include <string.h>
 #endif
 
+#if HAVE_CTYPE_H
+#include <ctype.h>
+#endif
+
+#if HAVE_WCHAR_H
+#include <wchar.h>
+#endif
+
+#if HAVE_WCTYPE_H
+#include <wctype.h>
+#endif
+
 } // end extern "C"
 
+#include <algorithm>
+
 #include "mask_list.hpp"
 #include "erreurs.hpp"
 #include "tools.hpp"
@@ -53,7 +67,13 @@ using namespace std;
 namespace libdar
 {
 
+    static constexpr U_I folded_max = 8192; //< longest uppercased path is_covered() handles without allocating memory
+
+    static S_I modified_lexicalorder_compare(const char *a, U_I a_len, const char *b, U_I b_len);
     static bool modified_lexicalorder_a_lessthan_b(const std::string & a, const std::string & b);
+    static void leading_directories(const std::string & entry, std::deque<std::string> & dirs);
+    static bool fold_to_upper(const std::string & src, char *dst, U_I dst_size, U_I & len);
+    static U_I hash_entry(const char *data, U_I len);
 
     mask_list::mask_list(const string & filename_list_st, bool case_sensit, const path & prefix_t, bool include)
     {
@@ -211,12 +231,100 @@ namespace libdar
 		    // sorting the list with a modified lexicographical order where the / as is lowest character, other letter order unchanged
 		tmp.sort(&modified_lexicalorder_a_lessthan_b);
 		tmp.unique(); // remove duplicates
+		taille = tmp.size();
+
+		    /////////////
+		    // listing the directories leading to the entries, when including files
+
+		deque<string> dirs;
+
+		if(including)
+		{
+		    deque<string> previous, current;
+
+		    for(list<string>::iterator it = tmp.begin(); it != tmp.end(); ++it)
+		    {
+			leading_directories(*it, current);
+
+			    // the entries under a given directory are contiguous in the sorted list
+			    // so the directories shared with the previous entry are already listed
+			for(U_I i = 0; i < current.size(); ++i)
+			    if(i >= previous.size() || previous[i] != current[i])
+				dirs.push_back(current[i]);
+			previous.swap(current);
+		    }
+
+		    sort(dirs.begin(), dirs.end(), &modified_lexicalorder_a_lessthan_b);
+		    dirs.erase(unique(dirs.begin(), dirs.end()), dirs.end());
+		}
+
+		    /////////////
+		    // merging the entries and their directories in a single buffer
+
+		list<string>::iterator it = tmp.begin();
+		deque<string>::iterator dt = dirs.begin();
+		U_I total = 0;
+
+		for(list<string>::iterator tt = tmp.begin(); tt != tmp.end(); ++tt)
+		    total += tt->size();
+		for(deque<string>::iterator tt = dirs.begin(); tt != dirs.end(); ++tt)
+		    total += tt->size();
+
+		contenu.reserve(total);
+		offset.reserve(tmp.size() + dirs.size() + 1);
+		listed.reserve(tmp.size() + dirs.size());
+
+		while(it != tmp.end() || dt != dirs.end())
+		{
+		    S_I cmp;
+
+		    if(it == tmp.end())
+			cmp = 1;
+		    else if(dt == dirs.end())
+			cmp = -1;
+		    else
+			cmp = modified_lexicalorder_compare(it->c_str(), it->size(), dt->c_str(), dt->size());
+
+		    offset.push_back(contenu.size());
+		    if(cmp <= 0)
+		    {
+			contenu += *it;
+			listed.push_back(true);
+			++it;
+			if(cmp == 0)
+			    ++dt; // a listed directory leading to other listed entries
+		    }
+		    else
+		    {
+			contenu += *dt;
+			listed.push_back(false);
+			++dt;
+		    }
+		}
+		offset.push_back(contenu.size());
+
+		    /////////////
+		    // indexing the entries in an open addressing hash table, at most half filled
+
+		U_I num = entries();
+		U_I table_size = 2;
 
-		    // converting the sorted list to deque, to get the indexing feature of this type
-		contenu.assign(tmp.begin(), tmp.end());
-		taille = contenu.size();
-		if(taille < contenu.size())
+		if(num >= (U_I)(U_32)(-1))
 		    throw Erange("mask_list::mask_list", tools_printf(gettext("Too much line in file %S (integer overflow)"), &filename_list_st));
+		while(table_size < 2*num)
+		    table_size *= 2;
+		bucket.assign(table_size, 0);
+		for(U_I i = 0; i < num; ++i)
+		{
+		    const char *ent;
+		    U_I ent_len;
+		    U_I h;
+
+		    ent = entry(i, ent_len);
+		    for(h = hash_entry(ent, ent_len) & (table_size - 1); bucket[h] != 0; h = (h + 1) & (table_size - 1))
+			;
+		    bucket[h] = i + 1;
+		}
 	    }
 	    catch(Egeneric & e)
 	    {
@@ -234,50 +342,75 @@ namespace libdar
 
     bool mask_list::is_covered(const string & expression) const
     {
-	if(taille == 0)
+	if(entries() == 0)
 	    return false;
 
-	U_I min = 0, max = taille-1, tmp;
-        string target;
-        bool ret;
-
-        if(case_s)
-            target = expression;
-        else
-            tools_to_upper(expression, target);
-
-            // divide & conquer algorithm on a sorted list (aka binary search)
-        while(max - min > 1)
-        {
-            tmp = (min + max)/2;
-            if(modified_lexicalorder_a_lessthan_b(contenu[tmp], target))
-                min = tmp;
+	char folded[folded_max];
+	string upper;
+	const char *target;
+	U_I target_len;
+
+	if(case_s)
+	{
+	    target = expression.c_str();
+	    target_len = expression.size();
+	}
+	else
+	{
+	    if(fold_to_upper(expression, folded, folded_max, target_len))
+		target = folded;
 	    else
-		max = tmp; // we could set max to tmp-1 but we need to get  min < target < max , if target is absent from the list
-        }
-	if(min == 0 && modified_lexicalorder_a_lessthan_b(target, contenu[min]))
-	    max = min;
+	    {
+		tools_to_upper(expression, upper);
+		target = upper.c_str();
+		target_len = upper.size();
+	    }
+	}
+
+	    // if including files, the directories leading to a listed file are present
+	    // in the table beside the listed entries, so any entry found is covered
+	if(find(target, target_len))
+	    return true;
+
+	if(including && target_len > 1 && target[target_len - 1] == '/')
+	{
+		// the expression is a directory given with a trailing '/'
+	    while(target_len > 1 && target[target_len - 1] == '/')
+		--target_len;
+	    return find(target, target_len);
+	}
+
+	return false;
+    }
 
-        ret = contenu[max] == target || contenu[min] == target;
-        if(including && !ret) // if including files, we must also include directories leading to a listed file
+    bool mask_list::find(const char *target, U_I target_len) const
+    {
+	const char *ent;
+	U_I ent_len;
+
+	for(U_I h = hash_entry(target, target_len) & (bucket.size() - 1); bucket[h] != 0; h = (h + 1) & (bucket.size() - 1))
 	{
-	    string c_max = contenu[max];
-            ret = path(c_max).is_subdir_of(expression, case_s);
+	    ent = entry(bucket[h] - 1, ent_len);
+	    if(ent_len == target_len && memcmp(ent, target, target_len) == 0)
+		return true;
 	}
 
-        return ret;
+	return false;
     }
 
     string mask_list::dump(const string & prefix) const
     {
-	deque<string>::const_iterator it = contenu.begin();
 	string rec_pref = prefix + "  | ";
+	const char *ent;
+	U_I ent_len;
 
 	string ret = prefix + "If matches one of the following line(s):\n";
-	while(it != contenu.end())
+	for(U_I i = 0; i < entries(); ++i)
 	{
-	    ret += rec_pref + *it + "\n";
-	    ++it;
+	    if(!listed[i])
+		continue;
+	    ent = entry(i, ent_len);
+	    ret += rec_pref + string(ent, ent_len) + "\n";
 	}
 	ret += prefix + "  +--";
 
@@ -285,46 +418,147 @@ namespace libdar
     }
 
 
+    static S_I modified_lexicalorder_compare(const char *a, U_I a_len, const char *b, U_I b_len)
+    {
+	U_I len = a_len < b_len ? a_len : b_len;
+
+	for(U_I i = 0; i < len; ++i)
+	{
+	    if(a[i] == b[i])
+		continue;
+	    if(a[i] == '/')
+		return -1;
+	    if(b[i] == '/')
+		return 1;
+	    return a[i] < b[i] ? -1 : 1;
+	}
+
+	if(a_len == b_len)
+	    return 0;
+	else
+	    return a_len < b_len ? -1 : 1;
+    }
+
+    static U_I hash_entry(const char *data, U_I len)
+    {
+	    // FNV-1a hash
+	U_64 ret = 14695981039346656037ULL;
+
+	for(U_I i = 0; i < len; ++i)
+	{
+	    ret ^= (unsigned char)(data[i]);
+	    ret *= 1099511628211ULL;
+	}
+
+	return (U_I)(ret ^ (ret >> 32));
+    }
+
     static bool modified_lexicalorder_a_lessthan_b(const string & a, const string & b)
     {
-	string::const_iterator at = a.begin();
-	string::const_iterator bt = b.begin();
+	return modified_lexicalorder_compare(a.c_str(), a.size(), b.c_str(), b.size()) < 0;
+    }
+
+    static void leading_directories(const string & entry, deque<string> & dirs)
+    {
+	    // this gives the same directories as path(entry) would, without building it
+	string::const_iterator it = entry.begin();
+	string current = entry.empty() || entry[0] != '/' ? "" : "/";
+	bool first = true;
 
-	while(at != a.end() && bt != b.end())
+	dirs.clear();
+	while(it != entry.end())
 	{
-	    if(*at == '/')
-	    {
-		if(*bt != '/')
-		    return true;
+	    string::const_iterator next = find(it, entry.end(), '/');
 
-		    // else both a and b current letter are equal to '/'
-		    // reading further
+	    if(next != it) // ignoring the empty components of "//" or of a leading or trailing '/'
+	    {
+		if(!first)
+		{
+		    dirs.push_back(current);
+		    current += '/';
+		}
+		current += string(it, next);
+		first = false;
 	    }
+
+	    if(next == entry.end())
+		it = next;
 	    else
+		it = next + 1;
+	}
+
+	    // an absolute entry is not normalized when read, "/a/b/" must also cover "/a/b"
+	if(!first && current != entry)
+	    dirs.push_back(current);
+    }
+
+    static bool fold_to_upper(const string & src, char *dst, U_I dst_size, U_I & len)
+    {
+	    // this gives the same result as tools_to_upper() in the provided buffer
+
+	len = 0;
+#if HAVE_WCTYPE_H && HAVE_WCHAR_H
+	mbstate_t in_state, out_state;
+	const char *ptr = src.c_str();
+	U_I remain = src.size();
+	char conv[MB_LEN_MAX];
+	bool valid = true;
+
+	memset(&in_state, '\0', sizeof(in_state));
+	memset(&out_state, '\0', sizeof(out_state));
+	while(remain > 0 && valid)
+	{
+	    wchar_t wc;
+	    size_t used;
+
+#ifdef __STDC_ISO_10646__
+		// ASCII characters are their own wide char code, avoiding the
+		// costly multibyte conversions for them when no shift is pending
+	    if((unsigned char)(*ptr) < 0x80 && *ptr != '\0' && mbsinit(&in_state) && mbsinit(&out_state))
 	    {
-		if(*bt == '/')
-		    return false;
-		else
+		wc = towupper((unsigned char)(*ptr));
+		if(wc < 0x80)
 		{
-		    if(*at != *bt)
-			return *at < *bt;
-
-			// else a and b letter are equal
-			// reading further to find a difference
+		    if(len >= dst_size)
+			return false;
+		    dst[len++] = (char)wc;
+		    ++ptr;
+		    --remain;
+		    continue;
 		}
 	    }
+#endif
+	    used = mbrtowc(&wc, ptr, remain, &in_state);
+
+	    if(used == (size_t)-1 || used == (size_t)-2 || used == 0)
+		valid = false;
+	    else
+	    {
+		size_t made = wcrtomb(conv, towupper(wc), &out_state);
 
-	    ++at;
-	    ++bt;
+		if(made == (size_t)-1)
+		    throw SRC_BUG; // towupper() should return a valid wide char
+		if(len + made > dst_size)
+		    return false;
+		memcpy(dst + len, conv, made);
+		len += made;
+		ptr += used;
+		remain -= used;
+	    }
 	}
 
-	if(at == a.end())
-	    return true; // even if bt == b.end(), we have a <= b
+	if(valid)
+	    return true;
+	len = 0;
+#endif
+	if(src.size() > dst_size)
+	    return false;
+
+	for(U_I x = 0; x < src.size(); ++x)
+	    dst[x] = toupper(src[x]);
+	len = src.size();
 
-	if(bt == b.end())
-	    return false; // because at != a.end(), we thus have neither a == b nor a < b
-	else
-	    throw SRC_BUG; // at != a.end() and bt != b.end() how did we escaped the while loop?
+	return true;
     }
 
 } // end of namespace
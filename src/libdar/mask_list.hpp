@@ -34,6 +34,7 @@
 #include "mask.hpp"
 
 #include <string>
+#include <vector>
 
 namespace libdar
 {
@@ -46,6 +47,11 @@ namespace libdar
         /// the given file must contain one entry per line (thus no carriage return
         /// is allowed in a given entry). Note that the file listed in the
         /// file may have a relative path or an absolute path.
+	/// The entries are kept sorted in a single buffer, uppercased once at
+	/// construction time if the mask is not case sensitive, and when used for
+	/// inclusion the directories leading to them are added beside them, so
+	/// checking a path is a lookup in a hash table of the entries that does
+	/// not allocate memory.
 
     class mask_list : public mask
     {
@@ -73,17 +79,24 @@ namespace libdar
         virtual mask *clone() const override { return new (std::nothrow) mask_list(*this); };
 
             /// routing only necessary for doing some testing
-        U_I size() const { return contenu.size(); };
+        U_I size() const { return taille; };
 
 	    /// output the listing content
 	virtual std::string dump(const std::string & prefix) const override;
 
     private:
 
-        std::deque <std::string> contenu;
-        U_I taille;
+        std::string contenu;              ///< all entries one after the other, in modified lexicographical order
+	std::vector<U_I> offset;          ///< offset of each entry in contenu, plus the end offset of the last one
+	std::vector<bool> listed;         ///< whether each entry is in the list or is only a directory leading to listed entries
+	std::vector<U_32> bucket;         ///< open addressing hash table of the entries, holding their index plus one, zero for an empty slot
+        U_I taille;                       ///< number of entries in the list
         bool case_s;
         bool including;   // mask is used for including files (not for excluding files)
+
+	U_I entries() const { return offset.size() - 1; };
+	const char *entry(U_I index, U_I & len) const { len = offset[index + 1] - offset[index]; return contenu.c_str() + offset[index]; };
+	bool find(const char *target, U_I target_len) const;
     };
 
         /// @}
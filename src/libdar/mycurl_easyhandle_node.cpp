@@ -55,9 +55,9 @@ namespace libdar
     mycurl_easyhandle_node::mycurl_easyhandle_node(mycurl_easyhandle_node && ref) noexcept
     {
 	handle = ref.handle;
-	used = ref.used;
+	used = ref.get_used_mode();
 	ref.handle = nullptr;
-	ref.used = false;
+	ref.set_used_mode(false);
     }
 
 #endif
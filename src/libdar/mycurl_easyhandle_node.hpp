@@ -38,6 +38,7 @@ extern "C"
 } // end extern "C"
 
 #include <string>
+#include <atomic>
 
 namespace libdar
 {
@@ -70,14 +71,17 @@ namespace libdar
 	    /// destructor
 	~mycurl_easyhandle_node() { if(handle != nullptr) curl_easy_cleanup(handle); };
 
-	void set_used_mode(bool mode) { used = mode; };
-	bool get_used_mode() const { return used; };
+	    /// \note the used mode may be changed by a thread while another one reads it to find
+	    /// a free handle, a handle must only be released once no more accessed by the thread
+	    /// releasing it (see mycurl_shared_handle destructor)
+	void set_used_mode(bool mode) { used.store(mode, std::memory_order_release); };
+	bool get_used_mode() const { return used.load(std::memory_order_acquire); };
 
 	CURL *get_handle() const { return handle; };
 
     private:
 	CURL *handle;
-	bool used;
+	std::atomic<bool> used;
     };
 
 #endif
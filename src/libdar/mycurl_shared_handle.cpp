@@ -49,5 +49,19 @@ namespace libdar
 	return *this;
     }
 
+    mycurl_shared_handle::~mycurl_shared_handle()
+    {
+	if(!ref.is_null())
+	{
+	    mycurl_easyhandle_node *node = &(*ref);
+
+		// the reference is dropped before the node is seen free, as
+		// the thread allocating handles may then take a new reference
+		// on it; the node still exists as the sharing object keeps it
+	    ref = smart_pointer<mycurl_easyhandle_node>();
+	    node->set_used_mode(false);
+	}
+    }
+
 #endif
 } // end of namespace
@@ -70,7 +70,9 @@ namespace libdar
 	mycurl_shared_handle & operator = (mycurl_shared_handle && arg) noexcept;
 
 	    /// destructor
-	~mycurl_shared_handle() { if(!ref.is_null()) ref->set_used_mode(false); };
+
+	    /// \note the object may be destroyed by another thread than the one that created it
+	~mycurl_shared_handle();
 
 	    /// get access to the managed CURL easy handle
 	CURL *get_handle() const { return ref->get_handle(); };
@@ -0,0 +1,829 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_FNMATCH_H
+#include <fnmatch.h>
+#endif
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif
+
+#if HAVE_WCTYPE_H
+#include <wctype.h>
+#endif
+} // end extern "C"
+
+#include <bitset>
+#include <map>
+#include <algorithm>
+
+#include "pattern_set_mask.hpp"
+#include "tools.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+	// acceptance flags of automaton states, "sure" flags are set for states
+	// from which any continuation of the string is accepted
+
+    static constexpr unsigned char accept_any = 0x01;   ///< a glob expression matches
+    static constexpr unsigned char accept_exact = 0x02; ///< a glob expression not using '?' nor '[...]' matches
+    static constexpr unsigned char sure_shift = 2;
+
+	/// in the key of a state, value standing for the acceptance flags any continuation gets
+    static constexpr U_32 sure_marker = 0xFFFFFF00;
+
+	/// maximum number of entries of the transition table of an automaton
+
+	/// the glob expressions are split into several automata beyond that
+    static constexpr U_I automaton_max_size = 2*1024*1024;
+
+	/// maximum number of regular expressions merged into a single alternation
+    static constexpr U_I regex_merge_max = 256;
+
+    enum glob_token_kind { tk_literal, tk_any, tk_set, tk_star };
+
+    struct glob_token
+    {
+	glob_token_kind kind;
+	U_I value;            ///< the byte for tk_literal, the set index for tk_set
+    };
+
+	/// the trie of the common prefixes of the glob expressions
+
+	/// a node stands for the tokens read from the root, a node entered
+	/// by a '*' token loops on itself for any byte. A node is linked
+	/// to its '*' child by an epsilon transition (the '*' may match nothing)
+    struct trie_node
+    {
+	struct edge
+	{
+	    glob_token tok;
+	    U_I target;
+	};
+
+	vector<edge> edges;   ///< children but the '*' one
+	U_I star = 0;         ///< the '*' child, zero if none
+	bool is_star = false; ///< whether this node has been entered by a '*'
+	unsigned char accept = 0;
+    };
+
+    static string bool2_sensitivity(bool case_s);
+    static bool locale_is_utf8();
+    static bool is_ascii(const string & expression);
+    static bool parse_glob(const string & glob,
+			   vector<glob_token> & tokens,
+			   bool & wide,
+			   map<string, U_I> & set_index);
+    static bool find_bracket_end(const string & glob, U_I start, U_I & end, bool & supported);
+    static bool build_automaton(const vector<vector<glob_token> > & parsed,
+				const vector<bool> & wide_glob,
+				const vector<bitset<256> > & sets,
+				const vector<U_I> & which,
+				unsigned char *byte_class,
+				U_I & width,
+				vector<U_32> & table,
+				vector<unsigned char> & flags);
+    static bool regex_can_be_merged(const string & expression);
+
+    pattern_set_mask::pattern_set_mask(const deque<string> & glob_expressions,
+				       const deque<string> & regular_expressions,
+				       bool case_sensit): case_s(case_sensit),
+							  utf8(false),
+							  regex(regular_expressions)
+    {
+	for(deque<string>::const_iterator it = glob_expressions.begin(); it != glob_expressions.end(); ++it)
+	{
+	    if(!case_s)
+	    {
+		string upper;
+
+		tools_to_upper(*it, upper);
+		globs.push_back(upper);
+	    }
+	    else
+		globs.push_back(*it);
+	}
+
+	compile_globs();
+	compile_regex();
+    }
+
+    bool pattern_set_mask::is_covered(const string & expression) const
+    {
+	bool ret = false;
+
+	if(!globs.empty())
+	{
+	    string upper;
+	    const string *target = &expression;
+
+	    if(!case_s)
+	    {
+		tools_to_upper(expression, upper);
+		target = &upper;
+	    }
+
+	    if(!automata.empty())
+	    {
+		if(!utf8 || is_ascii(*target))
+		    ret = match_automata(*target, accept_any);
+		else
+		{
+		    if(mbstowcs(nullptr, target->c_str(), 0) == (size_t)(-1))
+			ret = match_all_globs(*target); // not a valid multi-byte string, leaving fnmatch() deal with it
+		    else
+			ret = match_automata(*target, accept_exact) || match_fnmatch(*target, wide);
+		}
+	    }
+
+	    if(!ret)
+		ret = match_fnmatch(*target, residual);
+	}
+
+	for(deque<regular_mask>::const_iterator it = regex_set.begin(); !ret && it != regex_set.end(); ++it)
+	    ret = it->is_covered(expression);
+
+	return ret;
+    }
+
+    string pattern_set_mask::dump(const string & prefix) const
+    {
+	string sensit = bool2_sensitivity(case_s);
+	string recursive_prefix = prefix + "  | ";
+	string ret = prefix + gettext("OR") + "\n";
+
+	for(deque<string>::const_iterator it = globs.begin(); it != globs.end(); ++it)
+	    ret += tools_printf(gettext("%Sglob expression: %S [%S]"),
+				&recursive_prefix,
+				&(*it),
+				&sensit) + "\n";
+	for(deque<string>::const_iterator it = regex.begin(); it != regex.end(); ++it)
+	    ret += tools_printf(gettext("%Sregular expression: %S [%S]"),
+				&recursive_prefix,
+				&(*it),
+				&sensit) + "\n";
+	ret += prefix + "  +--";
+
+	return ret;
+    }
+
+    bool pattern_set_mask::match_automata(const string & expression, unsigned char accept) const
+    {
+	unsigned char sure = accept << sure_shift;
+
+	for(deque<automaton>::const_iterator it = automata.begin(); it != automata.end(); ++it)
+	{
+	    const U_32 *table = it->table.data();
+	    const unsigned char *flags = it->flags.data();
+	    U_32 state = 1;
+
+	    for(string::const_iterator ch = expression.begin(); ch != expression.end() && state != 0; ++ch)
+	    {
+		state = table[state * it->width + it->byte_class[(unsigned char)(*ch)]];
+		if((flags[state] & sure) != 0)
+		    return true;
+	    }
+
+	    if((flags[state] & accept) != 0)
+		return true;
+	}
+
+	return false;
+    }
+
+    bool pattern_set_mask::match_fnmatch(const string & expression, const vector<U_I> & which) const
+    {
+	for(vector<U_I>::const_iterator it = which.begin(); it != which.end(); ++it)
+	    if(fnmatch(globs[*it].c_str(), expression.c_str(), FNM_PERIOD) == 0)
+		return true;
+
+	return false;
+    }
+
+    bool pattern_set_mask::match_all_globs(const string & expression) const
+    {
+	for(deque<string>::const_iterator it = globs.begin(); it != globs.end(); ++it)
+	    if(fnmatch(it->c_str(), expression.c_str(), FNM_PERIOD) == 0)
+		return true;
+
+	return false;
+    }
+
+    void pattern_set_mask::compile_globs()
+    {
+	vector<vector<glob_token> > parsed;
+	vector<bool> wide_glob;
+	map<string, U_I> set_index;
+	vector<bitset<256> > sets;
+	vector<U_I> compiled;
+	deque<vector<U_I> > todo;
+
+	if(MB_CUR_MAX > 1)
+	{
+	    utf8 = locale_is_utf8();
+	    if(!utf8)
+	    {
+		    // in other multi-byte encodings a byte of a character
+		    // may be an ASCII one, the automata cannot be used
+
+		for(U_I i = 0; i < globs.size(); ++i)
+		    residual.push_back(i);
+		return;
+	    }
+	}
+
+	parsed.resize(globs.size());
+	wide_glob.resize(globs.size(), false);
+
+	for(U_I i = 0; i < globs.size(); ++i)
+	{
+	    bool is_wide;
+	    bool ok = parse_glob(globs[i], parsed[i], is_wide, set_index);
+
+	    wide_glob[i] = is_wide;
+
+	    if(ok && utf8 && !is_ascii(globs[i]))
+		ok = mbstowcs(nullptr, globs[i].c_str(), 0) != (size_t)(-1);
+
+	    if(ok)
+		compiled.push_back(i);
+	    else
+		residual.push_back(i);
+	}
+
+	    // which bytes each bracket expression matches is asked to fnmatch()
+
+	sets.resize(set_index.size());
+	for(map<string, U_I>::const_iterator it = set_index.begin(); it != set_index.end(); ++it)
+	{
+	    char single[2] = { 0, 0 };
+
+	    for(U_I b = 1; b < 256; ++b)
+	    {
+		single[0] = (char)b;
+		if(fnmatch(it->first.c_str(), single, 0) == 0)
+		    sets[it->second].set(b);
+	    }
+	}
+
+	if(!compiled.empty())
+	    todo.push_back(compiled);
+
+	while(!todo.empty())
+	{
+	    automaton tmp;
+
+	    if(build_automaton(parsed, wide_glob, sets, todo.front(), tmp.byte_class, tmp.width, tmp.table, tmp.flags))
+	    {
+		automata.push_back(move(tmp));
+		if(utf8)
+		    for(vector<U_I>::const_iterator it = todo.front().begin(); it != todo.front().end(); ++it)
+			if(wide_glob[*it])
+			    wide.push_back(*it);
+	    }
+	    else
+	    {
+		if(todo.front().size() == 1)
+		    residual.push_back(todo.front().front());
+		else
+		{
+		    U_I half = todo.front().size() / 2;
+
+		    todo.push_back(vector<U_I>(todo.front().begin(), todo.front().begin() + half));
+		    todo.push_back(vector<U_I>(todo.front().begin() + half, todo.front().end()));
+		}
+	    }
+
+	    todo.pop_front();
+	}
+    }
+
+    void pattern_set_mask::compile_regex()
+    {
+	string merged;
+	deque<string> members;
+
+	for(U_I i = 0; i <= regex.size(); ++i)
+	{
+	    if(i < regex.size())
+	    {
+		if(!regex_can_be_merged(regex[i]))
+		{
+		    regex_set.emplace_back(regex[i], case_s);
+		    continue;
+		}
+
+		    // compiling the expression alone for an invalid one to be reported as regular_mask does
+		(void)regular_mask(regex[i], case_s);
+
+		if(!members.empty())
+		    merged += "|";
+		merged += "(" + regex[i] + ")";
+		members.push_back(regex[i]);
+	    }
+
+	    if(!members.empty() && (i == regex.size() || members.size() >= regex_merge_max))
+	    {
+		if(members.size() == 1)
+		    regex_set.emplace_back(members.front(), case_s);
+		else
+		{
+		    try
+		    {
+			regex_set.emplace_back(merged, case_s);
+		    }
+		    catch(Erange & e)
+		    {
+			for(deque<string>::const_iterator it = members.begin(); it != members.end(); ++it)
+			    regex_set.emplace_back(*it, case_s);
+		    }
+		}
+		merged.clear();
+		members.clear();
+	    }
+	}
+    }
+
+    static string bool2_sensitivity(bool case_s)
+    {
+	return case_s ? gettext("case sensitive") : gettext("case in-sensitive");
+    }
+
+    static bool locale_is_utf8()
+    {
+	const char *sample = "\xc3\xa9\xe2\x82\xac"; // U+00E9 and U+20AC
+	wchar_t decoded[3];
+
+	return mbstowcs(decoded, sample, 3) == 2
+	    && decoded[0] == (wchar_t)0xE9
+	    && decoded[1] == (wchar_t)0x20AC;
+    }
+
+    static bool is_ascii(const string & expression)
+    {
+	for(string::const_iterator it = expression.begin(); it != expression.end(); ++it)
+	    if(((unsigned char)(*it) & 0x80) != 0)
+		return false;
+
+	return true;
+    }
+
+    static bool parse_glob(const string & glob,
+			   vector<glob_token> & tokens,
+			   bool & wide,
+			   map<string, U_I> & set_index)
+    {
+	U_I i = 0;
+	glob_token tok;
+
+	tokens.clear();
+	wide = false;
+
+	while(i < glob.size())
+	{
+	    switch(glob[i])
+	    {
+	    case '*':
+		if(tokens.empty() || tokens.back().kind != tk_star)
+		{
+		    tok.kind = tk_star;
+		    tok.value = 0;
+		    tokens.push_back(tok);
+		}
+		++i;
+		break;
+	    case '?':
+		tok.kind = tk_any;
+		tok.value = 0;
+		tokens.push_back(tok);
+		wide = true;
+		++i;
+		break;
+	    case '\\':
+		if(i + 1 >= glob.size())
+		    return false; // fnmatch() never matches a trailing backslash
+		tok.kind = tk_literal;
+		tok.value = (unsigned char)glob[i + 1];
+		tokens.push_back(tok);
+		i += 2;
+		break;
+	    case '[':
+		{
+		    U_I end;
+		    bool supported = true;
+
+		    if(find_bracket_end(glob, i, end, supported))
+		    {
+			if(!supported)
+			    return false;
+
+			map<string, U_I>::iterator it = set_index.insert(pair<string, U_I>(glob.substr(i, end + 1 - i), set_index.size())).first;
+			tok.kind = tk_set;
+			tok.value = it->second;
+			tokens.push_back(tok);
+			wide = true;
+			i = end + 1;
+		    }
+		    else // unterminated bracket, '[' is a normal character
+		    {
+			tok.kind = tk_literal;
+			tok.value = (unsigned char)'[';
+			tokens.push_back(tok);
+			++i;
+		    }
+		}
+		break;
+	    default:
+		tok.kind = tk_literal;
+		tok.value = (unsigned char)glob[i];
+		tokens.push_back(tok);
+		++i;
+	    }
+	}
+
+	return true;
+    }
+
+    static bool find_bracket_end(const string & glob, U_I start, U_I & end, bool & supported)
+    {
+	U_I i = start + 1;
+	bool first = true;
+
+	if(i < glob.size() && (glob[i] == '!' || glob[i] == '^'))
+	    ++i;
+
+	while(i < glob.size())
+	{
+	    if(glob[i] == '\\')
+	    {
+		if(i + 1 >= glob.size())
+		{
+		    supported = false;
+		    return true;
+		}
+		i += 2;
+	    }
+	    else if(glob[i] == '['
+		    && i + 1 < glob.size()
+		    && (glob[i + 1] == ':' || glob[i + 1] == '=' || glob[i + 1] == '.'))
+	    {
+		string::size_type close = glob.find(string(1, glob[i + 1]) + "]", i + 2);
+
+		    // collating symbols and equivalence classes are left to fnmatch()
+		if(close == string::npos || glob[i + 1] != ':')
+		{
+		    supported = false;
+		    return true;
+		}
+#if HAVE_WCTYPE_H
+		    // an unknown class name is not a class, its '[' is a normal character
+		if(wctype(glob.substr(i + 2, close - i - 2).c_str()) == 0)
+		    ++i;
+		else
+		    i = close + 2;
+#else
+		supported = false;
+		return true;
+#endif
+	    }
+	    else if(glob[i] == ']' && !first)
+	    {
+		end = i;
+		return true;
+	    }
+	    else
+		++i;
+
+	    first = false;
+	}
+
+	return false;
+    }
+
+    static bool build_automaton(const vector<vector<glob_token> > & parsed,
+				const vector<bool> & wide_glob,
+				const vector<bitset<256> > & sets,
+				const vector<U_I> & which,
+				unsigned char *byte_class,
+				U_I & width,
+				vector<U_32> & table,
+				vector<unsigned char> & flags)
+    {
+	vector<trie_node> nodes(1);
+	map<pair<U_I, pair<U_I, U_I> >, U_I> children;
+	vector<U_I> key(256, 0);
+	vector<U_I> used_sets;
+	map<U_I, vector<U_I> > set_classes;
+	vector<U_I> all_classes;
+	U_I dot;
+	vector<unsigned char> reach;
+	map<vector<U_32>, U_32> known;
+	deque<vector<U_32> > pending;
+	vector<vector<U_32> > out;
+
+	    // building the trie
+
+	for(vector<U_I>::const_iterator it = which.begin(); it != which.end(); ++it)
+	{
+	    U_I cur = 0;
+
+	    for(vector<glob_token>::const_iterator tok = parsed[*it].begin(); tok != parsed[*it].end(); ++tok)
+	    {
+		if(tok->kind == tk_star)
+		{
+		    if(nodes[cur].star == 0)
+		    {
+			nodes.push_back(trie_node());
+			nodes.back().is_star = true;
+			nodes[cur].star = nodes.size() - 1;
+		    }
+		    cur = nodes[cur].star;
+		}
+		else
+		{
+		    pair<U_I, pair<U_I, U_I> > index(cur, pair<U_I, U_I>(tok->kind, tok->value));
+		    map<pair<U_I, pair<U_I, U_I> >, U_I>::iterator child = children.find(index);
+
+		    if(child == children.end())
+		    {
+			trie_node::edge ed;
+
+			nodes.push_back(trie_node());
+			ed.tok = *tok;
+			ed.target = nodes.size() - 1;
+			nodes[cur].edges.push_back(ed);
+			children[index] = ed.target;
+			cur = ed.target;
+			if(tok->kind == tk_set)
+			    used_sets.push_back(tok->value);
+		    }
+		    else
+			cur = child->second;
+		}
+	    }
+
+	    nodes[cur].accept |= wide_glob[*it] ? accept_any : (accept_any|accept_exact);
+	}
+	children.clear();
+
+	    // splitting bytes in classes: bytes of a class are matched
+	    // by the same literals and bracket expressions. The dot is kept
+	    // apart for the leading period rule of FNM_PERIOD
+
+	key['.'] = 1;
+	for(vector<trie_node>::const_iterator nd = nodes.begin(); nd != nodes.end(); ++nd)
+	    for(vector<trie_node::edge>::const_iterator ed = nd->edges.begin(); ed != nd->edges.end(); ++ed)
+		if(ed->tok.kind == tk_literal)
+		    key[ed->tok.value] = 2 + ed->tok.value;
+
+	sort(used_sets.begin(), used_sets.end());
+	used_sets.erase(unique(used_sets.begin(), used_sets.end()), used_sets.end());
+
+	for(U_I round = 0; round <= used_sets.size(); ++round)
+	{
+	    map<pair<U_I, bool>, U_I> renum;
+
+	    for(U_I b = 0; b < 256; ++b)
+	    {
+		bool in = round < used_sets.size() && sets[used_sets[round]].test(b);
+
+		key[b] = renum.insert(pair<pair<U_I, bool>, U_I>(pair<U_I, bool>(key[b], in), renum.size())).first->second;
+	    }
+	}
+
+	width = 0;
+	for(U_I b = 0; b < 256; ++b)
+	{
+	    byte_class[b] = (unsigned char)key[b];
+	    if(key[b] + 1 > width)
+		width = key[b] + 1;
+	}
+	dot = byte_class[(unsigned char)'.'];
+
+	for(U_I k = 0; k < width; ++k)
+	    all_classes.push_back(k);
+
+	for(vector<U_I>::const_iterator it = used_sets.begin(); it != used_sets.end(); ++it)
+	{
+	    vector<U_I> & cl = set_classes[*it];
+	    vector<bool> seen(width, false);
+
+	    for(U_I b = 0; b < 256; ++b)
+		if(sets[*it].test(b) && !seen[byte_class[b]])
+		{
+		    seen[byte_class[b]] = true;
+		    cl.push_back(byte_class[b]);
+		}
+	}
+
+	    // which acceptance flags can be reached from each node, the
+	    // children have been created after their parent
+
+	reach.resize(nodes.size());
+	for(U_I n = nodes.size(); n > 0; --n)
+	{
+	    const trie_node & node = nodes[n - 1];
+
+	    reach[n - 1] = node.accept;
+	    if(node.star != 0)
+		reach[n - 1] |= reach[node.star];
+	    for(vector<trie_node::edge>::const_iterator ed = node.edges.begin(); ed != node.edges.end(); ++ed)
+		reach[n - 1] |= reach[ed->target];
+	}
+
+	    // subset construction: a state is a set of trie nodes,
+	    // state 0 is the dead state, state 1 the start state which
+	    // is not shared as the first byte of the string follows its
+	    // own rule: a leading period is only matched by a literal
+	    // period at the beginning of the glob expression
+
+	table.assign(2 * width, 0);
+	flags.assign(2, 0);
+	known[vector<U_32>()] = 0;
+	pending.push_back(vector<U_32>());
+	pending.push_back(vector<U_32>(1, 0));
+	if(nodes[0].star != 0)
+	    pending.back().push_back(nodes[0].star);
+	for(vector<U_32>::const_iterator it = pending.back().begin(); it != pending.back().end(); ++it)
+	    flags[1] |= nodes[*it].accept;
+
+	out.resize(width);
+
+	for(U_32 id = 1; id < pending.size(); ++id)
+	{
+	    vector<U_32> cur;
+	    bool first = (id == 1);
+
+	    cur.swap(pending[id]);
+	    for(U_I k = 0; k < width; ++k)
+		out[k].clear();
+
+	    for(vector<U_32>::const_iterator n = cur.begin(); n != cur.end(); ++n)
+	    {
+		if(*n >= sure_marker)
+		{
+		    for(U_I k = 0; k < width; ++k)
+			out[k].push_back(*n);
+		    continue;
+		}
+
+		const trie_node & node = nodes[*n];
+
+		if(node.is_star)
+		    for(U_I k = 0; k < width; ++k)
+			if(!first || k != dot)
+			    out[k].push_back(*n);
+
+		for(vector<trie_node::edge>::const_iterator ed = node.edges.begin(); ed != node.edges.end(); ++ed)
+		{
+		    U_I single = 0;
+		    const vector<U_I> *classes = &all_classes;
+		    U_I num;
+
+		    switch(ed->tok.kind)
+		    {
+		    case tk_literal:
+			single = byte_class[ed->tok.value];
+			classes = nullptr;
+			break;
+		    case tk_any:
+			break;
+		    case tk_set:
+			classes = &(set_classes[ed->tok.value]);
+			break;
+		    default:
+			throw SRC_BUG;
+		    }
+
+		    num = classes == nullptr ? 1 : classes->size();
+		    for(U_I c = 0; c < num; ++c)
+		    {
+			U_I k = classes == nullptr ? single : (*classes)[c];
+
+			if(first && k == dot && (*n != 0 || ed->tok.kind != tk_literal))
+			    continue;
+
+			out[k].push_back(ed->target);
+			if(nodes[ed->target].star != 0)
+			    out[k].push_back(nodes[ed->target].star);
+		    }
+		}
+	    }
+
+	    for(U_I k = 0; k < width; ++k)
+	    {
+		vector<U_32> & next = out[k];
+		map<vector<U_32>, U_32>::iterator found;
+		unsigned char sure = 0;
+
+		sort(next.begin(), next.end());
+		next.erase(unique(next.begin(), next.end()), next.end());
+
+		    // once an accepting '*' node has been reached, any continuation
+		    // is accepted: the nodes that cannot lead to other acceptance
+		    // flags are removed and replaced by a marker, else the states
+		    // would record all the combinations of matched glob expressions
+
+		for(vector<U_32>::const_iterator it = next.begin(); it != next.end(); ++it)
+		{
+		    if(*it >= sure_marker)
+			sure |= (unsigned char)(*it - sure_marker);
+		    else if(nodes[*it].is_star)
+			sure |= nodes[*it].accept;
+		}
+
+		if(sure != 0)
+		{
+		    U_I kept = 0;
+
+		    for(U_I i = 0; i < next.size(); ++i)
+			if(next[i] < sure_marker && (reach[next[i]] & ~sure) != 0)
+			    next[kept++] = next[i];
+		    next.resize(kept);
+		    next.push_back(sure_marker + sure);
+		}
+
+		found = known.find(next);
+		if(found == known.end())
+		{
+		    unsigned char fl = sure | (sure << sure_shift);
+		    U_32 added = pending.size();
+
+		    for(vector<U_32>::const_iterator it = next.begin(); it != next.end() && *it < sure_marker; ++it)
+			fl |= nodes[*it].accept;
+
+		    if((added + 1) * width > automaton_max_size)
+			return false;
+
+		    found = known.insert(pair<vector<U_32>, U_32>(next, added)).first;
+		    pending.push_back(next);
+		    flags.push_back(fl);
+		    table.resize((added + 1) * width, 0);
+		}
+
+		table[id * width + k] = found->second;
+	    }
+	}
+
+	return true;
+    }
+
+    static bool regex_can_be_merged(const string & expression)
+    {
+	S_I depth = 0;
+
+	    // back references would refer to another group once merged,
+	    // parentheses are counted roughly, an unbalanced count only
+	    // leads the expression to be kept apart
+
+	for(U_I i = 0; i < expression.size(); ++i)
+	{
+	    switch(expression[i])
+	    {
+	    case '\\':
+		if(i + 1 < expression.size() && expression[i + 1] >= '1' && expression[i + 1] <= '9')
+		    return false;
+		break;
+	    case '(':
+		++depth;
+		break;
+	    case ')':
+		if(--depth < 0)
+		    return false;
+		break;
+	    default:
+		break;
+	    }
+	}
+
+	return depth == 0;
+    }
+
+} // end of namespace
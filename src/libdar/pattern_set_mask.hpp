@@ -0,0 +1,125 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+    /// \file pattern_set_mask.hpp
+    /// \brief here lies a mask that matches any of a large set of glob or regular expressions
+    /// \ingroup API
+    ///
+    /// The pattern_set_mask class defined here is to be used for filtering files
+    /// in the libdar API calls.
+
+#ifndef PATTERN_SET_MASK_HPP
+#define PATTERN_SET_MASK_HPP
+
+#include "../my_config.h"
+
+#include <string>
+#include <deque>
+#include <vector>
+
+#include "mask.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup API
+	/// @{
+
+	/// matches if any of the given glob or regular expressions matches
+
+	/// this gives the same result as an ou_mask of simple_mask and regular_mask
+	/// objects, but the glob expressions are compiled together in a trie
+	/// of their common prefixes from which a deterministic automaton is built,
+	/// so the cost of checking a string does not depend on the number of glob
+	/// expressions. Regular expressions are merged in alternations given at once
+	/// to the system regex library.
+	/// \note glob expressions the automaton cannot reproduce exactly (collating
+	/// elements, equivalence classes, locale other than a single byte one or UTF-8)
+	/// are kept apart and checked with fnmatch() as simple_mask does
+
+    class pattern_set_mask : public mask
+    {
+    public:
+
+	    /// the constructor to be used by libdar external programs
+
+	    /// \param[in] glob_expressions the glob expressions (see simple_mask)
+	    /// \param[in] regular_expressions the regular expressions (see regular_mask)
+	    /// \param[in] case_sensit whether the mask is case sensitive or not
+	pattern_set_mask(const std::deque<std::string> & glob_expressions,
+			 const std::deque<std::string> & regular_expressions,
+			 bool case_sensit);
+	pattern_set_mask(const pattern_set_mask & ref) = default;
+	pattern_set_mask(pattern_set_mask && ref) noexcept = default;
+	pattern_set_mask & operator = (const pattern_set_mask & ref) = default;
+	pattern_set_mask & operator = (pattern_set_mask && ref) noexcept = default;
+	~pattern_set_mask() = default;
+
+	    /// inherited from the mask class
+	virtual bool is_covered(const std::string & expression) const override;
+
+	    /// inherited from the mask class
+	virtual std::string dump(const std::string & prefix) const override;
+
+	    /// inherited from the mask class
+	virtual mask *clone() const override { return new (std::nothrow) pattern_set_mask(*this); };
+
+	    /// the number of glob and regular expressions of the mask
+	U_I size() const { return globs.size() + regex.size(); };
+
+	    /// the number of automata the glob expressions have been compiled into
+
+	    /// \note the glob expressions are split in several automata only when
+	    /// a single one would be too large
+	U_I get_automaton_count() const { return automata.size(); };
+
+    private:
+
+	    /// deterministic automaton built from a set of glob expressions
+	struct automaton
+	{
+	    unsigned char byte_class[256];    ///< class of each byte, bytes of a class lead to the same states
+	    U_I width;                        ///< number of byte classes
+	    std::vector<U_32> table;          ///< next state for each state and class, state 0 is dead, state 1 is the start
+	    std::vector<unsigned char> flags; ///< acceptance flags of each state
+	};
+
+	bool case_s;                          ///< whether the mask is case sensitive
+	bool utf8;                            ///< whether the locale is UTF-8 encoded (single byte locale if false and automata is not empty)
+	std::deque<std::string> globs;        ///< the glob expressions (uppercased if not case sensitive)
+	std::deque<std::string> regex;        ///< the regular expressions as given
+	std::deque<automaton> automata;       ///< the compiled glob expressions
+	std::vector<U_I> wide;                ///< globs compiled in automata but using '?' or '[...]' which act on characters not bytes
+	std::vector<U_I> residual;            ///< globs not compiled, checked with fnmatch()
+	std::deque<regular_mask> regex_set;   ///< regular expressions merged in alternations
+
+	bool match_automata(const std::string & expression, unsigned char accept) const;
+	bool match_fnmatch(const std::string & expression, const std::vector<U_I> & which) const;
+	bool match_all_globs(const std::string & expression) const;
+	void compile_globs();
+	void compile_regex();
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
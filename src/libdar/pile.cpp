@@ -288,6 +288,30 @@ namespace libdar
 	    throw Erange("pile::skip", "Error: inherited_read() on empty stack");
     }
 
+    bool pile::inherited_read_lend(const char * & ptr, U_I & size)
+    {
+	if(stack.size() > 0)
+	{
+	    if(stack.back().ptr == nullptr)
+		throw SRC_BUG;
+	    return stack.back().ptr->read_lend(ptr, size);
+	}
+	else
+	    throw Erange("pile::skip", "Error: inherited_read_lend() on empty stack");
+    }
+
+    bool pile::inherited_lent_from(S_I & fd, infinint & offset) const
+    {
+	if(stack.size() > 0)
+	{
+	    if(stack.back().ptr == nullptr)
+		throw SRC_BUG;
+	    return stack.back().ptr->lent_from(fd, offset);
+	}
+	else
+	    return false;
+    }
+
     void pile::inherited_write(const char *a, U_I size)
     {
 	if(stack.size() > 0)
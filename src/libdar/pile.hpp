@@ -156,6 +156,8 @@ namespace libdar
     protected:
 	virtual void inherited_read_ahead(const infinint & amount) override;
 	virtual U_I inherited_read(char *a, U_I size) override;
+	virtual bool inherited_read_lend(const char * & ptr, U_I & size) override;
+	virtual bool inherited_lent_from(S_I & fd, infinint & offset) const override;
 	virtual void inherited_write(const char *a, U_I size) override;
 	virtual void inherited_sync_write() override;
 	virtual void inherited_flush_read() override;
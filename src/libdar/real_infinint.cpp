@@ -62,6 +62,9 @@ namespace libdar
         S_I lu;
         int_tools_bitfield bf;
 
+	field = nullptr;
+	small = 0;
+
         while(!fin)
         {
             lu = x.read((char *)&a, 1);
@@ -87,6 +90,26 @@ namespace libdar
                     ++pos;
                 pos += 1; // bf starts at zero, but bit zero means 1 TG of length
 
+		if(skip.is_zero() && pos*TG <= sizeof(small))
+		{
+			// the value fits in 64 bits, no need to allocate a storage
+		    unsigned char buf[sizeof(small)];
+		    U_I width = pos*TG;
+		    U_I lu_width = 0;
+
+		    while(lu_width < width)
+		    {
+			lu = x.read((char *)buf + lu_width, width - lu_width);
+			if(lu <= 0)
+			    throw Erange("infinint::build_from_file(proto_generic_file)", gettext("Reached end of file before all data could be read"));
+			lu_width += lu;
+		    }
+
+		    for(U_I i = 0; i < width; ++i)
+			small = (small << 8) | buf[i];
+		    return;
+		}
+
                 skip *= 8;
                 skip += pos;
                 skip *= TG;
@@ -111,6 +134,7 @@ namespace libdar
             }
         }
         reduce(); // necessary to reduce due to TG storage
+	demote();
     }
 
 
@@ -122,6 +146,22 @@ namespace libdar
         infinint justification;
         U_32 tmp;
 
+	if(is_small())
+	{
+		// same layout as below, but the preamble is a single byte
+		// as the value never needs more than two groups of TG bytes
+	    unsigned char buf[1 + 2*TG];
+	    U_I width = small_width(small);
+	    U_I groups = (width + TG - 1) / TG;
+	    U_I total = groups*TG;
+
+	    buf[0] = 0x80 >> (groups - 1);
+	    for(U_I i = 0; i < total; ++i)
+		buf[1 + i] = i < total - width ? 0 : (small >> ((total - 1 - i)*8)) & 0xFF;
+	    x.write((char *)buf, 1 + total);
+	    return;
+	}
+
         if(! is_valid())
             throw SRC_BUG;
 
@@ -194,8 +234,18 @@ namespace libdar
         field->dump(x);
     }
 
-    infinint & infinint::operator += (const infinint & arg)
+    infinint & infinint::operator += (const infinint & ref)
     {
+	if(is_small() && ref.is_small() && small <= SMALL_MAX - ref.small)
+	{
+	    small += ref.small;
+	    return *this;
+	}
+
+	promote();
+	infinint arg_storage;
+	const infinint & arg = as_storage(ref, arg_storage);
+
         if(! is_valid() || ! arg.is_valid())
             throw SRC_BUG;
 
@@ -235,17 +285,29 @@ namespace libdar
             // not smaller than the one of the two infinint in presence.
 	    // resulting infinint is thus in canonical form (no leading zeros)
 
+        demote();
         return *this;
     }
 
-    infinint & infinint::operator -= (const infinint & arg)
+    infinint & infinint::operator -= (const infinint & ref)
     {
+        if(*this < ref)
+            throw Erange("infinint::operator", gettext("Subtracting an \"infinint\" greater than the first, \"infinint\" cannot be negative"));
+
+	if(ref.is_small() && (is_small() || ref.small == 0))
+	{
+	    if(is_small())
+		small -= ref.small;
+	    return *this;
+	}
+
+	promote();
+	infinint arg_storage;
+	const infinint & arg = as_storage(ref, arg_storage);
+
         if(! is_valid() || ! arg.is_valid())
             throw SRC_BUG;
 
-        if(*this < arg)
-            throw Erange("infinint::operator", gettext("Subtracting an \"infinint\" greater than the first, \"infinint\" cannot be negative"));
-
             // now processing the operation
 
         storage::iterator it_a = arg.field->rbegin();
@@ -290,11 +352,20 @@ namespace libdar
 	    // be in canonical form. It will be "reduced()" to canonical form only when necessary
 	    // at the detriment of the space used during the gap.
 
+        demote();
         return *this;
     }
 
     infinint & infinint::operator *= (unsigned char arg)
     {
+	if(is_small() && (arg == 0 || small <= SMALL_MAX / arg))
+	{
+	    small *= arg;
+	    return *this;
+	}
+
+	promote();
+
         if(!is_valid())
             throw SRC_BUG;
 
@@ -328,10 +399,20 @@ namespace libdar
         return *this;
     }
 
-    infinint & infinint::operator *= (const infinint & arg)
+    infinint & infinint::operator *= (const infinint & ref)
     {
         infinint ret = 0;
 
+	if(is_small() && ref.is_small() && (small == 0 || ref.small <= SMALL_MAX / small))
+	{
+	    small *= ref.small;
+	    return *this;
+	}
+
+	promote();
+	infinint arg_storage;
+	const infinint & arg = as_storage(ref, arg_storage);
+
         if(!is_valid() || !arg.is_valid())
             throw SRC_BUG;
 
@@ -346,11 +427,22 @@ namespace libdar
 
         *this = ret;
 
+        demote();
         return *this; // copy constructor
     }
 
-    infinint & infinint::operator &= (const infinint & arg)
+    infinint & infinint::operator &= (const infinint & ref)
     {
+	if(is_small() && ref.is_small())
+	{
+	    small &= ref.small;
+	    return *this;
+	}
+
+	promote();
+	infinint arg_storage;
+	const infinint & arg = as_storage(ref, arg_storage);
+
 	if(! is_valid() || ! arg.is_valid())
 	    throw SRC_BUG;
 
@@ -377,11 +469,22 @@ namespace libdar
 	    reduce();
 	}
 
+	demote();
 	return *this;
     }
 
-    infinint & infinint::operator |= (const infinint & arg)
+    infinint & infinint::operator |= (const infinint & ref)
     {
+	if(is_small() && ref.is_small())
+	{
+	    small |= ref.small;
+	    return *this;
+	}
+
+	promote();
+	infinint arg_storage;
+	const infinint & arg = as_storage(ref, arg_storage);
+
 	if(! is_valid() || ! arg.is_valid())
 	    throw SRC_BUG;
 
@@ -393,11 +496,22 @@ namespace libdar
 	while(it_res != field->rend() && it_a != arg.field->rend())
 	    *it_res-- |= *it_a--;
 
+	demote();
 	return *this;
     }
 
-    infinint & infinint::operator ^= (const infinint & arg)
+    infinint & infinint::operator ^= (const infinint & ref)
     {
+	if(is_small() && ref.is_small())
+	{
+	    small ^= ref.small;
+	    return *this;
+	}
+
+	promote();
+	infinint arg_storage;
+	const infinint & arg = as_storage(ref, arg_storage);
+
 	if(! is_valid() || ! arg.is_valid())
 	    throw SRC_BUG;
 
@@ -413,12 +527,19 @@ namespace libdar
 	    --it_a;
 	}
 
+	demote();
 	return *this;
     }
 
 
     infinint & infinint::operator >>= (U_32 bit)
     {
+	if(is_small())
+	{
+	    small = bit < sizeof(small)*8 ? small >> bit : 0;
+	    return *this;
+	}
+
         if(! is_valid())
             throw SRC_BUG;
 
@@ -457,14 +578,12 @@ namespace libdar
             }
         }
 
+        demote();
         return *this;
     }
 
     infinint & infinint::operator >>= (infinint bit)
     {
-        if(! is_valid() || ! bit.is_valid())
-            throw SRC_BUG;
-
         U_32 delta_bit = 0;
         bit.unstack(delta_bit);
 
@@ -481,15 +600,23 @@ namespace libdar
 
     infinint & infinint::operator <<= (U_32 bit)
     {
+        if(this->is_zero())
+            return *this;
+
+	if(is_small() && (bit == 0 || (bit < sizeof(small)*8 && (small >> (sizeof(small)*8 - bit)) == 0)))
+	{
+	    small <<= bit;
+	    return *this;
+	}
+
+	promote();
+
         if(! is_valid())
             throw SRC_BUG;
 
         U_32 byte = bit/8;
         storage::iterator it = field->end();
 
-        if(this->is_zero())
-            return *this;
-
         bit %= 8;     // bit gives now the remaining translation after the "byte" translation
 
         if(bit != 0)
@@ -547,8 +674,13 @@ namespace libdar
 
     unsigned char infinint::operator [] (const infinint & position) const
     {
-	if(field == nullptr)
-	    throw SRC_BUG;
+	if(is_small())
+	{
+	    if(position.is_small() && position.small < sizeof(small))
+		return (small >> (position.small*8)) & 0xFF;
+	    else
+		return 0x00;
+	}
 
 	if(position.is_zero())
 	{
@@ -568,7 +700,15 @@ namespace libdar
 	}
     }
 
-    bool infinint::is_zero() const
+    infinint infinint::get_storage_size() const noexcept
+    {
+	if(is_small())
+	    return small_width(small);
+	else
+	    return field->size();
+    }
+
+    bool infinint::is_zero_field() const
     {
 	if(field == nullptr)
 	    throw SRC_BUG;
@@ -587,6 +727,24 @@ namespace libdar
         storage::iterator itb;
         const infinint & a = *this;
 
+	if(a.is_small() && b.is_small())
+	    return a.small < b.small ? -1 : (a.small > b.small ? +1 : 0);
+
+	if(a.is_small() || b.is_small())
+	{
+		// neither value is modified, the one in storage form is
+		// the greatest unless it fits in 64 bits
+	    const infinint & large = a.is_small() ? b : a;
+	    U_64 inline_val = a.is_small() ? a.small : b.small;
+	    S_I large_sign = a.is_small() ? -1 : +1;
+	    U_64 large_val;
+
+	    if(!large.fits_small(large_val) || large_val > inline_val)
+		return large_sign;
+	    else
+		return large_val == inline_val ? 0 : -large_sign;
+	}
+
         if(! a.is_valid() || ! b.is_valid())
             throw SRC_BUG;
 
@@ -670,7 +828,10 @@ namespace libdar
 
     void infinint::copy_from(const infinint & ref)
     {
-        if(ref.is_valid())
+	small = ref.small;
+	if(ref.is_small())
+	    field = nullptr;
+        else if(ref.is_valid())
         {
             field = new (nothrow) storage(*(ref.field));
             if(field == nullptr)
@@ -689,6 +850,86 @@ namespace libdar
         }
     }
 
+    void infinint::promote()
+    {
+	if(!is_small())
+	    return;
+
+	U_I width = small_width(small);
+
+	field = new (nothrow) storage(width);
+	if(field == nullptr)
+	    throw Ememory("infinint::promote");
+
+	storage::iterator it = field->begin();
+	for(U_I i = width; i > 0; --i)
+	{
+	    *it = (small >> ((i - 1)*8)) & 0xFF;
+	    ++it;
+	}
+	small = 0;
+
+	if(used_endian == not_initialized)
+	    setup_endian();
+    }
+
+    void infinint::demote()
+    {
+	U_64 val;
+
+	if(is_small() || !fits_small(val))
+	    return;
+
+	delete field;
+	field = nullptr;
+	small = val;
+    }
+
+    bool infinint::fits_small(U_64 & val) const
+    {
+	U_I count = 0;
+	storage::iterator it;
+
+	if(field == nullptr)
+	    throw SRC_BUG;
+
+	it = field->begin();
+	while(it != field->end() && *it == 0)
+	    ++it;
+
+	val = 0;
+	while(it != field->end())
+	{
+	    if(count == sizeof(val))
+		return false;
+	    val = (val << 8) | *it;
+	    ++count;
+	    ++it;
+	}
+
+	return true;
+    }
+
+    const infinint & infinint::as_storage(const infinint & val, infinint & tmp)
+    {
+	if(!val.is_small())
+	    return val;
+
+	tmp = val;
+	tmp.promote();
+	return tmp;
+    }
+
+    U_I infinint::small_width(U_64 val) noexcept
+    {
+	U_I ret = 1;
+
+	while((val >>= 8) != 0)
+	    ++ret;
+
+	return ret;
+    }
+
     void infinint::make_at_least_as_wider_as(const infinint & ref)
     {
         if(! is_valid() || ! ref.is_valid())
@@ -839,6 +1080,18 @@ namespace libdar
         if(b.is_zero())
             throw Einfinint("infinint.cpp : euclide", gettext("Division by zero")); // division by zero
 
+	if(a.is_small() && b.is_small())
+	{
+	    U_64 quotient = a.small / b.small;
+	    U_64 reste = a.small % b.small;
+
+	    q = 0;
+	    q.small = quotient;
+	    r = 0;
+	    r.small = reste;
+	    return;
+	}
+
         if(a < b)
         {
             q = 0;
@@ -846,11 +1099,14 @@ namespace libdar
             return;
         }
 
+	a.promote();
+
 	    // need to reduce a and b first
 	if(*(a.field->begin()) == 0)
 	    a.reduce();
 
         r = b;
+	r.promote();
 	if(*(r.field->begin()) == 0)
 	    r.reduce();
 
@@ -870,6 +1126,8 @@ namespace libdar
         }
 
         r = a;
+	r.demote();
+	q.demote();
     }
 
 } // end of namespace
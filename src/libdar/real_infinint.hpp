@@ -79,7 +79,7 @@ namespace libdar
 	infinint(proto_generic_file & x);
 
         infinint(const infinint & ref) { copy_from(ref); }
-	infinint(infinint && ref) noexcept { field = nullptr; move_from(std::move(ref)); };
+	infinint(infinint && ref) noexcept { field = nullptr; small = 0; move_from(std::move(ref)); };
 
 	infinint & operator = (const infinint & ref) { detruit(); copy_from(ref); return *this; };
 	infinint & operator = (infinint && ref) noexcept { move_from(std::move(ref)); return *this; }
@@ -125,13 +125,13 @@ namespace libdar
 	{ infinint_unstack_to(v); }
 
 	    /// it returns number of byte of information necessary to store the integer
-	infinint get_storage_size() const noexcept { return field->size(); };
+	infinint get_storage_size() const noexcept;
 
 	    /// return in little endian order the information byte storing the integer
 	unsigned char operator [] (const infinint & position) const;
 
 	    /// \return true when the object is zero (more efficient than integer comparison)
-	bool is_zero() const;
+	bool is_zero() const { return field == nullptr ? small == 0 : is_zero_field(); };
 
         friend bool operator < (const infinint &, const infinint &);
         friend bool operator == (const infinint &, const infinint &);
@@ -145,17 +145,28 @@ namespace libdar
 
     private :
         static constexpr int TG = 4;
+	static constexpr U_64 SMALL_MAX = ~(U_64)(0);
 
         enum endian { big_endian, little_endian, not_initialized };
 	using group = unsigned char[TG];
 
+	    // values fitting in 64 bits are kept in "small" and field is then set to nullptr,
+	    // field is only allocated when the value overflows (or once promote() has been called)
         storage *field;
-
+	U_64 small;
+
+	bool is_small() const noexcept { return field == nullptr; };
+	void promote(); // switch to the storage representation, without changing the value
+	void demote(); // switch back to the inline representation when the value fits in 64 bits
+	bool fits_small(U_64 & val) const; // for storage representation, whether the value fits in 64 bits and which it is
+	static const infinint & as_storage(const infinint & val, infinint & tmp); // val in storage representation, using tmp if val has to be copied
+	bool is_zero_field() const;
+	static U_I small_width(U_64 val) noexcept; // number of significant bytes, at least one
         bool is_valid() const noexcept;
         void build_from_file(proto_generic_file & x);
         void reduce(); // put the object in canonical form : no leading byte equal to zero
         void copy_from(const infinint & ref);
-	void move_from(infinint && ref) noexcept { std::swap(field, ref.field); };
+	void move_from(infinint && ref) noexcept { std::swap(field, ref.field); std::swap(small, ref.small); };
         void detruit();
         void make_at_least_as_wider_as(const infinint & ref);
         template <class T> void infinint_from(T a);
@@ -235,6 +246,15 @@ namespace libdar
     {
 	infinint tmp = *this % infinint(arg);
         T ret = 0;
+
+	if(tmp.is_small())
+	{
+	    ret = (T)tmp.small;
+	    if((U_64)ret != tmp.small)
+		throw SRC_BUG; // could not put all the data in the returned value !
+	    return ret;
+	}
+
         unsigned char *debut = (unsigned char *)(&ret);
         unsigned char *ptr = debut + sizeof(T) - 1;
         storage::iterator it = tmp.field->rbegin();
@@ -267,6 +287,15 @@ namespace libdar
         U_I size = sizeof(a);
         S_I direction = +1;
         unsigned char *ptr, *fin;
+	T zero = 0;
+
+	small = 0;
+	if(sizeof(a) <= sizeof(small) && (a > zero || a == zero))
+	{
+	    field = nullptr;
+	    small = (U_64)a;
+	    return;
+	}
 
         if(used_endian == not_initialized)
             setup_endian();
@@ -337,8 +366,22 @@ namespace libdar
 	static const T max_T = max_val_of(a);
         infinint step = max_T - a;
 
-        if(*this < step)
+	if(is_small() && step.is_small())
+	{
+	    if(small < step.small)
+	    {
+		a += (T)small;
+		small = 0;
+	    }
+	    else
+	    {
+		small -= step.small;
+		a = max_T;
+	    }
+	}
+        else if(*this < step)
         {
+	    promote(); // *this may still be in small form when step is not
             T transfert = 0;
             unsigned char *debut = (unsigned char *)&transfert;
             unsigned char *ptr = debut + sizeof(transfert) - 1;
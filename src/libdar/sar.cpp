@@ -116,6 +116,11 @@ extern "C"
 #include "sar_tools.hpp"
 #include "fichier_global.hpp"
 
+#ifdef LIBTHREADAR_AVAILABLE
+#include "slice_finisher.hpp"
+#include "slice_prefetcher.hpp"
+#endif
+
 using namespace std;
 
 namespace libdar
@@ -146,6 +151,9 @@ namespace libdar
 	entr = where;
 	force_perm = false;
 	to_read_ahead = 0;
+	finisher = nullptr;
+	prefetcher = nullptr;
+	of_remote = nullptr;
 
         open_file_init();
 	try
@@ -153,6 +161,17 @@ namespace libdar
 	    if(!entr)
 		throw SRC_BUG;
 
+#ifdef LIBTHREADAR_AVAILABLE
+		// without command to run before each slice, the next
+		// slices can be fetched while the current one is read
+	    if(entr->get_parallel_transfers() > 1 && hook.empty())
+	    {
+		prefetcher = new (nothrow) slice_prefetcher(dialog, entr->get_parallel_transfers());
+		if(prefetcher == nullptr)
+		    throw Ememory("sar::sar");
+	    }
+#endif
+
 	    if(by_the_end)
 	    {
 		try
@@ -183,6 +202,7 @@ namespace libdar
 		    of_fd = nullptr;
 		}
 	    }
+	    prefetcher_release();
 	    throw;
 	}
     }
@@ -204,7 +224,8 @@ namespace libdar
 	     hash_algo x_hash,
 	     const infinint & x_min_digits,
 	     bool format_07_compatible,
-	     const string & execute) : generic_file(open_mode), mem_ui(dialog)
+	     const string & execute,
+	     U_I slices_in_flight) : generic_file(open_mode), mem_ui(dialog)
     {
 	if(open_mode == gf_read_only)
 	    throw SRC_BUG;
@@ -239,6 +260,9 @@ namespace libdar
 	of_flag = '\0';
 	slicing.older_sar_than_v8 = format_07_compatible;
 	to_read_ahead = 0;
+	finisher = nullptr;
+	prefetcher = nullptr;
+	of_remote = nullptr;
 
 	try
 	{
@@ -248,6 +272,21 @@ namespace libdar
 
 	    open_file_init();
 	    open_file(1, false);
+
+#ifdef LIBTHREADAR_AVAILABLE
+	    U_I parallel = entr->get_parallel_transfers();
+
+		// slices spooled locally are uploaded by the finisher
+	    if(parallel > 1 && slices_in_flight < parallel)
+		slices_in_flight = parallel;
+
+	    if(slices_in_flight > 0)
+	    {
+		finisher = new (nothrow) slice_finisher(slices_in_flight, parallel);
+		if(finisher == nullptr)
+		    throw Ememory("sar::sar");
+	    }
+#endif
 	}
 	catch(...)
 	{
@@ -262,6 +301,11 @@ namespace libdar
 		    delete of_fd;
 		    of_fd = nullptr;
 		}
+		if(of_remote != nullptr)
+		{
+		    delete of_remote;
+		    of_remote = nullptr;
+		}
 	    }
 	    throw;
 	}
@@ -269,6 +313,19 @@ namespace libdar
 
     void sar::inherited_terminate()
     {
+	    // previous slices must be finished before the last one
+	try
+	{
+	    finisher_wait(0);
+	}
+	catch(...)
+	{
+	    finisher_release();
+	    close_file(true);
+	    throw;
+	}
+	finisher_release();
+
         close_file(true);
         if(get_mode() != gf_read_only && natural_destruction)
 	{
@@ -287,6 +344,10 @@ namespace libdar
 	{
 		// ignore all exception
 	}
+	finisher_release();
+	prefetcher_release();
+	if(of_remote != nullptr)
+	    delete of_remote;
     }
 
     bool sar::skippable(skippability direction, const infinint & amount)
@@ -583,6 +644,51 @@ namespace libdar
         return lu;
     }
 
+    bool sar::inherited_read_lend(const char * & ptr, U_I & sz)
+    {
+	    // data is lent from the current slice only, the next slice is
+	    // opened when the current one has been completely read
+
+        while(true)
+        {
+	    U_I tmp = sz;
+
+	    if(of_fd != nullptr)
+	    {
+		if(!of_fd->read_lend(ptr, tmp))
+		    return false;
+		if(!slicing.older_sar_than_v8 && of_fd->get_position() == size_of_current)
+		    if(tmp > 0)
+			--tmp; // we do not "read" the terminal flag
+	    }
+	    else
+		tmp = 0; // simulating an end of slice
+
+	    if(tmp == 0)
+		if(of_flag == flag_type_terminal)
+		{
+		    sz = 0;
+		    return true;
+		}
+		else
+		    if(is_current_eof_a_normal_end_of_slice())
+			open_file(of_current + 1, false);
+		    else
+			return false; // inherited_read() fills the missing part of the slice with zeroed bytes
+	    else
+	    {
+		file_offset += tmp;
+		sz = tmp;
+		return true;
+	    }
+        }
+    }
+
+    bool sar::inherited_lent_from(S_I & fd, infinint & offset) const
+    {
+	return of_fd != nullptr && of_fd->lent_from(fd, offset);
+    }
+
     void sar::inherited_write(const char *a, U_I to_write)
     {
         infinint max_at_once;
@@ -618,17 +724,32 @@ namespace libdar
     {
         if(of_fd != nullptr)
         {
-	    char flag = terminal ? flag_type_terminal : flag_type_non_terminal;
-	    if(get_mode() == gf_read_write || get_mode() == gf_write_only)
+	    add_trailer(terminal);
+
+	    if(of_remote != nullptr)
 	    {
-		if(slicing.older_sar_than_v8)
+		    // uploading the spooled slice from here, no
+		    // slice remains to be written meanwhile
+		try
 		{
-		    header h = make_write_header(of_current, terminal ? flag_type_terminal : flag_type_non_terminal);
 		    of_fd->skip(0);
-		    h.write(get_ui(), *of_fd);
+		    of_fd->copy_to(*of_remote);
+		    of_remote->fadvise(fichier_global::advise_dontneed);
+		    of_remote->terminate();
 		}
-		else
-		    of_fd->write(&flag, 1);
+		catch(...)
+		{
+		    delete of_remote;
+		    of_remote = nullptr;
+		    delete of_fd;
+		    of_fd = nullptr;
+		    throw;
+		}
+		delete of_remote;
+		of_remote = nullptr;
+		delete of_fd;
+		of_fd = nullptr;
+		return;
 	    }
 
 		// telling the system to free this file from the cache
@@ -640,9 +761,168 @@ namespace libdar
         }
     }
 
+    void sar::add_trailer(bool terminal)
+    {
+	char flag = terminal ? flag_type_terminal : flag_type_non_terminal;
+
+	if(of_fd == nullptr)
+	    throw SRC_BUG;
+
+	if(get_mode() == gf_read_write || get_mode() == gf_write_only)
+	{
+	    if(slicing.older_sar_than_v8)
+	    {
+		header h = make_write_header(of_current, flag);
+		of_fd->skip(0);
+		h.write(get_ui(), *of_fd);
+	    }
+	    else
+		of_fd->write(&flag, 1);
+	}
+    }
+
+    void sar::finish_in_background()
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	string cmd_line;
+
+	if(finisher == nullptr)
+	    throw SRC_BUG;
+
+	finisher_wait(finisher->get_max_pending() - 1);
+	if(hook != "" && natural_destruction)
+	    cmd_line = hook_command(of_current);
+
+	if(of_fd != nullptr)
+	{
+	    add_trailer(false);
+	    if(of_remote != nullptr)
+	    {
+		    // the finisher uploads the spool to the slice
+		finisher->push(of_remote, of_fd, cmd_line);
+		of_remote = nullptr;
+	    }
+	    else
+		finisher->push(of_fd, nullptr, cmd_line);
+	    of_fd = nullptr;
+	}
+	else
+	    finisher->push(nullptr, nullptr, cmd_line);
+#else
+	throw SRC_BUG;
+#endif
+    }
+
+    void sar::finisher_wait(U_I pending)
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	string cmd_line;
+	string error;
+
+	if(finisher != nullptr)
+	{
+	    while(!finisher->wait(pending, cmd_line, error))
+	    {
+		    // the command failed in the finisher thread,
+		    // asking the user from here whether to retry it
+		hook_run(cmd_line, error);
+		finisher->resume();
+	    }
+	}
+#endif
+    }
+
+    void sar::finisher_release()
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	if(finisher != nullptr)
+	{
+	    delete finisher;
+	    finisher = nullptr;
+	}
+#endif
+    }
+
+    fichier_global *sar::prefetched(const infinint & num)
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	if(prefetcher != nullptr)
+	{
+	    if(prefetcher->is_pending(num))
+		return prefetcher->take(num);
+	    else
+		prefetcher->clear(); // not reading in sequence anymore
+	}
+#endif
+	return nullptr;
+    }
+
+    void sar::prefetch_after(const infinint & num)
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	if(prefetcher == nullptr || of_flag == flag_type_terminal)
+	    return;
+
+	infinint last = num + entr->get_parallel_transfers();
+
+	for(infinint next = num + 1; next <= last; ++next)
+	{
+	    fichier_global *remote = nullptr;
+
+	    if(of_last_file_known && next > of_last_file_num)
+		break;
+	    if(prefetcher->is_pending(next))
+		continue;
+
+	    try
+	    {
+		remote = entr->open(get_pointer(),
+				    sar_tools_make_filename(base, next, min_digits, ext),
+				    gf_read_only,
+				    false, //< force permission
+				    0,     //< permission to enforce (not used here)
+				    false, //< fail if exists
+				    false, //< erase
+				    hash_algo::none);
+		if(remote == nullptr)
+		    throw SRC_BUG;
+		prefetcher->push(next, remote);
+	    }
+	    catch(Ebug & e)
+	    {
+		throw;
+	    }
+	    catch(Ethread_cancel & e)
+	    {
+		throw;
+	    }
+	    catch(Egeneric & e)
+	    {
+		    // the slice will be opened again when needed
+		    // and the problem reported if it persists
+		if(remote != nullptr)
+		    delete remote;
+		break;
+	    }
+	}
+#endif
+    }
+
+    void sar::prefetcher_release()
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	if(prefetcher != nullptr)
+	{
+	    delete prefetcher;
+	    prefetcher = nullptr;
+	}
+#endif
+    }
+
     void sar::open_readonly(const string & fic, const infinint &num, bool bytheend)
     {
         header h;
+	fichier_global *ahead = prefetched(num);
 
         while(of_fd == nullptr)
         {
@@ -653,14 +933,20 @@ namespace libdar
                 //
 	    try
 	    {
-		of_fd = entr->open(get_pointer(),
-				   fic,
-				   gf_read_only,
-				   false, //< force permission
-				   0,     //< permission to enforce (not used here)
-				   false, //<  fail if exists
-				   false, //<  erase
-				   hash_algo::none);
+		if(ahead != nullptr)
+		{
+		    of_fd = ahead;
+		    ahead = nullptr;
+		}
+		else
+		    of_fd = entr->open(get_pointer(),
+				       fic,
+				       gf_read_only,
+				       false, //< force permission
+				       0,     //< permission to enforce (not used here)
+				       false, //<  fail if exists
+				       false, //<  erase
+				       hash_algo::none);
 		if(of_fd == nullptr)
 		    throw SRC_BUG;
 		of_fd->fadvise(fichier_global::advise_normal);
@@ -1154,6 +1440,17 @@ namespace libdar
 	{
 	    header h;
 
+#ifdef LIBTHREADAR_AVAILABLE
+	    if(entr->get_parallel_transfers() > 1)
+	    {
+		    // the slice is written to a local file, uploaded by
+		    // the finisher while the next slices are written
+		of_remote = of_fd;
+		of_fd = nullptr;
+		of_fd = sar_tools_open_spool(get_pointer());
+	    }
+#endif
+
 	    of_flag = flag_type_located_at_end_of_slice;
 	    h = make_write_header(num, of_flag);
 	    h.write(get_ui(), *of_fd);
@@ -1178,6 +1475,11 @@ namespace libdar
 		delete of_fd;
 		of_fd = nullptr;
 	    }
+	    if(of_remote != nullptr)
+	    {
+		delete of_remote;
+		of_remote = nullptr;
+	    }
 	    throw;
 	}
 
@@ -1207,26 +1509,34 @@ namespace libdar
 	    case gf_read_only:
 		close_file(false);
 		open_readonly(display, num, bytheend);
+		if(num == of_current + 1)
+		    prefetch_after(num);
 		break;
 	    case gf_write_only:
 	    case gf_read_write:
 		if(num < of_current)
 		    throw Erange("sar::open_file", "Skipping backward would imply accessing/modifying previous slice");
 
-		    // adding the trailing flag
-		if(of_fd != nullptr)
-		    close_file(false);
-
 		if(!initial)
 		{
+		    if(finisher != nullptr)
+			finish_in_background(); // adds the trailing flag, the shell command is launched once the slice is closed
+		    else
+		    {
+			    // adding the trailing flag
+			close_file(false);
 
-			// launch the shell command after the slice has been written
-		    hook_execute(of_current);
+			    // launch the shell command after the slice has been written
+			hook_execute(of_current);
+		    }
 		    if(!pause.is_zero() && (((num-1) % pause).is_zero()))
 		    {
 			deci conv = of_current;
 			bool ready = false;
 
+			    // completed slices must be closed before the user handles them
+			finisher_wait(0);
+
 			while(!ready)
 			{
 			    try
@@ -1243,7 +1553,11 @@ namespace libdar
 		    }
 		}
 		else
+		{
+		    if(of_fd != nullptr)
+			close_file(false);
 		    initial = false;
+		}
 
 		open_writeonly(display, num, bytheend);
 		break;
@@ -1361,30 +1675,37 @@ namespace libdar
     void sar::hook_execute(const infinint &num)
     {
         if(hook != "" && natural_destruction)
-        {
-	    try
-	    {
-		deci conv = num;
-		string num_str = conv.human();
+	    hook_run(hook_command(num), "");
+    }
 
-		if(!entr)
-		    throw SRC_BUG;
+    string sar::hook_command(const infinint &num) const
+    {
+	deci conv = num;
+	string num_str = conv.human();
 
-		tools_hook_substitute_and_execute(get_ui(),
-						  hook,
-						  entr->get_full_path().display(),
-						  base,
-						  num_str,
-						  sar_tools_make_padded_number(num_str, min_digits),
-						  ext,
-						  get_info_status(),
-						  entr->get_url());
-	    }
-	    catch(Escript & g)
-	    {
-		natural_destruction = false;
-		throw;
-	    }
+	if(!entr)
+	    throw SRC_BUG;
+
+	return tools_hook_substitute(hook,
+				     entr->get_full_path().display(),
+				     base,
+				     num_str,
+				     sar_tools_make_padded_number(num_str, min_digits),
+				     ext,
+				     get_info_status(),
+				     entr->get_url());
+    }
+
+    void sar::hook_run(const string & cmd_line, const string & error)
+    {
+	try
+	{
+	    tools_hook_execute(get_ui(), cmd_line, error);
+	}
+	catch(Euser_abort & g)
+	{
+	    natural_destruction = false;
+	    throw Escript("sar::hook_execute", string(gettext("Fatal error on user command line: ")) + g.get_message());
 	}
     }
 
@@ -42,6 +42,9 @@ namespace libdar
 {
 	// contextual is defined in generic_file module
 
+    class slice_finisher;
+    class slice_prefetcher;
+
 	/// \addtogroup Private
 	/// @{
 
@@ -54,7 +57,6 @@ namespace libdar
     class sar : public generic_file, public contextual, protected mem_ui
     {
     public:
-
 	    /// this constructor reads data from a set of slices
 
 	    /// \param[in] dialog is for user interation (such a requesting a slice and pausing
@@ -78,6 +80,9 @@ namespace libdar
 	    /// of the data cannot be determin. If slice header is too old the sar class will
 	    /// fallback openning the first slice and
 	    /// directly get the first slice.
+	    /// \note when the entrepot allows several transfers at the same time (see
+	    /// entrepot::get_parallel_transfers()) and no command is given, the slices
+	    /// following the one read in sequence are fetched ahead in local spool files
         sar(const std::shared_ptr<user_interaction> & dialog,
 	    const std::string & base_name,
 	    const std::string & extension,
@@ -108,6 +113,12 @@ namespace libdar
 	    /// \param[in] x_min_digits is the minimum number of digits the slices number is stored with in the filename
 	    /// \param[in] format_07_compatible when set to true, creates a slice header in the archive format of version 7 instead of the highest version known
 	    /// \param[in] execute is the command to execute after each slice creation (once it is completed)
+	    /// \param[in] slices_in_flight if not zero, completed slices are closed and the command
+	    /// to execute is run by a separated thread while the next slices are written, at most this
+	    /// number of completed slices being not yet finished (ignored without libthreadar)
+	    /// \note when the entrepot allows several transfers at the same time (see entrepot::get_parallel_transfers())
+	    /// slices are written to local spool files and as many of them are uploaded at the same time, slices_in_flight
+	    /// is then raised to that number if lower
 	    /// \note data_name should be equal to internal_name except when reslicing an archive as dar_xform does in which
 	    /// case internal_name is randomly, and data_name is kept from the source archive
         sar(const std::shared_ptr<user_interaction> & dialog,
@@ -127,7 +138,8 @@ namespace libdar
 	    hash_algo x_hash,
 	    const infinint & x_min_digits,
 	    bool format_07_compatible,
-	    const std::string & execute = "");
+	    const std::string & execute = "",
+	    U_I slices_in_flight = 0);
 
 	    /// the copy constructor
    	sar(const sar & ref) = delete;
@@ -182,6 +194,8 @@ namespace libdar
     protected :
 	virtual void inherited_read_ahead(const infinint & amount) override;
         virtual U_I inherited_read(char *a, U_I size) override;
+	virtual bool inherited_read_lend(const char * & ptr, U_I & size) override;
+	virtual bool inherited_lent_from(S_I & fd, infinint & offset) const override;
         virtual void inherited_write(const char *a, U_I size) override;
 	virtual void inherited_sync_write() override {}; // nothing to do
 	virtual void inherited_flush_read() override {}; // nothing to do
@@ -210,6 +224,7 @@ namespace libdar
 	bool force_perm;             ///< true if any future slice has its permission to be set explicitely
 	U_I perm;                    ///< if force_perm is true, value to use for slice permission
         fichier_global *of_fd;       ///< file object currently openned
+	fichier_global *of_remote;   ///< slice in the entrepot while of_fd is its local spool file (write mode with parallel transfers), else nullptr
         char of_flag;                ///< flags of the open file
         bool initial;                ///< do not launch hook command-line during sar initialization
             // these are the option flags
@@ -219,10 +234,19 @@ namespace libdar
         infinint pause;              ///< do we pause between slices
 	bool lax;                    ///< whether to try to go further reading problems
 	infinint to_read_ahead;      ///< amount of data to read ahead for next slices
+	slice_finisher *finisher;    ///< closes completed slices in background, nullptr if not used
+	slice_prefetcher *prefetcher;///< fetches the next slices in background when reading them in sequence, nullptr if not used
 
         bool skip_forward(U_I x);                    ///< skip forward in sar global contents
         bool skip_backward(U_I x);                   ///< skip backward in sar global contents
         void close_file(bool terminal);              ///< close current openned file, adding (in write mode only) a terminal mark (last slice) or not
+	void add_trailer(bool terminal);             ///< add the terminal mark or not to the current slice (in write mode only)
+	void finish_in_background();                 ///< add the trailer and give the current slice to the finisher
+	void finisher_wait(U_I pending);             ///< wait for the finisher to have at most "pending" slices left, handling failed commands
+	void finisher_release();                     ///< delete the finisher if any
+	fichier_global *prefetched(const infinint & num); ///< get the given slice from the prefetcher if any, nullptr if not available
+	void prefetch_after(const infinint & num);   ///< give the slices following num to the prefetcher
+	void prefetcher_release();                   ///< delete the prefetcher if any
         void open_readonly(const std::string & fic,  ///< open file of name "fic" for read only
 			   const infinint &num,      ///< "num" is the slice number
 			   bool bytheend             ///< whether to position the read cursor at the beginning or the end of the file
@@ -241,6 +265,8 @@ namespace libdar
 
             // function to lauch the eventually existing command to execute after/before each slice
         void hook_execute(const infinint &num);
+	std::string hook_command(const infinint &num) const;                  ///< the command line to execute for the given slice
+	void hook_run(const std::string & cmd_line, const std::string & error); ///< execute cmd_line, which may already have failed for the given error
     };
 
 	/// @}
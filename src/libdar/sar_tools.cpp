@@ -23,6 +23,10 @@
 
 extern "C"
 {
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif
+
 #if HAVE_STRING_H
 #include <string.h>
 #endif
@@ -74,6 +78,7 @@ extern "C"
 #include "tuyau.hpp"
 #include "cygwin_adapt.hpp"
 #include "deci.hpp"
+#include "fichier_local.hpp"
 
 using namespace std;
 
@@ -169,4 +174,51 @@ namespace libdar
 	return ret;
     }
 
+    fichier_global *sar_tools_open_spool(const shared_ptr<user_interaction> & dialog)
+    {
+#if HAVE_MKSTEMP
+	fichier_global *ret = nullptr;
+	const char *tmpdir = getenv("TMPDIR");
+	string name = string(tmpdir != nullptr && *tmpdir != '\0' ? tmpdir : "/tmp") + "/dar-spool-XXXXXX";
+	char *tmpl = new (nothrow) char[name.size() + 1];
+	int fd;
+
+	if(tmpl == nullptr)
+	    throw Ememory("sar_tools_open_spool");
+
+	try
+	{
+	    strcpy(tmpl, name.c_str());
+	    fd = mkstemp(tmpl);
+	    if(fd < 0)
+	    {
+		string err = tools_strerror_r(errno);
+		throw Erange("sar_tools_open_spool", tools_printf(gettext("Cannot create temporary file in %s: %S"), name.substr(0, name.rfind('/')).c_str(), &err));
+	    }
+	    name = tmpl;
+
+		// the file is used through the descriptor mkstemp() opened, its
+		// name is removed at once, the file disappears when closed
+	    (void)unlink(name.c_str());
+
+	    ret = new (nothrow) fichier_local(dialog, fd, gf_read_write);
+	    if(ret == nullptr)
+	    {
+		close(fd);
+		throw Ememory("sar_tools_open_spool");
+	    }
+	}
+	catch(...)
+	{
+	    delete [] tmpl;
+	    throw;
+	}
+	delete [] tmpl;
+
+	return ret;
+#else
+	throw Efeature(gettext("mkstemp() system call is missing, cannot spool slices locally"));
+#endif
+    }
+
 } // end of namespace
@@ -31,6 +31,7 @@
 #include <string>
 #include "infinint.hpp"
 #include "entrepot.hpp"
+#include "fichier_global.hpp"
 
 namespace libdar
 {
@@ -58,6 +59,12 @@ namespace libdar
     extern std::string sar_tools_make_padded_number(const std::string & num,
 						    const infinint & min_digits);
 
+	/// create an anonymous local file in read-write mode to hold a slice before or after its transfer
+
+	/// \note the file is created in $TMPDIR (or /tmp if not set) and is removed from the filesystem
+	/// right after its creation, its space is thus released as soon as the returned object is deleted
+    extern fichier_global *sar_tools_open_spool(const std::shared_ptr<user_interaction> & dialog);
+
 
 	/// @}
 
@@ -53,7 +53,7 @@ using namespace std;
 namespace libdar
 {
 
-    slave_zapette::slave_zapette(generic_file *input, generic_file *output, generic_file *data)
+    slave_zapette::slave_zapette(generic_file *input, generic_file *output, generic_file *data, U_I max_version)
     {
         if(input == nullptr)
             throw SRC_BUG;
@@ -74,6 +74,9 @@ namespace libdar
 	src_ctxt = dynamic_cast<contextual *>(data);
 	if(src_ctxt == nullptr)
 	    throw Erange("slave_zapette::slave_zapette", "Object given to data must inherit from contextual class");
+	if(max_version < PROTOCOL_VERSION_1 || max_version > PROTOCOL_VERSION_LAST)
+	    throw SRC_BUG;
+	max_protocol = max_version;
     }
 
     slave_zapette::~slave_zapette()
@@ -91,7 +94,10 @@ namespace libdar
         request req;
         answer ans;
         char *buffer = nullptr;
-        U_16 buf_size = 1024;
+        U_32 buf_size = 1024;
+	U_I version = PROTOCOL_VERSION_1; // until the zapette asks for a more recent one
+	infinint src_size;
+	bool src_size_known = false;
 
 	buffer = new (nothrow) char[buf_size];
 	if(buffer == nullptr)
@@ -101,12 +107,30 @@ namespace libdar
         {
             do
             {
-                req.read(in);
+                req.read(in, version);
                 ans.serial_num = req.serial_num;
 
-                if(req.size != REQUEST_SIZE_SPECIAL_ORDER)
+		if(version == PROTOCOL_VERSION_1
+		   && max_protocol > PROTOCOL_VERSION_1
+		   && req.size > REQUEST_SIZE_PROTOCOL_PROBE + PROTOCOL_VERSION_1
+		   && req.size <= REQUEST_SIZE_PROTOCOL_PROBE + 0xFF
+		   && src_size_known
+		   && req.offset == src_size + 1)
+		{
+			// the zapette tells the highest protocol version it supports
+		    U_I peer = req.size - REQUEST_SIZE_PROTOCOL_PROBE;
+
+		    version = peer < max_protocol ? peer : max_protocol;
+		    buffer[0] = (char)version;
+		    ans.type = ANSWER_TYPE_DATA;
+		    ans.size = 1;
+		    ans.write(out, buffer, PROTOCOL_VERSION_1);
+		}
+                else if(req.size != REQUEST_SIZE_SPECIAL_ORDER)
                 {
                     ans.type = ANSWER_TYPE_DATA;
+		    if(version > PROTOCOL_VERSION_1 && req.size > REQUEST_SIZE_MAX_V2)
+			throw Erange("slave_zapette::action", gettext("Received request exceeding the maximum transfer size"));
                     if(src->skip(req.offset))
                     {
                             // enlarge buffer if necessary
@@ -123,12 +147,12 @@ namespace libdar
                         }
 
                         ans.size = src->read(buffer, req.size);
-                        ans.write(out, buffer);
+                        ans.write(out, buffer, version);
                     }
                     else // bad position
                     {
                         ans.size = 0;
-                        ans.write(out, nullptr);
+                        ans.write(out, nullptr, version);
                     }
                 }
                 else // special orders
@@ -137,7 +161,7 @@ namespace libdar
                     {
                         ans.type = ANSWER_TYPE_DATA;
                         ans.size = 0;
-                        ans.write(out, nullptr);
+                        ans.write(out, nullptr, version);
                     }
                     else if(req.offset == REQUEST_OFFSET_GET_FILESIZE) // return file size
                     {
@@ -145,27 +169,29 @@ namespace libdar
                         if(!src->skip_to_eof())
                             throw Erange("slave_zapette::action", gettext("Cannot skip at end of file"));
                         ans.arg = src->get_position();
-                        ans.write(out, nullptr);
+			src_size = ans.arg;
+			src_size_known = true;
+                        ans.write(out, nullptr, version);
                     }
 		    else if(req.offset == REQUEST_OFFSET_CHANGE_CONTEXT_STATUS) // contextual status change requested
 		    {
 			ans.type = ANSWER_TYPE_INFININT;
 			ans.arg = 1;
  			src_ctxt->set_info_status(req.info);
-			ans.write(out, nullptr);
+			ans.write(out, nullptr, version);
 		    }
                     else if(req.offset == REQUEST_IS_OLD_START_END_ARCHIVE) // return whether the underlying archive has an old slice header or not
 		    {
 			ans.type = ANSWER_TYPE_INFININT;
 			ans.arg = src_ctxt->is_an_old_start_end_archive() ? 1 : 0;
-			ans.write(out, nullptr);
+			ans.write(out, nullptr, version);
 		    }
 		    else if(req.offset == REQUEST_GET_DATA_NAME) // return the data_name of the underlying sar
 		    {
 			ans.type = ANSWER_TYPE_DATA;
 			ans.arg = 0;
 			ans.size = src_ctxt->get_data_name().size();
-			ans.write(out, (char *)(src_ctxt->get_data_name().data()));
+			ans.write(out, (char *)(src_ctxt->get_data_name().data()), version);
 		    }
 		    else if(req.offset == REQUEST_FIRST_SLICE_HEADER_SIZE)
 		    {
@@ -179,7 +205,7 @@ namespace libdar
 			    ans.arg = src_sar->get_first_slice_header_size();
 			else
 			    ans.arg = 0; // means unknown
-			ans.write(out, nullptr);
+			ans.write(out, nullptr, version);
 		    }
 		    else if(req.offset == REQUEST_OTHER_SLICE_HEADER_SIZE)
 		    {
@@ -193,7 +219,7 @@ namespace libdar
 			    ans.arg = src_sar->get_non_first_slice_header_size();
 			else
 			    ans.arg = 0; // means unknown
-			ans.write(out, nullptr);
+			ans.write(out, nullptr, version);
 		    }
 		    else
                         throw Erange("zapette::action", gettext("Received unknown special order"));
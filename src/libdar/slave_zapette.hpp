@@ -35,6 +35,7 @@
 #include "../my_config.h"
 #include "generic_file.hpp"
 #include "contextual.hpp"
+#include "zapette_protocol.hpp"
 
 namespace libdar
 {
@@ -57,7 +58,8 @@ namespace libdar
 	    /// \param[in] input is used to receive orders from an zapette object
 	    /// \param[in] output is used to return informations or data in answer to received orders
 	    /// \param[in] data is where the informations or data is taken from. Object must inherit from contextual
-        slave_zapette(generic_file *input, generic_file *output, generic_file *data);
+	    /// \param[in] max_version highest protocol version to agree on with the zapette (see zapette_protocol.hpp)
+        slave_zapette(generic_file *input, generic_file *output, generic_file *data, U_I max_version = PROTOCOL_VERSION_LAST);
 	slave_zapette(const slave_zapette & ref) = delete;
 	slave_zapette(slave_zapette && ref) noexcept = delete;
 	slave_zapette & operator = (const slave_zapette & ref) = delete;
@@ -75,6 +77,7 @@ namespace libdar
 	generic_file *out;    ///< where to send requested info or data to
 	generic_file *src;    ///< where to read data from
 	contextual *src_ctxt; ///< same as src but seen as contextual
+	U_I max_protocol;     ///< highest protocol version we may use
     };
 
 	/// @}
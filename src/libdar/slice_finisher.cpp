@@ -0,0 +1,364 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include "slice_finisher.hpp"
+#include "erreurs.hpp"
+#include "tools.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+	/// thread running slice_finisher::work()
+
+    class slice_finisher_worker : public libthreadar::thread
+    {
+    public:
+	slice_finisher_worker(slice_finisher & owner): ref(owner) {};
+
+    protected:
+	virtual void inherited_run() override { ref.work(); };
+
+    private:
+	slice_finisher & ref;
+    };
+
+
+    slice_finisher::slice_finisher(U_I x_max_pending, U_I x_workers): lock(2)
+    {
+	max_pending = x_max_pending;
+	next_id = 0;
+	cmd_running = false;
+	cmd_failed = false;
+	stopping = false;
+
+	if(max_pending == 0 || x_workers == 0)
+	    throw SRC_BUG;
+
+	try
+	{
+	    for(U_I i = 0; i < x_workers; ++i)
+	    {
+		slice_finisher_worker *tmp = new (nothrow) slice_finisher_worker(*this);
+		if(tmp == nullptr)
+		    throw Ememory("slice_finisher::slice_finisher");
+		workers.push_back(tmp);
+		tmp->run();
+	    }
+	}
+	catch(...)
+	{
+	    release();
+	    throw;
+	}
+    }
+
+    slice_finisher::~slice_finisher()
+    {
+	release();
+    }
+
+    void slice_finisher::push(fichier_global *slice, fichier_global *spool, const string & cmd_line)
+    {
+	job added;
+
+	added.id = 0;
+	added.slice = slice;
+	added.spool = spool;
+	added.cmd_line = cmd_line;
+	added.started = (slice == nullptr);
+	added.finished = (slice == nullptr);
+
+	lock.lock();
+	try
+	{
+	    added.id = next_id++;
+	    todo.push_back(added);
+	    lock.broadcast(0);
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    throw;
+	}
+	lock.unlock();
+    }
+
+    bool slice_finisher::wait(U_I pending, string & cmd_line, string & x_error)
+    {
+	bool ret = true;
+	exception_ptr met = nullptr;
+
+	lock.lock();
+	try
+	{
+	    while(!error && !cmd_failed && todo.size() > pending)
+		lock.wait(1);
+
+	    if(error)
+		met = error;
+	    else
+		if(cmd_failed)
+		{
+		    cmd_line = todo.front().cmd_line;
+		    x_error = cmd_error;
+		    ret = false;
+		}
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    throw;
+	}
+	lock.unlock();
+
+	if(met)
+	    rethrow_exception(met);
+
+	return ret;
+    }
+
+    void slice_finisher::resume()
+    {
+	lock.lock();
+	try
+	{
+	    if(!cmd_failed || todo.empty())
+		throw SRC_BUG;
+	    cmd_failed = false;
+	    todo.pop_front();
+	    lock.broadcast(0);
+	    lock.signal(1);
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    throw;
+	}
+	lock.unlock();
+    }
+
+    void slice_finisher::work()
+    {
+	try
+	{
+	    while(true)
+	    {
+		job current;
+		string failure;
+		bool run_cmd = false;
+		bool found = false;
+		deque<job>::iterator it;
+
+		    // picking the next command to run or slice to finish
+
+		lock.lock();
+		try
+		{
+		    do
+		    {
+			if(stopping || error)
+			    break;
+
+			run_cmd = can_run_cmd();
+			if(run_cmd)
+			    break;
+
+			it = todo.begin();
+			while(it != todo.end() && it->started)
+			    ++it;
+			found = (it != todo.end());
+			if(!found)
+			    lock.wait(0);
+		    }
+		    while(!found);
+
+		    if(run_cmd)
+		    {
+			cmd_running = true;
+			current.cmd_line = todo.front().cmd_line;
+		    }
+		    else
+			if(found)
+			{
+				// this worker is now responsible for the slice and its spool
+			    current = *it;
+			    it->started = true;
+			    it->slice = nullptr;
+			    it->spool = nullptr;
+			}
+		}
+		catch(...)
+		{
+		    lock.unlock();
+		    throw;
+		}
+		lock.unlock();
+
+		if(!run_cmd && !found)
+		    return; // stopping
+
+		if(run_cmd)
+		{
+		    if(!current.cmd_line.empty())
+		    {
+			try
+			{
+			    tools_hook_execute_once(current.cmd_line);
+			}
+			catch(Erange & e)
+			{
+			    failure = e.get_message();
+			}
+		    }
+
+		    lock.lock();
+		    try
+		    {
+			cmd_running = false;
+			if(failure.empty())
+			    todo.pop_front();
+			else
+			{
+			    cmd_failed = true;
+			    cmd_error = failure;
+			}
+			lock.broadcast(0);
+			lock.signal(1);
+		    }
+		    catch(...)
+		    {
+			lock.unlock();
+			throw;
+		    }
+		    lock.unlock();
+		}
+		else
+		{
+		    finish(current);
+
+			// the job may have moved in the deque but cannot have
+			// been removed as long as it is not marked finished
+
+		    lock.lock();
+		    try
+		    {
+			it = todo.begin();
+			while(it != todo.end() && it->id != current.id)
+			    ++it;
+			if(it == todo.end())
+			    throw SRC_BUG;
+			it->finished = true;
+			lock.broadcast(0);
+		    }
+		    catch(...)
+		    {
+			lock.unlock();
+			throw;
+		    }
+		    lock.unlock();
+		}
+	    }
+	}
+	catch(...)
+	{
+		// the exception is thrown back to the
+		// caller by wait(), nothing is done anymore
+	    lock.lock();
+	    if(!error)
+		error = current_exception();
+	    lock.broadcast(0);
+	    lock.signal(1);
+	    lock.unlock();
+	}
+    }
+
+    void slice_finisher::finish(job & current)
+    {
+	try
+	{
+	    if(current.spool != nullptr)
+	    {
+		current.spool->skip(0);
+		current.spool->copy_to(*current.slice);
+		delete current.spool;
+		current.spool = nullptr;
+	    }
+
+		// telling the system to free this file from the cache
+	    current.slice->fadvise(fichier_global::advise_dontneed);
+	    current.slice->terminate();
+	}
+	catch(...)
+	{
+	    if(current.spool != nullptr)
+		delete current.spool;
+	    delete current.slice;
+	    throw;
+	}
+	delete current.slice;
+    }
+
+    void slice_finisher::release()
+    {
+	lock.lock();
+	stopping = true;
+	lock.broadcast(0);
+	lock.unlock();
+
+	for(deque<slice_finisher_worker *>::iterator wt = workers.begin(); wt != workers.end(); ++wt)
+	{
+	    if(*wt != nullptr)
+	    {
+		try
+		{
+		    (*wt)->join();
+		}
+		catch(...)
+		{
+			// ignore all exceptions
+		}
+		delete *wt;
+		*wt = nullptr;
+	    }
+	}
+	workers.clear();
+
+	for(deque<job>::iterator it = todo.begin(); it != todo.end(); ++it)
+	{
+	    if(it->spool != nullptr)
+	    {
+		delete it->spool;
+		it->spool = nullptr;
+	    }
+	    if(it->slice != nullptr)
+	    {
+		delete it->slice;
+		it->slice = nullptr;
+	    }
+	}
+	todo.clear();
+    }
+
+} // end of namespace
@@ -0,0 +1,140 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+    /// \file slice_finisher.hpp
+    /// \brief closes the slices sar has completed and runs the user command on them, in a separated thread
+    /// \ingroup Private
+
+#ifndef SLICE_FINISHER_HPP
+#define SLICE_FINISHER_HPP
+
+#include "../my_config.h"
+
+#if HAVE_LIBTHREADAR_LIBTHREADAR_HPP
+#include <libthreadar/libthreadar.hpp>
+#endif
+
+#include <deque>
+#include <exception>
+#include <string>
+#include "integers.hpp"
+#include "fichier_global.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+    class slice_finisher_worker;
+
+	/// finalizes completed slices while sar writes the next ones
+
+	/// slices are given once their trailer has been written. A thread tells the
+	/// system the slice can be dropped from the cache, terminates it (which
+	/// flushes it and writes its hash file if any) then runs the user command
+	/// given with it. When the slice has been written to a local spool file,
+	/// the thread first copies the spool to the slice. With several threads,
+	/// several slices are terminated at the same time but the user commands
+	/// are still run one after the other in the order the slices were given.
+	/// A failing command is not retried by the threads, which stop running
+	/// commands until the caller has handled the failure (see wait() and
+	/// resume()), so the user is only asked from the caller's thread.
+
+    class slice_finisher
+    {
+    public:
+	    /// constructor
+
+	    /// \param[in] max_pending maximum number of slices given and not yet finished
+	    /// \param[in] workers number of threads terminating slices at the same time
+	slice_finisher(U_I max_pending, U_I workers = 1);
+	slice_finisher(const slice_finisher & ref) = delete;
+	slice_finisher(slice_finisher && ref) noexcept = delete;
+	slice_finisher & operator = (const slice_finisher & ref) = delete;
+	slice_finisher & operator = (slice_finisher && ref) noexcept = delete;
+
+	    /// destructor
+
+	    /// slices not yet finished are closed without running their
+	    /// command, use wait() before for them to be finished normally
+	~slice_finisher();
+
+	    /// get the maximum number of slices given and not yet finished
+	U_I get_max_pending() const { return max_pending; };
+
+	    /// give a completed slice
+
+	    /// \param[in] slice the slice to finish, the object passes under the responsibility of the slice_finisher
+	    /// \param[in] spool if not nullptr, the local file holding the slice data to copy into slice, the
+	    /// object passes under the responsibility of the slice_finisher
+	    /// \param[in] cmd_line the command to execute once the slice is closed, nothing is run if empty
+	    /// \note to respect the max_pending limit, wait() has to be called first
+	void push(fichier_global *slice, fichier_global *spool, const std::string & cmd_line);
+
+	    /// wait for the slices to be finished
+
+	    /// \param[in] pending the number of slices that may still be pending when returning
+	    /// \param[out] cmd_line set to the command that failed when false is returned
+	    /// \param[out] error set to the reason of the failure when false is returned
+	    /// \return false if a command failed, the caller has to handle it (it may run
+	    /// it again) then call resume() and wait() again
+	    /// \note an error met while terminating a slice is thrown from here
+	bool wait(U_I pending, std::string & cmd_line, std::string & error);
+
+	    /// let the threads go on after a command failure
+	void resume();
+
+    private:
+	struct job
+	{
+	    U_I id;                            ///< identifies the job while workers process it
+	    fichier_global *slice;
+	    fichier_global *spool;
+	    std::string cmd_line;
+	    bool started;                      ///< a worker is terminating the slice
+	    bool finished;                     ///< the slice is terminated, only the command remains to run
+	};
+
+	U_I max_pending;
+	U_I next_id;                           ///< id of the next job given
+	libthreadar::condition lock;           ///< protects the following fields, instance 0 is used by the workers, instance 1 by wait()
+	std::deque<job> todo;                  ///< slices to finish, in the order they were given
+	bool cmd_running;                      ///< a worker is running the command of the first job
+	bool cmd_failed;                       ///< whether the command of the first job failed
+	std::string cmd_error;                 ///< why the command of the first job failed
+	std::exception_ptr error;              ///< exception met by a worker, all workers then stop
+	bool stopping;                         ///< set when the workers have to end
+	std::deque<slice_finisher_worker *> workers;
+
+	void work();                           ///< the routine the workers run
+	bool can_run_cmd() const { return !cmd_running && !cmd_failed && !todo.empty() && todo.front().finished; };
+	void finish(job & current);            ///< copy the spool if any, and terminate the slice of the job
+	void release();
+
+	friend class slice_finisher_worker;
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
@@ -0,0 +1,443 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include "slice_prefetcher.hpp"
+#include "erreurs.hpp"
+#include "sar_tools.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+	/// thread running slice_prefetcher::work()
+
+    class slice_prefetcher_worker : public libthreadar::thread
+    {
+    public:
+	slice_prefetcher_worker(slice_prefetcher & owner): ref(owner) {};
+
+    protected:
+	virtual void inherited_run() override { ref.work(); };
+
+    private:
+	slice_prefetcher & ref;
+    };
+
+
+    slice_prefetcher::slice_prefetcher(const shared_ptr<user_interaction> & dialog, U_I x_workers): ui(dialog), lock(2)
+    {
+	stopping = false;
+
+	if(x_workers == 0 || !ui)
+	    throw SRC_BUG;
+
+	try
+	{
+	    for(U_I i = 0; i < x_workers; ++i)
+	    {
+		slice_prefetcher_worker *tmp = new (nothrow) slice_prefetcher_worker(*this);
+		if(tmp == nullptr)
+		    throw Ememory("slice_prefetcher::slice_prefetcher");
+		workers.push_back(tmp);
+		tmp->run();
+	    }
+	}
+	catch(...)
+	{
+	    release();
+	    throw;
+	}
+    }
+
+    slice_prefetcher::~slice_prefetcher()
+    {
+	release();
+    }
+
+    U_I slice_prefetcher::size() const
+    {
+	U_I ret = 0;
+
+	lock.lock();
+	for(deque<job>::const_iterator it = todo.begin(); it != todo.end(); ++it)
+	    if(!it->dropped)
+		++ret;
+	lock.unlock();
+
+	return ret;
+    }
+
+    bool slice_prefetcher::is_pending(const infinint & num) const
+    {
+	bool ret = false;
+
+	lock.lock();
+	try
+	{
+	    deque<job>::const_iterator it = todo.begin();
+
+	    while(it != todo.end() && (it->dropped || it->num != num))
+		++it;
+	    ret = (it != todo.end());
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    throw;
+	}
+	lock.unlock();
+
+	return ret;
+    }
+
+    void slice_prefetcher::push(const infinint & num, fichier_global *remote)
+    {
+	job added;
+
+	if(remote == nullptr)
+	    throw SRC_BUG;
+
+	added.num = num;
+	added.remote = remote;
+	added.spool = nullptr;
+	added.status = state::waiting;
+	added.dropped = false;
+
+	lock.lock();
+	try
+	{
+	    todo.push_back(added);
+	    lock.signal(0);
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    throw;
+	}
+	lock.unlock();
+    }
+
+    fichier_global *slice_prefetcher::take(const infinint & num)
+    {
+	fichier_global *ret = nullptr;
+	fichier_global *to_delete = nullptr;
+
+	lock.lock();
+	try
+	{
+	    deque<job>::iterator it = find(num);
+
+	    while(it != todo.end() && it->status == state::running)
+	    {
+		lock.wait(1);
+		it = find(num); // the deque may have changed meanwhile
+	    }
+
+	    if(it != todo.end())
+	    {
+		switch(it->status)
+		{
+		case state::waiting:
+		    ret = it->remote;
+		    break;
+		case state::done:
+		    ret = it->spool;
+		    to_delete = it->remote;
+		    break;
+		case state::failed:
+		    break;
+		default:
+		    throw SRC_BUG;
+		}
+		todo.erase(it);
+	    }
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    throw;
+	}
+	lock.unlock();
+
+	if(to_delete != nullptr)
+	    delete to_delete;
+
+	return ret;
+    }
+
+    void slice_prefetcher::clear()
+    {
+	deque<fichier_global *> to_delete;
+
+	lock.lock();
+	try
+	{
+	    deque<job>::iterator it = todo.begin();
+
+	    while(it != todo.end())
+	    {
+		if(it->status == state::running)
+		{
+		    it->dropped = true;
+		    ++it;
+		}
+		else
+		{
+		    if(it->remote != nullptr)
+			to_delete.push_back(it->remote);
+		    if(it->spool != nullptr)
+			to_delete.push_back(it->spool);
+		    it = todo.erase(it);
+		}
+	    }
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    throw;
+	}
+	lock.unlock();
+
+	for(deque<fichier_global *>::iterator dt = to_delete.begin(); dt != to_delete.end(); ++dt)
+	    delete *dt;
+    }
+
+    void slice_prefetcher::work()
+    {
+	while(true)
+	{
+	    fichier_global *remote = nullptr;
+	    fichier_global *spool = nullptr;
+	    bool ok = false;
+	    deque<job>::iterator it;
+
+		// picking the next slice to fetch
+
+	    lock.lock();
+	    try
+	    {
+		bool found = false;
+
+		while(!stopping && !found)
+		{
+		    it = todo.begin();
+		    while(it != todo.end() && it->status != state::waiting)
+			++it;
+		    found = (it != todo.end());
+		    if(!found)
+			lock.wait(0);
+		}
+
+		if(!stopping)
+		{
+		    it->status = state::running;
+		    remote = it->remote;
+		}
+	    }
+	    catch(...)
+	    {
+		lock.unlock();
+		return;
+	    }
+	    lock.unlock();
+
+	    if(remote == nullptr)
+		return; // stopping
+
+	    try
+	    {
+		spool = sar_tools_open_spool(ui);
+		ok = fetch(remote, spool);
+	    }
+	    catch(...)
+	    {
+		    // the slice will be opened again by sar
+		    // which will report the problem if it persists
+		ok = false;
+	    }
+
+		// recording the result, the job cannot have been
+		// removed by another thread as long as it is running
+
+	    lock.lock();
+	    try
+	    {
+		it = todo.begin();
+		while(it != todo.end() && it->remote != remote)
+		    ++it;
+		if(it == todo.end())
+		    throw SRC_BUG;
+
+		if(ok && !it->dropped)
+		{
+		    it->status = state::done;
+		    it->spool = spool;
+		    spool = nullptr;
+		}
+		else
+		{
+		    it->status = state::failed;
+		    it->remote = nullptr;
+		    if(it->dropped)
+			todo.erase(it);
+		}
+		lock.signal(1);
+	    }
+	    catch(...)
+	    {
+		lock.unlock();
+		throw;
+	    }
+	    lock.unlock();
+
+	    if(spool != nullptr)
+	    {
+		delete spool;
+		delete remote;
+	    }
+	    else
+		if(!ok)
+		    delete remote;
+	}
+    }
+
+    bool slice_prefetcher::fetch(fichier_global *remote, fichier_global *spool)
+    {
+	static constexpr U_I buffer_size = 102400;
+	char *buffer = new (nothrow) char[buffer_size];
+	U_I lu;
+
+	if(buffer == nullptr)
+	    throw Ememory("slice_prefetcher::fetch");
+
+	try
+	{
+		// copying the slice size rather than reading up to
+		// the end of file, as sar does when reading a slice
+	    infinint remaining = remote->get_size();
+
+	    while(!remaining.is_zero())
+	    {
+		U_I step = buffer_size;
+
+		if(interrupted(remote))
+		{
+		    delete [] buffer;
+		    return false;
+		}
+		if(remaining < infinint(step))
+		{
+		    step = 0;
+		    remaining.unstack(step);
+		}
+		else
+		    remaining -= step;
+
+		lu = remote->read(buffer, step);
+		if(lu < step)
+		    throw Erange("slice_prefetcher::fetch", gettext("Reached premature end of file while fetching a slice"));
+		spool->write(buffer, lu);
+	    }
+
+	    spool->skip(0);
+	}
+	catch(...)
+	{
+	    delete [] buffer;
+	    throw;
+	}
+	delete [] buffer;
+
+	return true;
+    }
+
+    bool slice_prefetcher::interrupted(const fichier_global *remote) const
+    {
+	bool ret = false;
+
+	lock.lock();
+	try
+	{
+	    deque<job>::const_iterator it = todo.begin();
+
+	    while(it != todo.end() && it->remote != remote)
+		++it;
+	    ret = stopping || (it != todo.end() && it->dropped);
+	}
+	catch(...)
+	{
+	    lock.unlock();
+	    throw;
+	}
+	lock.unlock();
+
+	return ret;
+    }
+
+    deque<slice_prefetcher::job>::iterator slice_prefetcher::find(const infinint & num)
+    {
+	deque<job>::iterator it = todo.begin();
+
+	while(it != todo.end() && (it->dropped || it->num != num))
+	    ++it;
+
+	return it;
+    }
+
+    void slice_prefetcher::release()
+    {
+	lock.lock();
+	stopping = true;
+	lock.broadcast(0);
+	lock.unlock();
+
+	for(deque<slice_prefetcher_worker *>::iterator wt = workers.begin(); wt != workers.end(); ++wt)
+	{
+	    if(*wt != nullptr)
+	    {
+		try
+		{
+		    (*wt)->join();
+		}
+		catch(...)
+		{
+			// ignore all exceptions
+		}
+		delete *wt;
+		*wt = nullptr;
+	    }
+	}
+	workers.clear();
+
+	for(deque<job>::iterator it = todo.begin(); it != todo.end(); ++it)
+	{
+	    if(it->remote != nullptr)
+		delete it->remote;
+	    if(it->spool != nullptr)
+		delete it->spool;
+	}
+	todo.clear();
+    }
+
+} // end of namespace
@@ -0,0 +1,126 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+    /// \file slice_prefetcher.hpp
+    /// \brief fetches the next slices into local files while sar reads the current one
+    /// \ingroup Private
+
+#ifndef SLICE_PREFETCHER_HPP
+#define SLICE_PREFETCHER_HPP
+
+#include "../my_config.h"
+
+#if HAVE_LIBTHREADAR_LIBTHREADAR_HPP
+#include <libthreadar/libthreadar.hpp>
+#endif
+
+#include <deque>
+#include <memory>
+#include "integers.hpp"
+#include "infinint.hpp"
+#include "fichier_global.hpp"
+#include "user_interaction.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+    class slice_prefetcher_worker;
+
+	/// copies slices from a remote repository to local spool files ahead of their use
+
+	/// the slices are opened by the caller, the threads only transfer their
+	/// data, several slices at a time. A failed transfer is not reported: the
+	/// caller gets no spool for that slice and opens it again the usual way,
+	/// which lets errors be handled and reported as without prefetching.
+
+    class slice_prefetcher
+    {
+    public:
+	    /// constructor
+
+	    /// \param[in] dialog used to create the spool files
+	    /// \param[in] workers number of slices transferred at the same time
+	slice_prefetcher(const std::shared_ptr<user_interaction> & dialog, U_I workers);
+	slice_prefetcher(const slice_prefetcher & ref) = delete;
+	slice_prefetcher(slice_prefetcher && ref) noexcept = delete;
+	slice_prefetcher & operator = (const slice_prefetcher & ref) = delete;
+	slice_prefetcher & operator = (slice_prefetcher && ref) noexcept = delete;
+
+	    /// destructor, transfers in progress are interrupted
+	~slice_prefetcher();
+
+	    /// get the number of slices given and not yet taken back
+	U_I size() const;
+
+	    /// whether the given slice has been given and not yet taken back
+	bool is_pending(const infinint & num) const;
+
+	    /// give a slice to fetch
+
+	    /// \param[in] num the slice number
+	    /// \param[in] remote the slice opened read-only, the object passes under the responsibility of the slice_prefetcher
+	void push(const infinint & num, fichier_global *remote);
+
+	    /// get back a slice
+
+	    /// \return a local spool file holding the whole slice, the remote object itself if its transfer
+	    /// was not started yet, or nullptr if the transfer failed or the slice was not given
+	    /// \note waits for the transfer in progress if any, the returned object passes under the responsibility of the caller
+	fichier_global *take(const infinint & num);
+
+	    /// drop all the slices given, interrupting their transfer
+	void clear();
+
+    private:
+	enum class state { waiting, running, done, failed };
+
+	struct job
+	{
+	    infinint num;
+	    fichier_global *remote;
+	    fichier_global *spool;
+	    state status;
+	    bool dropped;                      ///< the slice is no more expected, the worker removes the job once the transfer stopped
+	};
+
+	std::shared_ptr<user_interaction> ui;
+	mutable libthreadar::condition lock;   ///< protects the following fields, instance 0 is used by the workers, instance 1 by take()
+	std::deque<job> todo;
+	bool stopping;                         ///< set when the workers have to end
+	std::deque<slice_prefetcher_worker *> workers;
+
+	void work();                           ///< the routine the workers run
+	bool fetch(fichier_global *remote, fichier_global *spool);       ///< transfer the remote slice into the spool file, returns false if interrupted
+	bool interrupted(const fichier_global *remote) const;            ///< whether the transfer of that remote slice has to stop
+	std::deque<job>::iterator find(const infinint & num);            ///< the job of that slice not dropped, todo.end() if none
+	void release();
+
+	friend class slice_prefetcher_worker;
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
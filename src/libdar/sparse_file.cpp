@@ -236,7 +236,11 @@ namespace libdar
     void sparse_file::copy_to(generic_file &ref, const infinint & crc_size, crc * & value)
     {
 	char buffer[BUFFER_SIZE];
-	S_I lu;
+	const char *data;
+	bool lent;
+	U_I lu;
+	S_I fd;
+	infinint from;
 	bool loop = true;
 	bool last_is_skip = false;
 
@@ -256,15 +260,25 @@ namespace libdar
 	{
 	    do
 	    {
-		lu = escape::inherited_read(buffer, BUFFER_SIZE);
+		    // data between holes is lent by the escape layer when possible
+		lu = BUFFER_SIZE;
+		lent = escape::inherited_read_lend(data, lu);
+		if(!lent)
+		{
+		    lu = escape::inherited_read(buffer, BUFFER_SIZE);
+		    data = buffer;
+		}
 		if(has_escaped_data_since_last_skip())
 		    data_escaped = true;
 
 		if(lu > 0)
 		{
 		    if(!crc_size.is_zero())
-			value->compute(offset, buffer, lu);
-		    ref.write(buffer, lu);
+			value->compute(offset, data, lu);
+		    if(lent && escape::inherited_lent_from(fd, from))
+			ref.write_lent(data, lu, fd, from);
+		    else
+			ref.write(data, lu);
 		    offset += lu;
 		    last_is_skip = false;
 		}
@@ -508,41 +522,57 @@ namespace libdar
     bool sparse_file::look_for_hole(const char *a, U_I size, U_I min_hole_size, U_I & start, U_I & length)
     {
 	U_I inspected = 0;
-	length = 0;
 
-	while(inspected < size)
+	if(min_hole_size > 0)
 	{
-	    start = inspected;
+	    while(size - inspected > min_hole_size) // else the remaining data is too short to hold a hole
+	    {
+		    // memchr() locates the next zeroed byte, then we measure the run of zeros it starts
 
-	    while(start < size && a[start] != '\0')
-		++start;
+		const char *zero = (const char *)memchr(a + inspected, '\0', size - inspected);
 
-	    if(start < size)
-	    {
-		inspected = start + 1;
-		while(inspected < size && a[inspected] == '\0')
-		    ++inspected;
-	    }
-	    else
-		inspected = start;
+		if(zero == nullptr)
+		    break;
 
-	    length = inspected - start;
-	    if(min_hole_size > 0 && length > min_hole_size)
-		inspected = size;
-	    else
-	    {
-		++inspected;
-		length = 0;
+		start = zero - a;
+		length = count_initial_zeros(zero, size - start);
+		if(length > min_hole_size)
+		    return true;
+
+		inspected = start + length; // the run of zeros is too short, continuing after it
 	    }
 	}
 
-	return length > 0;
+	start = size;
+	length = 0;
+
+	return false;
     }
 
 
     U_I sparse_file::count_initial_zeros(const char *a, U_I size)
     {
 	U_I curs = 0;
+	U_64 words[8];
+
+	    // checking 64 bytes per step, then word by word, then byte by byte for the tail,
+	    // memcpy() avoids alignment constraints and is reduced to plain loads by the compiler
+
+	while(curs + sizeof(words) <= size)
+	{
+	    (void)memcpy(words, a + curs, sizeof(words));
+	    if((words[0] | words[1] | words[2] | words[3] | words[4] | words[5] | words[6] | words[7]) != 0)
+		break;
+	    curs += sizeof(words);
+	}
+
+	while(curs + sizeof(words[0]) <= size)
+	{
+	    (void)memcpy(words, a + curs, sizeof(words[0]));
+	    if(words[0] != 0)
+		break;
+	    curs += sizeof(words[0]);
+	}
 
 	while(curs < size && a[curs] == '\0')
 	    ++curs;
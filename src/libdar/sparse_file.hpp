@@ -130,6 +130,7 @@ namespace libdar
 	    // methods from generic_file redefined as protected
 
 	virtual U_I inherited_read(char *a, U_I size) override;
+	virtual bool inherited_read_lend(const char * & ptr, U_I & size) override { return false; }; // holes are rebuilt by inherited_read()
 	virtual void inherited_write(const char *a, U_I size) override;
 	virtual void inherited_sync_write() override;
 	    // inherited_flush_read() kept as is from the escape class
@@ -167,11 +168,12 @@ namespace libdar
 
 	    /// \param[in] a pointer to the buffer area
 	    /// \param[in] size size of the buffer to inspect
-	    /// \param[in] min_hole_size minimum size of hole to consider, if set to zero only consider hole at end of buffer
+	    /// \param[in] min_hole_size minimum size of hole to consider, if set to zero no hole is looked for
 	    /// \param[out] offset in "a" where starts the found hole
 	    /// \param[out] length length of the hole in byte
 	    /// \return true if a hole has been found, false else
-	    /// \note if the buffer ends by zeros, start points to the first zero, and length may be less than min_hole_size
+	    /// \note the hole returned is the first run of zeros longer than min_hole_size, if it ends
+	    /// the buffer, its length is the number of zeros up to the end of the buffer
 	static bool look_for_hole(const char *a, U_I size, U_I min_hole_size, U_I & start, U_I & length);
 
 	    /// count the number of zeroed byte starting at the provided buffer
@@ -129,6 +129,9 @@ namespace libdar
 	    /// increment by one the fsa treated counter
 	void incr_fsa_treated() { (this->*increment)(&fsa_treated); };
 
+	    /// increment the skipped counter by a given value
+	void add_to_skipped(const infinint & val) { (this->*add_to)(&skipped, val); };
+
 	    /// increment the ignored counter by a given value
 	void add_to_ignored(const infinint & val) { (this->*add_to)(&ignored, val); };
 
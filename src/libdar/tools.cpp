@@ -1448,37 +1448,62 @@ namespace libdar
     }
 
 
+    void tools_hook_execute_once(const string & cmd_line)
+    {
+        NLS_SWAP_IN;
+        try
+        {
+            S_I code = system(cmd_line.c_str());
+            switch(code)
+            {
+            case 0:
+                break; // All is fine, script did not report error
+            case 127:
+                throw Erange("tools_hook_execute", gettext("execve() failed. (process table is full ?)"));
+            case -1:
+                throw Erange("tools_hook_execute", string(gettext("system() call failed: ")) + tools_strerror_r(errno));
+            default:
+                throw Erange("tools_hook_execute", tools_printf(gettext("execution of [ %S ] returned error code: %d"), &cmd_line, code));
+            }
+        }
+        catch(...)
+        {
+            NLS_SWAP_OUT;
+            throw;
+        }
+        NLS_SWAP_OUT;
+    }
+
     void tools_hook_execute(user_interaction & ui,
-                            const string & cmd_line)
+                            const string & cmd_line,
+                            const string & first_error)
     {
         NLS_SWAP_IN;
         try
         {
-            const char *ptr = cmd_line.c_str();
-            bool loop = false;
-            do
+            string failure = first_error;
+            bool loop = failure.empty();
+
+            while(loop || !failure.empty())
             {
-                try
+                if(failure.empty())
                 {
-                    S_I code = system(ptr);
-                    switch(code)
+                    try
                     {
-                    case 0:
+                        tools_hook_execute_once(cmd_line);
                         loop = false;
-                        break; // All is fine, script did not report error
-                    case 127:
-                        throw Erange("tools_hook_execute", gettext("execve() failed. (process table is full ?)"));
-                    case -1:
-                        throw Erange("tools_hook_execute", string(gettext("system() call failed: ")) + tools_strerror_r(errno));
-                    default:
-                        throw Erange("tools_hook_execute", tools_printf(gettext("execution of [ %S ] returned error code: %d"), &cmd_line, code));
+                    }
+                    catch(Erange & e)
+                    {
+                        failure = e.get_message();
                     }
                 }
-                catch(Erange & e)
+
+                if(!failure.empty())
                 {
                     try
                     {
-                        ui.pause(string(gettext("Error during user command line execution: ")) + e.get_message() + gettext(" . Retry command-line ?"));
+                        ui.pause(string(gettext("Error during user command line execution: ")) + failure + gettext(" . Retry command-line ?"));
                         loop = true;
                     }
                     catch(Euser_abort & f)
@@ -1486,9 +1511,9 @@ namespace libdar
                         ui.pause(gettext("Ignore previous error on user command line and continue ?"));
                         loop = false;
                     }
+                    failure.clear();
                 }
             }
-            while(loop);
         }
         catch(...)
         {
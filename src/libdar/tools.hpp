@@ -448,12 +448,22 @@ namespace libdar
 					     const std::string & base_url);
 
 
+	/// execute once a given command line
+
+	/// \param[in] cmd_line the command line to execute
+	/// \note an Erange exception is thrown if the command failed
+    extern void tools_hook_execute_once(const std::string & cmd_line);
+
+
 	/// execute and retries at user will a given command line
 
 	/// \param[in] ui which way to ask the user whether to continue upon command line error
 	/// \param[in] cmd_line the command line to execute
+	/// \param[in] first_error if not empty, the command line has already been executed and
+	/// failed for this reason, the user is then first asked whether to retry it
     extern void tools_hook_execute(user_interaction & ui,
-				   const std::string & cmd_line);
+				   const std::string & cmd_line,
+				   const std::string & first_error = "");
 
 
 	/// subsititue and execute command line
@@ -288,6 +288,41 @@ namespace libdar
         return lu;
     }
 
+    bool tronc::inherited_read_lend(const char * & ptr, U_I & size)
+    {
+	infinint abso_pos = start + current;
+
+	if(check_pos && ref->get_position() != abso_pos)
+	{
+	    if(!ref->skip(abso_pos))
+		throw Erange("tronc::inherited_read_lend", gettext("Cannot skip to the current position in \"tronc\""));
+	}
+
+	if(limited)
+	{
+	    infinint avail = sz - current;
+
+	    if(avail.is_zero())
+	    {
+		size = 0;
+		return true;
+	    }
+
+	    if(avail < size)
+	    {
+		size = 0;
+		avail.unstack(size);
+	    }
+	}
+
+	if(!ref->read_lend(ptr, size))
+	    return false;
+
+	current += size;
+
+	return true;
+    }
+
     void tronc::inherited_write(const char *a, U_I size)
     {
         U_I wrote = 0;
@@ -99,6 +99,10 @@ namespace libdar
 	    /// inherited from generic_file
         virtual U_I inherited_read(char *a, U_I size) override;
 	    /// inherited from generic_file
+	virtual bool inherited_read_lend(const char * & ptr, U_I & size) override;
+	    /// inherited from generic_file
+	virtual bool inherited_lent_from(S_I & fd, infinint & offset) const override { return ref->lent_from(fd, offset); };
+	    /// inherited from generic_file
         virtual void inherited_write(const char *a, U_I size) override;
 	virtual void inherited_sync_write() override { ref->sync_write(); }
 	virtual void inherited_flush_read() override {};
@@ -46,6 +46,12 @@ extern "C"
 #endif
 }
 
+#include <exception>
+
+#if HAVE_LIBTHREADAR_LIBTHREADAR_HPP
+#include <libthreadar/libthreadar.hpp>
+#endif
+
 #include "tronconneuse.hpp"
 #include "tools.hpp"
 #include "memory_file.hpp"
@@ -55,7 +61,56 @@ using namespace std;
 namespace libdar
 {
 
-    tronconneuse::tronconneuse(U_32 block_size, generic_file & encrypted_side, bool no_initial_shift, const archive_version & x_reading_ver) : generic_file(encrypted_side.get_mode() == gf_read_only ? gf_read_only : gf_write_only)
+#ifdef LIBTHREADAR_AVAILABLE
+
+	/// thread ciphering or deciphering a single block of a tronconneuse batch at a time
+
+    class tronconneuse_worker : public libthreadar::thread
+    {
+    public:
+	tronconneuse_worker() { set_job(nullptr, 0, true, nullptr); };
+
+	    /// define the next job to run
+
+	    /// \param[in] owner the tronconneuse object the block belongs to
+	    /// \param[in] worker the worker number which ciphering context is to be used
+	    /// \param[in] encrypt whether to cipher or decipher the block
+	    /// \param[in,out] blk the block to process
+	void set_job(tronconneuse *owner, U_I worker, bool encrypt, tronconneuse::batch_block *blk)
+	{
+	    x_owner = owner;
+	    x_worker = worker;
+	    x_encrypt = encrypt;
+	    x_blk = blk;
+	};
+
+    protected:
+	virtual void inherited_run() override
+	{
+	    if(x_owner == nullptr || x_blk == nullptr)
+		throw SRC_BUG;
+	    x_owner->process_block(x_worker, x_encrypt, *x_blk);
+	};
+
+    private:
+	tronconneuse *x_owner;
+	U_I x_worker;
+	bool x_encrypt;
+	tronconneuse::batch_block *x_blk;
+    };
+
+#else
+
+	// only used as pointed type in the workers deque which stays empty
+    class tronconneuse_worker {};
+
+#endif
+
+    tronconneuse::tronconneuse(U_32 block_size,
+			       generic_file & encrypted_side,
+			       bool no_initial_shift,
+			       const archive_version & x_reading_ver,
+			       U_I x_num_workers) : generic_file(encrypted_side.get_mode() == gf_read_only ? gf_read_only : gf_write_only)
     {
 	if(block_size == 0)
 	    throw Erange("tronconneuse::tronconneuse", tools_printf(gettext("%d is not a valid block size"), block_size));
@@ -81,6 +136,12 @@ namespace libdar
 	reof = false;
 	reading_ver = x_reading_ver;
 	trailing_clear_data = nullptr;
+#ifdef LIBTHREADAR_AVAILABLE
+	num_workers = x_num_workers > 1 ? x_num_workers : 1;
+#else
+	num_workers = 1;
+#endif
+	batch_used = 0;
 
 	    // buffers cannot be initialized here as they need result from pure virtual methods
 	    // the inherited class constructor part has not yet been initialized
@@ -275,7 +336,10 @@ namespace libdar
 	    {
 		try
 		{
-		    flush();
+		    if(num_workers > 1)
+			queue_block();
+		    else
+			flush();
 		}
 		catch(Ethread_cancel & e)
 		{
@@ -313,6 +377,7 @@ namespace libdar
 	encrypted_buf_data = 0;
 	extra_buf_size = 0;
 	extra_buf_data = 0;
+	release_batch();
     }
 
     void tronconneuse::nullifyptr() noexcept
@@ -364,6 +429,10 @@ namespace libdar
 	    reof = ref.reof;
 	    reading_ver = ref.reading_ver;
 	    trailing_clear_data = ref.trailing_clear_data;
+	    num_workers = ref.num_workers;
+	    batch_used = 0;
+		// batch and workers are created when needed by init_buf()
+		// blocks pending in ref's batch are not copied
 	}
 	catch(...)
 	{
@@ -393,6 +462,10 @@ namespace libdar
 	reof = move(ref.reof);
 	reading_ver = move(ref.reading_ver);
 	trailing_clear_data = move(ref.trailing_clear_data);
+	num_workers = move(ref.num_workers);
+	workers.swap(ref.workers);
+	batch.swap(ref.batch);
+	batch_used = move(ref.batch_used);
     }
 
     U_32 tronconneuse::fill_buf()
@@ -406,7 +479,11 @@ namespace libdar
 	{
 	    position_clear2crypt(current_position, crypt_offset, buf_offset, tmp_ret, block_num);
 
-	    if(!reof)
+	    if(!reof && num_workers > 1 && fill_buf_from_batch(crypt_offset))
+	    {
+		    // buf has been filled from the blocks deciphered in advance
+	    }
+	    else if(!reof)
 	    {
 		    // if extra_buf contains the encrypted byte we need we move them to encrypted_buf
 		if(crypt_offset >= extra_buf_offset && crypt_offset < extra_buf_offset + extra_buf_data)
@@ -486,6 +563,14 @@ namespace libdar
 	if(weof)
 	    return;
 
+	if(num_workers > 1)
+	{
+	    if(buf_byte_data > 0)
+		queue_block();
+	    flush_batch();
+	    return;
+	}
+
 	if(buf_byte_data > 0)
 	{
 	    init_buf();
@@ -557,6 +642,288 @@ namespace libdar
 		throw Ememory("tronconneuse::init_encrypte_buf_size");
 	    }
 	}
+	if(num_workers > 1 && batch.empty())
+	{
+	    try
+	    {
+		batch.resize(num_workers);
+		for(vector<batch_block>::iterator it = batch.begin(); it != batch.end(); ++it)
+		{
+		    it->clear = nullptr;
+		    it->crypt = nullptr;
+		    it->clear_data = 0;
+		    it->crypt_data = 0;
+		    it->valid = false;
+		}
+		for(vector<batch_block>::iterator it = batch.begin(); it != batch.end(); ++it)
+		{
+		    it->clear = new (nothrow) char[buf_size];
+		    it->crypt = new (nothrow) char[encrypted_buf_size];
+		    if(it->clear == nullptr || it->crypt == nullptr)
+			throw Ememory("tronconneuse::init_buf");
+		}
+		batch_used = 0;
+#ifdef LIBTHREADAR_AVAILABLE
+		    // the calling thread processes the first block of each batch
+		for(U_I i = 1; i < num_workers; ++i)
+		{
+		    workers.push_back(nullptr);
+		    workers.back() = new (nothrow) tronconneuse_worker();
+		    if(workers.back() == nullptr)
+			throw Ememory("tronconneuse::init_buf");
+		}
+#endif
+	    }
+	    catch(...)
+	    {
+		release_batch();
+		throw;
+	    }
+	}
+    }
+
+    void tronconneuse::release_batch() noexcept
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	for(deque<tronconneuse_worker *>::iterator it = workers.begin(); it != workers.end(); ++it)
+	    if(*it != nullptr)
+	    {
+		try
+		{
+		    (*it)->join();
+		}
+		catch(...)
+		{
+			// ignoring exception of a job which result is dropped
+		}
+		delete *it;
+	    }
+#endif
+	workers.clear();
+
+	for(vector<batch_block>::iterator it = batch.begin(); it != batch.end(); ++it)
+	{
+	    if(it->clear != nullptr)
+		delete [] it->clear;
+	    if(it->crypt != nullptr)
+		delete [] it->crypt;
+	}
+	batch.clear();
+	batch_used = 0;
+    }
+
+    U_32 tronconneuse::encrypt_data_by(U_I worker,
+				       const infinint & block_num,
+				       const char *clear_buf, const U_32 clear_size, const U_32 clear_allocated,
+				       char *crypt_buf, U_32 crypt_size)
+    {
+	if(worker != 0)
+	    throw SRC_BUG; // inherited class does not support concurrent ciphering
+	return encrypt_data(block_num, clear_buf, clear_size, clear_allocated, crypt_buf, crypt_size);
+    }
+
+    U_32 tronconneuse::decrypt_data_by(U_I worker,
+				       const infinint & block_num,
+				       const char *crypt_buf, const U_32 crypt_size,
+				       char *clear_buf, U_32 clear_size)
+    {
+	if(worker != 0)
+	    throw SRC_BUG; // inherited class does not support concurrent deciphering
+	return decrypt_data(block_num, crypt_buf, crypt_size, clear_buf, clear_size);
+    }
+
+    void tronconneuse::process_block(U_I worker, bool encrypt, batch_block & blk)
+    {
+	if(encrypt)
+	    blk.crypt_data = encrypt_data_by(worker, blk.num, blk.clear, blk.clear_data, buf_size, blk.crypt, encrypted_buf_size);
+	else
+	{
+	    blk.clear_data = decrypt_data_by(worker, blk.num, blk.crypt, blk.crypt_data, blk.clear, clear_block_size);
+	    if(blk.clear_data > clear_block_size)
+		throw Erange("tronconneuse::process_block", gettext("Data corruption may have occurred, cannot decrypt data"));
+	}
+	blk.valid = true;
+    }
+
+    void tronconneuse::process_batch(U_I num, bool encrypt)
+    {
+	exception_ptr failed;
+#ifdef LIBTHREADAR_AVAILABLE
+	U_I launched = 0;
+#endif
+
+	if(num > batch.size())
+	    throw SRC_BUG;
+
+	for(U_I i = 0; i < num; ++i)
+	    batch[i].valid = false;
+
+	try
+	{
+#ifdef LIBTHREADAR_AVAILABLE
+	    for(U_I i = 1; i < num; ++i)
+	    {
+		if(workers[i - 1] == nullptr)
+		    throw SRC_BUG;
+		workers[i - 1]->set_job(this, i, encrypt, &(batch[i]));
+		workers[i - 1]->run();
+		++launched;
+	    }
+#endif
+	    if(num > 0)
+		process_block(0, encrypt, batch[0]);
+	}
+	catch(...)
+	{
+	    failed = current_exception();
+	}
+
+#ifdef LIBTHREADAR_AVAILABLE
+	for(U_I i = 0; i < launched; ++i)
+	{
+	    try
+	    {
+		workers[i]->join();
+	    }
+	    catch(...)
+	    {
+		if(!failed)
+		    failed = current_exception();
+	    }
+	}
+#endif
+
+	if(encrypt)
+	{
+	    if(failed)
+		rethrow_exception(failed);
+	}
+	else
+	{
+		// a deciphering failure may be due to clear data following
+		// the encrypted data, the block and those following it are
+		// left to the sequential reading which handles that case
+	    bool ok = true;
+
+	    for(U_I i = 0; i < num; ++i)
+	    {
+		if(!batch[i].valid)
+		    ok = false;
+		if(!ok)
+		    batch[i].valid = false;
+	    }
+	}
+    }
+
+    void tronconneuse::queue_block()
+    {
+	init_buf();
+
+	if(batch_used >= batch.size())
+	    throw SRC_BUG;
+
+	batch_block & blk = batch[batch_used];
+
+	swap(blk.clear, buf);
+	blk.clear_data = buf_byte_data;
+	blk.num = block_num;
+	++batch_used;
+	buf_byte_data = 0;
+	buf_offset += infinint(clear_block_size);
+
+	if(batch_used == batch.size())
+	    flush_batch();
+    }
+
+    void tronconneuse::flush_batch()
+    {
+	U_I i = 0;
+
+	if(batch_used == 0)
+	    return;
+
+	try
+	{
+	    process_batch(batch_used, true);
+	}
+	catch(...)
+	{
+	    batch_used = 0;
+	    throw;
+	}
+
+	try
+	{
+	    while(i < batch_used)
+	    {
+		encrypted->write(batch[i].crypt, batch[i].crypt_data);
+		++i;
+	    }
+	}
+	catch(Ethread_cancel & e)
+	{
+		// same as in flush(), clear data of the batch has already been
+		// reported as written to the upper layer, we must not drop it
+	    ++i;
+	    while(i < batch_used)
+	    {
+		encrypted->write(batch[i].crypt, batch[i].crypt_data);
+		++i;
+	    }
+	    batch_used = 0;
+	    throw;
+	}
+	batch_used = 0;
+    }
+
+    bool tronconneuse::fill_buf_from_batch(const infinint & crypt_offset)
+    {
+	U_I num = 0;
+
+	init_buf();
+
+	for(vector<batch_block>::iterator it = batch.begin(); it != batch.end(); ++it)
+	{
+	    if(it->valid && it->num == block_num)
+	    {
+		swap(it->clear, buf);
+		buf_byte_data = it->clear_data;
+		it->valid = false;
+		return true;
+	    }
+	}
+
+	    // reading a whole batch of full encrypted blocks
+
+	extra_buf_data = 0; // the encrypted side position is about to change
+	if(!encrypted->skip(crypt_offset + initial_shift))
+	    return false;
+
+	while(num < batch.size())
+	{
+	    batch_block & blk = batch[num];
+
+	    blk.crypt_data = encrypted->read(blk.crypt, encrypted_buf_size);
+	    if(blk.crypt_data < encrypted_buf_size)
+		break;
+		// a partial block may contain trailing clear data, it is left
+		// to the sequential reading, as well as any block after it
+	    blk.num = block_num + infinint(num);
+	    ++num;
+	}
+
+	if(num == 0)
+	    return false;
+
+	process_batch(num, false);
+
+	if(!batch[0].valid)
+	    return false;
+
+	swap(batch[0].clear, buf);
+	buf_byte_data = batch[0].clear_data;
+	batch[0].valid = false;
+	return true;
     }
 
     void tronconneuse::position_clear2crypt(const infinint & pos, infinint & file_buf_start, infinint & clear_buf_start, infinint & pos_in_buf, infinint & block_num)
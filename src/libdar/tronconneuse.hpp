@@ -30,6 +30,8 @@
 
 #include "../my_config.h"
 #include <string>
+#include <deque>
+#include <vector>
 
 #include "infinint.hpp"
 #include "generic_file.hpp"
@@ -41,6 +43,7 @@ namespace libdar
 	/// \addtogroup Private
 	/// @{
 
+    class tronconneuse_worker;
 
 	/// this is a partial implementation of the generic_file interface to cypher/decypher data block by block.
 
@@ -55,6 +58,9 @@ namespace libdar
 	/// In write_only no skip() is allowed, writing is sequential from the beginning of the file to the end
 	/// (like writing to a pipe).
 	/// In read_only all skip() functions are available.
+	/// When more than one worker is requested, blocks are processed by batches of as many blocks
+	/// as workers, each block of a batch being ciphered or deciphered concurrently by a different
+	/// thread, see encrypt_data_by() and decrypt_data_by().
     class tronconneuse : public generic_file
     {
     public:
@@ -65,9 +71,15 @@ namespace libdar
   	    /// \param[in] no_initial_shift assume that no unencrypted data is located at the begining of the underlying file, else this is the
 	    /// position of the encrypted_side at the time of this call that is used as initial_shift
 	    /// \param[in] reading_ver version of the archive format
+	    /// \param[in] num_workers number of blocks to cipher/decipher concurrently (1 for no additional thread)
 	    /// \note that encrypted_side is not owned and destroyed by tronconneuse, it must exist during all the life of the
 	    /// tronconneuse object, and is not destroyed by the tronconneuse's destructor
-	tronconneuse(U_32 block_size, generic_file & encrypted_side, bool no_initial_shift, const archive_version & reading_ver);
+	    /// \note num_workers greater than one requires libthreadar, else it is ignored
+	tronconneuse(U_32 block_size,
+		     generic_file & encrypted_side,
+		     bool no_initial_shift,
+		     const archive_version & reading_ver,
+		     U_I num_workers = 1);
 
 	    /// copy constructor
 	tronconneuse(const tronconneuse & ref) : generic_file(ref) { copy_from(ref); };
@@ -116,6 +128,9 @@ namespace libdar
 	    /// returns the block size give to constructor
 	U_32 get_clear_block_size() const { return clear_block_size; };
 
+	    /// returns the number of blocks ciphered/deciphered concurrently
+	U_I get_num_workers() const { return num_workers; };
+
     private:
 
 	    /// inherited from generic_file
@@ -135,7 +150,7 @@ namespace libdar
 	virtual void inherited_sync_write() override { flush(); };
 
 	    /// this protected inherited method is now private for inherited classes of tronconneuse
-	virtual void inherited_flush_read() override { buf_byte_data = 0; };
+	virtual void inherited_flush_read() override { buf_byte_data = 0; drop_batch(); };
 
 	    /// this protected inherited method is now private for inherited classes of tronconneuse
 	virtual void inherited_terminate() override {};
@@ -186,6 +201,25 @@ namespace libdar
 				  const char *crypt_buf, const U_32 crypt_size,
 				  char *clear_buf, U_32 clear_size) = 0;
 
+	    /// same as encrypt_data() but using the ciphering context dedicated to the given worker
+
+	    /// \param[in] worker is the worker number, from zero to get_num_workers() - 1
+	    /// \note this method is called concurrently for different worker numbers, an inherited class
+	    /// providing more than one worker must thus not share modifiable data between workers.
+	    /// The default implementation only supports worker zero and relies on encrypt_data().
+	virtual U_32 encrypt_data_by(U_I worker,
+				     const infinint & block_num,
+				     const char *clear_buf, const U_32 clear_size, const U_32 clear_allocated,
+				     char *crypt_buf, U_32 crypt_size);
+
+	    /// same as decrypt_data() but using the deciphering context dedicated to the given worker
+
+	    /// \note same remarks as for encrypt_data_by() apply here
+	virtual U_32 decrypt_data_by(U_I worker,
+				     const infinint & block_num,
+				     const char *crypt_buf, const U_32 crypt_size,
+				     char *clear_buf, U_32 clear_size);
+
     protected:
 	const archive_version & get_reading_version() const { return reading_ver; };
 
@@ -216,6 +250,21 @@ namespace libdar
 	bool reof;                 ///< whether we reached eof while reading
 	archive_version reading_ver; ///< archive format we currently read
 	infinint (*trailing_clear_data)(generic_file & below, const archive_version & reading_ver); ///< callback function that gives the amount of clear data found at the end of the given file
+	    //
+	struct batch_block
+	{
+	    infinint num;          ///< block number
+	    char *clear;           ///< clear data, allocated size is buf_size
+	    U_32 clear_data;       ///< amount of clear data
+	    char *crypt;           ///< encrypted data, allocated size is encrypted_buf_size
+	    U_32 crypt_data;       ///< amount of encrypted data
+	    bool valid;            ///< whether the block has been successfully ciphered/deciphered
+	};
+
+	U_I num_workers;           ///< number of blocks processed concurrently
+	std::deque<tronconneuse_worker *> workers; ///< threads processing all but the first block of a batch
+	std::vector<batch_block> batch; ///< blocks to cipher and write (write mode) or read and deciphered in advance (read mode)
+	U_I batch_used;            ///< number of blocks in the batch waiting to be ciphered (write mode)
 
 
 	void nullifyptr() noexcept;
@@ -225,6 +274,30 @@ namespace libdar
 	U_32 fill_buf();       ///< returns the position (of the next read op) inside the buffer and fill the buffer with clear data
 	void flush();          ///< flush any pending data (write mode only) to encrypted device
 	void init_buf();       ///< initialize if necessary the various buffers that relies on inherited method values
+	void release_batch() noexcept; ///< release memory and threads used by the batch
+	void drop_batch() { batch_used = 0; for(std::vector<batch_block>::iterator it = batch.begin(); it != batch.end(); ++it) it->valid = false; };
+
+	    /// cipher or decipher a block of the batch using the context of the given worker
+	void process_block(U_I worker, bool encrypt, batch_block & blk);
+
+	    /// cipher or decipher the first 'num' blocks of the batch concurrently
+
+	    /// \note in read mode exceptions met while deciphering are not propagated, the corresponding block is left invalid
+	void process_batch(U_I num, bool encrypt);
+
+	    /// move the current clear block to the batch, cipher and write the batch once it is full (write mode)
+	void queue_block();
+
+	    /// cipher and write the blocks of the batch (write mode)
+	void flush_batch();
+
+	    /// fills buf from the batch, reading and deciphering a whole batch of blocks if necessary (read mode)
+
+	    /// \param[in] crypt_offset is the offset of the encrypted block, not counting initial_shift
+	    /// \return false if the block could not be obtained that way and must be read and deciphered the usual way
+	bool fill_buf_from_batch(const infinint & crypt_offset);
+
+	friend class tronconneuse_worker;
 
 
 	    /// convert clear position to corresponding position in the encrypted data
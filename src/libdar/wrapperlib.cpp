@@ -27,6 +27,7 @@
 #define CHECK_Z if(z_ptr == nullptr) throw SRC_BUG
 #define CHECK_BZ if(bz_ptr == nullptr) throw SRC_BUG
 #define CHECK_LZMA if(lzma_ptr == nullptr) throw SRC_BUG;
+#define CHECK_ZSTD if(zstd_ptr == nullptr) throw SRC_BUG;
 
 using namespace std;
 
@@ -45,6 +46,9 @@ namespace libdar
     static S_I lzma2wrap_code(S_I code);
     static lzma_action wrap2lzma_code(S_I code);
 #endif
+#if LIBZSTD_AVAILABLE
+    static S_I zstd2wrap_code(size_t code, S_I error_code);
+#endif
 
     wrapperlib::wrapperlib(wrapperlib_mode mode)
     {
@@ -60,6 +64,9 @@ namespace libdar
 #endif
 #if LIBLZMA_AVAILABLE
 	    lzma_ptr = nullptr;
+#endif
+#if LIBZSTD_AVAILABLE
+	    zstd_ptr = nullptr;
 #endif
             z_ptr->zalloc = nullptr;
             z_ptr->zfree = nullptr;
@@ -93,6 +100,9 @@ namespace libdar
 #endif
 #if LIBLZMA_AVAILABLE
 	    lzma_ptr = nullptr;
+#endif
+#if LIBZSTD_AVAILABLE
+	    zstd_ptr = nullptr;
 #endif
             bz_ptr->bzalloc = nullptr;
             bz_ptr->bzfree = nullptr;
@@ -123,6 +133,9 @@ namespace libdar
 #endif
 #if LIBBZ2_AVAILABLE
             bz_ptr = nullptr;
+#endif
+#if LIBZSTD_AVAILABLE
+	    zstd_ptr = nullptr;
 #endif
 	    lzma_ptr = new (nothrow) lzma_stream;
 	    if(lzma_ptr == nullptr)
@@ -145,6 +158,50 @@ namespace libdar
             x_get_total_out = & wrapperlib::lzma_get_total_out;
 #else
 	    throw Ecompilation("xz compression support (libxz)");
+#endif
+	    break;
+	case zstd_mode:
+	case zstd_long_mode:
+#if LIBZSTD_AVAILABLE
+#if LIBZ_AVAILABLE
+            z_ptr = nullptr;
+#endif
+#if LIBBZ2_AVAILABLE
+            bz_ptr = nullptr;
+#endif
+#if LIBLZMA_AVAILABLE
+	    lzma_ptr = nullptr;
+#endif
+	    zstd_ptr = new (nothrow) zstd_stream;
+	    if(zstd_ptr == nullptr)
+		throw Ememory("wrapperlib::wrapperlib");
+	    zstd_ptr->comp = nullptr;
+	    zstd_ptr->decomp = nullptr;
+	    zstd_ptr->long_window = (mode == zstd_long_mode);
+	    zstd_ptr->frame_end = false;
+	    zstd_ptr->next_in = nullptr;
+	    zstd_ptr->avail_in = 0;
+	    zstd_ptr->total_in = 0;
+	    zstd_ptr->next_out = nullptr;
+	    zstd_ptr->avail_out = 0;
+	    zstd_ptr->total_out = 0;
+            x_compressInit = & wrapperlib::zstd_compressInit;
+            x_decompressInit = & wrapperlib::zstd_decompressInit;
+            x_compressEnd = & wrapperlib::zstd_compressEnd;
+            x_decompressEnd = & wrapperlib::zstd_decompressEnd;
+            x_compress = & wrapperlib::zstd_compress;
+            x_decompress = & wrapperlib::zstd_decompress;
+            x_set_next_in = & wrapperlib::zstd_set_next_in;
+            x_set_avail_in = & wrapperlib::zstd_set_avail_in;
+            x_get_avail_in = & wrapperlib::zstd_get_avail_in;
+            x_get_total_in = & wrapperlib::zstd_get_total_in;
+            x_set_next_out = & wrapperlib::zstd_set_next_out;
+            x_get_next_out = & wrapperlib::zstd_get_next_out;
+            x_set_avail_out = & wrapperlib::zstd_set_avail_out;
+            x_get_avail_out = & wrapperlib::zstd_get_avail_out;
+            x_get_total_out = & wrapperlib::zstd_get_total_out;
+#else
+	    throw Ecompilation("zstd compression support (libzstd)");
 #endif
 	    break;
         default:
@@ -169,6 +226,16 @@ namespace libdar
 	    ::lzma_end(lzma_ptr);
 	    delete lzma_ptr;
 	}
+#endif
+#if LIBZSTD_AVAILABLE
+	if(zstd_ptr != nullptr)
+	{
+	    if(zstd_ptr->comp != nullptr)
+		ZSTD_freeCCtx(zstd_ptr->comp);
+	    if(zstd_ptr->decomp != nullptr)
+		ZSTD_freeDCtx(zstd_ptr->decomp);
+	    delete zstd_ptr;
+	}
 #endif
     }
 
@@ -460,6 +527,213 @@ namespace libdar
     }
 #endif
 
+////////////// ZSTD routines /////////////
+
+#if LIBZSTD_AVAILABLE
+    S_I wrapperlib::zstd_compressInit(U_I compression_level)
+    {
+	size_t ret;
+
+        CHECK_ZSTD;
+	if(zstd_ptr->comp != nullptr)
+	    throw SRC_BUG;
+	zstd_ptr->comp = ZSTD_createCCtx();
+	if(zstd_ptr->comp == nullptr)
+	    return WR_MEM_ERROR;
+	zstd_ptr->total_in = 0;
+	zstd_ptr->total_out = 0;
+
+	ret = ZSTD_CCtx_setParameter(zstd_ptr->comp, ZSTD_c_compressionLevel, compression_level);
+	if(!ZSTD_isError(ret) && zstd_ptr->long_window)
+		// long distance matching sets the window to 128 MiB, which is the largest
+		// window the decompression side accepts without raising its memory limit
+	    ret = ZSTD_CCtx_setParameter(zstd_ptr->comp, ZSTD_c_enableLongDistanceMatching, 1);
+
+	return zstd2wrap_code(ret, WR_VERSION_ERROR);
+    }
+
+    S_I wrapperlib::zstd_decompressInit()
+    {
+        CHECK_ZSTD;
+	if(zstd_ptr->decomp != nullptr)
+	    throw SRC_BUG;
+	zstd_ptr->decomp = ZSTD_createDCtx();
+	if(zstd_ptr->decomp == nullptr)
+	    return WR_MEM_ERROR;
+	zstd_ptr->total_in = 0;
+	zstd_ptr->total_out = 0;
+	zstd_ptr->frame_end = false;
+
+	return WR_OK;
+    }
+
+    S_I wrapperlib::zstd_compressEnd()
+    {
+        CHECK_ZSTD;
+	if(zstd_ptr->comp != nullptr)
+	{
+	    ZSTD_freeCCtx(zstd_ptr->comp);
+	    zstd_ptr->comp = nullptr;
+	}
+	return WR_OK;
+    }
+
+    S_I wrapperlib::zstd_decompressEnd()
+    {
+        CHECK_ZSTD;
+	if(zstd_ptr->decomp != nullptr)
+	{
+	    ZSTD_freeDCtx(zstd_ptr->decomp);
+	    zstd_ptr->decomp = nullptr;
+	}
+	return WR_OK;
+    }
+
+    S_I wrapperlib::zstd_compress(S_I flag)
+    {
+	ZSTD_inBuffer in;
+	ZSTD_outBuffer out;
+	ZSTD_EndDirective mode;
+	size_t ret;
+
+        CHECK_ZSTD;
+	if(zstd_ptr->comp == nullptr)
+	    throw SRC_BUG;
+
+	switch(flag)
+	{
+	case WR_NO_FLUSH:
+	    mode = ZSTD_e_continue;
+	    break;
+	case WR_FINISH:
+	    mode = ZSTD_e_end;
+	    break;
+	default:
+	    throw SRC_BUG;
+	}
+
+	in.src = zstd_ptr->next_in;
+	in.size = zstd_ptr->avail_in;
+	in.pos = 0;
+	out.dst = zstd_ptr->next_out;
+	out.size = zstd_ptr->avail_out;
+	out.pos = 0;
+
+	ret = ZSTD_compressStream2(zstd_ptr->comp, &out, &in, mode);
+
+	zstd_ptr->next_in += in.pos;
+	zstd_ptr->avail_in -= in.pos;
+	zstd_ptr->total_in += in.pos;
+	zstd_ptr->next_out += out.pos;
+	zstd_ptr->avail_out -= out.pos;
+	zstd_ptr->total_out += out.pos;
+
+	if(ZSTD_isError(ret))
+	    return zstd2wrap_code(ret, WR_STREAM_ERROR);
+	if(mode == ZSTD_e_end && ret == 0)
+	    return WR_STREAM_END; // frame completed and fully flushed
+	return WR_OK;
+    }
+
+    S_I wrapperlib::zstd_decompress(S_I flag)
+    {
+	    // flag is not used here.
+	ZSTD_inBuffer in;
+	ZSTD_outBuffer out;
+	size_t ret;
+
+        CHECK_ZSTD;
+	if(zstd_ptr->decomp == nullptr)
+	    throw SRC_BUG;
+
+	    // contrary to zlib, zstd would start decoding the next frame if any,
+	    // we must stay at the end of the stream until decompressReset() is called
+	if(zstd_ptr->frame_end)
+	    return WR_STREAM_END;
+
+	in.src = zstd_ptr->next_in;
+	in.size = zstd_ptr->avail_in;
+	in.pos = 0;
+	out.dst = zstd_ptr->next_out;
+	out.size = zstd_ptr->avail_out;
+	out.pos = 0;
+
+	ret = ZSTD_decompressStream(zstd_ptr->decomp, &out, &in);
+	    // zstd never consumes data past the end of a frame, what follows
+	    // stays available in next_in like it does with zlib
+
+	zstd_ptr->next_in += in.pos;
+	zstd_ptr->avail_in -= in.pos;
+	zstd_ptr->total_in += in.pos;
+	zstd_ptr->next_out += out.pos;
+	zstd_ptr->avail_out -= out.pos;
+	zstd_ptr->total_out += out.pos;
+
+	if(ZSTD_isError(ret))
+	    return zstd2wrap_code(ret, WR_DATA_ERROR);
+	if(ret == 0)
+	{
+	    zstd_ptr->frame_end = true;
+	    return WR_STREAM_END; // frame completely decoded and fully flushed
+	}
+	return WR_OK;
+    }
+
+    void wrapperlib::zstd_set_next_in(const char *x)
+    {
+        CHECK_ZSTD;
+        zstd_ptr->next_in = x;
+    }
+
+    void wrapperlib::zstd_set_avail_in(U_I x)
+    {
+        CHECK_ZSTD;
+        zstd_ptr->avail_in = x;
+    }
+
+    U_I wrapperlib::zstd_get_avail_in() const
+    {
+        CHECK_ZSTD;
+        return zstd_ptr->avail_in;
+    }
+
+    U_64 wrapperlib::zstd_get_total_in() const
+    {
+        CHECK_ZSTD;
+        return zstd_ptr->total_in;
+    }
+
+    void wrapperlib::zstd_set_next_out(char *x)
+    {
+        CHECK_ZSTD;
+        zstd_ptr->next_out = x;
+    }
+
+    char *wrapperlib::zstd_get_next_out() const
+    {
+        CHECK_ZSTD;
+        return zstd_ptr->next_out;
+    }
+
+    void wrapperlib::zstd_set_avail_out(U_I x)
+    {
+        CHECK_ZSTD;
+        zstd_ptr->avail_out = x;
+    }
+
+    U_I wrapperlib::zstd_get_avail_out() const
+    {
+        CHECK_ZSTD;
+        return zstd_ptr->avail_out;
+    }
+
+    U_64 wrapperlib::zstd_get_total_out() const
+    {
+        CHECK_ZSTD;
+        return zstd_ptr->total_out;
+    }
+#endif
+
     S_I wrapperlib::compressReset()
     {
         S_I ret;
@@ -617,4 +891,24 @@ namespace libdar
 
 #endif
 
+#if LIBZSTD_AVAILABLE
+    static S_I zstd2wrap_code(size_t code, S_I error_code)
+    {
+	if(!ZSTD_isError(code))
+	    return WR_OK;
+
+	switch(ZSTD_getErrorCode(code))
+	{
+	case ZSTD_error_memory_allocation:
+	    return WR_MEM_ERROR;
+	case ZSTD_error_parameter_unsupported:
+	case ZSTD_error_parameter_outOfBound:
+	case ZSTD_error_version_unsupported:
+	    return WR_VERSION_ERROR;
+	default:
+	    return error_code;
+	}
+    }
+#endif
+
 } // end of namespace
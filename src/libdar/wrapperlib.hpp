@@ -25,7 +25,8 @@
     ///
     /// libz and libbz2 library differ in the way they return values
     /// in certain circumpstances. This module defines the wrapperlib class
-    /// that make their use homogeneous.
+    /// that make their use homogeneous. liblzma and libzstd are also
+    /// wrapped to follow the libz behavior.
 
 #ifndef WRAPPERLIB_HPP
 #define WRAPPERLIB_HPP
@@ -45,6 +46,11 @@ extern "C"
 #if HAVE_LZMA_H && LIBLZMA_AVAILABLE
 #include <lzma.h>
 #endif
+
+#if HAVE_ZSTD_H && LIBZSTD_AVAILABLE
+#include <zstd.h>
+#include <zstd_errors.h>
+#endif
 } // end extern "C"
 
 #include "integers.hpp"
@@ -65,9 +71,9 @@ namespace libdar
     const int WR_STREAM_END    = 7;  // end of compressed data met
     const int WR_FINISH        = 8;  // parameter requiring the compression library to cleanly stop the running operation
 
-    enum wrapperlib_mode { zlib_mode, bzlib_mode, xz_mode };
+    enum wrapperlib_mode { zlib_mode, bzlib_mode, xz_mode, zstd_mode, zstd_long_mode };
 
-	/// this class encapsulates calls to libz or libbz2
+	/// this class encapsulates calls to libz, libbz2, liblzma or libzstd
 
 	/// this is mainly an adaptation of libbz2 specificities to
 	/// have libb2 acting exactly as libz does.
@@ -111,6 +117,23 @@ namespace libdar
 #if LIBLZMA_AVAILABLE
 	lzma_stream *lzma_ptr;
 #endif
+#if LIBZSTD_AVAILABLE
+	    /// libzstd does not keep track of the input and output buffers, they are kept here
+	struct zstd_stream
+	{
+	    ZSTD_CCtx *comp;    ///< compression context (nullptr if not initialized)
+	    ZSTD_DCtx *decomp;  ///< decompression context (nullptr if not initialized)
+	    bool long_window;   ///< whether to use long distance matching for compression
+	    bool frame_end;     ///< whether the frame being decompressed has been completely decoded
+	    const char *next_in;
+	    U_I avail_in;
+	    U_64 total_in;
+	    char *next_out;
+	    U_I avail_out;
+	    U_64 total_out;
+	};
+	zstd_stream *zstd_ptr;
+#endif
 
         S_I level;
 
@@ -188,6 +211,25 @@ namespace libdar
         U_64 lzma_get_total_out() const;
 #endif
 
+            // set of routines for libzstd
+#if LIBZSTD_AVAILABLE
+        S_I zstd_compressInit(U_I compression_level);
+        S_I zstd_decompressInit();
+        S_I zstd_compressEnd();
+        S_I zstd_decompressEnd();
+        S_I zstd_compress(S_I flag);
+        S_I zstd_decompress(S_I flag);
+        void zstd_set_next_in(const char *x);
+        void zstd_set_avail_in(U_I x);
+        U_I zstd_get_avail_in() const;
+        U_64 zstd_get_total_in() const;
+        void zstd_set_next_out(char *x);
+        char *zstd_get_next_out() const;
+        void zstd_set_avail_out(U_I x);
+        U_I zstd_get_avail_out() const;
+        U_64 zstd_get_total_out() const;
+#endif
+
     };
 
 	/// @}
@@ -36,6 +36,10 @@ extern "C"
 #if HAVE_ARPA_INET_H
 #include <arpa/inet.h>
 #endif
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif
 } // end extern "C"
 
 #include <string>
@@ -52,6 +56,12 @@ using namespace std;
 
 namespace libdar
 {
+
+	// with protocol version 2, at most this number of requests are sent ahead of
+	// the one which answer is waited for. It must stay low for the requests not to
+	// fill the pipe to the slave_zapette while it is blocked sending its answers
+    static constexpr U_I max_outstanding = 8;
+
     zapette::zapette(const shared_ptr<user_interaction> & dialog,
 		     generic_file *input,
 		     generic_file *output,
@@ -70,6 +80,12 @@ namespace libdar
 	out = output;
 	position = 0;
 	serial_counter = 0;
+	version = PROTOCOL_VERSION_1;
+	requested = 0;
+	ahead = 0;
+	buffer = nullptr;
+	buffer_len = 0;
+	buffer_offset = 0;
 	contextual::set_info_status(CONTEXT_INIT);
 
 	    //////////////////////////////
@@ -85,6 +101,8 @@ namespace libdar
 
 	try
 	{
+	    negotiate();
+
 	    if(by_the_end)
 	    {
 		try
@@ -120,6 +138,8 @@ namespace libdar
 	}
         delete in;
         delete out;
+	if(buffer != nullptr)
+	    delete [] buffer;
     }
 
     void zapette::inherited_terminate()
@@ -133,6 +153,9 @@ namespace libdar
 	if(is_terminated())
 	    throw SRC_BUG;
 
+	if(pos != position)
+	    ahead = 0;
+
         if(pos >= file_size)
         {
             position = file_size;
@@ -150,6 +173,9 @@ namespace libdar
 	if(is_terminated())
 	    throw SRC_BUG;
 
+	if(x != 0)
+	    ahead = 0;
+
         if(x >= 0)
         {
             position += x;
@@ -242,49 +268,234 @@ namespace libdar
     }
 
 
+    void zapette::inherited_read_ahead(const infinint & amount)
+    {
+	if(version == PROTOCOL_VERSION_1)
+	    return; // a single request can be sent at a time
+
+	if(amount.is_zero())
+	    ahead = file_size;
+	else
+	    ahead = position + amount;
+
+	if(outstanding.empty() || outstanding.front().offset == position)
+	    send_requests(position);
+	    // else the reader has moved since the previous requests,
+	    // their answers will be dropped at next read
+    }
+
     U_I zapette::inherited_read(char *a, U_I size)
     {
         static const U_16 max_short = ~0;
         U_I lu = 0;
 
-        if(size > 0)
-        {
-            infinint not_used;
-            U_16 pas;
-            S_I ret;
+	if(version == PROTOCOL_VERSION_1)
+	{
+	    if(size > 0)
+	    {
+		infinint not_used;
+		U_16 pas;
+		S_I ret;
 
-            do
-            {
-                if(size - lu > max_short)
-                    pas = max_short;
-                else
-                    pas = size - lu;
-                make_transfert(pas, position, a+lu, "", ret, not_used);
-                position += ret;
-                lu += ret;
-            }
-            while(lu < size && ret != 0);
-        }
+		do
+		{
+		    if(size - lu > max_short)
+			pas = max_short;
+		    else
+			pas = size - lu;
+		    make_transfert(pas, position, a+lu, "", ret, not_used);
+		    position += ret;
+		    lu += ret;
+		}
+		while(lu < size && ret != 0);
+	    }
+
+	    return lu;
+	}
+
+	while(lu < size && position < file_size)
+	{
+	    if(buffer_len > 0 && position >= buffer_offset && position < buffer_offset + buffer_len)
+	    {
+		    // data has already been received
+
+		infinint delta = position - buffer_offset;
+		U_32 off = 0;
+		U_I step;
+
+		delta.unstack(off);
+		if(!delta.is_zero())
+		    throw SRC_BUG;
+		step = buffer_len - off;
+		if(step > size - lu)
+		    step = size - lu;
+		memcpy(a + lu, buffer + off, step);
+		lu += step;
+		position += step;
+	    }
+	    else
+	    {
+		pending cur;
+		U_32 got;
+
+		if(!outstanding.empty() && outstanding.front().offset != position)
+		    drop_outstanding(); // the reader has moved since these requests were sent
+
+		send_requests(position + infinint(size - lu));
+		if(outstanding.empty())
+		    throw SRC_BUG; // position < file_size, something should have been requested
+
+		cur = outstanding.front();
+		outstanding.pop_front();
+		if(cur.size <= size - lu)
+		{
+			// the reader wants all the data of this request, no need to copy it
+		    got = receive(cur, a + lu);
+		    lu += got;
+		    position += got;
+		}
+		else
+		{
+		    got = receive(cur, buffer);
+		    buffer_offset = cur.offset;
+		    buffer_len = got;
+		}
+
+		if(got == 0)
+		{
+			// slave could not provide the data
+		    drop_outstanding();
+		    break;
+		}
+	    }
+	}
 
         return lu;
     }
 
+    void zapette::inherited_flush_read()
+    {
+	if(version == PROTOCOL_VERSION_1)
+	    return;
+
+	drop_outstanding();
+	buffer_len = 0;
+    }
+
     void zapette::inherited_write(const char *a, U_I size)
     {
         throw SRC_BUG; // zapette is read-only
     }
 
+    void zapette::negotiate()
+    {
+        request req;
+        answer ans;
+	char peer = 0;
+
+	req.serial_num = serial_counter++;
+	req.offset = file_size + 1;
+	req.size = REQUEST_SIZE_PROTOCOL_PROBE + PROTOCOL_VERSION_LAST;
+	req.write(out, PROTOCOL_VERSION_1);
+
+	ans.read(in, &peer, 1, PROTOCOL_VERSION_1);
+	if(ans.serial_num != req.serial_num || ans.type != ANSWER_TYPE_DATA)
+	    throw Erange("zapette::negotiate", gettext("Incoherent answer from peer"));
+
+	if(ans.size == 0)
+	    version = PROTOCOL_VERSION_1; // slave_zapette from an older release, beyond end of file
+	else
+	{
+	    if(ans.size != 1 || (U_I)(peer) <= PROTOCOL_VERSION_1 || (U_I)(peer) > PROTOCOL_VERSION_LAST)
+		throw Erange("zapette::negotiate", gettext("Incoherent answer from peer"));
+	    version = peer;
+	}
+
+	if(version > PROTOCOL_VERSION_1)
+	{
+	    buffer = new (nothrow) char[REQUEST_SIZE_MAX_V2];
+	    if(buffer == nullptr)
+		throw Ememory("zapette::negotiate");
+	}
+    }
+
+    void zapette::send_requests(const infinint & wanted)
+    {
+	infinint end = wanted;
+
+	if(ahead > end)
+	    end = ahead;
+	if(end > file_size)
+	    end = file_size;
+	if(outstanding.empty())
+	{
+	    if(buffer_len > 0 && position >= buffer_offset && position < buffer_offset + buffer_len)
+		requested = buffer_offset + buffer_len;
+	    else
+		requested = position;
+	}
+
+	while(outstanding.size() < max_outstanding && requested < end)
+	{
+	    request req;
+	    pending sent;
+	    infinint remain = end - requested;
+
+	    req.serial_num = serial_counter++; // may loopback to 0
+	    req.offset = requested;
+	    if(remain > REQUEST_SIZE_MAX_V2)
+		req.size = REQUEST_SIZE_MAX_V2;
+	    else
+	    {
+		req.size = 0;
+		remain.unstack(req.size);
+	    }
+	    req.write(out, version);
+
+	    sent.serial_num = req.serial_num;
+	    sent.offset = req.offset;
+	    sent.size = req.size;
+	    outstanding.push_back(sent);
+	    requested += req.size;
+	}
+    }
+
+    U_32 zapette::receive(const pending & req, char *data)
+    {
+	answer ans;
+
+	ans.read(in, data, req.size, version);
+	if(ans.serial_num != req.serial_num || ans.type != ANSWER_TYPE_DATA || ans.size > req.size)
+	    throw Erange("zapette::receive", gettext("Incoherent answer from peer"));
+
+	return ans.size;
+    }
+
+    void zapette::drop_outstanding()
+    {
+	while(!outstanding.empty())
+	{
+	    receive(outstanding.front(), buffer);
+	    outstanding.pop_front();
+	}
+	buffer_len = 0; // buffer has been overwritten
+    }
+
     void zapette::make_transfert(U_16 size, const infinint &offset, char *data, const string & info, S_I & lu, infinint & arg) const
     {
         request req;
         answer ans;
 
+	    // answers are received in the order of the requests
+	if(!outstanding.empty())
+	    const_cast<zapette *>(this)->drop_outstanding();
+
             // building the request
         req.serial_num = const_cast<char &>(serial_counter)++; // may loopback to 0
         req.offset = offset;
         req.size = size;
 	req.info = info;
-        req.write(out);
+        req.write(out, version);
 
 	if(req.size == REQUEST_SIZE_SPECIAL_ORDER)
 	    size = lu;
@@ -292,7 +503,7 @@ namespace libdar
             // reading the answer
         do
         {
-            ans.read(in, data, size);
+            ans.read(in, data, size, version);
             if(ans.serial_num != req.serial_num)
                 get_ui().pause(gettext("Communication problem with peer, retry ?"));
 	}
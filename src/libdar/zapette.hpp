@@ -33,6 +33,9 @@
 #define ZAPETTE_HPP
 
 #include "../my_config.h"
+
+#include <deque>
+
 #include "infinint.hpp"
 #include "generic_file.hpp"
 #include "integers.hpp"
@@ -63,16 +66,16 @@ namespace libdar
 	    /// \param[in] output is used to send orders to slave_zapette
 	    /// \param[in] by_the_end if true dar will try to open the archive starting from the end else it will try starting from the first bytes
         zapette(const std::shared_ptr<user_interaction> & dialog, generic_file *input, generic_file *output, bool by_the_end);
-	zapette(const zapette & ref) = default;
-	zapette(zapette && ref) noexcept = default;
-	zapette & operator = (const zapette & ref) = default;
-	zapette & operator = (zapette && ref) noexcept = default;
+	zapette(const zapette & ref) = delete;
+	zapette(zapette && ref) noexcept = delete;
+	zapette & operator = (const zapette & ref) = delete;
+	zapette & operator = (zapette && ref) noexcept = delete;
         ~zapette();
 
             // inherited methods from generic_file
 	virtual bool skippable(skippability direction, const infinint & amount) override { return true; };
         virtual bool skip(const infinint &pos) override;
-        virtual bool skip_to_eof() override { if(is_terminated()) throw SRC_BUG; position = file_size; return true; };
+        virtual bool skip_to_eof() override { if(is_terminated()) throw SRC_BUG; position = file_size; ahead = 0; return true; };
         virtual bool skip_relative(S_I x) override;
         virtual infinint get_position() const override { if(is_terminated()) throw SRC_BUG; return position; };
 
@@ -92,17 +95,44 @@ namespace libdar
 	infinint get_non_first_slice_header_size() const;
 
     protected:
-	virtual void inherited_read_ahead(const infinint & amount) override {}; // optimization will be done when zapette will use the messaging_encode/decode exchange format
+	virtual void inherited_read_ahead(const infinint & amount) override;
         virtual U_I inherited_read(char *a, U_I size) override;
         virtual void inherited_write(const char *a, U_I size) override;
 	virtual void inherited_sync_write() override {};
-	virtual void inherited_flush_read() override {};
+	virtual void inherited_flush_read() override;
 	virtual void inherited_terminate() override;
 
     private:
+	    /// a data request sent to the slave_zapette which answer has not yet been read
+	struct pending
+	{
+	    char serial_num;
+	    infinint offset;
+	    U_32 size;
+	};
+
         generic_file *in, *out;
         infinint position, file_size;
         char serial_counter;
+	U_I version;                      ///< protocol version agreed with the slave_zapette
+	std::deque<pending> outstanding;  ///< data requests sent and not yet answered, in the order they have been sent
+	infinint requested;               ///< offset following the last outstanding request
+	infinint ahead;                   ///< offset up to which data has to be read ahead
+	char *buffer;                     ///< data received ahead of the reader
+	U_32 buffer_len;                  ///< amount of data in buffer
+	infinint buffer_offset;           ///< offset of the data in buffer
+
+	    /// agree with the slave_zapette on the protocol version to use
+	void negotiate();
+
+	    /// send data requests up to the given offset or the read ahead one, as much as the window allows (version 2)
+	void send_requests(const infinint & wanted);
+
+	    /// read the answer of an outstanding request to the given location and return the amount of data received (version 2)
+	U_32 receive(const pending & req, char *data);
+
+	    /// read and forget the answers of all outstanding requests (version 2)
+	void drop_outstanding();
 
 	    /// wrapped formatted method to communicate with the slave_zapette located behind the pair of pipes (= tuyau)
 
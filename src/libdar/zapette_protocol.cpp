@@ -49,47 +49,40 @@ using namespace std;
 namespace libdar
 {
 
-    void request::write(generic_file *f)
-    {
-        U_16 tmp = htons(size);
+    static void write_size(generic_file *f, U_32 size, U_I version);
+    static U_32 read_size(generic_file *f, U_I version);
 
+    void request::write(generic_file *f, U_I version)
+    {
         f->write(&serial_num, 1);
         offset.dump(*f);
-        f->write((char *)&tmp, sizeof(tmp));
+	write_size(f, size, version);
 	if(size == REQUEST_SIZE_SPECIAL_ORDER && offset == REQUEST_OFFSET_CHANGE_CONTEXT_STATUS)
 	    tools_write_string(*f, info);
     }
 
-    void request::read(generic_file *f)
+    void request::read(generic_file *f, U_I version)
     {
-        U_16 tmp;
-        U_16 pas;
-
-        if(f->read(&serial_num, 1) == 0)
-            throw Erange("request::read", gettext("Partial request received, aborting\n"));
 	if(f == nullptr)
 	    throw SRC_BUG;
+        if(f->read(&serial_num, 1) == 0)
+            throw Erange("request::read", gettext("Partial request received, aborting\n"));
         offset = infinint(*f);
-        pas = 0;
-        while(pas < sizeof(tmp))
-            pas += f->read((char *)&tmp+pas, sizeof(tmp)-pas);
-        size = ntohs(tmp);
+	size = read_size(f, version);
 	if(size == REQUEST_SIZE_SPECIAL_ORDER && offset == REQUEST_OFFSET_CHANGE_CONTEXT_STATUS)
 	    tools_read_string(*f, info);
 	else
 	    info = "";
     }
 
-    void answer::write(generic_file *f, char *data)
+    void answer::write(generic_file *f, char *data, U_I version)
     {
-        U_16 tmp = htons(size);
-
         f->write(&serial_num, 1);
         f->write(&type, 1);
         switch(type)
         {
         case ANSWER_TYPE_DATA:
-            f->write((char *)&tmp, sizeof(tmp));
+	    write_size(f, size, version);
             if(data != nullptr)
                 f->write(data, size);
             else
@@ -104,37 +97,36 @@ namespace libdar
         }
     }
 
-    void answer::read(generic_file *f, char *data, U_16 max)
+    void answer::read(generic_file *f, char *data, U_32 max, U_I version)
     {
-        U_16 tmp;
-        U_16 pas;
+        U_32 pas;
 
+	if(f == nullptr)
+	    throw SRC_BUG;
         f->read(&serial_num, 1);
         f->read(&type, 1);
         switch(type)
         {
         case ANSWER_TYPE_DATA:
+	    size = read_size(f, version);
             pas = 0;
-            while(pas < sizeof(tmp))
-                pas += f->read((char *)&tmp+pas, sizeof(tmp)-pas);
-            size = ntohs(tmp);
-            pas = 0;
-            while(pas < size)
-                pas += f->read(data+pas, size-pas);
+            while(pas < size && pas < max)
+                pas += f->read(data+pas, (size < max ? size : max) - pas);
 
             if(size > max) // need to drop the remaining data
             {
-                char black_hole;
-
-                for(tmp = max; tmp < size; ++tmp)
-                    f->read(&black_hole, 1);
-                    // might not be very performant code
+                char black_hole[1024];
+		U_32 step;
+
+                while(pas < size)
+		{
+		    step = size - pas > sizeof(black_hole) ? sizeof(black_hole) : size - pas;
+		    pas += f->read(black_hole, step);
+		}
             }
             arg = 0;
             break;
         case ANSWER_TYPE_INFININT:
-	    if(f == nullptr)
-		throw SRC_BUG;
             arg = infinint(*f);
             size = 0;
             break;
@@ -143,4 +135,45 @@ namespace libdar
         }
     }
 
+    static void write_size(generic_file *f, U_32 size, U_I version)
+    {
+	if(version == PROTOCOL_VERSION_1)
+	{
+	    U_16 tmp;
+
+	    if(size > (U_16)(~0))
+		throw SRC_BUG;
+	    tmp = htons(size);
+	    f->write((char *)&tmp, sizeof(tmp));
+	}
+	else
+	{
+	    U_32 tmp = htonl(size);
+
+	    f->write((char *)&tmp, sizeof(tmp));
+	}
+    }
+
+    static U_32 read_size(generic_file *f, U_I version)
+    {
+	U_I pas = 0;
+
+	if(version == PROTOCOL_VERSION_1)
+	{
+	    U_16 tmp;
+
+	    while(pas < sizeof(tmp))
+		pas += f->read((char *)&tmp+pas, sizeof(tmp)-pas);
+	    return ntohs(tmp);
+	}
+	else
+	{
+	    U_32 tmp;
+
+	    while(pas < sizeof(tmp))
+		pas += f->read((char *)&tmp+pas, sizeof(tmp)-pas);
+	    return ntohl(tmp);
+	}
+    }
+
 } // end of namespace
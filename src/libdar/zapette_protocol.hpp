@@ -44,6 +44,23 @@ namespace libdar
 	/// \addtogroup Private
         /// @{
 
+	/// protocol versions
+
+	/// version 1 transfers at most 65535 bytes per request and the zapette waits for
+	/// the answer of a request before sending the next one. Version 2 allows larger
+	/// requests and several outstanding requests, the slave answering them in order.
+	/// Just after the file size has been asked, the zapette sends a data request one byte
+	/// past the end of the data, of REQUEST_SIZE_PROTOCOL_PROBE size plus the highest
+	/// version it supports: a version 1 slave returns no data as this is beyond the end of
+	/// file, a more recent slave returns a single byte holding the version both will use
+	/// for the following exchanges, the lowest of their highest supported version.
+
+    constexpr U_I PROTOCOL_VERSION_1 = 1;
+    constexpr U_I PROTOCOL_VERSION_2 = 2;
+    constexpr U_I PROTOCOL_VERSION_LAST = PROTOCOL_VERSION_2;
+    constexpr U_32 REQUEST_SIZE_PROTOCOL_PROBE = 0x5A00;
+    constexpr U_32 REQUEST_SIZE_MAX_V2 = 1048576;
+
     constexpr unsigned char ANSWER_TYPE_DATA = 'D';
     constexpr unsigned char ANSWER_TYPE_INFININT = 'I';
 
@@ -59,23 +76,23 @@ namespace libdar
     struct request
     {
         char serial_num;
-        U_16 size; // size or REQUEST_SIZE_SPECIAL_ORDER
+        U_32 size; // size or REQUEST_SIZE_SPECIAL_ORDER, at most 65535 with PROTOCOL_VERSION_1
         infinint offset; // offset or REQUEST_OFFSET_END_TRANSMIT or REQUEST_OFFSET_GET_FILESIZE, REQUEST_OFFSET_* ...
 	std::string info; // new contextual_status
 
-        void write(generic_file *f); // master side
-        void read(generic_file *f);  // slave side
+        void write(generic_file *f, U_I version); // master side
+        void read(generic_file *f, U_I version);  // slave side
     };
 
     struct answer
     {
         char serial_num;
         char type;
-        U_16 size;
+        U_32 size;
         infinint arg;
 
-        void write(generic_file *f, char *data); // slave side
-        void read(generic_file *f, char *data, U_16 max);  // master side
+        void write(generic_file *f, char *data, U_I version); // slave side
+        void read(generic_file *f, char *data, U_32 max, U_I version);  // master side
     };
 
 	/// @}
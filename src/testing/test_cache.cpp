@@ -53,6 +53,10 @@ extern "C"
 
 }
 
+#include <chrono>
+#include <memory>
+#include <random>
+
 #include "libdar.hpp"
 #include "cache.hpp"
 #include "shell_interaction.hpp"
@@ -61,27 +65,34 @@ extern "C"
 #include "shell_interaction.hpp"
 #include "cygwin_adapt.hpp"
 #include "fichier_local.hpp"
+#include "tools.hpp"
 
 using namespace libdar;
 using namespace std;
 
 void f1();
 void f2();
+void f3(U_I mebi);
+void f3_sub(const char *data, U_I length, U_I cache_size);
 
 static shared_ptr<user_interaction>ui;
 
-int main()
+int main(int argc, char *argv[])
 {
     U_I maj, med, min;
+    U_I mebi = 64;
 
     get_version(maj, med, min);
     ui.reset(new (nothrow) shell_interaction(cout, cerr, false));
     if(!ui)
 	cout << "ERREUR !" << endl;
+    if(argc > 1 && !tools_my_atoi(argv[1], mebi))
+	cout << "usage: " << argv[0] << " [benchmark size in MiB]" << endl;
     try
     {
 	f1();
 	f2();
+	f3(mebi);
     }
     catch(Ebug & e)
     {
@@ -145,5 +156,86 @@ void f2()
     c.write("*",1);
 }
 
+void f3(U_I mebi)
+{
+	// throughput of the cache in shift mode (used over pipes) for different
+	// cache sizes, with small reads and writes and short backward skips
+
+    U_I length = mebi * 1024 * 1024;
+    unique_ptr<char[]> data(new char[length]);
+    mt19937 gen(1);
+
+    for(U_I i = 0; i < length; ++i)
+	data[i] = (char)(gen() & 0xFF);
+
+    f3_sub(data.get(), length, 102400);
+    f3_sub(data.get(), length, 1024*1024);
+    f3_sub(data.get(), length, 8*1024*1024);
+}
+
+void f3_sub(const char *data, U_I length, U_I cache_size)
+{
+    unique_ptr<char[]> back(new char[length]);
+    mt19937 gen(2);
+    chrono::steady_clock::time_point start;
+    double write_time, read_time;
+    bool ok;
+    U_I pos;
 
+    {
+	fichier_local file(ui, "cache_bench", gf_write_only, 0666, false, true, false);
+	cache c(file, true, cache_size);
+
+	start = chrono::steady_clock::now();
+	pos = 0;
+	while(pos < length)
+	{
+	    U_I step = 1 + gen() % 2048;
+
+	    if(step > length - pos)
+		step = length - pos;
+	    c.write(data + pos, step);
+	    pos += step;
+	}
+	c.terminate();
+	write_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
 
+    {
+	fichier_local file(ui, "cache_bench", gf_read_only, 0666, false, false, false);
+	cache c(file, true, cache_size);
+	U_I count = 0;
+
+	start = chrono::steady_clock::now();
+	pos = 0;
+	while(pos < length)
+	{
+	    U_I step = 1 + gen() % 2048;
+
+	    if(++count % 64 == 0)
+	    {
+		U_I backward = gen() % 16384;
+
+		if(backward > pos)
+		    backward = pos;
+		if(c.skippable(generic_file::skip_backward, backward))
+		{
+		    c.skip_relative(-(S_I)backward);
+		    pos -= backward;
+		}
+	    }
+
+	    if(step > length - pos)
+		step = length - pos;
+	    if(c.read(back.get() + pos, step) != step)
+		break;
+	    pos += step;
+	}
+	read_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	ok = pos == length && memcmp(data, back.get(), length) == 0;
+    }
+
+    cout << "cache size " << cache_size << ": " << (ok ? "OK" : "DATA MISMATCH")
+	 << ", write: " << length / write_time / 1e6 << " MB/s"
+	 << ", read: " << length / read_time / 1e6 << " MB/s" << endl;
+}
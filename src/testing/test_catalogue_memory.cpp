@@ -0,0 +1,239 @@
+//*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+
+    // measures the memory used by a catalogue read from an archive: the
+    // "build" mode dumps a synthetic catalogue of <dirs> directories of
+    // <files> saved plain files each, the names of which are at least <length>
+    // characters long (when "fsa" is given, each file also carries Linux
+    // Filesystem Specific Attributes as a backup of an ext4 filesystem
+    // does), the "load" mode reads it back and destroys it
+    // <rounds> times and reports the time taken and the resident memory
+    // of the process.
+    // for example:
+    //   test_catalogue_memory build 1000 1000 8
+    //   test_catalogue_memory build 1000 1000 8 fsa
+    //   test_catalogue_memory load
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif
+#if HAVE_STRING_H
+#include <string.h>
+#endif
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+} // end extern "C"
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+
+#include "libdar.hpp"
+#include "catalogue.hpp"
+#include "cat_all_entrees.hpp"
+#include "shell_interaction.hpp"
+#include "macro_tools.hpp"
+#include "fichier_local.hpp"
+#include "memory_file.hpp"
+#include "compressor.hpp"
+#include "pile.hpp"
+#include "tools.hpp"
+#include "crc.hpp"
+
+using namespace std;
+using namespace libdar;
+
+#define FIC1 "test/catalogue_memory.bin"
+
+void usage(const char *argv0);
+void f1(U_I dirs, U_I files, U_I length, bool fsa);
+void f2(U_I rounds);
+string name_of(const char *prefix, U_I num, U_I length);
+U_I resident_kib();
+double since(const chrono::steady_clock::time_point & start);
+
+static shared_ptr<user_interaction> ui;
+
+int main(int argc, char *argv[])
+{
+    U_I maj, med, min;
+    bool build = (argc >= 4 && argc <= 6) && strcmp(argv[1], "build") == 0;
+    bool load = (argc == 2 || argc == 3) && strcmp(argv[1], "load") == 0;
+
+    if(!build && !load)
+    {
+	usage(argv[0]);
+	return 1;
+    }
+
+    ui.reset(new (nothrow) shell_interaction(cout, cerr, false));
+    if(!ui)
+	return 2;
+
+    try
+    {
+	get_version(maj, med, min);
+	if(build)
+	    f1(atoi(argv[2]), atoi(argv[3]), argc > 4 ? atoi(argv[4]) : 0, argc > 5 && strcmp(argv[5], "fsa") == 0);
+	else
+	    f2(argc > 2 ? atoi(argv[2]) : 3);
+    }
+    catch(Egeneric & e)
+    {
+	cout << "Exception caught: " << e.get_message() << endl;
+	return 2;
+    }
+
+    ui.reset();
+    return 0;
+}
+
+void usage(const char *argv0)
+{
+    cout << "usage: " << argv0 << " build <dirs> <files per dir> [ <name length> [ fsa ] ]" << endl;
+    cout << "       " << argv0 << " load [ <rounds> ]" << endl;
+}
+
+void f1(U_I dirs, U_I files, U_I length, bool fsa)
+{
+    label data_name;
+    catalogue cat(ui, datetime(0), data_name);
+    pile stack;
+    pile_descriptor pdesc;
+    crc *sum = create_crc_from_size(tools_file_size_to_crc_size(1024));
+    filesystem_specific_attribute_list ext;
+    crc *fsa_sum = nullptr;
+
+	// files are recorded as saved, with a CRC and the location
+	// of their data, as in the catalogue of a full backup
+
+    ext.add(fsa_bool(fsaf_linux_extX, fsan_append_only, false));
+    ext.add(fsa_bool(fsaf_linux_extX, fsan_compressed, false));
+    ext.add(fsa_bool(fsaf_linux_extX, fsan_no_dump, false));
+    ext.add(fsa_bool(fsaf_linux_extX, fsan_immutable, false));
+    ext.add(fsa_bool(fsaf_linux_extX, fsan_noatime_update, false));
+    fsa_sum = create_crc_from_size(tools_file_size_to_crc_size(ext.storage_size()));
+
+    data_name.clear();
+    for(U_I d = 0; d < dirs; ++d)
+    {
+	cat.add(new cat_directory(1000, 1000, 0755, datetime(1), datetime(2), datetime(3), name_of("dir", d, length), 0));
+	for(U_I f = 0; f < files; ++f)
+	{
+	    cat_file *ent = new cat_file(1000, 1000, 0644, datetime(1), datetime(2), datetime(3), name_of("file", f, length), path("."), 1024, 0, false);
+	    ent->set_offset((d * files + f) * 1024);
+	    ent->set_storage_size(1024);
+	    ent->set_crc(*sum);
+	    if(fsa)
+	    {
+		ent->fsa_set_saved_status(fsa_saved_status::full);
+		ent->fsa_attach(new filesystem_specific_attribute_list(ext));
+		ent->fsa_set_offset((d * files + f) * 1024 + 1024);
+		ent->fsa_set_crc(*fsa_sum);
+		ent->fsa_detach();
+	    }
+	    cat.add(ent);
+	}
+	cat.add(new cat_eod());
+    }
+    delete sum;
+    delete fsa_sum;
+
+    unlink(FIC1);
+    stack.push(new fichier_local(ui, FIC1, gf_write_only, 0644, false, true, false));
+    stack.push(new compressor(compression::none, *stack.top(), 1));
+    pdesc = & stack;
+    cat.dump(pdesc);
+    stack.sync_write();
+
+    cout << dirs * files + dirs << " entries dumped to " << FIC1 << endl;
+}
+
+void f2(U_I rounds)
+{
+    label data_name;
+    fichier_local src(FIC1);
+    memory_file *mem = new memory_file();
+    pile stack;
+    pile_descriptor pdesc;
+
+	// the dump is read from memory for the load time to
+	// be driven by the construction of the entries
+
+    data_name.clear();
+    src.copy_to(*mem);
+    stack.push(mem);
+    stack.push(new compressor(compression::none, *mem, 1));
+    pdesc = & stack;
+
+    cout << "resident memory before loading: " << resident_kib() << " KiB" << endl;
+
+    for(U_I r = 0; r < rounds; ++r)
+    {
+	chrono::steady_clock::time_point start;
+	catalogue *cat;
+	double load, destroy;
+	U_I loaded;
+
+	stack.skip(0);
+	start = chrono::steady_clock::now();
+	cat = new catalogue(ui, pdesc, macro_tools_supported_version, compression::none, false, data_name, false);
+	load = since(start);
+	loaded = resident_kib();
+
+	start = chrono::steady_clock::now();
+	delete cat;
+	destroy = since(start);
+
+	cout << "round " << r << ": load " << load << " s, destroy " << destroy << " s, resident memory "
+	     << loaded << " KiB loaded, " << resident_kib() << " KiB destroyed" << endl;
+    }
+}
+
+string name_of(const char *prefix, U_I num, U_I length)
+{
+    string ret = tools_printf("%s%d", prefix, num);
+
+    if(ret.size() < length)
+	ret += string(length - ret.size(), '_');
+
+    return ret;
+}
+
+U_I resident_kib()
+{
+    ifstream statm("/proc/self/statm");
+    U_I size = 0, resident = 0;
+
+    statm >> size >> resident;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+double since(const chrono::steady_clock::time_point & start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
@@ -37,18 +37,23 @@ extern "C"
 } // end extern "C"
 
 #include <memory>
+#include <chrono>
 #include "libdar.hpp"
 #include "compressor.hpp"
 #include "integers.hpp"
 #include "cygwin_adapt.hpp"
 #include "shell_interaction.hpp"
 #include "fichier_local.hpp"
+#include "deci.hpp"
+#include "crc.hpp"
 
 using namespace libdar;
 using namespace std;
 
 static shared_ptr<user_interaction> ui;
 static void f1();
+static void f2();
+static void f2_sub(compression algo, U_I num_workers, U_I block_size = 64*1024);
 
 int main()
 {
@@ -60,6 +65,7 @@ int main()
     if(!ui)
 	cout << "ERREUR !" << endl;
     f1();
+    f2();
     ui.reset();
 }
 
@@ -161,3 +167,91 @@ static void f1()
     unlink("tutu.bz");
     unlink("tutu.bz.bak");
 }
+
+static void f2()
+{
+    f2_sub(compression::gzip, 1);
+    f2_sub(compression::gzip, 2);
+    f2_sub(compression::gzip, 4);
+    f2_sub(compression::bzip2, 1);
+    f2_sub(compression::bzip2, 4);
+    f2_sub(compression::xz, 1);
+    f2_sub(compression::xz, 4);
+    f2_sub(compression::zstd, 1);
+    f2_sub(compression::zstd, 4);
+    f2_sub(compression::zstd_long, 4);
+    f2_sub(compression::lz4, 1);
+    f2_sub(compression::lz4, 4);
+
+	// stream mode (no block), lz4 is expected to silently switch to block mode
+
+    f2_sub(compression::gzip, 1, 0);
+    f2_sub(compression::lzo, 1, 0);
+    f2_sub(compression::xz, 1, 0);
+    f2_sub(compression::zstd, 1, 0);
+    f2_sub(compression::zstd_long, 1, 0);
+    f2_sub(compression::lz4, 1, 0);
+}
+
+static void f2_sub(compression algo, U_I num_workers, U_I block_size)
+{
+    infinint pos2, size, zipped;
+    crc *value = nullptr;
+
+    try
+    {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	double elapsed;
+
+	    // compressing twice the same data in block mode, separated by a flush
+
+	{
+	    fichier_local src = fichier_local(ui, "toto", gf_read_only, 0666, false, false, false);
+	    fichier_local dst = fichier_local(ui, "tutu.blk", gf_write_only, 0666, false, true, false);
+	    compressor comp(algo, dst, 6, block_size, num_workers);
+
+	    src.copy_to(comp);
+	    comp.sync_write();
+	    pos2 = comp.get_position();
+	    src.skip(0);
+	    src.copy_to(comp);
+	    comp.sync_write();
+	    size = src.get_position();
+	}
+
+	elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	cout << compression2string(algo) << " with " << num_workers << " worker(s) and block size " << block_size << ": compression " << elapsed << " s";
+
+	    // reading back each block sequence and comparing with the original data
+
+	start = chrono::steady_clock::now();
+	{
+	    fichier_local ref = fichier_local(ui, "toto", gf_read_only, 0666, false, false, false);
+	    fichier_local src = fichier_local(ui, "tutu.blk", gf_read_only, 0666, false, false, false);
+	    compressor comp(algo, src, 6, block_size, num_workers);
+
+	    zipped = src.get_size();
+
+	    if(comp.diff(ref, 0, 0, 1, value))
+		cout << " [FIRST SEQUENCE DIFFERS]";
+	    delete value;
+	    value = nullptr;
+
+	    comp.skip(pos2);
+	    ref.skip(0);
+	    if(comp.diff(ref, 0, 0, 1, value))
+		cout << " [SECOND SEQUENCE DIFFERS]";
+	    delete value;
+	    value = nullptr;
+	}
+	elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	cout << ", decompression " << elapsed << " s (" << libdar::deci(size).human() << " bytes twice, " << libdar::deci(zipped).human() << " bytes compressed)" << endl;
+    }
+    catch(Egeneric & e)
+    {
+	if(value != nullptr)
+	    delete value;
+        cerr << e.dump_str();
+    }
+    unlink("tutu.blk");
+}
@@ -0,0 +1,141 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <memory>
+#include <random>
+#include "libdar.hpp"
+#include "crc.hpp"
+#include "tools.hpp"
+
+using namespace libdar;
+using namespace std;
+
+    // checks the crc computed by libdar against a plain byte by byte
+    // computation for many widths, alignments and split of the data,
+    // then reports the throughput of crc computation for each width.
+    // usage: test_crc [benchmark size in MiB]
+
+static void f1(const char *buffer, U_I length);
+static void f2(const char *buffer, U_I length);
+static string reference_crc(const char *buffer, U_I length, U_I width);
+
+int main(int argc, char *argv[])
+{
+    U_I maj, med, min;
+    U_I mebi = 256;
+    unique_ptr<char[]> buffer;
+    U_I length;
+
+    get_version(maj, med, min);
+    if(argc > 1 && !tools_my_atoi(argv[1], mebi))
+	cout << "invalid benchmark size: " << argv[1] << endl;
+    length = mebi * 1024 * 1024;
+    if(length < 65536)
+	length = 65536;
+
+    try
+    {
+	mt19937 gen(1);
+
+	buffer.reset(new char[length]);
+	for(U_I i = 0; i < length; ++i)
+	    buffer[i] = (char)(gen() & 0xFF);
+
+	f1(buffer.get(), 65536);
+	f2(buffer.get(), length);
+    }
+    catch(Egeneric & e)
+    {
+	cerr << e.dump_str();
+    }
+
+    return 0;
+}
+
+static void f1(const char *buffer, U_I length)
+{
+    const U_I widths[] = { 1, 2, 3, 4, 5, 7, 8, 12, 16, 20, 24, 28, 32, 36, 40, 64, 100, 4000 };
+    const U_I chunks[] = { 1, 3, 7, 64, 1000, 65536 };
+    U_I errors = 0;
+    U_I checks = 0;
+
+    for(U_I width : widths)
+	for(U_I align = 0; align < 8; ++align)
+	    for(U_I chunk : chunks)
+	    {
+		unique_ptr<crc> val(create_crc_from_size(width));
+		const char *data = buffer + align;
+		U_I len = length - 8;
+		U_I done = 0;
+
+		while(done < len)
+		{
+		    U_I step = len - done < chunk ? len - done : chunk;
+		    val->compute(data + done, step);
+		    done += step;
+		}
+
+		if(val->crc2str() != reference_crc(data, len, width))
+		{
+		    cout << "FAILED: width = " << width << " alignment = " << align << " chunk = " << chunk << endl;
+		    ++errors;
+		}
+		++checks;
+	    }
+
+    cout << checks << " crc checked, " << errors << " error(s)" << endl;
+}
+
+static void f2(const char *buffer, U_I length)
+{
+    const U_I widths[] = { 1, 4, 8, 12, 16, 32, 64 };
+
+    for(U_I width : widths)
+    {
+	unique_ptr<crc> val(create_crc_from_size(width));
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	double elapsed;
+
+	for(U_I i = 0; i < 4; ++i)
+	    val->compute(buffer, length);
+	elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	cout << "width " << width << ": " << (4.0 * length) / elapsed / 1e9 << " GB/s" << endl;
+    }
+}
+
+static string reference_crc(const char *buffer, U_I length, U_I width)
+{
+    unique_ptr<unsigned char[]> field(new unsigned char[width]());
+    ostringstream ret;
+
+    for(U_I i = 0; i < length; ++i)
+	field[i % width] ^= (unsigned char)buffer[i];
+
+    for(U_I i = 0; i < width; ++i)
+	ret << hex << ((field[i] & 0xF0) >> 4) << (field[i] & 0x0F);
+
+    return ret.str();
+}
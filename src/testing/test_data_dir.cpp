@@ -0,0 +1,119 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include <iostream>
+#include <chrono>
+#include "libdar.hpp"
+#include "data_dir.hpp"
+#include "cat_all_entrees.hpp"
+#include "shell_interaction.hpp"
+#include "tools.hpp"
+#include "deci.hpp"
+
+using namespace libdar;
+using namespace std;
+
+    // adds to a data_dir the equivalent of a synthetic catalogue of "total"
+    // entries, spread in directories of "per_dir" entries each, then adds it
+    // a second time as if a second archive had been added to the database.
+    // usage: test_data_dir [total entries] [entries per directory]
+
+static void f1(U_I total, U_I per_dir);
+static void add_catalogue(data_dir & root, archive_num num, U_I total, U_I per_dir);
+
+int main(int argc, char *argv[])
+{
+    U_I maj, med, min;
+    U_I total = 5000000;
+    U_I per_dir = 100000;
+
+    get_version(maj, med, min);
+    if(argc > 1 && !tools_my_atoi(argv[1], total))
+	cout << "invalid number of entries: " << argv[1] << endl;
+    if(argc > 2 && !tools_my_atoi(argv[2], per_dir))
+	cout << "invalid number of entries per directory: " << argv[2] << endl;
+    if(per_dir == 0)
+	per_dir = 1;
+
+    try
+    {
+	f1(total, per_dir);
+    }
+    catch(Egeneric & e)
+    {
+	cerr << e.dump_str();
+    }
+
+    return 0;
+}
+
+static void f1(U_I total, U_I per_dir)
+{
+    data_dir root("root");
+    const data_tree *found = nullptr;
+
+    for(archive_num num = 1; num <= 2; ++num)
+    {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	double elapsed;
+
+	add_catalogue(root, num, total, per_dir);
+	elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	cout << "adding archive " << num << " (" << total << " entries, " << per_dir << " per directory): " << elapsed << " s" << endl;
+    }
+
+    if(!root.data_tree_find(path("dir_0/file_0"), found) || found == nullptr)
+	cout << "FAILED to find dir_0/file_0" << endl;
+    if(root.data_tree_find(path("dir_0/nonexistent"), found))
+	cout << "FOUND nonexistent entry" << endl;
+}
+
+static void add_catalogue(data_dir & root, archive_num num, U_I total, U_I per_dir)
+{
+    datetime date = datetime(infinint(num));
+    cat_directory dir(1000, 1000, 0755, date, date, date, "dir", 0);
+    cat_file file(1000, 1000, 0644, date, date, date, "file", path("."), 1024, 0, false);
+    U_I dir_num = 0;
+    U_I added = 0;
+
+    dir.set_saved_status(saved_status::saved);
+    file.set_saved_status(saved_status::saved);
+
+    while(added < total)
+    {
+	data_dir *sub = nullptr;
+	string dir_name = "dir_" + libdar::deci(dir_num++).human();
+
+	dir.change_name(dir_name);
+	root.add(&dir, num);
+	sub = dynamic_cast<data_dir *>(const_cast<data_tree *>(root.read_child(dir_name)));
+	if(sub == nullptr)
+	    throw SRC_BUG;
+
+	for(U_I i = 0; i < per_dir && added < total; ++i, ++added)
+	{
+	    file.change_name("file_" + libdar::deci(i).human());
+	    sub->add(&file, num);
+	}
+    }
+}
@@ -28,11 +28,17 @@ extern "C"
 #endif
 } // end extern "C"
 
+#include <chrono>
+#include <memory>
+#include <random>
+
 #include "libdar.hpp"
 #include "escape.hpp"
 #include "cygwin_adapt.hpp"
 #include "shell_interaction.hpp"
 #include "fichier_local.hpp"
+#include "cache.hpp"
+#include "tools.hpp"
 
 using namespace libdar;
 using namespace std;
@@ -41,18 +47,24 @@ static shared_ptr<user_interaction> ui;
 
 void f1();
 void f2();
+void f3(U_I mebi);
+void f3_sub(const char *label, const char *data, U_I length);
 
-int main()
+int main(int argc, char *argv[])
 {
     U_I maj, med, min;
+    U_I mebi = 64;
 
     get_version(maj, med, min);
     ui.reset(new (nothrow) shell_interaction(cout, cerr, false));
     if(!ui)
 	cout << "ERREUR !" << endl;
+    if(argc > 1 && !tools_my_atoi(argv[1], mebi))
+	cout << "usage: " << argv[0] << " [benchmark size in MiB]" << endl;
 
     f1();
     f2();
+    f3(mebi);
 }
 
 void f1()
@@ -120,3 +132,65 @@ void f2()
 	cout << "NOK" << endl;
     cout << libdar::deci(tested.get_position()).human() << endl;
 }
+
+void f3(U_I mebi)
+{
+	// throughput of the escape layer, first with random data, then with
+	// data where the first bytes of the escape sequence are frequent
+
+    const unsigned char sequence[] = { 0xAD, 0xFD, 0xEA, 0x77, 0x21 };
+    U_I length = mebi * 1024 * 1024;
+    unique_ptr<char[]> data(new char[length]);
+    mt19937 gen(1);
+
+    for(U_I i = 0; i < length; ++i)
+	data[i] = (char)(gen() & 0xFF);
+    f3_sub("random data", data.get(), length);
+
+    for(U_I i = 0; i + sizeof(sequence) < length; i += 61 + (gen() % 64))
+	(void)memcpy(&data[i], sequence, 1 + gen() % sizeof(sequence));
+    f3_sub("data with frequent escape sequences", data.get(), length);
+}
+
+void f3_sub(const char *label, const char *data, U_I length)
+{
+    const U_I block = 65536;
+    set<escape::sequence_type> nojump;
+    unique_ptr<char[]> back(new char[length]);
+    chrono::steady_clock::time_point start;
+    double write_time, read_time;
+    U_I lu = 0;
+
+    {
+	fichier_local file(ui, "escape_bench", gf_write_only, 0666, false, true, false);
+	cache below(file, false);
+	escape tested(&below, nojump);
+
+	start = chrono::steady_clock::now();
+	for(U_I i = 0; i < length; i += block)
+	    tested.write(data + i, length - i < block ? length - i : block);
+	tested.add_mark_at_current_position(escape::seqt_file);
+	tested.terminate();
+	below.terminate();
+	write_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    {
+	fichier_local file(ui, "escape_bench", gf_read_only, 0666, false, false, false);
+	cache below(file, false);
+	escape tested(&below, nojump);
+	U_I step;
+
+	start = chrono::steady_clock::now();
+	do
+	{
+	    step = tested.read(back.get() + lu, length - lu < block ? length - lu : block);
+	    lu += step;
+	}
+	while(step > 0 && lu < length);
+	read_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    cout << label << ": " << (lu == length && memcmp(data, back.get(), length) == 0 ? "OK" : "DATA MISMATCH") << endl;
+    cout << "   write: " << length / write_time / 1e6 << " MB/s, read: " << length / read_time / 1e6 << " MB/s" << endl;
+}
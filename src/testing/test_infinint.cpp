@@ -41,6 +41,7 @@ extern "C"
 } // end extern "C"
 
 #include <iostream>
+#include <chrono>
 
 #include "libdar.hpp"
 #include "integers.hpp"
@@ -52,6 +53,7 @@ extern "C"
 #include "generic_file.hpp"
 #include "fichier_local.hpp"
 #include "tools.hpp"
+#include "memory_file.hpp"
 
 using namespace libdar;
 using namespace std;
@@ -59,20 +61,27 @@ using namespace std;
 static void routine1();
 static void routine2();
 static void routine3();
+static void routine4();
+static void routine5(U_I loops);
 
 static shared_ptr<user_interaction>ui;
 
-int main()
+int main(int argc, char *argv[])
 {
     U_I maj, med, min;
+    U_I loops = 1000000;
 
     get_version(maj, med, min);
     ui.reset(new (nothrow) shell_interaction(cout, cerr, false));
     if(ui == nullptr)
 	cout << "ERREUR !" << endl;
+    if(argc > 1 && !tools_my_atoi(argv[1], loops))
+	cout << "usage: " << argv[0] << " [benchmark loops]" << endl;
     routine1();
     routine2();
     routine3();
+    routine4();
+    routine5(loops);
     ui.reset();
 }
 
@@ -224,3 +233,84 @@ static void routine3()
     res = tools_rounded_cube_root(c);
     res = 1;
 }
+
+static void routine4()
+{
+	// values around the 64 bits boundary, where the
+	// inline representation of infinint switches to storage
+
+    infinint max64 = ~(U_64)(0);
+    infinint val;
+    memory_file mem;
+    U_I count = 0;
+
+    try
+    {
+	val = max64;
+	++val;
+	ui->message(libdar::deci(val).human());  // 2^64
+	val -= 1;
+	ui->message(string(val == max64 ? "ok" : "FAILED") + " overflow then back by subtraction");
+	val = max64;
+	val *= 16;
+	val >>= 4;
+	ui->message(string(val == max64 ? "ok" : "FAILED") + " overflow then back by shift");
+	val = max64;
+	val <<= (U_32)1;
+	val /= 2;
+	ui->message(string(val == max64 ? "ok" : "FAILED") + " overflow then back by division");
+	val = max64;
+	val += max64;
+	ui->message(string(val % max64 == 0 ? "ok" : "FAILED") + " modulo over 64 bits");
+	ui->message(string((val & max64) + 1 == max64 ? "ok" : "FAILED") + " bitwise and over 64 bits");
+
+	    // dump and read back values in and out of the inline representation
+
+	for(val = 1; val < max64 * infinint(65536); val *= 3)
+	{
+	    mem.reset();
+	    val.dump(mem);
+	    (val + 1).dump(mem);
+	    mem.skip(0);
+	    if(infinint(mem) != val || infinint(mem) != val + 1)
+		ui->message(string("FAILED round trip for ") + libdar::deci(val).human());
+	    ++count;
+	}
+	ui->message(string("dump/read checked for ") + libdar::deci(infinint(count)).human() + " values");
+    }
+    catch(Elimitint & e)
+    {
+	ui->message(e.get_message());
+    }
+}
+
+static void routine5(U_I loops)
+{
+	// micro-benchmark of the most frequent operations on small values
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    infinint sum = 0;
+    infinint tmp;
+    memory_file mem;
+
+    for(U_I i = 0; i < loops; ++i)
+    {
+	tmp = i;
+	tmp *= 3;
+	sum += tmp;
+	sum -= i;
+	if(sum < tmp)
+	    ++sum;
+    }
+
+    for(U_I i = 0; i < loops; ++i)
+    {
+	mem.reset();
+	infinint(i).dump(mem);
+	mem.skip(0);
+	tmp = infinint(mem);
+    }
+
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << loops << " loops in " << elapsed << " s (sum = " << sum << ")" << endl;
+}
@@ -35,9 +35,17 @@ extern "C"
 #if HAVE_FCNTL_H
 #include <fcntl.h>
 #endif
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif
+#if HAVE_STRING_H
+#include <string.h>
+#endif
 }
 
 #include <iostream>
+#include <fstream>
+#include <chrono>
 
 #include "libdar.hpp"
 #include "erreurs.hpp"
@@ -50,6 +58,8 @@ using namespace libdar;
 using namespace std;
 
 void f1(const shared_ptr<user_interaction> & dialog, const char *filename);
+void f2(const char *filename, U_I count);
+void f3(const mask_list & m, const deque<string> & names, bool expected, const char *what);
 
 int main(int argc, char *argv[])
 {
@@ -62,9 +72,14 @@ int main(int argc, char *argv[])
 
     try
     {
-	if(argc != 2)
-	    throw Erange("mask_list", tools_printf("usage: %s <filename>\n", argv[0]));
-	f1(dialog, argv[1]);
+	if(argc == 4 && strcmp(argv[1], "bench") == 0)
+	    f2(argv[2], atoi(argv[3]));
+	else
+	{
+	    if(argc != 2)
+		throw Erange("mask_list", tools_printf("usage: %s <filename>\n       %s bench <filename to create> <number of entries>\n", argv[0], argv[0]));
+	    f1(dialog, argv[1]);
+	}
     }
     catch(Egeneric & e)
     {
@@ -99,3 +114,58 @@ void f1(const shared_ptr<user_interaction> & dialog, const char *filename)
 	cout << (m.is_covered(tester) ? string("COVERED") : string("not covered")) << endl;
     }
 }
+
+void f2(const char *filename, U_I count)
+{
+    deque<string> listed, dirs, absent;
+    ofstream out(filename);
+    chrono::steady_clock::time_point start;
+
+    if(!out)
+	throw Erange("f2", tools_printf("cannot create %s", filename));
+
+	// entries like the ones of a home directory, with a relative path
+	// one time out of two to have the prefix added to them
+
+    srand(1);
+    for(U_I i = 0; i < count; ++i)
+    {
+	string dir = tools_printf("dir%d/sub%d", i % 997, (i / 997) % 53);
+	string name = tools_printf("%s/file%d.txt", dir.c_str(), i);
+
+	out << (i % 2 == 0 ? "/toto/tutu/" : "") << name << endl;
+	listed.push_back("/toto/tutu/" + name);
+	if(i < 997*53)
+	    dirs.push_back("/toto/tutu/" + dir);
+	absent.push_back(tools_printf("/toto/tutu/%s/file%d.bak", dir.c_str(), rand()));
+    }
+    out.close();
+
+    for(U_I c = 0; c < 2; ++c)
+    {
+	bool case_sensit = c == 0;
+
+	start = chrono::steady_clock::now();
+	mask_list m(filename, case_sensit, path("/toto/tutu"), true);
+	cout << (case_sensit ? "case sensitive" : "case insensitive") << " list of " << m.size() << " entries loaded in "
+	     << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s" << endl;
+
+	f3(m, listed, true, "listed entries");
+	f3(m, dirs, true, "directories leading to listed entries");
+	f3(m, absent, false, "absent entries");
+    }
+}
+
+void f3(const mask_list & m, const deque<string> & names, bool expected, const char *what)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    U_I errors = 0;
+
+    for(deque<string>::const_iterator it = names.begin(); it != names.end(); ++it)
+	if(m.is_covered(*it) != expected)
+	    ++errors;
+
+    cout << "    " << what << ": "
+	 << chrono::duration<double>(chrono::steady_clock::now() - start).count() * 1e9 / names.size()
+	 << " ns/lookup, " << errors << " error(s)" << endl;
+}
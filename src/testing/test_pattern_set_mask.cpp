@@ -0,0 +1,313 @@
+//*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+    // the "check" mode compares the result of pattern_set_mask with the one of
+    // an ou_mask of simple_mask and regular_mask on random expressions and
+    // strings, the locale is taken from the environment (try LC_ALL=C and a
+    // UTF-8 locale). The "bench" mode reports the time taken per entry name
+    // by both masks for 10, 100, 1000 and 10000 glob expressions like the
+    // ones found in exclusion lists, then for as many regular expressions.
+    // for example:
+    //   test_pattern_set_mask check 2000
+    //   test_pattern_set_mask bench
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif
+#if HAVE_STRING_H
+#include <string.h>
+#endif
+} // end extern "C"
+
+#include <iostream>
+#include <chrono>
+#include <clocale>
+
+#include "libdar.hpp"
+#include "pattern_set_mask.hpp"
+#include "tools.hpp"
+
+using namespace std;
+using namespace libdar;
+
+void usage(const char *argv0);
+void f1(U_I rounds);
+void f2();
+void f3(const deque<string> & names, const deque<string> & globs, const deque<string> & regex);
+string random_glob();
+string random_regex();
+string random_name();
+double since(const chrono::steady_clock::time_point & start);
+
+int main(int argc, char *argv[])
+{
+    U_I maj, med, min;
+    bool check = (argc == 2 || argc == 3) && strcmp(argv[1], "check") == 0;
+    bool bench = argc == 2 && strcmp(argv[1], "bench") == 0;
+
+    if(!check && !bench)
+    {
+	usage(argv[0]);
+	return 1;
+    }
+
+    setlocale(LC_ALL, "");
+
+    try
+    {
+	get_version(maj, med, min);
+	if(check)
+	    f1(argc > 2 ? atoi(argv[2]) : 1000);
+	else
+	    f2();
+    }
+    catch(Egeneric & e)
+    {
+	cout << "Exception caught: " << e.get_message() << endl;
+	return 2;
+    }
+
+    return 0;
+}
+
+void usage(const char *argv0)
+{
+    cout << "usage: " << argv0 << " check [ <rounds> ]" << endl;
+    cout << "       " << argv0 << " bench" << endl;
+}
+
+void f1(U_I rounds)
+{
+    U_I errors = 0;
+    U_I matched = 0;
+    U_I checked = 0;
+
+    srand(1);
+    for(U_I r = 0; r < rounds; ++r)
+    {
+	deque<string> globs, regex;
+	ou_mask ref;
+	bool case_sensit = rand() % 4 != 0;
+	U_I num = 1 + rand() % 20;
+
+	for(U_I i = 0; i < num; ++i)
+	{
+	    if(rand() % 5 != 0)
+	    {
+		globs.push_back(random_glob());
+		ref.add_mask(simple_mask(globs.back(), case_sensit));
+	    }
+	    else
+	    {
+		regex.push_back(random_regex());
+		try
+		{
+		    ref.add_mask(regular_mask(regex.back(), case_sensit));
+		}
+		catch(Erange & e)
+		{
+		    regex.pop_back();
+		}
+	    }
+	}
+
+	if(ref.size() == 0)
+	    continue;
+
+	pattern_set_mask set(globs, regex, case_sensit);
+
+	for(U_I s = 0; s < 200; ++s)
+	{
+	    string name = random_name();
+	    bool expected = ref.is_covered(name);
+
+	    ++checked;
+	    if(expected)
+		++matched;
+	    if(set.is_covered(name) != expected)
+	    {
+		++errors;
+		cout << "mismatch for \"" << name << "\", expected " << (expected ? "true" : "false") << " with:" << endl;
+		cout << set.dump("    ") << endl;
+	    }
+	}
+    }
+
+    cout << checked << " strings checked, " << matched << " matched, " << errors << " error(s)" << endl;
+}
+
+void f2()
+{
+    const U_I counts[] = { 10, 100, 1000, 10000 };
+    deque<string> names;
+
+    srand(1);
+    for(U_I i = 0; i < 20000; ++i)
+    {
+	switch(rand() % 4)
+	{
+	case 0:
+	    names.push_back(tools_printf("file%d.ext%d", rand() % 1000, rand() % 20000));
+	    break;
+	case 1:
+	    names.push_back(tools_printf("name%d", rand() % 20000));
+	    break;
+	case 2:
+	    names.push_back(tools_printf("some_dir%d_cache%d", rand() % 100, rand() % 20000));
+	    break;
+	default:
+	    names.push_back(tools_printf(".hidden%d.o", rand() % 20000));
+	    break;
+	}
+    }
+
+    for(U_I c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+    {
+	deque<string> globs, regex;
+
+	for(U_I i = 0; i < counts[c]; ++i)
+	{
+	    switch(i % 5)
+	    {
+	    case 0:
+		globs.push_back(tools_printf("*.ext%d", i));
+		regex.push_back(tools_printf("\\.ext%d$", i));
+		break;
+	    case 1:
+		globs.push_back(tools_printf("name%d", i));
+		regex.push_back(tools_printf("^name%d$", i));
+		break;
+	    case 2:
+		globs.push_back(tools_printf("*cache%d*", i));
+		regex.push_back(tools_printf("cache%d", i));
+		break;
+	    case 3:
+		globs.push_back(tools_printf("file%d.[ch]", i));
+		regex.push_back(tools_printf("^file%d\\.[ch]$", i));
+		break;
+	    default:
+		globs.push_back(tools_printf("name%d.?", i));
+		regex.push_back(tools_printf("^name%d\\..$", i));
+		break;
+	    }
+	}
+
+	f3(names, globs, deque<string>());
+	f3(names, deque<string>(), regex);
+    }
+}
+
+void f3(const deque<string> & names, const deque<string> & globs, const deque<string> & regex)
+{
+    ou_mask ref;
+    chrono::steady_clock::time_point start;
+    double build_ref, build_set, time_ref, time_set;
+    U_I match_ref = 0, match_set = 0;
+    U_I count = globs.size() + regex.size();
+    U_I ref_names = names.size() * 10 / count;
+
+    start = chrono::steady_clock::now();
+    for(deque<string>::const_iterator it = globs.begin(); it != globs.end(); ++it)
+	ref.add_mask(simple_mask(*it, true));
+    for(deque<string>::const_iterator it = regex.begin(); it != regex.end(); ++it)
+	ref.add_mask(regular_mask(*it, true));
+    build_ref = since(start);
+
+    start = chrono::steady_clock::now();
+    pattern_set_mask set(globs, regex, true);
+    build_set = since(start);
+
+	// the ou_mask is too slow with many expressions to check all the names
+
+    if(ref_names > names.size())
+	ref_names = names.size();
+    if(ref_names < 100)
+	ref_names = 100;
+
+    start = chrono::steady_clock::now();
+    for(U_I i = 0; i < ref_names; ++i)
+	if(ref.is_covered(names[i]))
+	    ++match_ref;
+    time_ref = since(start);
+
+    start = chrono::steady_clock::now();
+    for(U_I i = 0; i < ref_names; ++i)
+	if(set.is_covered(names[i]))
+	    ++match_set;
+    if(match_ref != match_set)
+	throw Erange("f3", "pattern_set_mask and ou_mask disagree");
+
+    for(U_I i = ref_names; i < names.size(); ++i)
+	if(set.is_covered(names[i]))
+	    ++match_set;
+    time_set = since(start);
+
+    cout << count << (globs.empty() ? " regular" : " glob") << " expressions: "
+	 << "ou_mask " << time_ref * 1e9 / ref_names << " ns/entry (built in " << build_ref << " s), "
+	 << "pattern_set_mask " << time_set * 1e9 / names.size() << " ns/entry (built in " << build_set << " s, "
+	 << set.get_automaton_count() << " automaton), "
+	 << match_set << " of " << names.size() << " entries matched" << endl;
+}
+
+string random_glob()
+{
+    static const char *pieces[] = { "a", "b", "A", ".", "*", "?", "[ab]", "[!a]", "[^.]", "[a-c]", "[[:alpha:]]", "[]a]", "\\*", "\\", "[", "]", "-", "\xc3\xa9", "\xc3\x89" };
+    U_I num = rand() % 6;
+    string ret;
+
+    for(U_I i = 0; i < num; ++i)
+	ret += pieces[rand() % (sizeof(pieces) / sizeof(pieces[0]))];
+
+    return ret;
+}
+
+string random_regex()
+{
+    static const char *pieces[] = { "a", "b", "A", ".", "*", "^", "$", "(a|b)", "[ab]", "\\.", "+", "(", ")", "\\1", "\xc3\xa9" };
+    U_I num = 1 + rand() % 5;
+    string ret;
+
+    for(U_I i = 0; i < num; ++i)
+	ret += pieces[rand() % (sizeof(pieces) / sizeof(pieces[0]))];
+
+    return ret;
+}
+
+string random_name()
+{
+    static const char *pieces[] = { "a", "b", "c", "A", "B", ".", "*", "[", "]", "-", "\\", "\xc3\xa9", "\xc3\x89", "\xa9" };
+    U_I num = rand() % 7;
+    string ret;
+
+    for(U_I i = 0; i < num; ++i)
+	ret += pieces[rand() % (sizeof(pieces) / sizeof(pieces[0]))];
+
+    return ret;
+}
+
+double since(const chrono::steady_clock::time_point & start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,152 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_STRING_H
+#include <string.h>
+#endif
+} // end extern "C"
+
+#include <iostream>
+#include <chrono>
+#include <memory>
+#include <random>
+#include "libdar.hpp"
+#include "sparse_file.hpp"
+#include "fichier_local.hpp"
+#include "cache.hpp"
+#include "shell_interaction.hpp"
+#include "tools.hpp"
+#include "deci.hpp"
+
+using namespace libdar;
+using namespace std;
+
+    // writes data through a sparse_file object (hole detection) then reads it
+    // back, checking the restored data and reporting the throughput, first
+    // with dense data (random bytes), then with data looking like a virtual
+    // machine disk image (mostly zeroed blocks between blocks of data)
+    // usage: test_sparse_file [size in MiB]
+
+static shared_ptr<user_interaction> ui;
+
+static void f1(U_I mebi);
+static void f2(const char *label, const char *data, U_I length);
+
+int main(int argc, char *argv[])
+{
+    U_I maj, med, min;
+    U_I mebi = 64;
+
+    get_version(maj, med, min);
+    ui.reset(new (nothrow) shell_interaction(cout, cerr, false));
+    if(!ui)
+	cout << "ERREUR !" << endl;
+    if(argc > 1 && !tools_my_atoi(argv[1], mebi))
+	cout << "usage: " << argv[0] << " [size in MiB]" << endl;
+
+    try
+    {
+	f1(mebi);
+    }
+    catch(Egeneric & e)
+    {
+	cerr << e.dump_str();
+    }
+
+    ui.reset();
+    return 0;
+}
+
+static void f1(U_I mebi)
+{
+    const U_I block = 4096;
+    U_I length = mebi * 1024 * 1024;
+    unique_ptr<char[]> data(new char[length]);
+    mt19937 gen(1);
+
+    for(U_I i = 0; i < length; ++i)
+	data[i] = (char)(gen() & 0xFF);
+    f2("dense data", data.get(), length);
+
+	// 60% of zeroed blocks, 30% of random data blocks and 10% of
+	// blocks holding short runs of zeros (like filesystem metadata)
+
+    for(U_I i = 0; i + block <= length; i += block)
+    {
+	U_I kind = gen() % 10;
+
+	if(kind < 6)
+	    (void)memset(&data[i], 0, block);
+	else if(kind == 9)
+	    for(U_I j = 0; j < block; j += 16)
+		(void)memset(&data[i + j], 0, 1 + gen() % 12);
+    }
+    f2("sparse data", data.get(), length);
+}
+
+static void f2(const char *label, const char *data, U_I length)
+{
+    const U_I step = 65536;
+    unique_ptr<char[]> back(new char[length]);
+    chrono::steady_clock::time_point start;
+    double write_time, read_time;
+    infinint encoded;
+    U_I lu = 0;
+
+    {
+	fichier_local file(ui, "sparse_bench", gf_write_only, 0666, false, true, false);
+	cache below(file, false);
+	sparse_file tested(&below);
+
+	start = chrono::steady_clock::now();
+	for(U_I i = 0; i < length; i += step)
+	    tested.write(data + i, length - i < step ? length - i : step);
+	tested.sync_write();
+	tested.terminate();
+	below.terminate();
+	write_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	encoded = file.get_size();
+    }
+
+    {
+	fichier_local file(ui, "sparse_bench", gf_read_only, 0666, false, false, false);
+	cache below(file, false);
+	sparse_file tested(&below);
+	U_I r;
+
+	start = chrono::steady_clock::now();
+	do
+	{
+	    r = tested.read(back.get() + lu, length - lu < step ? length - lu : step);
+	    lu += r;
+	}
+	while(r > 0 && lu < length);
+	read_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    cout << label << ": " << (lu == length && memcmp(data, back.get(), length) == 0 ? "OK" : "DATA MISMATCH")
+	 << ", " << length << " bytes encoded in " << libdar::deci(encoded).human() << " bytes" << endl;
+    cout << "   write: " << length / write_time / 1e6 << " MB/s, read: " << length / read_time / 1e6 << " MB/s" << endl;
+}
@@ -70,7 +70,7 @@ using namespace libdar;
 class test : public tronconneuse
 {
 public:
-    test(user_interaction & dialog, U_32 block_size, generic_file & encrypted_size, bool no_is = false): tronconneuse(block_size, encrypted_size, no_is, macro_tools_supported_version)
+    test(user_interaction & dialog, U_32 block_size, generic_file & encrypted_size, bool no_is = false, U_I workers = 1): tronconneuse(block_size, encrypted_size, no_is, macro_tools_supported_version, workers)
     {};
 
 protected:
@@ -78,6 +78,9 @@ protected:
     U_32 clear_block_allocated_size_for(U_32 clear_block_size) { return clear_block_size + 2; };
     U_32 encrypt_data(const infinint & block_num, const char *clear_buf, const U_32 clear_size, const U_32 clear_allocated, char *crypt_buf, U_32 crypt_size);
     U_32 decrypt_data(const infinint & block_num, const char *crypt_buf, const U_32 crypt_size, char *clear_buf, U_32 clear_size);
+	// no state is kept, all workers can share the same methods
+    U_32 encrypt_data_by(U_I worker, const infinint & block_num, const char *clear_buf, const U_32 clear_size, const U_32 clear_allocated, char *crypt_buf, U_32 crypt_size) { return encrypt_data(block_num, clear_buf, clear_size, clear_allocated, crypt_buf, crypt_size); };
+    U_32 decrypt_data_by(U_I worker, const infinint & block_num, const char *crypt_buf, const U_32 crypt_size, char *clear_buf, U_32 clear_size) { return decrypt_data(block_num, crypt_buf, crypt_size, clear_buf, clear_size); };
 };
 
 U_32 test::encrypt_data(const infinint & block_num, const char *clear_buf, const U_32 clear_size, const U_32 clear_allocated, char *crypt_buf, U_32 crypt_size)
@@ -102,8 +105,8 @@ U_32 test::decrypt_data(const infinint & block_num, const char *crypt_buf, const
 }
 
 
-void f1(const shared_ptr<user_interaction> & dialog);
-void f2(const shared_ptr<user_interaction> & dialog);
+void f1(const shared_ptr<user_interaction> & dialog, U_I workers = 1);
+void f2(const shared_ptr<user_interaction> & dialog, U_I workers = 1);
 void f3(const shared_ptr<user_interaction> & dialog);
 
 int main()
@@ -117,6 +120,9 @@ int main()
 	f1(dialog);
 	f2(dialog);
 	f3(dialog);
+	    // same as f1 and f2 with blocks processed by batches, the output must not change
+	f1(dialog, 3);
+	f2(dialog, 3);
     }
     catch(Egeneric & e)
     {
@@ -129,11 +135,11 @@ int main()
     dialog.reset();
 }
 
-void f1(const shared_ptr<user_interaction> & dialog)
+void f1(const shared_ptr<user_interaction> & dialog, U_I workers)
 {
     fichier_local fic = fichier_local(dialog, "toto", gf_write_only, 0666, false, true, false);
 
-    test *toto = new test(*dialog, 10, fic);
+    test *toto = new test(*dialog, 10, fic, false, workers);
     if(toto == nullptr)
 	throw Ememory("test");
 
@@ -151,11 +157,11 @@ void f1(const shared_ptr<user_interaction> & dialog)
     delete toto;
 }
 
-void f2(const shared_ptr<user_interaction> & dialog)
+void f2(const shared_ptr<user_interaction> & dialog, U_I workers)
 {
     fichier_local fic = fichier_local(dialog, "toto", gf_read_only, 0666, false, false, false);
 
-    test *toto = new test(*dialog, 10, fic);
+    test *toto = new test(*dialog, 10, fic, false, workers);
     if(toto == nullptr)
 	throw Ememory("test");
 
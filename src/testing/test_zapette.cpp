@@ -0,0 +1,399 @@
+//*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2019 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author : http://dar.linux.free.fr/email.html
+/*********************************************************************/
+
+    // reads a file through a zapette and a slave_zapette, once with each
+    // protocol version the slave_zapette may agree on. The pipes between
+    // them go through a relay process that delays the data by the given
+    // latency in each direction, as a network link would. The file is read
+    // sequentially then by blocks at random offsets, the data is compared
+    // with the file content read directly.
+    // for example:
+    //   test_zapette /tmp/scratch 64 5
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif
+#if HAVE_STRING_H
+#include <string.h>
+#endif
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif
+#if HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#if HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
+#include <poll.h>
+} // end extern "C"
+
+#include <iostream>
+#include <chrono>
+#include <deque>
+
+#include "libdar.hpp"
+#include "shell_interaction.hpp"
+#include "fichier_local.hpp"
+#include "contextual.hpp"
+#include "tuyau.hpp"
+#include "zapette.hpp"
+#include "slave_zapette.hpp"
+#include "zapette_protocol.hpp"
+#include "tools.hpp"
+
+using namespace std;
+using namespace libdar;
+
+    // the data the slave_zapette reads from
+class source : public fichier_local, public contextual
+{
+public:
+    source(const shared_ptr<user_interaction> & dialog, const string & filename): fichier_local(dialog, filename, gf_read_only, 0, false, false, false) {};
+
+    virtual bool is_an_old_start_end_archive() const override { return false; };
+    virtual const label & get_data_name() const override { return name; };
+
+private:
+    label name;
+};
+
+    // a chunk of data waiting in the relay
+struct chunk
+{
+    chrono::steady_clock::time_point due;
+    string data;
+};
+
+void usage(const char *argv0);
+void f1(const shared_ptr<user_interaction> & dialog, const string & filename, U_I size, U_I latency, U_I version);
+void relay(int from_master, int to_slave, int from_slave, int to_master, U_I latency);
+void make_file(const string & filename, U_I size);
+void check(const char *data, U_I len, U_I offset, const string & filename);
+double since(const chrono::steady_clock::time_point & start);
+
+int main(int argc, char *argv[])
+{
+    U_I maj, med, min;
+
+    if(argc != 4)
+    {
+	usage(argv[0]);
+	return 1;
+    }
+
+    try
+    {
+	shared_ptr<user_interaction> dialog(new (nothrow) shell_interaction(cout, cerr, false));
+	string filename = argv[1];
+	U_I size = atoi(argv[2]);
+	U_I latency = atoi(argv[3]);
+
+	get_version(maj, med, min);
+	if(!dialog)
+	    throw Ememory("main");
+
+	make_file(filename, size*1024*1024);
+	for(U_I version = PROTOCOL_VERSION_1; version <= PROTOCOL_VERSION_LAST; ++version)
+	    f1(dialog, filename, size*1024*1024, latency, version);
+    }
+    catch(Egeneric & e)
+    {
+	cout << "Exception caught: " << e.get_message() << endl;
+	return 2;
+    }
+
+    return 0;
+}
+
+void usage(const char *argv0)
+{
+    cout << "usage: " << argv0 << " <scratch file> <size in MiB> <latency in ms>" << endl;
+}
+
+void f1(const shared_ptr<user_interaction> & dialog, const string & filename, U_I size, U_I latency, U_I version)
+{
+    int m2r[2], r2s[2], s2r[2], r2m[2];
+    pid_t relay_pid, slave_pid;
+    chrono::steady_clock::time_point start;
+    double seq_time, rand_time;
+    static const U_I block = 65536;
+    static const U_I rand_block = 262144;
+    static const U_I rand_count = 50;
+    char *buffer = new (nothrow) char[rand_block];
+
+    if(buffer == nullptr)
+	throw Ememory("f1");
+
+    if(pipe(m2r) != 0 || pipe(r2s) != 0 || pipe(s2r) != 0 || pipe(r2m) != 0)
+	throw Erange("f1", string("pipe() failed: ") + tools_strerror_r(errno));
+
+    relay_pid = fork();
+    if(relay_pid == 0)
+    {
+	close(m2r[1]);
+	close(r2s[0]);
+	close(s2r[1]);
+	close(r2m[0]);
+	relay(m2r[0], r2s[1], s2r[0], r2m[1], latency);
+	exit(0);
+    }
+
+    slave_pid = fork();
+    if(slave_pid == 0)
+    {
+	close(m2r[0]);
+	close(m2r[1]);
+	close(s2r[0]);
+	close(r2m[0]);
+	close(r2m[1]);
+	close(r2s[1]);
+	try
+	{
+	    slave_zapette slave(new tuyau(dialog, r2s[0], gf_read_only),
+				new tuyau(dialog, s2r[1], gf_write_only),
+				new source(dialog, filename),
+				version);
+	    slave.action();
+	}
+	catch(Egeneric & e)
+	{
+	    cout << "slave: exception caught: " << e.get_message() << endl;
+	    exit(1);
+	}
+	exit(0);
+    }
+
+    close(m2r[0]);
+    close(r2s[0]);
+    close(r2s[1]);
+    close(s2r[0]);
+    close(s2r[1]);
+    close(r2m[1]);
+
+    try
+    {
+	zapette zap(dialog, new tuyau(dialog, r2m[0], gf_read_only), new tuyau(dialog, m2r[1], gf_write_only), false);
+	U_I lu = 0, got;
+
+	    // sequential reading of the whole file
+
+	start = chrono::steady_clock::now();
+	zap.skip(0);
+	zap.read_ahead(0);
+	do
+	{
+	    got = zap.read(buffer, block);
+	    check(buffer, got, lu, filename);
+	    lu += got;
+	}
+	while(got > 0);
+	seq_time = since(start);
+	if(lu != size)
+	    throw Erange("f1", tools_printf("read %d bytes instead of %d", lu, size));
+
+	    // reading blocks at random offsets
+
+	srand(1);
+	start = chrono::steady_clock::now();
+	for(U_I i = 0; i < rand_count; ++i)
+	{
+	    U_I offset = (U_I)(rand()) % (size - rand_block);
+
+	    zap.skip(offset);
+	    zap.read_ahead(rand_block);
+	    lu = 0;
+	    do
+	    {
+		got = zap.read(buffer + lu, rand_block - lu);
+		lu += got;
+	    }
+	    while(got > 0 && lu < rand_block);
+	    check(buffer, lu, offset, filename);
+	}
+	rand_time = since(start);
+
+	zap.terminate();
+    }
+    catch(...)
+    {
+	delete [] buffer;
+	throw;
+    }
+    delete [] buffer;
+
+    waitpid(slave_pid, nullptr, 0);
+    waitpid(relay_pid, nullptr, 0);
+
+    cout << "protocol version " << version << ", latency " << latency << " ms: "
+	 << "sequential " << (double)(size) / 1048576 / seq_time << " MiB/s, "
+	 << "random blocks of " << rand_block / 1024 << " KiB " << rand_time * 1000 / rand_count << " ms/block" << endl;
+}
+
+void relay(int from_master, int to_slave, int from_slave, int to_master, U_I latency)
+{
+    deque<chunk> to_slave_queue, to_master_queue;
+    bool master_open = true, slave_open = true;
+    char buffer[65536];
+
+	// each direction is delayed by half the round trip latency
+    chrono::microseconds delay(latency * 500);
+
+    while(master_open || slave_open || !to_slave_queue.empty() || !to_master_queue.empty())
+    {
+	struct pollfd fds[2];
+	nfds_t num = 0;
+	int timeout = -1;
+	chrono::steady_clock::time_point now = chrono::steady_clock::now();
+
+	    // sending what is due
+
+	while(!to_slave_queue.empty() && to_slave_queue.front().due <= now)
+	{
+	    if(write(to_slave, to_slave_queue.front().data.c_str(), to_slave_queue.front().data.size()) < 0)
+		exit(1);
+	    to_slave_queue.pop_front();
+	}
+	while(!to_master_queue.empty() && to_master_queue.front().due <= now)
+	{
+	    if(write(to_master, to_master_queue.front().data.c_str(), to_master_queue.front().data.size()) < 0)
+		exit(1);
+	    to_master_queue.pop_front();
+	}
+
+	if(!master_open && to_slave_queue.empty() && to_slave >= 0)
+	{
+	    close(to_slave);
+	    to_slave = -1;
+	}
+	if(!slave_open && to_master_queue.empty() && to_master >= 0)
+	{
+	    close(to_master);
+	    to_master = -1;
+	}
+
+	    // waiting for data or for the next chunk to be due
+
+	if(!to_slave_queue.empty())
+	    timeout = chrono::duration_cast<chrono::milliseconds>(to_slave_queue.front().due - now).count() + 1;
+	if(!to_master_queue.empty())
+	{
+	    int tmp = chrono::duration_cast<chrono::milliseconds>(to_master_queue.front().due - now).count() + 1;
+	    if(timeout < 0 || tmp < timeout)
+		timeout = tmp;
+	}
+
+	if(master_open)
+	{
+	    fds[num].fd = from_master;
+	    fds[num].events = POLLIN;
+	    ++num;
+	}
+	if(slave_open)
+	{
+	    fds[num].fd = from_slave;
+	    fds[num].events = POLLIN;
+	    ++num;
+	}
+	if(num == 0 && timeout < 0)
+	    break;
+
+	if(poll(fds, num, timeout) < 0)
+	    exit(1);
+
+	for(nfds_t i = 0; i < num; ++i)
+	{
+	    if((fds[i].revents & (POLLIN|POLLHUP)) == 0)
+		continue;
+
+	    ssize_t lu = read(fds[i].fd, buffer, sizeof(buffer));
+	    chunk cur;
+
+	    if(lu <= 0)
+	    {
+		if(fds[i].fd == from_master)
+		    master_open = false;
+		else
+		    slave_open = false;
+		continue;
+	    }
+
+	    cur.due = chrono::steady_clock::now() + delay;
+	    cur.data.assign(buffer, lu);
+	    if(fds[i].fd == from_master)
+		to_slave_queue.push_back(cur);
+	    else
+		to_master_queue.push_back(cur);
+	}
+    }
+}
+
+void make_file(const string & filename, U_I size)
+{
+    fichier_local f(shared_ptr<user_interaction>(new (nothrow) shell_interaction(cout, cerr, false)), filename, gf_write_only, 0600, false, true, false);
+    char buffer[4096];
+    U_I written = 0;
+
+    srand(2);
+    while(written < size)
+    {
+	for(U_I i = 0; i < sizeof(buffer); ++i)
+	    buffer[i] = rand() % 256;
+	f.write(buffer, sizeof(buffer) < size - written ? sizeof(buffer) : size - written);
+	written += sizeof(buffer);
+    }
+}
+
+void check(const char *data, U_I len, U_I offset, const string & filename)
+{
+    static fichier_local *ref = nullptr;
+    static char buffer[262144];
+    U_I lu = 0, got;
+
+    if(ref == nullptr)
+	ref = new fichier_local(filename);
+
+    if(len > sizeof(buffer))
+	throw Erange("check", "too large data to check");
+
+    ref->skip(offset);
+    do
+    {
+	got = ref->read(buffer + lu, len - lu);
+	lu += got;
+    }
+    while(got > 0 && lu < len);
+
+    if(lu != len || memcmp(buffer, data, len) != 0)
+	throw Erange("check", tools_printf("data read through the zapette differs from the file at offset %d", offset));
+}
+
+double since(const chrono::steady_clock::time_point & start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}